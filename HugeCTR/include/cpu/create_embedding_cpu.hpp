@@ -25,6 +25,7 @@ template <typename TypeFP>
 struct create_embedding_cpu {
   void operator()(const InferenceParams& inference_params, const nlohmann::json& j_layers_array,
                   std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+                  std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
                   std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
                   std::vector<size_t>& embedding_table_slot_size,
                   std::vector<TensorEntry>* tensor_entries,
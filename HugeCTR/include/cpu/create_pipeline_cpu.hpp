@@ -24,16 +24,19 @@ namespace HugeCTR {
 void create_pipeline_cpu(const nlohmann::json& config, std::map<std::string, bool> tensor_active,
                          const InferenceParams& inference_params, Tensor2<float>& dense_input,
                          std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+                         std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
                          std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
                          std::vector<size_t>& embedding_table_slot_size,
                          std::vector<std::shared_ptr<LayerCPU>>* embeddings, NetworkCPU** network,
-                         const std::shared_ptr<CPUResource>& cpu_resource);
+                         const std::shared_ptr<CPUResource>& cpu_resource,
+                         const NetworkCPU* weights_source = nullptr);
 
 template <typename TypeEmbeddingComp>
 void create_pipeline_inference_cpu(const nlohmann::json& config,
                                    const InferenceParams& inference_params,
                                    Tensor2<float>& dense_input,
                                    std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+                                   std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
                                    std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
                                    std::vector<size_t>& embedding_table_slot_size,
                                    std::vector<std::shared_ptr<LayerCPU>>* embeddings,
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <core/macro.hpp>
+#include <cstdint>
+#include <hps/hier_parameter_server_base.hpp>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+struct EmbeddingCacheCPUParams final {
+  size_t capacity{0};     // Maximum number of embeddings cached per table (0 = disable cache).
+  size_t num_shards{16};  // Each table is split into this many independently locked shards.
+  std::chrono::milliseconds refresh_interval{0};  // Period with which cached embeddings are
+                                                  // re-read from the parameter server (0 = never).
+};
+
+/**
+ * Counters of a table in an \p EmbeddingCacheCPU .
+ */
+struct EmbeddingCacheCPUStats final {
+  size_t num_hits{0};
+  size_t num_misses{0};
+  size_t num_admitted{0};   // Missed keys that were inserted into the cache.
+  size_t num_rejected{0};   // Missed keys that were less frequent than the eviction candidate.
+  size_t num_evicted{0};    // Cached keys that were replaced.
+  size_t num_refreshed{0};  // Embeddings updated by background refreshes.
+  size_t size{0};           // Currently cached embeddings.
+
+  inline double hit_rate() const {
+    const size_t num_lookups{num_hits + num_misses};
+    return num_lookups ? static_cast<double>(num_hits) / static_cast<double>(num_lookups) : 0;
+  }
+
+  EmbeddingCacheCPUStats& operator+=(const EmbeddingCacheCPUStats& other);
+};
+
+std::ostream& operator<<(std::ostream& os, const EmbeddingCacheCPUStats& stats);
+
+/**
+ * Host memory cache for the embeddings of a model, which serves lookups of CPU-only deployments
+ * without going through the parameter server (i.e., the CPU counterpart of \p EmbeddingCache ).
+ *
+ * Each table is split into shards by key hash. Shards are cache-line aligned, and store their
+ * embeddings in cache-line aligned slots. Keys are admitted following the TinyLFU policy: Each
+ * shard estimates the access frequency of keys with a count-min sketch whose counters are halved
+ * periodically. A missed key only replaces the eviction candidate (chosen by the CLOCK algorithm)
+ * if it was accessed more frequently. Hence, one-off keys do not displace hot keys.
+ *
+ * Missed keys are always fetched from the parameter server synchronously. Cached embeddings are
+ * re-read from the parameter server in the background (see \p refresh_interval ).
+ *
+ * @tparam Key Data-type of the keys.
+ */
+template <typename Key>
+class EmbeddingCacheCPU final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(EmbeddingCacheCPU);
+
+  EmbeddingCacheCPU() = delete;
+
+  /**
+   * @param params Cache configuration.
+   * @param inference_params Model whose embedding tables are cached.
+   * @param parameter_server Source of the embeddings. Must outlive the cache.
+   */
+  EmbeddingCacheCPU(const EmbeddingCacheCPUParams& params, const InferenceParams& inference_params,
+                    HierParameterServerBase* parameter_server);
+
+  ~EmbeddingCacheCPU();
+
+  /**
+   * Looks up embeddings (thread-safe). Missing embeddings are fetched from the parameter server.
+   *
+   * @param table_id Index of the embedding table.
+   * @param keys Pointer to the keys.
+   * @param num_keys Number of \p keys .
+   * @param vectors Buffer that receives the embeddings (`num_keys * embedding_vecsize` floats).
+   */
+  void lookup(size_t table_id, const Key* keys, size_t num_keys, float* vectors);
+
+  /**
+   * Re-reads all cached embeddings from the parameter server. Called periodically by the
+   * background thread, if a \p refresh_interval was configured.
+   */
+  void refresh();
+
+  inline size_t num_tables() const { return tables_.size(); }
+
+  EmbeddingCacheCPUStats stats(size_t table_id) const;
+
+ private:
+  struct alignas(64) Shard final {
+    mutable std::mutex guard;
+
+    // Slots.
+    phmap::flat_hash_map<Key, uint32_t> index;  // Key -> slot.
+    std::vector<Key> keys;
+    std::vector<uint8_t> referenced;
+    std::unique_ptr<float, void (*)(void*)> vectors{nullptr, std::free};
+    size_t size{0};
+    size_t hand{0};
+
+    // Frequency sketch (4 rows of saturating 4-bit counters, stored as bytes).
+    std::vector<uint8_t> sketch;
+    size_t sketch_width{0};
+    size_t sketch_additions{0};
+
+    EmbeddingCacheCPUStats stats;
+  };
+
+  struct Table final {
+    size_t vector_size;  // Number of floats per embedding.
+    size_t slot_size;    // Number of floats per slot (multiple of a cache line).
+    size_t slots_per_shard;
+    std::vector<Shard> shards;
+  };
+
+  const EmbeddingCacheCPUParams params_;
+  const std::string model_name_;
+  HierParameterServerBase* const parameter_server_;
+  std::vector<Table> tables_;
+
+  // Background refresh.
+  std::mutex refresh_guard_;
+  std::condition_variable refresh_semaphore_;
+  bool terminate_{false};
+  std::thread refresher_;
+  void run_();
+
+  // Estimates the access frequency of a key. Also counts the access, if \p record is \p true .
+  uint8_t frequency_(Shard& shard, const Key& key, bool record) const;
+
+  // Caches a value, subject to admission. Requires holding the lock of the shard.
+  void admit_(const Table& table, Shard& shard, const Key& key, const float* vector);
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
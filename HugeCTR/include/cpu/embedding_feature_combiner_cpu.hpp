@@ -39,6 +39,10 @@ class EmbeddingFeatureCombinerCPU : public LayerCPU {
    * stores the references to the row pointers tensors of this layer.
    */
   std::vector<std::shared_ptr<Tensor2<int>>> row_ptrs_tensors_;
+  /*
+   * stores the references to the row indices tensors of this layer (empty, if not used).
+   */
+  std::vector<std::shared_ptr<Tensor2<int>>> row_indices_tensors_;
 
  public:
   /**
@@ -52,13 +56,16 @@ class EmbeddingFeatureCombinerCPU : public LayerCPU {
    * @param slot_num slot number
    * @param combiner_type combiner type for the features in the same slot, Sum or Mean
    * @param blobs_buff GeneralBuffer used to create the output tensor
-   * @param gpu_resource available gpu resource
+   * @param row_indices_tensor optional row indices tensor, should be 1D. If given, feature l of the
+   * batch refers to row row_indices[l] of the embedding feature tensor, which thus only needs to
+   * hold the vectors of the distinct keys
    */
   EmbeddingFeatureCombinerCPU(const std::shared_ptr<Tensor2<float>>& in_tensor,
                               const std::shared_ptr<Tensor2<int>>& row_ptrs_tensor,
                               Tensor2<T>& out_tensor, int batch_size, int slot_num,
                               EmbeddingFeatureCombiner_t combiner_type,
-                              const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff);
+                              const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
+                              const std::shared_ptr<Tensor2<int>>& row_indices_tensor = nullptr);
   ~EmbeddingFeatureCombinerCPU(){};
 
   /**
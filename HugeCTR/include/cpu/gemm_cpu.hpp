@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cuda_fp16.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Element-wise operations that \p gemm_cpu applies to each block of C right after computing it,
+ * i.e., while the block is still in cache. This fuses the bias and activation of fully connected
+ * layers into the matrix multiplication.
+ */
+struct GemmEpilogueCPU {
+  const float* bias{nullptr};  // If set, added to every row of C (n elements).
+  bool relu{false};            // If set, negative results are replaced by 0.
+};
+
+/**
+ * General matrix multiplication for the CPU layers, i.e., `C = A * B` or `C += A * B` (if
+ * \p accumulate is set). All matrices are dense and row-major.
+ *
+ * Following the GotoBLAS scheme, blocks of A and B are packed into contiguous panels that fit the
+ * L2 and L3 caches, and multiplied by a register-blocked micro-kernel. The micro-kernel is chosen
+ * at runtime (AVX-512, AVX2 + FMA, or portable C++). Sufficiently large products are split into
+ * blocks along M and N, which are processed concurrently (see \p set_gemm_cpu_num_threads ). B is
+ * packed once per call, and shared by all blocks along M (see \p PackedMatrixCPU to reuse it).
+ *
+ * The \p __half overloads convert the inputs while packing, and accumulate in fp32. Hence, they are
+ * numerically equivalent to the fp32 overload applied to the converted inputs.
+ *
+ * @param m Number of rows of A and C.
+ * @param n Number of columns of B and C.
+ * @param k Number of columns of A / rows of B.
+ * @param a Pointer to A (`m * k` elements).
+ * @param b Pointer to B (`k * n` elements).
+ * @param c Pointer to C (`m * n` elements).
+ * @param accumulate If \p true , the product is added to the current content of C.
+ * @param epilogue Applied to the result, after accumulation.
+ */
+void gemm_cpu(size_t m, size_t n, size_t k, const float* a, const float* b, float* c,
+              bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+void gemm_cpu(size_t m, size_t n, size_t k, const __half* a, const __half* b, float* c,
+              bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+void gemm_cpu(size_t m, size_t n, size_t k, const __half* a, const __half* b, __half* c,
+              bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+
+/**
+ * Right-hand side of \p gemm_cpu that is multiplied repeatedly (typically the weights of a layer),
+ * i.e., a `k x n` matrix, which is converted to fp32 and packed into the panels of the micro-kernel
+ * once, when it is created. Products with such a matrix skip packing B altogether.
+ */
+class PackedMatrixCPU final {
+ public:
+  /**
+   * @param k Number of rows of B.
+   * @param n Number of columns of B.
+   * @param b Pointer to B (`k * n` elements, row-major).
+   */
+  PackedMatrixCPU(size_t k, size_t n, const float* b);
+  PackedMatrixCPU(size_t k, size_t n, const __half* b);
+
+  size_t get_k() const { return k_; }
+  size_t get_n() const { return n_; }
+
+  // Values in the layout of the micro-kernel.
+  const float* get_packed() const { return packed_.data(); }
+
+ private:
+  size_t k_;
+  size_t n_;
+  std::vector<float> packed_;
+};
+
+/**
+ * \p gemm_cpu with a pre-packed B (`b.get_k() x b.get_n()`).
+ */
+void gemm_cpu(size_t m, const float* a, const PackedMatrixCPU& b, float* c,
+              bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+void gemm_cpu(size_t m, const __half* a, const PackedMatrixCPU& b, float* c,
+              bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+void gemm_cpu(size_t m, const __half* a, const PackedMatrixCPU& b, __half* c,
+              bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+
+/**
+ * Right-hand side of \p gemm_int8_cpu , i.e., a `k x n` matrix (typically the weights of a layer),
+ * which is quantized to int8 with one scale per column (i.e., per output channel). The quantized
+ * matrix is packed for the int8 micro-kernel once, when it is created. The AVX2 micro-kernel
+ * limits the quantized values to 7 bits.
+ */
+class Int8MatrixCPU final {
+ public:
+  /**
+   * @param k Number of rows of B.
+   * @param n Number of columns of B.
+   * @param b Pointer to B (`k * n` elements, row-major).
+   */
+  Int8MatrixCPU(size_t k, size_t n, const float* b);
+
+  size_t get_k() const { return k_; }
+  size_t get_n() const { return n_; }
+
+  // Dequantization scale of each column.
+  const std::vector<float>& get_scales() const { return scales_; }
+  // Sum of the quantized values of each column.
+  const std::vector<int32_t>& get_column_sums() const { return column_sums_; }
+  // Quantized values in the layout of the micro-kernel.
+  const int8_t* get_packed() const { return packed_.data(); }
+
+ private:
+  size_t k_;
+  size_t n_;
+  std::vector<float> scales_;
+  std::vector<int32_t> column_sums_;
+  std::vector<int8_t> packed_;
+};
+
+/**
+ * Quantized counterpart of \p gemm_cpu , i.e., `C = A * B` or `C += A * B`, where B is quantized
+ * per column (see \p Int8MatrixCPU ), and A is quantized per row on the fly. Products are
+ * accumulated in int32, and dequantized block by block, together with the epilogue. The
+ * micro-kernel is chosen at runtime (AVX-512 VNNI, AVX2, or portable C++).
+ *
+ * @param m Number of rows of A and C.
+ * @param a Pointer to A (`m * b.get_k()` elements).
+ * @param a_scale Quantization scale of A (i.e., A is rounded to multiples of \p a_scale , and
+ * clamped to `[-127 * a_scale, 127 * a_scale]`). If 0, each row of A is scaled to its own range.
+ * @param b The quantized matrix B.
+ * @param c Pointer to C (`m * b.get_n()` elements).
+ */
+void gemm_int8_cpu(size_t m, const float* a, float a_scale, const Int8MatrixCPU& b, float* c,
+                   bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+void gemm_int8_cpu(size_t m, const __half* a, float a_scale, const Int8MatrixCPU& b, float* c,
+                   bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+void gemm_int8_cpu(size_t m, const __half* a, float a_scale, const Int8MatrixCPU& b, __half* c,
+                   bool accumulate = false, const GemmEpilogueCPU& epilogue = {});
+
+/**
+ * Rounds \p n fp32 elements to fp16 (e.g., partial sums that were accumulated in fp32).
+ */
+void convert_cpu(size_t n, const float* src, __half* dst);
+
+/**
+ * Largest absolute value of \p n elements (e.g., to calibrate quantization scales).
+ */
+float abs_max_cpu(size_t n, const float* x);
+float abs_max_cpu(size_t n, const __half* x);
+
+/**
+ * Matrix-vector multiplication for the CPU layers, i.e., `y = A * x`, where A is a row-major
+ * `m x k` matrix.
+ */
+void gemv_cpu(size_t m, size_t k, const float* a, const float* x, float* y);
+
+/**
+ * Pairwise dot products of the rows of a `m x k` matrix X, i.e., the strictly lower triangle of
+ * `X * X^T`, stored row by row (`m * (m - 1) / 2` elements). The rows are given by pointers. Hence,
+ * X need not be contiguous (e.g., the features of a sample in the DLRM interaction).
+ *
+ * Computed by the calling thread with the micro-kernel of \p gemm_cpu , skipping tiles above the
+ * diagonal. That is, this is meant for batches of small matrices, which are split across the tasks
+ * of \p parallel_for_cpu .
+ */
+void gram_lower_cpu(size_t m, size_t k, const float* const* rows, float* out);
+void gram_lower_cpu(size_t m, size_t k, const __half* const* rows, float* out);
+
+/**
+ * Dot product of two vectors of length \p k (single-threaded, e.g., for use within the tasks of
+ * \p parallel_for_cpu ).
+ */
+float dot_cpu(size_t k, const float* a, const float* b);
+
+/**
+ * Limits the number of threads that a single \p gemm_cpu call may use (including the calling
+ * thread). Defaults to the number of hardware threads. 1 disables multithreading.
+ */
+void set_gemm_cpu_num_threads(size_t num_threads);
+
+/**
+ * Runs `func(task)` for all tasks in `[0, num_tasks)` on up to \p num_threads threads (bounded by
+ * \p set_gemm_cpu_num_threads ), sharing the thread pool of \p gemm_cpu with other CPU layers. The
+ * calling thread participates. Hence, this never blocks on a saturated pool.
+ */
+void parallel_for_cpu(size_t num_tasks, size_t num_threads,
+                      const std::function<void(size_t)>& func);
+
+/**
+ * Runs `func(begin, end)` for contiguous ranges of rows that cover `[0, num_rows)`, using
+ * \p parallel_for_cpu . Rows are only spread over multiple tasks if that pays off, given that each
+ * row takes about \p work_per_row elementary operations (e.g., multiply-adds).
+ */
+void parallel_for_rows_cpu(size_t num_rows, size_t work_per_row,
+                           const std::function<void(size_t, size_t)>& func);
+
+/**
+ * Name of the instruction set of the micro-kernel that was chosen for this CPU.
+ */
+const char* gemm_cpu_isa();
+
+/**
+ * Name of the instruction set of the int8 micro-kernel that was chosen for this CPU.
+ */
+const char* gemm_int8_cpu_isa();
+
+}  // namespace HugeCTR
@@ -16,49 +16,113 @@
 #pragma once
 
 #include <common.hpp>
+#include <condition_variable>
+#include <cpu/embedding_cache_cpu.hpp>
 #include <cpu/embedding_feature_combiner_cpu.hpp>
 #include <cpu/network_cpu.hpp>
+#include <cpu/unique_op_cpu.hpp>
 #include <hps/hier_parameter_server.hpp>
-#include <inference/preallocated_buffer2.hpp>
+#include <memory>
+#include <mutex>
 #include <parser.hpp>
 #include <string>
 #include <tensor2.hpp>
 #include <thread>
+#include <thread_pool.hpp>
 #include <utility>
 #include <vector>
 
 namespace HugeCTR {
 
+struct InferenceSessionCPUParams final {
+  size_t num_workers{1};  // Number of worker contexts. Each context has its own activations, but
+                          // the dense weights are shared. Hence, up to this many predictions (or
+                          // sub-batches thereof) are processed concurrently.
+  size_t worker_batchsize{0};  // Batches are split into sub-batches of up to this many samples,
+                               // which are processed by different worker contexts in parallel
+                               // (0 = max_batchsize, i.e., no split).
+};
+
+/**
+ * Inference session for CPU-only deployments. \p predict is thread-safe. Each prediction (or
+ * sub-batch) acquires an idle worker context. Embeddings of different tables are looked up in
+ * parallel. Only the distinct keys of each table are looked up, and the embedding feature
+ * combiners gather the vectors of duplicate keys by their inverse index.
+ */
 template <typename TypeHashKey>
 class InferenceSessionCPU {
  private:
+  struct WorkerContext final {
+    std::vector<std::shared_ptr<Tensor2<int>>> row_ptrs_tensors;
+    std::vector<std::shared_ptr<Tensor2<int>>> row_indices_tensors;
+    std::vector<std::shared_ptr<Tensor2<float>>> embedding_features_tensors;
+    Tensor2<float> dense_input_tensor;
+
+    std::vector<std::shared_ptr<LayerCPU>> embedding_feature_combiners;
+    std::unique_ptr<NetworkCPU> network;
+
+    // Keys, distinct keys and row pointers of the current sub-batch (table first).
+    // keys and unique_keys serve key types of both long long and unsigned int.
+    std::vector<long long> keys;
+    std::vector<long long> unique_keys;
+    std::vector<int> row_ptrs;
+    std::vector<UniqueOpCPU> unique_ops;  // One per table, as tables are looked up concurrently.
+  };
+
   nlohmann::json config_;
   std::string model_name_;
   std::vector<size_t> embedding_table_slot_size_;
+  size_t worker_batchsize_;
 
-  std::vector<std::shared_ptr<Tensor2<int>>> row_ptrs_tensors_;
-  std::vector<std::shared_ptr<Tensor2<float>>> embedding_features_tensors_;
-  Tensor2<float> dense_input_tensor_;
+  std::vector<std::unique_ptr<WorkerContext>> workers_;
+  std::vector<WorkerContext*> idle_workers_;
+  std::mutex idle_workers_guard_;
+  std::condition_variable idle_workers_semaphore_;
 
-  std::vector<std::shared_ptr<LayerCPU>> embedding_feature_combiners_;
-  std::unique_ptr<NetworkCPU> network_;
-  std::shared_ptr<HierParameterServerBase> parameter_server_;
+  std::unique_ptr<ThreadPool> predict_workers_;  // Processes sub-batches.
+  std::unique_ptr<ThreadPool> lookup_workers_;   // Looks up the embeddings of individual tables.
 
-  void* h_keys_;
-  float* h_embedding_vectors_;
+  std::shared_ptr<HierParameterServerBase> parameter_server_;
+  std::unique_ptr<EmbeddingCacheCPU<TypeHashKey>> embedding_cache_;
 
   std::shared_ptr<CPUResource> cpu_resource_;
 
+  std::unique_ptr<WorkerContext> create_worker_(const NetworkCPU* weights_source);
+  WorkerContext* acquire_worker_();
+  void release_worker_(WorkerContext* worker);
+
+  // Processes samples [first, last) of a batch.
+  void predict_(const float* h_dense, const void* h_embeddingcolumns, const int* h_row_ptrs,
+                float* h_output, size_t num_samples, size_t first, size_t last);
+  void predict_(WorkerContext* worker, const float* h_dense, const void* h_embeddingcolumns,
+                const int* h_row_ptrs, float* h_output, size_t num_samples, size_t first,
+                size_t last);
+
  protected:
   InferenceParser inference_parser_;
   InferenceParams inference_params_;
 
  public:
   InferenceSessionCPU(const std::string& model_config_path, const InferenceParams& inference_params,
-                      const std::shared_ptr<HierParameterServerBase>& parameter_server);
+                      const std::shared_ptr<HierParameterServerBase>& parameter_server,
+                      const EmbeddingCacheCPUParams& embedding_cache_params = {},
+                      const InferenceSessionCPUParams& session_params = {});
   virtual ~InferenceSessionCPU();
   void predict(float* h_dense, void* h_embeddingcolumns, int* h_row_ptrs, float* h_output,
                int num_samples);
+  /**
+   * Switches the dense network to int8 inference (post-training quantization, see
+   * \p NetworkCPU::quantize ). The inputs of the quantized layers are calibrated on the given
+   * sample requests (in the format of \p predict ). Without samples, they are quantized per row
+   * on the fly. All worker contexts share the quantized weights. Must not be called concurrently
+   * with \p predict .
+   */
+  void quantize(float* h_dense, void* h_embeddingcolumns, int* h_row_ptrs, int num_samples);
+  // nullptr, if the embedding cache is disabled.
+  const EmbeddingCacheCPU<TypeHashKey>* get_embedding_cache() const {
+    return embedding_cache_.get();
+  }
+  size_t get_num_workers() const { return workers_.size(); }
 };
 
-}  // namespace HugeCTR
\ No newline at end of file
+}  // namespace HugeCTR
@@ -55,6 +55,22 @@ class LayerCPU {
    * Some of the layers requires initialize like fully connected layer
    */
   virtual void initialize() {}
+
+  /*
+   * Int8 inference (see NetworkCPU::quantize). While calibrating, layers that support it record
+   * the range of their inputs.
+   */
+  virtual void set_calibration(bool calibrating) {}
+  /*
+   * Switches the layer to int8, if supported. If weights_source is provided (i.e., the same layer
+   * of a network with shared weights), its quantized weights are shared.
+   */
+  virtual void quantize(const LayerCPU* weights_source) {}
+  /*
+   * Packs constant weights for gemm_cpu once (see NetworkCPU::pack_weights). If weights_source is
+   * provided, its packed weights are shared.
+   */
+  virtual void pack_weights(const LayerCPU* weights_source) {}
 };
 
 }  // namespace HugeCTR
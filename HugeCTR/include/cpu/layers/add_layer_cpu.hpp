@@ -48,12 +48,11 @@ class AddLayerCPU : public LayerCPU {
    * Ctor of AddLayer.
    * @param in_tensor the input tensor
    * @param out_tensor the resulting output tensor
-   * @param device_id the id of GPU where this layer belongs
+   * @param fuse_relu if set, the sum is rectified (i.e., a fused ReLU layer)
    */
   AddLayerCPU(const Tensors2<T>& in_tensors, const Tensor2<T>& out_tensor,
-              const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff);
-
-  void initialize() override;
+              const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
+              bool fuse_relu = false);
 
   /**
    * AddLayer's foward propagation
@@ -69,6 +68,7 @@ class AddLayerCPU : public LayerCPU {
  private:
   int size_;
   size_t num_;
+  bool fuse_relu_;
   Tensor2<T*> h_inputs_;
 };
 
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <cpu/layer_cpu.hpp>
+#include <cpu/packed_fully_connected_cpu.hpp>
+#include <cpu/quantized_fully_connected_cpu.hpp>
 #include <functional>
 #include <vector>
 
@@ -32,6 +34,7 @@ template <>
 class FullyConnectedLayerCPU<float> : public LayerCPU {
  private:
   const bool use_mixed_precision_{false};
+  const bool fuse_relu_{false};
 
   /*
    * stores the weight tensors of this layer.
@@ -49,6 +52,14 @@ class FullyConnectedLayerCPU<float> : public LayerCPU {
    * stores the references to the output tensors of this layer.
    */
   Tensors2<float> out_tensors_;
+  /*
+   * int8 inference
+   */
+  QuantizedFullyConnectedCPU int8_;
+  /*
+   * weights, pre-packed for gemm_cpu
+   */
+  PackedFullyConnectedCPU packed_;
 
   Tensors2<float>& get_in_tensors(bool is_train) { return in_tensors_; }
 
@@ -62,6 +73,10 @@ class FullyConnectedLayerCPU<float> : public LayerCPU {
    */
   void bprop() final;
 
+  void set_calibration(bool calibrating) final { int8_.set_calibration(calibrating); }
+  void quantize(const LayerCPU* weights_source) final;
+  void pack_weights(const LayerCPU* weights_source) final;
+
   /**
    * This is the constructor of the FullyConnectedLayer.
    * It will check whether the format combination of all tensors is supported or not.
@@ -79,6 +94,15 @@ class FullyConnectedLayerCPU<float> : public LayerCPU {
                          const std::shared_ptr<BufferBlock2<float>>& wgrad_buff,
                          const Tensor2<float>& in_tensor, const Tensor2<float>& out_tensor,
                          bool use_mixed_precision);
+  /**
+   * Same as above, but the input is the concatenation of \p in_tensors along the second dimension
+   * (i.e., a fused Concat layer), and the output is optionally rectified (i.e., a fused ReLU
+   * layer).
+   */
+  FullyConnectedLayerCPU(const std::shared_ptr<BufferBlock2<float>>& weight_buff,
+                         const std::shared_ptr<BufferBlock2<float>>& wgrad_buff,
+                         const Tensors2<float>& in_tensors, const Tensor2<float>& out_tensor,
+                         bool use_mixed_precision, bool fuse_relu = false);
   FullyConnectedLayerCPU(const FullyConnectedLayerCPU& C) = delete;
   FullyConnectedLayerCPU& operator=(const FullyConnectedLayerCPU&);
 };
@@ -17,6 +17,8 @@
 
 #include <cpu/layer_cpu.hpp>
 #include <cpu/layers/fully_connected_layer_cpu.hpp>
+#include <cpu/packed_fully_connected_cpu.hpp>
+#include <cpu/quantized_fully_connected_cpu.hpp>
 #include <functional>
 #include <vector>
 
@@ -41,7 +43,7 @@ class FullyConnectedLayerCPU<__half> : public LayerCPU {
   /*
    * stores the references to the input tensors of this layer.
    */
-  Tensor2<__half> bottom_tensor_;
+  Tensors2<__half> bottom_tensors_;
 
   /*
    * stores the references to the output tensors of this layer.
@@ -53,7 +55,18 @@ class FullyConnectedLayerCPU<__half> : public LayerCPU {
    */
   Tensor2<__half> identity_tensor_;
 
-  Tensor2<__half>& get_bottom_tensor(bool is_train) { return bottom_tensor_; }
+  /*
+   * int8 inference
+   */
+  QuantizedFullyConnectedCPU int8_;
+  /*
+   * weights, pre-packed for gemm_cpu
+   */
+  PackedFullyConnectedCPU packed_;
+
+  const bool fuse_relu_{false};
+
+  Tensors2<__half>& get_bottom_tensors(bool is_train) { return bottom_tensors_; }
 
  public:
   /**
@@ -65,6 +78,10 @@ class FullyConnectedLayerCPU<__half> : public LayerCPU {
    */
   void bprop() final;
 
+  void set_calibration(bool calibrating) final { int8_.set_calibration(calibrating); }
+  void quantize(const LayerCPU* weights_source) final;
+  void pack_weights(const LayerCPU* weights_source) final;
+
   /**
    * This is the constructor of the FullyConnectedLayer.
    * It will check whether the format combination of all tensors is supported or not.
@@ -83,6 +100,17 @@ class FullyConnectedLayerCPU<__half> : public LayerCPU {
                          const std::shared_ptr<BufferBlock2<__half>>& weights_grad_buff,
                          const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
                          const Tensor2<__half>& bottom_tensor, const Tensor2<__half>& top_tensor);
+  /**
+   * Same as above, but the input is the concatenation of \p bottom_tensors along the second
+   * dimension (i.e., a fused Concat layer), and the output is optionally rectified (i.e., a fused
+   * ReLU layer).
+   */
+  FullyConnectedLayerCPU(const std::shared_ptr<BufferBlock2<float>>& master_weights_buff,
+                         const std::shared_ptr<BufferBlock2<__half>>& weights_buff,
+                         const std::shared_ptr<BufferBlock2<__half>>& weights_grad_buff,
+                         const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
+                         const Tensors2<__half>& bottom_tensors, const Tensor2<__half>& top_tensor,
+                         bool fuse_relu = false);
   FullyConnectedLayerCPU(const FullyConnectedLayerCPU&) = delete;
   FullyConnectedLayerCPU& operator=(const FullyConnectedLayerCPU&);
 };
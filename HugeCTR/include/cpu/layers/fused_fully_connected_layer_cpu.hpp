@@ -16,6 +16,8 @@
 #pragma once
 
 #include <cpu/layer_cpu.hpp>
+#include <cpu/packed_fully_connected_cpu.hpp>
+#include <cpu/quantized_fully_connected_cpu.hpp>
 #include <functional>
 #include <vector>
 
@@ -55,6 +57,15 @@ class FusedFullyConnectedLayerCPU : public LayerCPU {
    */
   Tensor2<float> bias_grad_tensor_;
 
+  /*
+   * int8 inference
+   */
+  QuantizedFullyConnectedCPU int8_;
+  /*
+   * weights, pre-packed for gemm_cpu
+   */
+  PackedFullyConnectedCPU packed_;
+
   Tensor2<__half>& get_bottom_tensor(bool is_train) { return bottom_tensor_; }
 
  public:
@@ -67,6 +78,10 @@ class FusedFullyConnectedLayerCPU : public LayerCPU {
    */
   void bprop() final;
 
+  void set_calibration(bool calibrating) final { int8_.set_calibration(calibrating); }
+  void quantize(const LayerCPU* weights_source) final;
+  void pack_weights(const LayerCPU* weights_source) final;
+
   /**
    * This is the constructor of the FullyConnectedLayer.
    * It will check whether the format combination of all tensors is supported or not.
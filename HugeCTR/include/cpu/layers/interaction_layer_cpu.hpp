@@ -44,8 +44,6 @@ class InteractionLayerCPU : public LayerCPU {
 
   bool use_mixed_precision_;
 
-  Tensors2<T> internal_tensors_;
-
   Tensors2<T>& get_in_tensors(bool is_train) { return in_tensors_; }
 
  public:
@@ -19,6 +19,7 @@
 #include <cpu/layer_cpu.hpp>
 #include <fstream>
 #include <functional>
+#include <general_buffer2.hpp>
 #include <nlohmann/json.hpp>
 #include <parser.hpp>
 #include <vector>
@@ -42,6 +43,9 @@ class NetworkCPU {
 
   Tensor2<float> pred_tensor_;
 
+  // Backing memory of weight_tensor_ and weight_tensor_half_. Shared by replicas.
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> params_buff_;
+
   std::shared_ptr<CPUResource> cpu_resource_;
   // std::shared_ptr<GPUResource> gpu_resource_; /**< gpu resource */
 
@@ -75,7 +79,8 @@ class NetworkCPU {
   NetworkCPU& operator=(const NetworkCPU&) = delete;
 
   /**
-   * Forward only for inference.
+   * Forward only for inference. Does not alter the weights. Hence, replicas that share the same
+   * weights may run concurrently.
    */
   void predict();
 
@@ -99,13 +104,40 @@ class NetworkCPU {
    */
   void initialize();
 
+  /**
+   * While calibrating, the int8 layers record the range of their inputs on each \p predict (see
+   * \p quantize ).
+   */
+  void set_calibration(bool calibrating);
+
+  /**
+   * Switches the layers that support it (i.e., fully connected layers) to int8 inference, with
+   * weights quantized per output channel, and inputs quantized with the calibrated scales.
+   * @param weights_source If provided (i.e., this network is a replica of \p weights_source ),
+   * the quantized weights of \p weights_source are shared instead.
+   */
+  void quantize(const NetworkCPU* weights_source = nullptr);
+
+  /**
+   * Packs the weights of the layers that support it (i.e., fully connected layers) for the
+   * micro-kernel of \p gemm_cpu , which then skips packing them on every \p predict . Must be
+   * repeated whenever the weights change.
+   * @param weights_source If provided (i.e., this network is a replica of \p weights_source ),
+   * the packed weights of \p weights_source are shared instead.
+   */
+  void pack_weights(const NetworkCPU* weights_source = nullptr);
+
   /**
    * factory method to create network
+   * @param weights_source If provided, the new network is a replica of \p weights_source (which
+   * must have been created from the same configuration). That is, it has its own activations, but
+   * shares the weights of \p weights_source .
    */
   static NetworkCPU* create_network(const nlohmann::json& j_array,
                                     std::vector<TensorEntry>& tensor_entries,
                                     const std::shared_ptr<CPUResource>& cpu_resource,
-                                    bool use_mixed_precision);
+                                    bool use_mixed_precision,
+                                    const NetworkCPU* weights_source = nullptr);
 };
 
 }  // namespace HugeCTR
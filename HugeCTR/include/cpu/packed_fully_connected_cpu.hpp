@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cpu/gemm_cpu.hpp>
+#include <memory>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Pre-packed weights of the fully connected CPU layers (see \p LayerCPU::pack_weights ). The
+ * inputs of such a layer multiply consecutive row ranges of its weight matrix, one range per input.
+ * Each range is packed for the micro-kernel of \p gemm_cpu once, instead of on every product.
+ */
+class PackedFullyConnectedCPU {
+ public:
+  PackedFullyConnectedCPU() = default;
+  /**
+   * @param input_widths Number of columns of each input (i.e., rows of its range of the weights).
+   */
+  explicit PackedFullyConnectedCPU(std::vector<size_t> input_widths);
+
+  /**
+   * Packs the weights (`k x n`, row-major). If \p source is provided (i.e., a layer with the same
+   * weights), its packed weights are shared instead.
+   */
+  template <typename T>
+  void pack(const T* weights, size_t n, const PackedFullyConnectedCPU* source);
+
+  bool is_packed() const { return weights_ != nullptr; }
+
+  /**
+   * Computes `out = sum_i inputs[i] * W_i`, followed by \p epilogue .
+   */
+  template <typename T>
+  void fprop(size_t m, const std::vector<const T*>& inputs, T* out,
+             const GemmEpilogueCPU& epilogue) const;
+
+ private:
+  std::vector<size_t> input_widths_;
+  // Packed row range of the weights of each input. Immutable, and thus shared with replicas.
+  std::shared_ptr<const std::vector<PackedMatrixCPU>> weights_;
+};
+
+}  // namespace HugeCTR
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cpu/gemm_cpu.hpp>
+#include <memory>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * Int8 inference of the fully connected CPU layers (see \p LayerCPU::quantize ). The inputs of such
+ * a layer multiply consecutive row ranges of its weight matrix, one range per input.
+ *
+ * While calibrating, the largest absolute value of each input is recorded. Once quantized, each
+ * row range of the weights is quantized per output channel, and each input is quantized with a
+ * scale derived from its calibrated range (or per row on the fly, if it was not calibrated). The
+ * products are then computed by \p gemm_int8_cpu .
+ *
+ * Layers with few outputs (e.g., the logit layer) are kept in fp32. Their products are too small
+ * to benefit, and their accuracy matters most.
+ */
+class QuantizedFullyConnectedCPU {
+ public:
+  QuantizedFullyConnectedCPU() = default;
+  /**
+   * @param input_widths Number of columns of each input (i.e., rows of its range of the weights).
+   */
+  explicit QuantizedFullyConnectedCPU(std::vector<size_t> input_widths);
+
+  void set_calibration(bool calibrating) { calibrating_ = calibrating; }
+  bool is_calibrating() const { return calibrating_; }
+
+  /**
+   * Records the range of the \p m rows of input \p i .
+   */
+  template <typename T>
+  void calibrate(size_t i, size_t m, const T* input);
+
+  /**
+   * Quantizes the weights (`k x n`, row-major). If \p source is provided (i.e., a layer with the
+   * same weights), its quantized weights and input scales are shared instead.
+   */
+  void quantize(const float* weights, size_t n, const QuantizedFullyConnectedCPU* source);
+
+  bool is_quantized() const { return weights_ != nullptr; }
+
+  /**
+   * Int8 counterpart of the product of the layer, i.e., `out = sum_i inputs[i] * W_i`, followed
+   * by \p epilogue .
+   */
+  template <typename T>
+  void fprop(size_t m, const std::vector<const T*>& inputs, T* out,
+             const GemmEpilogueCPU& epilogue) const;
+
+ private:
+  std::vector<size_t> input_widths_;
+  bool calibrating_{false};
+  std::vector<float> input_abs_max_;
+  // Quantization scale of each input (0 = per row).
+  std::vector<float> input_scales_;
+  // Quantized row range of the weights of each input. Immutable, and thus shared with replicas.
+  std::shared_ptr<const std::vector<Int8MatrixCPU>> weights_;
+};
+
+}  // namespace HugeCTR
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace HugeCTR {
+
+/**
+ * CPU counterpart of \p unique_op::unique_op . Determines the distinct keys of a key list and,
+ * for every key, the position of that key in the list of distinct keys (inverse index).
+ *
+ * Large key lists are split into partitions by key hash, which are deduplicated concurrently with
+ * open addressing hash tables (see \p parallel_for_cpu ). Each key is thus owned by exactly one
+ * partition, and no synchronization is needed. Small key lists are deduplicated by the calling
+ * thread, and the distinct keys keep the order of their first occurrence.
+ *
+ * The workspace is reused across calls. Hence, an object must not be used by multiple threads
+ * at the same time.
+ */
+class UniqueOpCPU {
+ public:
+  /**
+   * @param capacity Maximum number of keys per call.
+   */
+  explicit UniqueOpCPU(size_t capacity);
+
+  size_t get_capacity() const { return capacity_; }
+
+  /**
+   * @param keys Keys to deduplicate.
+   * @param len Number of keys (<= capacity).
+   * @param output_index For each key, the index of that key in \p unique_keys ( \p len elements).
+   * @param unique_keys The distinct keys (up to \p len elements).
+   * @return Number of distinct keys.
+   */
+  template <typename TypeHashKey>
+  size_t unique(const TypeHashKey* keys, size_t len, int* output_index, TypeHashKey* unique_keys);
+
+ private:
+  size_t capacity_;
+
+  // Partitioned keys, their original positions and their indices within the partition.
+  // part_keys_ and part_unique_keys_ serve key types of both long long and unsigned int.
+  std::vector<long long> part_keys_;
+  std::vector<long long> part_unique_keys_;
+  std::vector<int> part_positions_;
+  std::vector<int> part_index_;
+  // Hash tables of all partitions. Each slot refers to a distinct key (-1 = empty).
+  std::vector<int> slots_;
+};
+
+}  // namespace HugeCTR
@@ -17,9 +17,11 @@
 
 #include <cuda_runtime_api.h>
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <tensor2.hpp>
+#include <unordered_map>
 
 namespace HugeCTR {
 
@@ -159,10 +161,66 @@ class GeneralBuffer2 : public std::enable_shared_from_this<GeneralBuffer2<Alloca
     }
   };
 
+  struct Lifetime {
+    size_t first_use;
+    size_t last_use;
+  };
+
   Allocator allocator_;
   void *ptr_;
   size_t total_size_in_bytes_;
   std::vector<std::shared_ptr<BufferInternal>> reserved_buffers_;
+  std::unordered_map<const BufferInternal *, Lifetime> lifetimes_;
+
+  static size_t align_up(size_t size_in_bytes, size_t align_size) {
+    if (size_in_bytes % align_size != 0) {
+      size_in_bytes += (align_size - size_in_bytes % align_size);
+    }
+    return size_in_bytes;
+  }
+
+  // Assigns offsets to the buffers with a lifetime, such that buffers whose lifetimes intersect do
+  // not overlap. Larger buffers are placed first, each at the lowest offset that fits. Returns the
+  // size of the shared region.
+  size_t place_shared_buffers(size_t align_size,
+                              std::unordered_map<const BufferInternal *, size_t> *offsets) const {
+    std::vector<const BufferInternal *> buffers;
+    for (const std::shared_ptr<BufferInternal> &buffer : reserved_buffers_) {
+      if (lifetimes_.count(buffer.get())) {
+        buffers.push_back(buffer.get());
+      }
+    }
+    std::stable_sort(buffers.begin(), buffers.end(),
+                     [](const BufferInternal *a, const BufferInternal *b) {
+                       return a->get_size_in_bytes() > b->get_size_in_bytes();
+                     });
+
+    size_t region_size = 0;
+    for (size_t i = 0; i < buffers.size(); i++) {
+      const Lifetime &lifetime = lifetimes_.at(buffers[i]);
+      std::vector<std::pair<size_t, size_t>> conflicts;
+      for (size_t j = 0; j < i; j++) {
+        const Lifetime &other = lifetimes_.at(buffers[j]);
+        if (lifetime.first_use <= other.last_use && other.first_use <= lifetime.last_use) {
+          const size_t begin = offsets->at(buffers[j]);
+          conflicts.emplace_back(begin, begin + buffers[j]->get_size_in_bytes());
+        }
+      }
+      std::sort(conflicts.begin(), conflicts.end());
+
+      const size_t size_in_bytes = buffers[i]->get_size_in_bytes();
+      size_t offset = 0;
+      for (const auto &conflict : conflicts) {
+        if (offset + size_in_bytes <= conflict.first) {
+          break;
+        }
+        offset = std::max(offset, align_up(conflict.second, align_size));
+      }
+      (*offsets)[buffers[i]] = offset;
+      region_size = std::max(region_size, offset + size_in_bytes);
+    }
+    return align_up(region_size, align_size);
+  }
 
   GeneralBuffer2(Allocator allocator)
       : allocator_(allocator), ptr_(nullptr), total_size_in_bytes_(0) {}
@@ -188,16 +246,20 @@ class GeneralBuffer2 : public std::enable_shared_from_this<GeneralBuffer2<Alloca
       HCTR_OWN_THROW(Error_t::WrongInput, "Memory has already been allocated.");
     }
 
-    size_t offset = 0;
+    // Buffers with a lifetime share a region at the beginning, and all others follow.
+    std::unordered_map<const BufferInternal *, size_t> shared_offsets;
+    size_t offset = place_shared_buffers(align_size, &shared_offsets);
     for (const std::shared_ptr<BufferInternal> &buffer : reserved_buffers_) {
-      buffer->initialize(this->shared_from_this(), offset);
-      size_t size_in_bytes = buffer->get_size_in_bytes();
-      if (size_in_bytes % align_size != 0) {
-        size_in_bytes += (align_size - size_in_bytes % align_size);
+      auto shared_offset = shared_offsets.find(buffer.get());
+      if (shared_offset != shared_offsets.end()) {
+        buffer->initialize(this->shared_from_this(), shared_offset->second);
+        continue;
       }
-      offset += size_in_bytes;
+      buffer->initialize(this->shared_from_this(), offset);
+      offset += align_up(buffer->get_size_in_bytes(), align_size);
     }
     reserved_buffers_.clear();
+    lifetimes_.clear();
     total_size_in_bytes_ = offset;
 
     if (total_size_in_bytes_ != 0) {
@@ -231,6 +293,27 @@ class GeneralBuffer2 : public std::enable_shared_from_this<GeneralBuffer2<Alloca
     *tensor = Tensor2<T>(dimensions, buffer_impl);
   }
 
+  /**
+   * Declares that \p buffer (reserved from this buffer) is only in use from step \p first_use up
+   * to and including step \p last_use , e.g., the activations of a network between the layer that
+   * produces them and the last layer that consumes them. Buffers whose lifetimes do not intersect
+   * may share memory. Hence, their content must not be relied upon outside their lifetime.
+   */
+  void set_lifetime(const std::shared_ptr<TensorBuffer2> &buffer, size_t first_use,
+                    size_t last_use) {
+    if (allocated()) {
+      HCTR_OWN_THROW(Error_t::IllegalCall, "General buffer is finalized.");
+    }
+    for (const std::shared_ptr<BufferInternal> &reserved_buffer : reserved_buffers_) {
+      auto tensor_buffer = dynamic_cast<TensorBufferImpl *>(reserved_buffer.get());
+      if (tensor_buffer && static_cast<TensorBuffer2 *>(tensor_buffer) == buffer.get()) {
+        lifetimes_[reserved_buffer.get()] = {first_use, last_use};
+        return;
+      }
+    }
+    HCTR_OWN_THROW(Error_t::WrongInput, "Buffer was not reserved from this general buffer.");
+  }
+
   template <typename T>
   void reserve(const std::vector<size_t> &dimensions, const size_t slot_num,
                SparseTensor<T> *tensor) {
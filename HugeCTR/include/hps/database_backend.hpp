@@ -43,6 +43,7 @@ enum class DatabaseTableDumpFormat_t {
   Automatic = 0,  // Try to deduce the storage format from the provided path.
   Raw,            // Use raw storage format.
   SST,            // Write data as an "Static Sorted Table" file.
+  Snapshot,       // Memory-mappable image of the table (only supported by some backends).
 };
 
 /**
@@ -121,6 +122,14 @@ class DatabaseBackendBase {
   virtual size_t insert(const std::string& table_name, size_t num_pairs, const Key* keys,
                         const char* values, uint32_t value_size, size_t value_stride) = 0;
 
+  /**
+   * Same as \p insert , but meant for populating tables with large amounts of data at once (e.g.,
+   * during startup). Backends may implement this with a faster write path that bypasses their
+   * usual transaction handling. The default implementation calls \p insert .
+   */
+  virtual size_t bulk_insert(const std::string& table_name, size_t num_pairs, const Key* keys,
+                             const char* values, uint32_t value_size, size_t value_stride);
+
   /**
    * Attempt to retrieve the stored value for a set of keys in the backing database (direct
    * indexing).
@@ -224,6 +233,12 @@ class DatabaseBackendBase {
 
   virtual size_t dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) = 0;
 
+  /**
+   * Writes a snapshot of the table, from which \p load_dump_snapshot can restore it quickly. Only
+   * supported by some backends.
+   */
+  virtual size_t dump_snapshot(const std::string& table_name, const std::string& path);
+
   /**
    * Loads the contents of a dump file into a table.
    *
@@ -236,6 +251,15 @@ class DatabaseBackendBase {
 
   virtual size_t load_dump_sst(const std::string& table_name, const std::string& path);
 
+  virtual size_t load_dump_snapshot(const std::string& table_name, const std::string& path);
+
+ protected:
+  /**
+   * @return Maximum number of key/value pairs that \p load_dump_bin and \p load_dump_sst pass to
+   * \p bulk_insert at once.
+   */
+  virtual size_t max_bulk_batch_size() const { return max_batch_size_; }
+
  private:
   const size_t max_batch_size_;  // Temporary, until find a better solution.
 };
@@ -18,7 +18,9 @@
 #include <rocksdb/db.h>
 
 #include <cstdint>
+#include <numeric>
 #include <type_traits>
+#include <vector>
 
 namespace HugeCTR {
 
@@ -63,6 +65,35 @@ inline uint64_t rrxmrrxmsx_0(uint64_t x) {
 #endif
 #define HCTR_HPS_KEY_TO_PART_INDEX_(KEY) (rrxmrrxmsx_0(KEY) % num_partitions)
 
+/**
+ * Groups keys by the partition they belong to (counting sort). Afterwards, the indices of the keys
+ * that belong to partition `p` are stored in `part_indices[part_offsets[p]]` ... up to
+ * `part_indices[part_offsets[p + 1] - 1]`, retaining their original order. If \p indices is
+ * `nullptr`, the keys `0` ... `num_indices - 1` are grouped.
+ *
+ * Each key is hashed exactly once. This is considerably cheaper than letting each partition scan
+ * through all keys.
+ */
+template <typename Key>
+void group_keys_by_part(const size_t num_partitions, const size_t num_indices,
+                        const size_t* const indices, const Key* const keys,
+                        std::vector<size_t>& part_offsets, std::vector<size_t>& part_indices) {
+  std::vector<size_t> key_parts(num_indices);
+  part_offsets.assign(num_partitions + 1, 0);
+  for (size_t i{0}; i < num_indices; ++i) {
+    const size_t part_index{HCTR_HPS_KEY_TO_PART_INDEX_(keys[indices ? indices[i] : i])};
+    key_parts[i] = part_index;
+    ++part_offsets[part_index + 1];
+  }
+  std::partial_sum(part_offsets.begin(), part_offsets.end(), part_offsets.begin());
+
+  std::vector<size_t> next(part_offsets.begin(), part_offsets.end() - 1);
+  part_indices.resize(num_indices);
+  for (size_t i{0}; i < num_indices; ++i) {
+    part_indices[next[key_parts[i]]++] = indices ? indices[i] : i;
+  }
+}
+
 /**
  * Time budget checking and resolution.
  */
@@ -17,11 +17,18 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
-#include <core/memory.hpp>
 #include <deque>
 #include <functional>
 #include <hps/database_backend.hpp>
+#include <hps/recency_clock.hpp>
+#include <hps/robin_hood_hash_map.hpp>
+#include <hps/sharded_shared_mutex.hpp>
+#include <hps/value_arena.hpp>
+#include <hps/value_codec.hpp>
+#include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <thread_pool.hpp>
@@ -37,6 +44,17 @@ namespace HugeCTR {
 struct HashMapBackendParams final : public VolatileBackendParams {
   size_t allocation_rate{256L * 1024 *
                          1024};  // Number of additional bytes to allocate per allocation cycle.
+  size_t overflow_sample_size{0};  // If > 0, overflow resolution evicts the worst out of this many
+                                   // randomly sampled entries, instead of sorting all entries.
+  DatabaseRecencySource_t recency_source{
+      DatabaseRecencySource_t::CoarseClock};  // Source of access stamps for `EvictOldest`.
+  DatabaseHugePages_t huge_pages{
+      DatabaseHugePages_t::Disabled};  // Whether to back value storage with huge pages.
+  bool numa_aware{false};  // If true, spreads the value storage of partitions across NUMA nodes.
+  double compaction_threshold{1.0};  // Compact partitions, if more than this fraction of their
+                                     // resident value storage is unused (1 = never).
+  DatabaseValueCodec_t value_codec{
+      DatabaseValueCodec_t::Float32};  // Format in which values of new tables are stored.
 };
 
 /**
@@ -90,58 +108,133 @@ class HashMapBackend final : public VolatileBackend<Key, HashMapBackendParams> {
 
   size_t dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) override;
 
+  /**
+   * Writes the keys of each partition, followed by an image of its value pages. Partitions are
+   * written one after another. Lookups continue, but all writers wait while a partition is
+   * written, and can only run between partitions. Hence, the snapshot is consistent per
+   * partition. The file is replaced atomically.
+   */
+  size_t dump_snapshot(const std::string& table_name, const std::string& path) override;
+
+  /**
+   * Replaces the table with the contents of a snapshot. If the snapshot was taken with the same
+   * value storage layout (i.e., number of partitions, value codec and \p allocation_rate ), the
+   * value pages are mapped from the file instead of being copied. Hence, values are only read once
+   * accessed. Otherwise, values are decoded and inserted.
+   */
+  size_t load_dump_snapshot(const std::string& table_name, const std::string& path) override;
+
+  /**
+   * Memory usage of the value storage of a table (summed over all partitions).
+   */
+  ValueArenaStats memory_stats(const std::string& table_name) const;
+
  protected:
-#if 1
-  // Better performance on most systems.
-  using CharAllocator = AlignedAllocator<char>;
-  static constexpr size_t value_page_alignment{CharAllocator::alignment};
-#else
-  using CharAllocator = std::allocator<char>;
-  // __STDCPP_DEFAULT_NEW_ALIGNMENT__ is actually 16 with current GCC. But we use sizeof(char) here
-  // which equates to have no padding.
-  static constexpr size_t value_page_alignment{sizeof(char)};
-#endif
-  static_assert(value_page_alignment > 0);
-
-  using ValuePage = std::vector<char, CharAllocator>;
+  // Align values to x86 cache lines. Encoded values are packed more densely, because saving memory
+  // is the point of encoding them.
+  static constexpr size_t value_alignment{64};
+  static constexpr size_t encoded_value_alignment{8};
+
   using ValuePtr = char*;
 
   // Data-structure that will be associated with every key.
   struct Payload final {
     union {
-      time_t last_access;
+      uint64_t last_access;  // Recency stamp (see `RecencyClock`).
       uint64_t access_count;
     };
     ValuePtr value;
   };
-  using Entry = std::pair<const Key, Payload>;
+  using Entry = std::pair<Key, Payload>;
+
+  // Access statistics gathered by lookups, that were not yet applied to the payloads. Each thread
+  // records into a separate shard, so that concurrent lookups do not contend for cache lines.
+  struct alignas(64) AccessStats final {
+    static constexpr size_t max_size{64 * 1024};  // Further keys are not tracked until merged.
+
+    std::mutex guard;
+    phmap::flat_hash_map<Key, uint64_t> values;  // access count (LFU) or time (LRU)
+  };
 
   struct Partition final {
-    const uint32_t value_size;
-    const size_t allocation_rate;
+    const uint32_t value_size;  // Size of decoded values.
+    const ValueCodec codec;
+
+    // Pooled payload storage (holds encoded values).
+    ValueArena value_arena;
+
+    // Key -> Payload map. Supports lock-free lookups (see `SeqLockWriteGuard`).
+    RobinHoodHashMap<Key, Payload> entries;
+
+    // Keys eligible for sampled overflow resolution. May contain keys that were already evicted.
+    // These are purged lazily.
+    std::vector<Key> sample_keys;
+
+    // Recency stamps for `EvictOldest`.
+    RecencyClock recency_clock;
 
-    // Pooled payload storage.
-    std::vector<ValuePage> value_pages;
-    std::vector<ValuePtr> value_slots;
+    // Pending access statistics. Merged into `entries` before resolving overflows.
+    std::array<AccessStats, ShardedSharedMutex::num_shards> access_stats;
 
-    // Key -> Payload map.
-    phmap::flat_hash_map<Key, Payload> entries;
+    // Writers are serialized, and keep `version` odd while altering the partition.
+    std::mutex write_guard;
+    std::atomic<uint64_t> version{0};
 
     Partition() = delete;
 
-    Partition(const uint32_t value_size, const HashMapBackendParams& params)
-        : value_size{value_size}, allocation_rate{params.allocation_rate} {}
+    Partition(const uint32_t value_size, const HashMapBackendParams& params, const int numa_node)
+        : value_size{value_size},
+          codec{params.value_codec},
+          value_arena{codec.encoded_size(value_size),
+                      codec.type() == DatabaseValueCodec_t::Float32 ? value_alignment
+                                                                    : encoded_value_alignment,
+                      params.allocation_rate, params.huge_pages, numa_node},
+          recency_clock{params.recency_source} {}
+
+    /**
+     * Only safe while the partition is not accessible by other threads.
+     */
+    Partition(Partition&& other)
+        : value_size{other.value_size},
+          codec{other.codec},
+          value_arena{std::move(other.value_arena)},
+          entries{std::move(other.entries)},
+          sample_keys{std::move(other.sample_keys)},
+          recency_clock{other.recency_clock},
+          version{other.version.load(std::memory_order_relaxed)} {}
   };
 
   // Actual data.
-  CharAllocator char_allocator_;
   std::unordered_map<std::string, std::vector<Partition>> tables_;
 
-  // Access control.
+  // Access control. Writers hold `read_write_guard_` and alter partitions individually under a
+  // `SeqLockWriteGuard`. Lookups only acquire `read_guard_`, which does not contend. Altering the
+  // table map itself requires exclusive access to both.
   mutable std::shared_mutex read_write_guard_;
+  mutable ShardedSharedMutex read_guard_;
+
+  // Creates the partitions of a new table.
+  std::vector<Partition> make_partitions_(uint32_t value_size) const;
+
+  // Value storage. Requires exclusive access to the partition.
+  inline ValuePtr allocate_value_(Partition& part) const { return part.value_arena.allocate(); }
+  inline void release_value_(Partition& part, const ValuePtr value) const {
+    part.value_arena.release(value);
+  }
+
+  // Moves values out of sparsely occupied pages. Requires exclusive access to the partition.
+  void compact_(const std::string& table_name, size_t part_index, Partition& part) const;
+
+  // Applies pending access statistics. Requires exclusive access to the partition.
+  void merge_access_stats_(Partition& part) const;
+
+  // Applies pending access statistics, if plenty were gathered and no writer holds the partition.
+  void try_merge_access_stats_(Partition& part) const;
 
   // Overflow resolution.
   size_t resolve_overflow_(const std::string& table_name, size_t part_index, Partition& part);
+  size_t resolve_overflow_sampled_(const std::string& table_name, size_t part_index,
+                                   Partition& part);
 };
 
 // TODO: Remove me!
@@ -15,8 +15,11 @@
  */
 #pragma once
 
+#include <atomic>
+#include <core/macro.hpp>
 #include <hps/database_backend_detail.hpp>
 #include <hps/inference_utils.hpp>
+#include <thread>
 #include <thread_pool.hpp>
 #include <type_traits>
 
@@ -26,6 +29,34 @@ namespace HugeCTR {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic error "-Wconversion"
 
+/**
+ * Writer side of a sequence lock that guards a hash map partition. Writers are serialized through
+ * `part.write_guard`, and keep `part.version` odd while modifying the partition. This allows
+ * readers to access the partition without acquiring any locks (see
+ * `HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_`).
+ */
+template <typename Partition>
+class SeqLockWriteGuard final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(SeqLockWriteGuard);
+
+  SeqLockWriteGuard() = delete;
+
+  explicit SeqLockWriteGuard(Partition& part) : part_{part} {
+    part_.write_guard.lock();
+    part_.version.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  ~SeqLockWriteGuard() {
+    part_.version.fetch_add(1, std::memory_order_release);
+    part_.write_guard.unlock();
+  }
+
+ private:
+  Partition& part_;
+};
+
 /**
  * HashMap Backend / Contains
  */
@@ -38,6 +69,40 @@ namespace HugeCTR {
     return true;                                                                        \
   }()
 
+#ifdef HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_K_
+#error HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_K_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_K_()                          \
+  do {                                                                      \
+    static_assert(std::is_same_v<decltype(hit_count), size_t>);             \
+                                                                            \
+    for (;;) {                                                              \
+      const uint64_t version{part.version.load(std::memory_order_acquire)}; \
+      if (version & 1) {                                                    \
+        std::this_thread::yield();                                          \
+        continue;                                                           \
+      }                                                                     \
+                                                                            \
+      const bool hit{part.entries.find(*k) != part.entries.end()};          \
+                                                                            \
+      /* Retry if a writer interfered. */                                   \
+      std::atomic_thread_fence(std::memory_order_acquire);                  \
+      if (part.version.load(std::memory_order_relaxed) == version) {        \
+        hit_count += hit;                                                   \
+        break;                                                              \
+      }                                                                     \
+    }                                                                       \
+  } while (0)
+
+#ifdef HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_
+#error HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_(MODE)                      \
+  [&]() {                                                                 \
+    HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_K_()); \
+    return true;                                                          \
+  }()
+
 /**
  * HashMap Backend / Evict
  */
@@ -54,8 +119,8 @@ namespace HugeCTR {
     if (it != part.entries.end()) {                                 \
       const Payload& payload{it->second};                           \
                                                                     \
-      /* Stash pointer and reference in map. */                     \
-      part.value_slots.emplace_back(payload.value);                 \
+      /* Return storage slot and erase entry. */                    \
+      release_value_(part, payload.value);                          \
       part.entries.erase(it);                                       \
       ++num_deletions;                                              \
     }                                                               \
@@ -76,26 +141,26 @@ namespace HugeCTR {
 #ifdef HCTR_HPS_HASH_MAP_FETCH_IMPL_
 #error HCTR_HPS_HASH_MAP_FETCH_IMPL_ already defined. Potential naming conflict!
 #endif
-#define HCTR_HPS_HASH_MAP_FETCH_IMPL_(...)                                                   \
-  do {                                                                                       \
-    static_assert(std::is_same_v<decltype(miss_count), size_t>);                             \
-    static_assert(std::is_invocable_v<decltype(on_miss), size_t>);                           \
-    static_assert(std::is_same_v<decltype(value_stride), const size_t>);                     \
-    static_assert(std::is_same_v<decltype(k), const Key*> ||                                 \
-                  std::is_same_v<decltype(k), const Key* const>);                            \
-    static_assert(std::is_same_v<decltype(values), char* const>);                            \
-                                                                                             \
-    const auto& it{part.entries.find(*k)};                                                   \
-    if (it != part.entries.end()) {                                                          \
-      Payload& payload{it->second};                                                          \
-                                                                                             \
-      /* Race-conditions here are deliberately ignored because insignificant in practice. */ \
-      __VA_ARGS__;                                                                           \
-      std::copy_n(payload.value, part.value_size, &values[(k - keys) * value_stride]);       \
-    } else {                                                                                 \
-      on_miss(k - keys);                                                                     \
-      ++miss_count;                                                                          \
-    }                                                                                        \
+#define HCTR_HPS_HASH_MAP_FETCH_IMPL_(...)                                                     \
+  do {                                                                                         \
+    static_assert(std::is_same_v<decltype(miss_count), size_t>);                               \
+    static_assert(std::is_invocable_v<decltype(on_miss), size_t>);                             \
+    static_assert(std::is_same_v<decltype(value_stride), const size_t>);                       \
+    static_assert(std::is_same_v<decltype(k), const Key*> ||                                   \
+                  std::is_same_v<decltype(k), const Key* const>);                              \
+    static_assert(std::is_same_v<decltype(values), char* const>);                              \
+                                                                                               \
+    const auto& it{part.entries.find(*k)};                                                     \
+    if (it != part.entries.end()) {                                                            \
+      Payload& payload{it->second};                                                            \
+                                                                                               \
+      /* Race-conditions here are deliberately ignored because insignificant in practice. */   \
+      __VA_ARGS__;                                                                             \
+      part.codec.decode(&*payload.value, part.value_size, &values[(k - keys) * value_stride]); \
+    } else {                                                                                   \
+      on_miss(k - keys);                                                                       \
+      ++miss_count;                                                                            \
+    }                                                                                          \
   } while (0)
 
 #ifdef HCTR_HPS_HASH_MAP_FETCH_
@@ -113,7 +178,7 @@ namespace HugeCTR {
         HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_FETCH_IMPL_(++payload.access_count));      \
       } break;                                                                                \
       case DatabaseOverflowPolicy_t::EvictOldest: {                                           \
-        const time_t now{std::time(nullptr)};                                                 \
+        const uint64_t now{part.recency_clock.now()};                                         \
         HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_FETCH_IMPL_(payload.last_access = now));   \
       } break;                                                                                \
     }                                                                                         \
@@ -121,75 +186,318 @@ namespace HugeCTR {
   }()
 
 /**
- * HashMap Backend / Insert
+ * HashMap Backend / Fetch (lock-free, for partitions guarded by a `SeqLockWriteGuard`)
+ *
+ * Lookups are validated against the partition version. The value pointer is only dereferenced
+ * after the lookup was validated, and the copied value is validated again before it is accepted.
+ * Value pages are never released while the table exists. Hence, stale pointers always reference
+ * readable memory. Buckets are never written to, because they may be moved or released at any
+ * time. Instead, access statistics are recorded in `part_stats` (see
+ * `HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_`), which writers merge into the payloads.
  */
-#ifdef HCTR_HPS_HASH_MAP_INSERT_IMPL_
-#error HCTR_HPS_HASH_MAP_INSERT_IMPL_ already defined. Potential naming conflict!
+#ifdef HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_
+#error HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_ already defined. Potential naming conflict!
 #endif
-#define HCTR_HPS_HASH_MAP_INSERT_IMPL_(...)                                                  \
+#define HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_(...)                                        \
   do {                                                                                       \
-    static_assert(std::is_same_v<decltype(num_inserts), size_t>);                            \
-    static_assert(std::is_same_v<decltype(value_size), const uint32_t>);                     \
+    static_assert(std::is_same_v<decltype(miss_count), size_t>);                             \
+    static_assert(std::is_invocable_v<decltype(on_miss), size_t>);                           \
     static_assert(std::is_same_v<decltype(value_stride), const size_t>);                     \
     static_assert(std::is_same_v<decltype(k), const Key*> ||                                 \
                   std::is_same_v<decltype(k), const Key* const>);                            \
-    static_assert(std::is_same_v<decltype(values), const char* const>);                      \
-                                                                                             \
-    const auto& res{part.entries.try_emplace(*k)};                                           \
-    Payload& payload{res.first->second};                                                     \
-                                                                                             \
-    __VA_ARGS__;                                                                             \
-                                                                                             \
-    /* If new insertion. */                                                                  \
-    if (res.second) {                                                                        \
-      /* If no free space, allocate another buffer, and fill pointer queue. */               \
-      if (part.value_slots.empty()) {                                                        \
-        const size_t stride{(value_size + value_page_alignment - 1) / value_page_alignment * \
-                            value_page_alignment};                                           \
-        const size_t num_values{part.allocation_rate / stride};                              \
-        HCTR_CHECK(num_values > 0);                                                          \
+    static_assert(std::is_same_v<decltype(values), char* const>);                            \
                                                                                              \
-        /* Get more memory. */                                                               \
-        part.value_pages.emplace_back(num_values* stride, char_allocator_);                  \
-        ValuePage& value_page{part.value_pages.back()};                                      \
+    for (;;) {                                                                               \
+      const uint64_t version{part.version.load(std::memory_order_acquire)};                  \
+      if (version & 1) {                                                                     \
+        std::this_thread::yield();                                                           \
+        continue;                                                                            \
+      }                                                                                      \
                                                                                              \
-        /* Stock up slot references. */                                                      \
-        part.value_slots.reserve(part.value_slots.size() + num_values);                      \
-        for (auto it{value_page.end()}; it != value_page.begin();) {                         \
-          it -= stride;                                                                      \
-          part.value_slots.emplace_back(&*it);                                               \
+      const auto& it{part.entries.find(*k)};                                                 \
+      if (it == part.entries.end()) {                                                        \
+        std::atomic_thread_fence(std::memory_order_acquire);                                 \
+        if (part.version.load(std::memory_order_relaxed) != version) {                       \
+          continue;                                                                          \
         }                                                                                    \
+        on_miss(k - keys);                                                                   \
+        ++miss_count;                                                                        \
+        break;                                                                               \
       }                                                                                      \
+      Payload& payload{it->second};                                                          \
                                                                                              \
-      /* Fetch storage slot. */                                                              \
-      payload.value = part.value_slots.back();                                               \
-      part.value_slots.pop_back();                                                           \
-      ++num_inserts;                                                                         \
-    }                                                                                        \
+      /* Validate pointer, copy, and validate copy. */                                       \
+      const char* const value{&*payload.value};                                              \
+      std::atomic_thread_fence(std::memory_order_acquire);                                   \
+      if (part.version.load(std::memory_order_relaxed) != version) {                         \
+        continue;                                                                            \
+      }                                                                                      \
+      part.codec.decode(value, part.value_size, &values[(k - keys) * value_stride]);         \
+      std::atomic_thread_fence(std::memory_order_acquire);                                   \
+      if (part.version.load(std::memory_order_relaxed) != version) {                         \
+        continue;                                                                            \
+      }                                                                                      \
                                                                                              \
-    std::copy_n(&values[(k - keys) * value_stride], value_size, payload.value);              \
+      __VA_ARGS__;                                                                           \
+      break;                                                                                 \
+    }                                                                                        \
+  } while (0)
+
+#ifdef HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_
+#error HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_(MODE)                                             \
+  [&]() {                                                                                     \
+    static_assert(std::is_same_v<decltype(overflow_policy), const DatabaseOverflowPolicy_t>); \
+                                                                                              \
+    auto& stats{part_stats[ShardedSharedMutex::this_thread_shard()]};                         \
+    std::unique_lock stats_lock(stats.guard, std::defer_lock);                                \
+    if (overflow_policy != DatabaseOverflowPolicy_t::EvictRandom) {                           \
+      stats_lock.try_lock();                                                                  \
+    }                                                                                         \
+                                                                                              \
+    switch (overflow_policy) {                                                                \
+      case DatabaseOverflowPolicy_t::EvictRandom: {                                           \
+        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_());                 \
+      } break;                                                                                \
+      case DatabaseOverflowPolicy_t::EvictLeastUsed: {                                        \
+        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_(                    \
+                                     HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_(++value)));           \
+      } break;                                                                                \
+      case DatabaseOverflowPolicy_t::EvictOldest: {                                           \
+        const uint64_t now{part.recency_clock.now()};                                         \
+        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_(                    \
+                                     HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_(                      \
+                                         value = std::max(value, now))));                     \
+      } break;                                                                                \
+    }                                                                                         \
+    return true;                                                                              \
+  }()
+
+/**
+ * HashMap Backend / Fetch (lock-free, for partitions that gather access statistics in per-thread
+ * shards)
+ *
+ * Statistics are recorded on a best effort basis. Shards are never waited for, and keys beyond the
+ * capacity of a shard are ignored until the next merge.
+ */
+#ifdef HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_
+#error HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_(...)      \
+  do {                                               \
+    if (stats_lock) {                                \
+      if (stats.values.size() < stats.max_size) {    \
+        uint64_t& value{stats.values[*k]};           \
+        __VA_ARGS__;                                 \
+      } else {                                       \
+        const auto& stats_it{stats.values.find(*k)}; \
+        if (stats_it != stats.values.end()) {        \
+          uint64_t& value{stats_it->second};         \
+          __VA_ARGS__;                               \
+        }                                            \
+      }                                              \
+    }                                                \
+  } while (0)
+
+/**
+ * HashMap Backend / Fetch (batched, for partitions guarded by a `SeqLockWriteGuard`)
+ *
+ * Software-pipelined variant of `HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_` for sequential modes. Keys
+ * are processed in small groups. While a group is resolved, the keys of the next group are hashed
+ * and their home buckets are prefetched. Values are prefetched before they are copied. The
+ * partition version is validated once per group. If a writer interfered, the group is repeated
+ * key-by-key.
+ */
+#ifdef HCTR_HPS_HASH_MAP_KEY_INDEX_SEQUENTIAL_DIRECT_
+#error HCTR_HPS_HASH_MAP_KEY_INDEX_SEQUENTIAL_DIRECT_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_KEY_INDEX_SEQUENTIAL_DIRECT_(J) (static_cast<size_t>(k - keys) + (J))
+
+#ifdef HCTR_HPS_HASH_MAP_KEY_INDEX_SEQUENTIAL_INDIRECT_
+#error HCTR_HPS_HASH_MAP_KEY_INDEX_SEQUENTIAL_INDIRECT_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_KEY_INDEX_SEQUENTIAL_INDIRECT_(J) (i[J])
+
+#ifdef HCTR_HPS_HASH_MAP_BATCHED_FETCH_
+#error HCTR_HPS_HASH_MAP_BATCHED_FETCH_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_BATCHED_FETCH_(MODE)                                                \
+  [&]() {                                                                                     \
+    static_assert(std::is_same_v<decltype(overflow_policy), const DatabaseOverflowPolicy_t>); \
+    static_assert(std::is_same_v<decltype(batch_size), const size_t>);                        \
+    static_assert(std::is_same_v<decltype(miss_count), size_t>);                              \
+    static_assert(std::is_invocable_v<decltype(on_miss), size_t>);                            \
+    static_assert(std::is_same_v<decltype(value_stride), const size_t>);                      \
+    static_assert(std::is_same_v<decltype(values), char* const>);                             \
+                                                                                              \
+    using Entries = std::remove_reference_t<decltype(part.entries)>;                          \
+    constexpr size_t group_size{16};                                                          \
+    constexpr size_t max_value_prefetch_size{512};                                            \
+                                                                                              \
+    auto& stats{part.access_stats[ShardedSharedMutex::this_thread_shard()]};                  \
+    std::unique_lock stats_lock(stats.guard, std::defer_lock);                                \
+    if (overflow_policy != DatabaseOverflowPolicy_t::EvictRandom) {                           \
+      stats_lock.try_lock();                                                                  \
+    }                                                                                         \
+    const uint64_t now{overflow_policy == DatabaseOverflowPolicy_t::EvictOldest               \
+                           ? part.recency_clock.now()                                         \
+                           : 0};                                                              \
+    const auto record_access{[&](const Key* const k) {                                        \
+      switch (overflow_policy) {                                                              \
+        case DatabaseOverflowPolicy_t::EvictRandom:                                           \
+          break;                                                                              \
+        case DatabaseOverflowPolicy_t::EvictLeastUsed:                                        \
+          HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_(++value);                                        \
+          break;                                                                              \
+        case DatabaseOverflowPolicy_t::EvictOldest:                                           \
+          HCTR_HPS_HASH_MAP_RECORD_ACCESS_K_(value = std::max(value, now));                   \
+          break;                                                                              \
+      }                                                                                       \
+    }};                                                                                       \
+                                                                                              \
+    /* Hash a group of keys, and prefetch their home buckets. */                              \
+    uint64_t hashes[2][group_size];                                                           \
+    const auto prepare_group{[&](uint64_t* const h, const size_t g) {                         \
+      const size_t n{std::min(group_size, batch_size - g)};                                   \
+      for (size_t j{0}; j < n; ++j) {                                                         \
+        h[j] = Entries::hash(keys[HCTR_HPS_HASH_MAP_KEY_INDEX_##MODE##_(g + j)]);             \
+      }                                                                                       \
+      for (size_t j{0}; j < n; ++j) {                                                         \
+        part.entries.prefetch(h[j]);                                                          \
+      }                                                                                       \
+    }};                                                                                       \
+    if (batch_size) {                                                                         \
+      prepare_group(hashes[0], 0);                                                            \
+    }                                                                                         \
+                                                                                              \
+    const char* srcs[group_size];                                                             \
+    const size_t value_prefetch_size{                                                         \
+        std::min(part.codec.encoded_size(part.value_size), max_value_prefetch_size)};         \
+    for (size_t g{0}; g < batch_size; g += group_size) {                                      \
+      const uint64_t* const h{hashes[(g / group_size) % 2]};                                  \
+      const size_t n{std::min(group_size, batch_size - g)};                                   \
+      if (g + group_size < batch_size) {                                                      \
+        prepare_group(hashes[(g / group_size + 1) % 2], g + group_size);                      \
+      }                                                                                       \
+                                                                                              \
+      /* Locate values, prefetch them, and copy them. Then validate. */                       \
+      bool valid{false};                                                                      \
+      const uint64_t version{part.version.load(std::memory_order_acquire)};                   \
+      if (!(version & 1)) {                                                                   \
+        for (size_t j{0}; j < n; ++j) {                                                       \
+          const size_t index{HCTR_HPS_HASH_MAP_KEY_INDEX_##MODE##_(g + j)};                   \
+          const auto& it{part.entries.find(keys[index], h[j])};                               \
+          if (it == part.entries.end()) {                                                     \
+            srcs[j] = nullptr;                                                                \
+          } else {                                                                            \
+            srcs[j] = &*it->second.value;                                                     \
+            for (size_t o{0}; o < value_prefetch_size; o += 64) {                             \
+              __builtin_prefetch(&srcs[j][o]);                                                \
+            }                                                                                 \
+          }                                                                                   \
+        }                                                                                     \
+        std::atomic_thread_fence(std::memory_order_acquire);                                  \
+        if (part.version.load(std::memory_order_relaxed) == version) {                        \
+          for (size_t j{0}; j < n; ++j) {                                                     \
+            if (srcs[j]) {                                                                    \
+              const size_t index{HCTR_HPS_HASH_MAP_KEY_INDEX_##MODE##_(g + j)};               \
+              part.codec.decode(srcs[j], part.value_size, &values[index * value_stride]);     \
+            }                                                                                 \
+          }                                                                                   \
+          std::atomic_thread_fence(std::memory_order_acquire);                                \
+          valid = part.version.load(std::memory_order_relaxed) == version;                    \
+        }                                                                                     \
+      }                                                                                       \
+                                                                                              \
+      if (valid) {                                                                            \
+        for (size_t j{0}; j < n; ++j) {                                                       \
+          const size_t index{HCTR_HPS_HASH_MAP_KEY_INDEX_##MODE##_(g + j)};                   \
+          if (srcs[j]) {                                                                      \
+            record_access(&keys[index]);                                                      \
+          } else {                                                                            \
+            on_miss(index);                                                                   \
+            ++miss_count;                                                                     \
+          }                                                                                   \
+        }                                                                                     \
+      } else {                                                                                \
+        /* A writer interfered. Repeat key-by-key. */                                         \
+        for (size_t j{0}; j < n; ++j) {                                                       \
+          const size_t index{HCTR_HPS_HASH_MAP_KEY_INDEX_##MODE##_(g + j)};                   \
+          const Key* const k{&keys[index]};                                                   \
+          HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_IMPL_(record_access(k));                         \
+        }                                                                                     \
+      }                                                                                       \
+    }                                                                                         \
+                                                                                              \
+    HCTR_HPS_HASH_MAP_ADVANCE_##MODE##_();                                                    \
+    return true;                                                                              \
+  }()
+
+#ifdef HCTR_HPS_HASH_MAP_ADVANCE_SEQUENTIAL_DIRECT_
+#error HCTR_HPS_HASH_MAP_ADVANCE_SEQUENTIAL_DIRECT_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_ADVANCE_SEQUENTIAL_DIRECT_() k += batch_size
+
+#ifdef HCTR_HPS_HASH_MAP_ADVANCE_SEQUENTIAL_INDIRECT_
+#error HCTR_HPS_HASH_MAP_ADVANCE_SEQUENTIAL_INDIRECT_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_ADVANCE_SEQUENTIAL_INDIRECT_() i += batch_size
+
+/**
+ * HashMap Backend / Insert
+ */
+#ifdef HCTR_HPS_HASH_MAP_INSERT_IMPL_
+#error HCTR_HPS_HASH_MAP_INSERT_IMPL_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_HASH_MAP_INSERT_IMPL_(...)                                             \
+  do {                                                                                  \
+    static_assert(std::is_same_v<decltype(num_inserts), size_t>);                       \
+    static_assert(std::is_same_v<decltype(value_size), const uint32_t>);                \
+    static_assert(std::is_same_v<decltype(value_stride), const size_t>);                \
+    static_assert(std::is_same_v<decltype(k), const Key*> ||                            \
+                  std::is_same_v<decltype(k), const Key* const>);                       \
+    static_assert(std::is_same_v<decltype(values), const char* const>);                 \
+                                                                                        \
+    const auto& res{part.entries.try_emplace(*k)};                                      \
+    Payload& payload{res.first->second};                                                \
+                                                                                        \
+    __VA_ARGS__;                                                                        \
+                                                                                        \
+    /* If new insertion. */                                                             \
+    if (res.second) {                                                                   \
+      /* Fetch storage slot. */                                                         \
+      payload.value = allocate_value_(part);                                            \
+      ++num_inserts;                                                                    \
+    }                                                                                   \
+                                                                                        \
+    part.codec.encode(&values[(k - keys) * value_stride], value_size, &*payload.value); \
   } while (0)
 
 /**
  * HashMap Backend / Insert
+ *
+ * Optional arguments are executed for each key, after the entry was located or created.
  */
 #ifdef HCTR_HPS_HASH_MAP_INSERT_
 #error HCTR_HPS_HASH_MAP_INSERT_ already defined. Potential naming conflict!
 #endif
-#define HCTR_HPS_HASH_MAP_INSERT_(MODE)                                                       \
+#define HCTR_HPS_HASH_MAP_INSERT_(MODE, ...)                                                  \
   [&]() {                                                                                     \
     static_assert(std::is_same_v<decltype(overflow_policy), const DatabaseOverflowPolicy_t>); \
                                                                                               \
     switch (overflow_policy) {                                                                \
       case DatabaseOverflowPolicy_t::EvictRandom: {                                           \
-        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_INSERT_IMPL_());                           \
+        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_INSERT_IMPL_(__VA_ARGS__));                \
       } break;                                                                                \
       case DatabaseOverflowPolicy_t::EvictLeastUsed: {                                        \
-        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_INSERT_IMPL_(payload.access_count = 0));   \
+        HCTR_HPS_DB_APPLY_(                                                                   \
+            MODE, HCTR_HPS_HASH_MAP_INSERT_IMPL_(payload.access_count = 0; __VA_ARGS__));     \
       } break;                                                                                \
       case DatabaseOverflowPolicy_t::EvictOldest: {                                           \
-        const time_t now{std::time(nullptr)};                                                 \
-        HCTR_HPS_DB_APPLY_(MODE, HCTR_HPS_HASH_MAP_INSERT_IMPL_(payload.last_access = now));  \
+        const uint64_t now{part.recency_clock.now()};                                         \
+        HCTR_HPS_DB_APPLY_(                                                                   \
+            MODE, HCTR_HPS_HASH_MAP_INSERT_IMPL_(payload.last_access = now; __VA_ARGS__));    \
       } break;                                                                                \
     }                                                                                         \
     return true;                                                                              \
@@ -198,4 +506,4 @@ namespace HugeCTR {
 // TODO: Remove me!
 #pragma GCC diagnostic pop
 
-}  // namespace HugeCTR
\ No newline at end of file
+}  // namespace HugeCTR
@@ -22,6 +22,7 @@
 #include <hps/inference_utils.hpp>
 #include <hps/memory_pool.hpp>
 #include <hps/message.hpp>
+#include <hps/promotion_queue.hpp>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -76,15 +77,23 @@ class HierParameterServer : public HierParameterServerBase {
   bool volatile_db_initialize_after_startup_;
   double volatile_db_cache_rate_;
   bool volatile_db_cache_missed_embeddings_;
-  mutable ThreadPool volatile_db_async_inserter_{"vdb inserter", 1};
+  std::unique_ptr<PromotionQueue<TypeHashKey>> volatile_db_promotion_queue_;
+  std::string volatile_db_snapshot_path_;  // Directory for table snapshots ("" = disabled).
 
   std::unique_ptr<DatabaseBackendBase<TypeHashKey>> persistent_db_;
   bool persistent_db_initialize_after_startup_;
 
+  // Lookups that involve both databases are pipelined in chunks of this many keys.
+  static constexpr size_t lookup_chunk_size{16 * 1024};
+  mutable ThreadPool persistent_db_lookup_pool_{"pdb lookup"};
+
   // Realtime data ingestion.
   std::unique_ptr<MessageSource<TypeHashKey>> volatile_db_source_;
   std::unique_ptr<MessageSource<TypeHashKey>> persistent_db_source_;
 
+  // Writes volatile database snapshots in the background.
+  ThreadPool snapshot_worker_{"hps snapshot", 1};
+
   // Buffer pool that manages workspace and refreshspace of embedding caches
   std::shared_ptr<ManagerPool> buffer_pool_;
   // Configurations for memory pool
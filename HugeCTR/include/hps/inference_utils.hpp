@@ -40,15 +40,32 @@ enum class DatabaseType_t {
   MultiProcessHashMap,
   RedisCluster,
   RocksDB,
+  SlabStore,
 };
 enum class DatabaseOverflowPolicy_t {
   EvictRandom,
   EvictLeastUsed,
   EvictOldest,
 };
+enum class DatabaseRecencySource_t {
+  CoarseClock,
+  LogicalEpoch,
+};
+enum class DatabaseHugePages_t {
+  Disabled,
+  Transparent,
+  Explicit,
+};
+enum class DatabaseValueCodec_t {
+  Float32,
+  Float16,
+  BFloat16,
+  Int8,
+};
 enum class UpdateSourceType_t {
   Null,
   KafkaMessageQueue,
+  LocalMessageQueue,
 };
 enum class EmbeddingCacheType_t {
   Dynamic,
@@ -72,6 +89,8 @@ constexpr const char* hctr_enum_to_c_str(const DatabaseType_t value) {
       return "redis_cluster";
     case DatabaseType_t::RocksDB:
       return "rocks_db";
+    case DatabaseType_t::SlabStore:
+      return "slab_store";
     default:
       return "<unknown DatabaseType_t value>";
   }
@@ -105,6 +124,45 @@ constexpr const char* hctr_enum_to_c_str(const DatabaseOverflowPolicy_t value) {
       return "<unknown DatabaseOverflowPolicy_t value>";
   }
 }
+constexpr const char* hctr_enum_to_c_str(const DatabaseRecencySource_t value) {
+  // Remark: Dependent functions assume lower-case, and underscore separated.
+  switch (value) {
+    case DatabaseRecencySource_t::CoarseClock:
+      return "coarse_clock";
+    case DatabaseRecencySource_t::LogicalEpoch:
+      return "logical_epoch";
+    default:
+      return "<unknown DatabaseRecencySource_t value>";
+  }
+}
+constexpr const char* hctr_enum_to_c_str(const DatabaseHugePages_t value) {
+  // Remark: Dependent functions assume lower-case, and underscore separated.
+  switch (value) {
+    case DatabaseHugePages_t::Disabled:
+      return "disabled";
+    case DatabaseHugePages_t::Transparent:
+      return "transparent";
+    case DatabaseHugePages_t::Explicit:
+      return "explicit";
+    default:
+      return "<unknown DatabaseHugePages_t value>";
+  }
+}
+constexpr const char* hctr_enum_to_c_str(const DatabaseValueCodec_t value) {
+  // Remark: Dependent functions assume lower-case, and underscore separated.
+  switch (value) {
+    case DatabaseValueCodec_t::Float32:
+      return "float32";
+    case DatabaseValueCodec_t::Float16:
+      return "float16";
+    case DatabaseValueCodec_t::BFloat16:
+      return "bfloat16";
+    case DatabaseValueCodec_t::Int8:
+      return "int8";
+    default:
+      return "<unknown DatabaseValueCodec_t value>";
+  }
+}
 constexpr const char* hctr_enum_to_c_str(const UpdateSourceType_t value) {
   // Remark: Dependent functions assume lower-case, and underscore separated.
   switch (value) {
@@ -112,6 +170,8 @@ constexpr const char* hctr_enum_to_c_str(const UpdateSourceType_t value) {
       return "null";
     case UpdateSourceType_t::KafkaMessageQueue:
       return "kafka_message_queue";
+    case UpdateSourceType_t::LocalMessageQueue:
+      return "local_message_queue";
     default:
       return "<unknown UpdateSourceType_t value>";
   }
@@ -123,6 +183,15 @@ inline std::ostream& operator<<(std::ostream& os, DatabaseType_t value) {
 inline std::ostream& operator<<(std::ostream& os, DatabaseOverflowPolicy_t value) {
   return os << hctr_enum_to_c_str(value);
 }
+inline std::ostream& operator<<(std::ostream& os, DatabaseRecencySource_t value) {
+  return os << hctr_enum_to_c_str(value);
+}
+inline std::ostream& operator<<(std::ostream& os, DatabaseHugePages_t value) {
+  return os << hctr_enum_to_c_str(value);
+}
+inline std::ostream& operator<<(std::ostream& os, DatabaseValueCodec_t value) {
+  return os << hctr_enum_to_c_str(value);
+}
 inline std::ostream& operator<<(std::ostream& os, UpdateSourceType_t value) {
   return os << hctr_enum_to_c_str(value);
 }
@@ -137,6 +206,12 @@ UpdateSourceType_t get_hps_updatesource_type(const nlohmann::json& json, const s
                                              UpdateSourceType_t default_value);
 DatabaseOverflowPolicy_t get_hps_overflow_policy(const nlohmann::json& json, const std::string& key,
                                                  DatabaseOverflowPolicy_t default_value);
+DatabaseRecencySource_t get_hps_recency_source(const nlohmann::json& json, const std::string& key,
+                                               DatabaseRecencySource_t default_value);
+DatabaseHugePages_t get_hps_huge_pages(const nlohmann::json& json, const std::string& key,
+                                       DatabaseHugePages_t default_value);
+DatabaseValueCodec_t get_hps_value_codec(const nlohmann::json& json, const std::string& key,
+                                         DatabaseValueCodec_t default_value);
 EmbeddingCacheType_t get_hps_embeddingcache_type(const nlohmann::json& json, const std::string& key,
                                                  EmbeddingCacheType_t default_value);
 
@@ -149,30 +224,43 @@ struct VolatileDatabaseParams {
   std::string password;
   size_t num_partitions{16};
   size_t allocation_rate{256L * 1024 * 1024};  // Only used with HashMap type backends.
+  DatabaseHugePages_t huge_pages{
+      DatabaseHugePages_t::Disabled};  // Only used with HashMap type backends.
+  bool numa_aware{false};              // Only used with HashMap type backends.
+  double compaction_threshold{1.0};    // Only used with HashMap type backends.
   size_t shared_memory_size{
       16L * 1024 * 1024 *
       1024};  // Size-limit of the shared memory (only for Multi-Process hashmap).
   std::string shared_memory_name{
       "hctr_mp_hash_map_database"};  // Name of the shared memory (only for Multi-Process hashmap).
   bool shared_memory_auto_remove{true};
+  bool shared_memory_open_addressing{false};  // Lock-free lookups (only for Multi-Process hashmap).
   size_t num_node_connections{5};  // Only used with Redis backend.
   size_t max_batch_size{64L * 1024};
+  DatabaseValueCodec_t value_codec{
+      DatabaseValueCodec_t::Float32};  // Storage format (not used with Redis backend).
 
   bool enable_tls{false};
   std::string tls_ca_certificate{"cacertbundle.crt"};
   std::string tls_client_certificate{"client_cert.pem"};
   std::string tls_client_key{"client_key.pem"};
   std::string tls_server_name_identification{"redis.localhost"};
+  size_t near_cache_size{0};               // Only used with Redis backend (0 = disable).
+  size_t near_cache_max_staleness_ms{100};  // Only used with Redis backend.
 
   // Overflow handling related.
   size_t overflow_margin{std::numeric_limits<size_t>::max()};
   DatabaseOverflowPolicy_t overflow_policy{DatabaseOverflowPolicy_t::EvictRandom};
   double overflow_resolution_target{0.8};
+  size_t overflow_sample_size{0};  // Only used with HashMap type backends.
+  DatabaseRecencySource_t recency_source{
+      DatabaseRecencySource_t::CoarseClock};  // Only used with HashMap type backends.
 
   // Caching behavior related.
   bool initialize_after_startup{true};
   double initial_cache_rate{1.0};
   bool cache_missed_embeddings{false};
+  std::string snapshot_path;  // Only used with HashMap type backends ("" = disable).
 
   // Real-time update mechanism related.
   std::vector<std::string> update_filters{{"^hps_.+$"}};  // Should be a regex for Kafka.
@@ -182,16 +270,21 @@ struct VolatileDatabaseParams {
       DatabaseType_t type,
       // Backend specific.
       const std::string& address, const std::string& user_name, const std::string& password,
-      size_t num_partitions, size_t allocation_rate, size_t shared_memory_size,
+      size_t num_partitions, size_t allocation_rate, DatabaseHugePages_t huge_pages,
+      bool numa_aware, double compaction_threshold, size_t shared_memory_size,
       const std::string& shared_memory_name, bool shared_memory_auto_remove,
-      size_t num_node_connections, size_t max_batch_size, bool enable_tls,
-      const std::string& tls_ca_certificate, const std::string& tls_client_certificate,
-      const std::string& tls_client_key, const std::string& tls_server_name_identification,
+      bool shared_memory_open_addressing, size_t num_node_connections, size_t max_batch_size,
+      DatabaseValueCodec_t value_codec, bool enable_tls, const std::string& tls_ca_certificate,
+      const std::string& tls_client_certificate, const std::string& tls_client_key,
+      const std::string& tls_server_name_identification, size_t near_cache_size,
+      size_t near_cache_max_staleness_ms,
       // Overflow handling related.
       size_t overflow_margin, DatabaseOverflowPolicy_t overflow_policy,
-      double overflow_resolution_target,
+      double overflow_resolution_target, size_t overflow_sample_size,
+      DatabaseRecencySource_t recency_source,
       // Caching behavior related.
       bool initialize_after_startup, double initial_cache_rate, bool cache_missed_embeddings,
+      const std::string& snapshot_path,
       // Real-time update mechanism related.
       const std::vector<std::string>& update_filters);
 
@@ -207,6 +300,15 @@ struct PersistentDatabaseParams {
   size_t num_threads{16};  // 16 = Default for RocksDB.
   bool read_only{false};
   size_t max_batch_size{64L * 1024};
+  DatabaseValueCodec_t value_codec{DatabaseValueCodec_t::Float32};  // Storage format.
+  size_t block_cache_size{8L * 1024 * 1024};  // Shared by all tables (0 = disable).
+  double bloom_filter_bits_per_key{10};       // 0 = disable.
+  bool partitioned_filters{false};  // Partition the index and filter blocks, and cache them.
+  bool use_direct_reads{false};     // Bypass the OS page cache.
+  size_t num_lookup_tasks{1};       // Number of concurrent MultiGet batches per query.
+  size_t io_depth{64};              // SlabStore: Reads in flight per lookup task.
+  double compaction_threshold{0.5};  // SlabStore: Fraction of outdated rows that triggers
+                                     // compaction.
 
   // Caching behavior related.
   bool initialize_after_startup{true};
@@ -218,7 +320,11 @@ struct PersistentDatabaseParams {
   PersistentDatabaseParams(DatabaseType_t type,
                            // Backend specific.
                            const std::string& path, size_t num_threads, bool read_only,
-                           size_t max_batch_size,
+                           size_t max_batch_size, DatabaseValueCodec_t value_codec,
+                           size_t block_cache_size, double bloom_filter_bits_per_key,
+                           bool partitioned_filters, bool use_direct_reads,
+                           size_t num_lookup_tasks, size_t io_depth,
+                           double compaction_threshold,
                            // Caching behavior related.
                            bool initialize_after_startup,
                            // Real-time update mechanism related.
@@ -239,13 +345,15 @@ struct UpdateSourceParams {
   size_t max_batch_size{8 * 1024};
   size_t failure_backoff_ms{50};
   size_t max_commit_interval{32};
+  std::string path{"/tmp/hps_mq"};  // Local: Root directory of the message queue.
 
   UpdateSourceParams() {}
   UpdateSourceParams(UpdateSourceType_t type,
                      // Backend specific.
                      const std::string& brokers, size_t metadata_refresh_interval_ms,
                      size_t receive_buffer_size, size_t poll_timeout_ms, size_t max_batch_size,
-                     size_t failure_backoff_ms, size_t max_commit_interval);
+                     size_t failure_backoff_ms, size_t max_commit_interval,
+                     const std::string& path);
 
   bool operator==(const UpdateSourceParams& p) const;
   bool operator!=(const UpdateSourceParams& p) const;
@@ -77,9 +77,16 @@ class KafkaMessageSink final : public MessageSink<Key, KafkaMessageSinkParams> {
    *
    * @param value_size Size of each value. This will be used to fill the header and check for some
    * basic errors.
+   * @param prefix Identifies the payload format.
    * @return Pointer to send buffer.
    */
-  char* acquire_send_buffer(uint32_t value_size);
+  char* acquire_send_buffer(uint32_t value_size, uint32_t prefix);
+
+  /**
+   * Internally called to encode the pairs of a key group with the \p codec_ , and send them.
+   */
+  void post_encoded(rd_kafka_topic_t* topic, size_t num_pairs, const Key* keys, const char* values,
+                    uint32_t value_size);
 
   /**
    * Internally called to
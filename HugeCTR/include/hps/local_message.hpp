@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <hps/message.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Read-write or read-only memory mapping of a single segment file of a local message queue.
+ */
+class LocalMessageSegment final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(LocalMessageSegment);
+
+  LocalMessageSegment() = delete;
+
+  /**
+   * Maps an existing segment file.
+   *
+   * @param path Path of the segment file.
+   * @param writable Map the file for writing.
+   */
+  LocalMessageSegment(const std::string& path, bool writable);
+
+  ~LocalMessageSegment();
+
+  /**
+   * Atomically creates a new segment file of the given size (filled with zeros).
+   *
+   * @param path Path of the segment file.
+   * @param size Size of the segment file in bytes.
+   */
+  static void create(const std::string& path, size_t size);
+
+  char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  /**
+   * Writes the specified range back to disk.
+   */
+  void sync(size_t offset, size_t length, bool blocking) const;
+
+ private:
+  char* data_{nullptr};
+  size_t size_{0};
+};
+
+struct LocalMessageSinkParams : public MessageSinkParams {
+  std::string path = "/tmp/hps_mq";  // Root directory of the message queue.
+  size_t segment_size = 256 * 1024 * 1024;  // Size of each segment file. Hence, the maximum size of
+                                            // a single message.
+  size_t num_retained_segments = 8;  // Older segments are deleted (0 = keep everything).
+};
+
+/**
+ * \p MessageSink implementation that writes messages to an append-only log of memory mapped
+ * segment files on the local file system. Each tag is stored in a separate subdirectory of
+ * \p LocalMessageSinkParams::path . Only one sink may write to the same tag at a time.
+ *
+ * @tparam Key Data-type to be used for keys in this message queue.
+ */
+template <typename Key>
+class LocalMessageSink final : public MessageSink<Key, LocalMessageSinkParams> {
+ public:
+  using Base = MessageSink<Key, LocalMessageSinkParams>;
+
+  HCTR_DISALLOW_COPY_AND_MOVE(LocalMessageSink);
+
+  LocalMessageSink() = delete;
+
+  /**
+   * Construct a new \p LocalMessageSink object.
+   */
+  LocalMessageSink(const LocalMessageSinkParams& params);
+
+  virtual ~LocalMessageSink();
+
+  virtual void post(const std::string& tag, size_t num_pairs, const Key* keys, const char* values,
+                    uint32_t value_size) override;
+
+  virtual void flush() override;
+
+ protected:
+  struct Log final {
+    int lock_fd{-1};
+    size_t segment_index{0};
+    std::unique_ptr<LocalMessageSegment> segment;
+    size_t position{0};
+    size_t synced_position{0};
+  };
+
+  /**
+   * Internally called to find/open the log of a tag.
+   */
+  Log& resolve_log(const std::string& tag);
+
+  /**
+   * Internally called to seal the current segment and begin a new one.
+   */
+  void rotate(const std::string& tag, Log& log);
+
+  std::unordered_map<std::string, Log> logs_;
+};
+
+/**
+ * \p MessageSource implementation that reads from a message queue created by a
+ * \p LocalMessageSink . Consumer groups track their position independently, and commit it to the
+ * message queue directory. After a restart, consumption resumes at the last committed position.
+ *
+ * Unencoded messages are delivered directly from the mapped segment files (i.e., without copying).
+ *
+ * @tparam Key Data-type to be used for keys in this message queue.
+ */
+template <typename Key>
+class LocalMessageSource final : public MessageSource<Key> {
+ public:
+  using Base = MessageSource<Key>;
+
+  HCTR_DISALLOW_COPY_AND_MOVE(LocalMessageSource);
+
+  /**
+   * Construct a new LocalMessageSource object.
+   *
+   * @param path Root directory of the message queue.
+   * @param consumer_group_id Consumer group ID to use for this message source.
+   * @param tag_filters Regular expressions to limit the scope of tags that can be seen.
+   * @param poll_timeout_ms Wait this long before polling again if no new messages are available.
+   * @param max_batch_size Maximum number of key/values that are passed to the callback at once.
+   * @param failure_backoff_ms In case something bad happend, wait this number of milliseconds.
+   * @param max_commit_interval Commit after at most this many messages have been delivered.
+   */
+  LocalMessageSource(const std::string& path = "/tmp/hps_mq",
+                     const std::string& consumer_group_id = "",
+                     const std::vector<std::string>& tag_filters = {"^hps_.+$"},
+                     size_t poll_timeout_ms = 500, size_t max_batch_size = 8 * 1024,
+                     size_t failure_backoff_ms = 50, size_t max_commit_interval = 32);
+
+  virtual ~LocalMessageSource();
+
+  size_t num_keys_delivered() const { return num_keys_delivered_; }
+  size_t num_keys_committed() const { return num_keys_committed_; }
+  size_t num_messages_committed() const { return num_messages_committed_; }
+
+  virtual void engage(std::function<HCTR_MESSAGE_SOURCE_CALLBACK> callback) override;
+
+ protected:
+  const std::string path_;
+  const std::string consumer_group_id_;
+  const std::vector<std::string> tag_filters_;
+
+  // Background thread.
+  const std::chrono::milliseconds poll_timeout_ms_;
+  const size_t max_batch_size_;
+  const std::chrono::milliseconds failure_backoff_ms_;
+  const size_t max_commit_interval_;
+
+ private:
+  bool terminate_ = false;
+  std::thread event_handler_;
+  size_t num_keys_delivered_ = 0;
+  size_t num_keys_committed_ = 0;
+  size_t num_messages_committed_ = 0;
+
+  void run(std::function<HCTR_MESSAGE_SOURCE_CALLBACK> callback);
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
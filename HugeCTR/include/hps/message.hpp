@@ -17,10 +17,13 @@
 
 #include <common.hpp>
 #include <functional>
+#include <hps/message_codec.hpp>
 
 namespace HugeCTR {
 
-struct MessageSinkParams {};
+struct MessageSinkParams {
+  MessageCodecParams codec;  // How to encode the key/value pairs in each message.
+};
 
 /**
  * Each instance represents an emitter link to a theoretically infinitely sized message queue..
@@ -72,12 +75,13 @@ class MessageSink : public MessageSinkBase<Key> {
 
   MessageSink() = delete;
 
-  MessageSink(const Params& params) : params_{params} {}
+  MessageSink(const Params& params) : params_{params}, codec_{params.codec} {}
 
   virtual ~MessageSink() = default;
 
  protected:
   const Params params_;
+  const MessageCodec<Key> codec_;
 };
 
 #define HCTR_MESSAGE_SOURCE_CALLBACK \
@@ -85,6 +89,8 @@ class MessageSink : public MessageSinkBase<Key> {
 
 /**
  * Each instance represents an consumer link to a theoretically infinitely sized message queue..
+ * Implementations must accept messages regardless of the \p MessageCodecParams of the sink (i.e.,
+ * decode them using \p MessageCodec::decode ).
  *
  * @tparam Key Data-type to be used for keys in this message queue.
  */
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <hps/value_codec.hpp>
+#include <ostream>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+enum class MessageCompression_t {
+  None,
+  LZ4,
+  Zstd,
+};
+constexpr const char* hctr_enum_to_c_str(const MessageCompression_t value) {
+  // Remark: Dependent functions assume lower-case, and underscore separated.
+  switch (value) {
+    case MessageCompression_t::None:
+      return "none";
+    case MessageCompression_t::LZ4:
+      return "lz4";
+    case MessageCompression_t::Zstd:
+      return "zstd";
+    default:
+      return "<unknown MessageCompression_t value>";
+  }
+}
+
+inline std::ostream& operator<<(std::ostream& os, MessageCompression_t value) {
+  return os << hctr_enum_to_c_str(value);
+}
+
+struct MessageCodecParams final {
+  bool delta_keys{false};  // Sort keys, and store them as variable length deltas.
+  DatabaseValueCodec_t value_codec{DatabaseValueCodec_t::Float32};  // Value quantization.
+  MessageCompression_t compression{MessageCompression_t::None};     // Block compression.
+  int compression_level{0};  // Compression library specific (0 = default).
+  size_t block_size{16 * 1024};  // Pairs per block. Blocks are encoded/decoded in parallel.
+
+  bool operator==(const MessageCodecParams& p) const;
+  bool operator!=(const MessageCodecParams& p) const;
+};
+
+/**
+ * Encodes batches of key/value pairs into self-describing message payloads and back.
+ *
+ * The pairs are split into blocks of \p MessageCodecParams::block_size pairs, which are encoded
+ * and decoded independently, and in parallel. Per block, keys are optionally sorted and stored as
+ * variable length deltas, values are quantized by a \p ValueCodec , and the result is compressed.
+ * Blocks that do not compress are stored uncompressed. Sorting changes the order of the pairs, but
+ * not the relative order of duplicate keys.
+ *
+ * @tparam Key Data-type to be used for keys.
+ */
+template <typename Key>
+class MessageCodec final {
+ public:
+  MessageCodec(const MessageCodecParams& params);
+
+  inline const MessageCodecParams& params() const { return params_; }
+
+  /**
+   * @return \p true if payloads are just the keys followed by the values (i.e., no encoding).
+   */
+  inline bool is_identity() const { return identity_; }
+
+  /**
+   * @return Upper bound for the size of the payload that encodes \p num_pairs pairs.
+   */
+  size_t max_encoded_size(size_t num_pairs, uint32_t value_size) const;
+
+  /**
+   * @return Maximum number of pairs for which the encoded payload is guaranteed to fit into
+   * \p max_payload_size bytes.
+   */
+  size_t max_num_pairs(size_t max_payload_size, uint32_t value_size) const;
+
+  /**
+   * Encodes key/value pairs.
+   *
+   * @param num_pairs The number of \p keys and \p values .
+   * @param keys Pointer to the keys.
+   * @param values Pointer to the values.
+   * @param value_size The size of each value in bytes.
+   * @param payload Output buffer (at least \p max_encoded_size bytes).
+   *
+   * @return Size of the payload in bytes.
+   */
+  size_t encode(size_t num_pairs, const Key* keys, const char* values, uint32_t value_size,
+                char* payload) const;
+
+  /**
+   * Decodes a payload and appends the pairs to \p keys and \p values .
+   *
+   * @param payload Pointer to the payload.
+   * @param payload_size Size of the payload in bytes.
+   * @param keys Keys are appended here.
+   * @param values Values are appended here.
+   * @param value_size Set to the size of each (decoded) value in bytes.
+   *
+   * @return Number of decoded pairs.
+   */
+  static size_t decode(const char* payload, size_t payload_size, std::vector<Key>& keys,
+                       std::vector<char>& values, uint32_t& value_size);
+
+ private:
+  const MessageCodecParams params_;
+  const ValueCodec value_codec_;
+  const bool identity_;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
@@ -18,11 +18,13 @@
 #include <cuda_fp16.h>
 #include <cuda_runtime_api.h>
 
+#include <core/macro.hpp>
 #include <cstdint>
 #include <hps/database_backend.hpp>
 #include <io/filesystem.hpp>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
@@ -130,11 +132,15 @@ class IModelLoader {
   /**
    * @brief Returns all embedding keys for a specific number of iterations
    *
+   * The returned buffer holds at least as many keys as an iteration, even for the last (shorter)
+   * iteration. It may point into a read-only memory mapping. Hence, it must not be written to.
+   *
    * @param iteration
    */
   virtual std::pair<void*, size_t> getkeys(size_t iteration) = 0;
   /**
-   * Returns all embedding vectors for a specific number of iterations
+   * Returns all embedding vectors for a specific number of iterations. Like \p getkeys , the
+   * returned buffer is sized for a full iteration, and must not be written to.
    *@param iteration
    *@param embedding_vector_size
    */
@@ -150,10 +156,50 @@ class IModelLoader {
   IModelLoader() = default;
 };
 
+/**
+ * Read-only memory mapping of a model file on the local file system. The contents are served
+ * directly from the page cache. Hence, mapping a file does not require any additional memory.
+ */
+class MappedModelFile final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(MappedModelFile);
+
+  MappedModelFile() = delete;
+
+  /**
+   * @param path Path of the file.
+   */
+  MappedModelFile(const std::string& path);
+
+  ~MappedModelFile();
+
+  inline const char* data() const { return data_; }
+
+  inline size_t size() const { return size_; }
+
+  /**
+   * Faults in the pages that back a part of the file. Large ranges are split into chunks that are
+   * read in parallel, which keeps more I/O requests in flight than sequential page faults.
+   *
+   * @param offset Offset of the range in bytes.
+   * @param length Length of the range in bytes.
+   */
+  void prefault(size_t offset, size_t length) const;
+
+ private:
+  char* data_;
+  size_t size_;
+};
+
 /**
  * Implementations of read/parse embedding from legacy foramt model file, which is general format
  * for hugectr model file.
  *
+ * Files on the local file system are memory mapped. In this case, \p getkeys and \p getvectors
+ * return pointers into the mapped files (read-only) if the key type matches the file format, and
+ * the iteration is complete. They remain valid until the next call to \p load or
+ * \p delete_table .
+ *
  * @tparam TKey The data-type that is used for keys in this database.
  * @tparam TKey The data-type that is used for keys in this database.
  */
@@ -166,10 +212,17 @@ class RawModelLoader : public IModelLoader {
   size_t key_iteration;
   std::string embedding_folder_path;
   size_t key_num_iteration = 0;
+  const bool prefault_;
+  std::unique_ptr<MappedModelFile> key_file_;
+  std::unique_ptr<MappedModelFile> vec_file_;
   virtual void load_emb(const std::string& table_name, const std::string& path);
 
  public:
-  RawModelLoader();
+  /**
+   * @param prefault If true, fault in the mapped pages of each iteration in parallel before
+   * returning them (see \p MappedModelFile::prefault ).
+   */
+  RawModelLoader(bool prefault = false);
   virtual void load(const std::string& table_name, const std::string& path,
                     size_t key_num_per_iteration, size_t threshold);
 
@@ -196,10 +249,10 @@ class RawModelLoader : public IModelLoader {
 template <typename TKey, typename TValue>
 class ModelLoader {
  public:
-  static IModelLoader* CreateLoader(DatabaseTableDumpFormat_t type) {
+  static IModelLoader* CreateLoader(DatabaseTableDumpFormat_t type, bool prefault = false) {
     switch (type) {
       case DatabaseTableDumpFormat_t::Raw:
-        return new RawModelLoader<TKey, TValue>();
+        return new RawModelLoader<TKey, TValue>(prefault);
         break;
       // TBD: The load_dump logic implemented in the data backend can be encapsulated as another
       // model reader for sst/bin files, So as to facilitate the reuse by components, such as
@@ -15,15 +15,27 @@
  */
 #pragma once
 
+#include <parallel_hashmap/phmap.h>
+
+#include <array>
 #include <boost/interprocess/containers/flat_map.hpp>
 #include <boost/interprocess/containers/string.hpp>
 #include <boost/interprocess/containers/vector.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
 #include <boost/unordered_map.hpp>
 #include <core/macro.hpp>
 #include <hps/database_backend.hpp>
+#include <hps/recency_clock.hpp>
+#include <hps/robin_hood_hash_map.hpp>
+#include <hps/sharded_shared_mutex.hpp>
+#include <hps/value_codec.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace HugeCTR {
 
@@ -41,6 +53,12 @@ struct MultiProcessHashMapBackendParams final : public VolatileBackendParams {
   std::chrono::nanoseconds heart_beat_frequency{std::chrono::milliseconds{
       100}};               // Frequency at which we tick up the heart-beat frequency counter.
   bool auto_remove{true};  // Remove SHM if this is the last process to detach from the SHM.
+  bool open_addressing{
+      false};  // Store entries in open-addressing hash tables that allow lock-free lookups.
+  DatabaseRecencySource_t recency_source{
+      DatabaseRecencySource_t::CoarseClock};  // Source of access stamps for `EvictOldest`.
+  DatabaseValueCodec_t value_codec{
+      DatabaseValueCodec_t::Float32};  // Format in which values of new tables are stored.
 };
 
 template <typename Key>
@@ -115,76 +133,206 @@ class MultiProcessHashMapBackend final
   // Data-structure that will be associated with every key.
   struct Payload final {
     union {
-      time_t last_access;
+      uint64_t last_access;  // Recency stamp (see `RecencyClock`).
       uint64_t access_count;
     };
     ValuePtr value;
   };
-  using Entry = std::pair<const Key, Payload>;
+  template <typename Entries>
+  struct BasicPartition final {
+    using Entry = std::remove_const_t<
+        std::remove_reference_t<decltype(*std::declval<const Entries&>().begin())>>;
 
-  struct Partition final {
-    uint32_t value_size;
+    uint32_t value_size;  // Size of decoded values.
+    ValueCodec codec;     // Shared by all processes. Hence, fixed once the table exists.
     size_t allocation_rate;
     size_t overflow_margin;
     DatabaseOverflowPolicy_t overflow_policy;
     double overflow_resolution_target;
 
-    // Pooled payload storage.
+    // Recency stamps for `EvictOldest` (shared by all processes).
+    RecencyClock recency_clock;
+
+    // Pooled payload storage (holds encoded values).
     SharedVector<ValuePage> value_pages;
     SharedVector<ValuePtr> value_slots;
 
     // Key -> Payload map.
-    SharedFlatMap<Key, Payload> entries;
+    Entries entries;
+
+    // Serializes writers and allows readers to detect concurrent modifications (seqlock).
+    boost::interprocess::interprocess_mutex write_guard;
+    std::atomic<uint64_t> version{0};
 
-    Partition() = delete;
+    BasicPartition() = delete;
 
-    Partition(const uint32_t value_size, const MultiProcessHashMapBackendParams& params,
-              Segment& segment)
+    BasicPartition(const uint32_t value_size, const MultiProcessHashMapBackendParams& params,
+                   Segment& segment)
         : value_size{value_size},
+          codec{params.value_codec},
           allocation_rate{params.allocation_rate},
           overflow_margin{params.overflow_margin},
           overflow_policy{params.overflow_policy},
           overflow_resolution_target{params.overflow_resolution_target},
+          recency_clock{params.recency_source},
           value_pages(segment.get_allocator<ValuePage>()),
           value_slots(segment.get_allocator<ValuePtr>()),
-          entries(segment.get_allocator<Entry>()) {}
+          entries(typename Entries::allocator_type(segment.get_segment_manager())) {}
+
+    // Partitions are only moved before they become visible to other threads/processes. Hence, the
+    // synchronization state does not need to be transferred.
+    BasicPartition(BasicPartition&& other)
+        : value_size{other.value_size},
+          codec{other.codec},
+          allocation_rate{other.allocation_rate},
+          overflow_margin{other.overflow_margin},
+          overflow_policy{other.overflow_policy},
+          overflow_resolution_target{other.overflow_resolution_target},
+          recency_clock{other.recency_clock},
+          value_pages(std::move(other.value_pages)),
+          value_slots(std::move(other.value_slots)),
+          entries(std::move(other.entries)) {}
+
+    BasicPartition& operator=(BasicPartition&& other) {
+      value_size = other.value_size;
+      codec = other.codec;
+      allocation_rate = other.allocation_rate;
+      overflow_margin = other.overflow_margin;
+      overflow_policy = other.overflow_policy;
+      overflow_resolution_target = other.overflow_resolution_target;
+      recency_clock = other.recency_clock;
+      value_pages = std::move(other.value_pages);
+      value_slots = std::move(other.value_slots);
+      entries = std::move(other.entries);
+      return *this;
+    }
   };
 
+  // Sorted storage. All accesses are serialized by the global `read_write_guard`.
+  using FlatPartition = BasicPartition<SharedFlatMap<Key, Payload>>;
+  // Open-addressing storage. Writers lock partitions individually. Readers are lock-free.
+  using OpenPartition = BasicPartition<
+      RobinHoodHashMap<Key, Payload, SegmentAllocator<std::pair<Key, Payload>>>>;
+
+  template <typename Partition>
+  using SharedTables = SharedMap<SharedString, SharedVector<Partition>>;
+
   struct SharedMemory final {
     const std::chrono::nanoseconds heart_beat_frequency;
     const bool auto_remove;
+    const bool open_addressing;
     volatile std::atomic<uint64_t> heart_beat;
 
     // Access control.
     boost::interprocess::interprocess_sharable_mutex read_write_guard;
 
-    // Actual data.
-    SharedMap<SharedString, SharedVector<Partition>> tables;
+    // Actual data (only one of the two is used, depending on `open_addressing`).
+    SharedTables<FlatPartition> tables;
+    SharedTables<OpenPartition> open_tables;
 
     HCTR_DISALLOW_COPY_AND_MOVE(SharedMemory);
 
     SharedMemory() = delete;
 
     SharedMemory(const std::chrono::nanoseconds& heart_beat_frequency, const bool& auto_remove,
-                 Segment& segment)
+                 const bool& open_addressing, Segment& segment)
         : heart_beat_frequency{heart_beat_frequency},
           auto_remove{auto_remove},
+          open_addressing{open_addressing},
           heart_beat{0},
-          tables(segment.get_allocator<std::pair<const SharedString, SharedVector<Partition>>>()) {}
+          tables(segment.get_allocator<
+                 std::pair<const SharedString, SharedVector<FlatPartition>>>()),
+          open_tables(segment.get_allocator<
+                      std::pair<const SharedString, SharedVector<OpenPartition>>>()) {}
+  };
+
+  // Access statistics gathered by lock-free lookups (open-addressing mode only), that were not yet
+  // applied to the payloads. Buckets may be moved or released while they are read. Hence, readers
+  // record statistics process-locally, and they are merged while holding the partition write lock.
+  struct alignas(64) AccessStats final {
+    static constexpr size_t max_size{64 * 1024};  // Further keys are not tracked until merged.
+
+    std::mutex guard;
+    phmap::flat_hash_map<Key, uint64_t> values;  // access count (LFU) or time (LRU)
   };
+  using PartitionAccessStats = std::array<AccessStats, ShardedSharedMutex::num_shards>;
 
   Segment sm_segment_;
   SegmentAllocator<char> char_allocator_;
   SegmentAllocator<ValuePage> value_page_allocator_;
-  SegmentAllocator<Partition> partition_allocator_;
   SharedMemory* sm_;
 
+  // Process-local access statistics of each table (see `AccessStats`). Entries are only removed
+  // while holding `read_write_guard` exclusively.
+  std::unordered_map<std::string, std::vector<PartitionAccessStats>> access_stats_;
+  mutable std::shared_mutex access_stats_guard_;
+
   // Heart beat system.
   bool heart_stop_signal_ = false;
   std::thread heart_;
   bool is_process_connected_() const;
 
+  // Implementations for the different storage modes.
+  template <typename Partition>
+  size_t size_(const SharedTables<Partition>& tables, const std::string& table_name) const;
+
+  template <typename Partition>
+  size_t contains_(const SharedTables<Partition>& tables, const std::string& table_name,
+                   size_t num_keys, const Key* keys,
+                   const std::chrono::nanoseconds& time_budget) const;
+
+  template <typename Partition>
+  size_t insert_(SharedTables<Partition>& tables, const std::string& table_name, size_t num_pairs,
+                 const Key* keys, const char* values, uint32_t value_size, size_t value_stride);
+
+  template <typename Partition>
+  size_t fetch_(SharedTables<Partition>& tables, const std::string& table_name, size_t num_keys,
+                const Key* keys, char* values, size_t value_stride,
+                const DatabaseMissCallback& on_miss, const std::chrono::nanoseconds& time_budget);
+
+  template <typename Partition>
+  size_t fetch_(SharedTables<Partition>& tables, const std::string& table_name,
+                size_t num_indices, const size_t* indices, const Key* keys, char* values,
+                size_t value_stride, const DatabaseMissCallback& on_miss,
+                const std::chrono::nanoseconds& time_budget);
+
+  template <typename Partition>
+  size_t evict_(SharedTables<Partition>& tables, const std::string& table_name);
+
+  template <typename Partition>
+  size_t evict_(SharedTables<Partition>& tables, const std::string& table_name, size_t num_keys,
+                const Key* keys);
+
+  template <typename Partition>
+  void find_tables_(const SharedTables<Partition>& tables, const std::string& tag_prefix,
+                    std::vector<std::string>& matches) const;
+
+  template <typename Partition>
+  size_t dump_bin_(SharedTables<Partition>& tables, const std::string& table_name,
+                   std::ofstream& file);
+
+  template <typename Partition>
+  size_t dump_sst_(SharedTables<Partition>& tables, const std::string& table_name,
+                   rocksdb::SstFileWriter& file);
+
+  // Value storage. Requires exclusive access to the partition.
+  template <typename Partition>
+  ValuePtr allocate_value_(Partition& part);
+  template <typename Partition>
+  void release_value_(Partition& part, const ValuePtr& value);
+
+  // Locates the access statistics of a table, or creates them, if they do not exist yet.
+  std::vector<PartitionAccessStats>& get_access_stats_(const std::string& table_name,
+                                                       size_t num_partitions);
+
+  // Applies pending access statistics. Requires exclusive access to the partition.
+  void merge_access_stats_(OpenPartition& part, PartitionAccessStats& part_stats) const;
+
+  // Applies pending access statistics, if plenty were gathered and no writer holds the partition.
+  void try_merge_access_stats_(OpenPartition& part, PartitionAccessStats& part_stats) const;
+
   // Overflow resolution.
+  template <typename Partition>
   size_t resolve_overflow_(const std::string& table_name, size_t part_index, Partition& part);
 };
 
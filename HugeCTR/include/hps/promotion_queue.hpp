@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <core/macro.hpp>
+#include <hps/database_backend.hpp>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Counters of a \p PromotionQueue .
+ */
+struct PromotionQueueStats final {
+  size_t num_submitted{0};   // Keys passed to `submit`.
+  size_t num_duplicates{0};  // Keys skipped, because they were already queued or being inserted.
+  size_t num_dropped{0};     // Keys rejected, because the queue was full.
+  size_t num_promoted{0};    // Keys inserted into the database.
+  size_t num_batches{0};     // Insert batches (one per table).
+  size_t queue_depth{0};     // Keys currently waiting to be inserted.
+  double promotion_rate{0};  // Recently promoted keys per second.
+};
+
+std::ostream& operator<<(std::ostream& os, const PromotionQueueStats& stats);
+
+/**
+ * Moves embeddings into a database in the background (e.g., to elevate embeddings that were missing
+ * in the volatile database, but could be found in the persistent database).
+ *
+ * Submitted keys are deduplicated across callers, and coalesced into batches that are inserted by a
+ * single background thread. The queue is bounded. Keys that are submitted while the queue is full
+ * are dropped. Hence, callers are never blocked by a slow database, and a key that keeps missing
+ * will simply be submitted again by a later lookup.
+ *
+ * @tparam Key Data-type of the keys.
+ */
+template <typename Key>
+class PromotionQueue final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(PromotionQueue);
+
+  PromotionQueue() = delete;
+
+  /**
+   * @param db Database into which the embeddings are inserted. Must outlive the queue.
+   * @param max_batch_size Insert as soon as this many keys are queued.
+   * @param max_queue_size Maximum number of queued keys.
+   * @param max_delay Maximum time that keys wait for a batch to fill up.
+   */
+  PromotionQueue(DatabaseBackendBase<Key>* db, size_t max_batch_size, size_t max_queue_size,
+                 std::chrono::microseconds max_delay);
+
+  ~PromotionQueue();
+
+  /**
+   * Queues `keys[indices[i]]` and the corresponding values for insertion.
+   *
+   * @param table_name The name of the table.
+   * @param num_indices Number of \p indices .
+   * @param indices Indices of the keys to promote.
+   * @param keys Pointer to the keys.
+   * @param values Pointer to the values (\p value_size bytes per key).
+   * @param value_size Size of each value in bytes. Must be the same for all calls with the same
+   * \p table_name .
+   *
+   * @return Number of keys that were queued.
+   */
+  size_t submit(const std::string& table_name, size_t num_indices, const size_t* indices,
+                const Key* keys, const char* values, size_t value_size);
+
+  /**
+   * Blocks until all queued keys have been inserted.
+   */
+  void flush();
+
+  PromotionQueueStats stats() const;
+
+ private:
+  struct Table final {
+    size_t value_size{0};
+    std::unordered_set<Key> queued_keys;
+    std::vector<Key> keys;
+    std::vector<char> values;
+  };
+
+  DatabaseBackendBase<Key>* const db_;
+  const size_t max_batch_size_;
+  const size_t max_queue_size_;
+  const std::chrono::microseconds max_delay_;
+
+  mutable std::mutex barrier_;
+  std::condition_variable ready_semaphore_;  // Triggered when a batch should be inserted.
+  std::condition_variable idle_semaphore_;   // Triggered after inserting a batch.
+
+  // Tables receive new keys, while the background thread inserts the keys of `inserting_`.
+  // Afterwards, both are swapped. Hence, their buffers are reused.
+  std::unordered_map<std::string, Table> queued_;
+  std::unordered_map<std::string, Table> inserting_;
+  bool busy_{false};
+  size_t num_flushing_{0};
+
+  PromotionQueueStats stats_;
+  std::chrono::steady_clock::time_point last_insert_time_;
+
+  // Background thread.
+  bool terminate_{false};
+  std::thread inserter_;
+  void run_();
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
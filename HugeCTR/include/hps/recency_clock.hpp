@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <time.h>
+
+#include <atomic>
+#include <cstdint>
+#include <hps/inference_utils.hpp>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Monotonic clock with millisecond granularity, that is ticked in the background by the kernel.
+ * Reading it does not require a system call, and is considerably cheaper than querying a
+ * high-resolution clock. Readings are comparable across processes on the same machine.
+ */
+class CoarseClock final {
+ public:
+  static inline uint64_t now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+  }
+};
+
+/**
+ * Source of the recency stamps that are used to determine the least recently accessed entries of a
+ * partition (i.e., for \p DatabaseOverflowPolicy_t::EvictOldest ). Stamps are only comparable
+ * within the same partition.
+ *
+ * - \p CoarseClock : Milliseconds since an arbitrary point in time (see \p CoarseClock ).
+ * - \p LogicalEpoch : A counter that advances with each batch of accesses to the partition.
+ *   Hence, the order of accesses is retained precisely, except that all keys in a batch are
+ *   considered to be accessed at the same time.
+ */
+class RecencyClock final {
+ public:
+  RecencyClock() = delete;
+
+  explicit RecencyClock(const DatabaseRecencySource_t source) : source_{source} {}
+
+  /**
+   * Only safe while the owning partition is not accessible by other threads.
+   */
+  RecencyClock(const RecencyClock& other)
+      : source_{other.source_}, epoch_{other.epoch_.load(std::memory_order_relaxed)} {}
+
+  RecencyClock& operator=(const RecencyClock& other) {
+    source_ = other.source_;
+    epoch_.store(other.epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  inline DatabaseRecencySource_t source() const { return source_; }
+
+  /**
+   * Stamp for the next batch of accesses.
+   */
+  inline uint64_t now() {
+    switch (source_) {
+      case DatabaseRecencySource_t::CoarseClock:
+        return CoarseClock::now();
+      case DatabaseRecencySource_t::LogicalEpoch:
+        return epoch_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return 0;
+  }
+
+ private:
+  DatabaseRecencySource_t source_;
+  std::atomic<uint64_t> epoch_{0};
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
@@ -18,6 +18,7 @@
 #include <sw/redis++/redis++.h>
 
 #include <hps/database_backend.hpp>
+#include <hps/redis_near_cache.hpp>
 #include <memory>
 
 namespace HugeCTR {
@@ -44,6 +45,12 @@ struct RedisClusterBackendParams final : public VolatileBackendParams {
   std::string client_key{"client_key.pem"};           // Private key to use for this client.
   std::string server_name_identification{
       "redis.localhost"};  // SNI to request (can deviate from connection address).
+
+  size_t near_cache_size{0};  // Size of the in-process cache for values fetched from Redis in bytes
+                              // (0 = disabled).
+  size_t near_cache_max_staleness_ms{
+      100};  // Period for which cached values are served without verifying that their partition
+             // was not modified (0 = verify during each lookup).
 };
 
 /**
@@ -144,9 +151,21 @@ class RedisClusterBackend final : public VolatileBackend<Key, RedisClusterBacken
   void queue_metadata_refresh_(const std::string& table_name, size_t part_index,
                                std::shared_ptr<std::vector<Key>>&& keys);
 
+  /**
+   * Called after modifying a partition, so that subsequent lookups observe the modification.
+   */
+  inline void invalidate_near_cache_(const std::string& table_name, const size_t part_index) {
+    if (near_cache_) {
+      near_cache_->invalidate(near_cache_->table_id(table_name), part_index);
+    }
+  }
+
  protected:
   std::unique_ptr<sw::redis::RedisCluster> redis_;
 
+  // Optional cache for values fetched from Redis (nullptr = disabled).
+  std::unique_ptr<RedisNearCache<Key>> near_cache_;
+
   // Worker used to update timestamps and carry out overflow handling.
   mutable ThreadPool background_worker_{"redis bg worker", 1};
 };
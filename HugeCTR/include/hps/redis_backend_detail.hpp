@@ -19,6 +19,7 @@
 
 #include <charconv>
 #include <core23/logger.hpp>
+#include <hps/redis_near_cache.hpp>
 #include <iterator>
 #include <type_traits>
 #include <vector>
@@ -257,6 +258,53 @@ class RedisDirectValueInserter final
   size_t index{0};
 };
 
+/**
+ * Wraps a \p RedisDirectValueInserter to also store the parsed values in a \p RedisNearCache .
+ */
+template <typename Key>
+class RedisNearCacheValueInserter final
+    : public RedisInsertIterator<Key, sw::redis::Optional<sw::redis::StringView>> {
+ public:
+  static_assert(std::is_integral_v<Key>);
+
+  RedisNearCacheValueInserter() = delete;
+
+  inline RedisNearCacheValueInserter(RedisDirectValueInserter<Key>&& base,
+                                     const std::vector<sw::redis::StringView>& k_views,
+                                     RedisNearCache<Key>& near_cache, const uint32_t table_id,
+                                     const size_t part_index, const uint64_t generation)
+      : base{std::move(base)},
+        k_views{&k_views},
+        near_cache{&near_cache},
+        table_id{table_id},
+        part_index{part_index},
+        generation{generation} {}
+
+  inline RedisNearCacheValueInserter& operator=(
+      sw::redis::Optional<sw::redis::StringView>&& v_view) {
+    const Key* const k{reinterpret_cast<const Key*>(k_views->at(index++).data())};
+    if (v_view) {
+      near_cache->insert(table_id, part_index, generation, *k, v_view->data(), v_view->size());
+    }
+    base = std::move(v_view);
+
+    return *this;
+  }
+
+  inline RedisNearCacheValueInserter& operator*() { return *this; }
+  inline RedisNearCacheValueInserter& operator++() { return *this; }
+  inline RedisNearCacheValueInserter& operator++(int) { return *this; }
+
+ protected:
+  RedisDirectValueInserter<Key> base;
+  const std::vector<sw::redis::StringView>* const k_views;
+  RedisNearCache<Key>* const near_cache;
+  const uint32_t table_id;
+  const size_t part_index;
+  const uint64_t generation;
+  size_t index{0};
+};
+
 /**
  * Optimized iterator to parse redis reponses for the `HMGET` command and directly
  * write them to a dump file.
@@ -347,6 +395,7 @@ class RedisBinFileInserter final
     sw::redis::Pipeline pipe{redis_->pipeline(hkey_v, false)};                                     \
     pipe.hdel(hkey_v, k_views.begin(), k_views.end());                                             \
     pipe.hdel(hkey_m, k_views.begin(), k_views.end());                                             \
+    pipe.incr(hkey_r);                                                                             \
                                                                                                    \
     sw::redis::QueuedReplies replies{pipe.exec()};                                                 \
     num_deletions += replies.get<long long>(0);                                                    \
@@ -401,6 +450,10 @@ class RedisBinFileInserter final
   [&]() {                                                                                          \
     static_assert(std::is_same_v<decltype(k_views), std::vector<sw::redis::StringView>>);          \
                                                                                                    \
+    if (near_cache_) {                                                                             \
+      return HCTR_HPS_REDIS_NEAR_CACHE_FETCH_(MODE);                                               \
+    }                                                                                              \
+                                                                                                   \
     k_views.clear();                                                                               \
     HCTR_HPS_DB_APPLY_(MODE, k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key))); \
                                                                                                    \
@@ -412,6 +465,84 @@ class RedisBinFileInserter final
   }()
 #endif
 
+/**
+ * Redis Backend / Fetch via near cache
+ *
+ * Keys are first looked up in the near cache. The remaining keys are fetched from Redis, together
+ * with the version of the partition. If the version differs from the version against which the
+ * cached values were validated, the keys served from the near cache are fetched again.
+ */
+#ifdef HCTR_HPS_REDIS_NEAR_CACHE_FETCH_
+#error HCTR_HPS_REDIS_NEAR_CACHE_FETCH_ already defined. Potential naming conflict!
+#endif
+#define HCTR_HPS_REDIS_NEAR_CACHE_FETCH_(MODE)                                                  \
+  [&]() {                                                                                       \
+    static_assert(std::is_same_v<decltype(k_views), std::vector<sw::redis::StringView>>);       \
+    static_assert(std::is_same_v<decltype(hit_views), std::vector<sw::redis::StringView>>);     \
+    static_assert(std::is_same_v<decltype(near_cache_table_id), const uint32_t>);               \
+                                                                                                \
+    const auto snapshot{near_cache_->snapshot(near_cache_table_id, part_index)};                \
+    k_views.clear();                                                                            \
+    hit_views.clear();                                                                          \
+    HCTR_HPS_DB_APPLY_(MODE, {                                                                  \
+      if (snapshot.version >= 0 &&                                                              \
+          near_cache_->find(near_cache_table_id, part_index, snapshot.generation, *k,           \
+                            &values[(k - keys) * value_stride], value_stride)) {                \
+        hit_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key));                  \
+      } else {                                                                                  \
+        k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key));                    \
+      }                                                                                         \
+    });                                                                                         \
+                                                                                                \
+    if (this->params_.overflow_policy != DatabaseOverflowPolicy_t::EvictRandom &&               \
+        !hit_views.empty()) {                                                                   \
+      if (!touched_keys) {                                                                      \
+        touched_keys = std::make_shared<std::vector<Key>>();                                    \
+      }                                                                                         \
+      for (const sw::redis::StringView& k_view : hit_views) {                                   \
+        touched_keys->emplace_back(*reinterpret_cast<const Key*>(k_view.data()));               \
+      }                                                                                         \
+    }                                                                                           \
+    if (k_views.empty() && snapshot.fresh) {                                                    \
+      return true;                                                                              \
+    }                                                                                           \
+                                                                                                \
+    /* Fetch the remaining keys along with the current version of the partition. */             \
+    const std::string& hkey_r{make_hkey(table_name, part_index, 'r')};                          \
+    sw::redis::Pipeline pipe{redis_->pipeline(hkey_v, false)};                                  \
+    pipe.get(hkey_r);                                                                           \
+    if (!k_views.empty()) {                                                                     \
+      pipe.hmget(hkey_v, k_views.begin(), k_views.end());                                       \
+    }                                                                                           \
+    sw::redis::QueuedReplies replies{pipe.exec()};                                              \
+                                                                                                \
+    const sw::redis::OptionalString& version_view{replies.get<sw::redis::OptionalString>(0)};   \
+    const long long version{version_view ? std::stoll(*version_view) : 0};                      \
+    const uint64_t generation{near_cache_->update(near_cache_table_id, part_index, version)};   \
+                                                                                                \
+    if (!k_views.empty()) {                                                                     \
+      replies.get(1, RedisNearCacheValueInserter<Key>(                                          \
+                         RedisDirectValueInserter<Key>(keys, k_views, values, value_stride,     \
+                                                       on_miss, miss_count,                     \
+                                                       this->params_.overflow_policy,           \
+                                                       touched_keys),                           \
+                         k_views, *near_cache_, near_cache_table_id, part_index, generation));  \
+    }                                                                                           \
+                                                                                                \
+    /* Cached values are outdated if the partition was modified in the meantime. */             \
+    if (version != snapshot.version && !hit_views.empty()) {                                    \
+      std::shared_ptr<std::vector<Key>> no_touched_keys;                                        \
+      redis_->hmget(hkey_v, hit_views.begin(), hit_views.end(),                                 \
+                    RedisNearCacheValueInserter<Key>(                                           \
+                        RedisDirectValueInserter<Key>(keys, hit_views, values, value_stride,    \
+                                                      on_miss, miss_count,                      \
+                                                      DatabaseOverflowPolicy_t::EvictRandom,    \
+                                                      no_touched_keys),                         \
+                        hit_views, *near_cache_, near_cache_table_id, part_index, generation)); \
+    }                                                                                           \
+    return true;                                                                                \
+  }()
+
 #ifdef HCTR_HPS_REDIS_INSERT_
 #error HCTR_HPS_REDIS_INSERT_ already defined. Potential naming conflict!
 #endif
@@ -467,10 +598,11 @@ class RedisBinFileInserter final
     }                                                                                          \
     pipe.hset(hkey_v, kv_views.begin(), kv_views.end());                                       \
     pipe.hlen(hkey_v);                                                                         \
+    pipe.incr(hkey_r);                                                                         \
                                                                                                \
     sw::redis::QueuedReplies replies{pipe.exec()};                                             \
-    num_inserts += std::max(replies.get<long long>(replies.size() - 2), 0LL);                  \
-    part_size = std::max(replies.get<long long>(replies.size() - 1), 0LL);                     \
+    num_inserts += std::max(replies.get<long long>(replies.size() - 3), 0LL);                  \
+    part_size = std::max(replies.get<long long>(replies.size() - 2), 0LL);                     \
     return true;                                                                               \
   }()
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <chrono>
+#include <core/macro.hpp>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Bounded, in-process cache for the values stored in a \p RedisClusterBackend .
+ *
+ * The cache has one shard per Redis partition. Shards evict entries using the CLOCK algorithm.
+ *
+ * Each Redis partition has a version counter, which is incremented by every modification. The
+ * cache remembers the last version observed for each partition, and tags entries with a local
+ * generation number that changes whenever this version changes. Hence, entries become invalid as
+ * soon as a newer version is observed. Versions are only verified when talking to Redis anyway, or
+ * once \p max_staleness has passed since the last verification.
+ *
+ * @tparam Key Data-type of the keys.
+ */
+template <typename Key>
+class RedisNearCache final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(RedisNearCache);
+
+  RedisNearCache() = delete;
+
+  /**
+   * @param capacity Maximum combined size of the cached values in bytes.
+   * @param num_partitions Number of partitions of each table (i.e., number of shards).
+   * @param max_staleness Period for which cached values may be used without verifying the version
+   * of their partition.
+   */
+  RedisNearCache(size_t capacity, size_t num_partitions, std::chrono::nanoseconds max_staleness);
+
+  /**
+   * State of a partition, as seen by a lookup.
+   */
+  struct Snapshot final {
+    long long version;    // Last observed version (-1 = unknown).
+    uint64_t generation;  // Entries with this generation are consistent with \p version .
+    bool fresh;           // If \p true , \p version was verified less than max_staleness ago.
+  };
+
+  /**
+   * @return Handle that identifies the table in the other functions.
+   */
+  uint32_t table_id(const std::string& table_name);
+
+  Snapshot snapshot(uint32_t table_id, size_t part_index) const;
+
+  /**
+   * Copies a cached value to \p value , if an entry with the given \p generation exists.
+   *
+   * @return Size of the value in bytes (0 = not found).
+   */
+  size_t find(uint32_t table_id, size_t part_index, uint64_t generation, const Key& key,
+              char* value, size_t value_stride);
+
+  /**
+   * Records the \p version of a partition that was just read from Redis.
+   *
+   * @return The generation of the entries that are consistent with \p version .
+   */
+  uint64_t update(uint32_t table_id, size_t part_index, long long version);
+
+  /**
+   * Caches a value that was read from Redis after the version of generation \p generation . The
+   * value is dropped if the partition changed in the meantime.
+   */
+  void insert(uint32_t table_id, size_t part_index, uint64_t generation, const Key& key,
+              const char* value, size_t value_size);
+
+  /**
+   * Invalidates all entries of a partition (e.g., after modifying the partition).
+   */
+  void invalidate(uint32_t table_id, size_t part_index);
+
+  /**
+   * @return Combined size of the cached values in bytes.
+   */
+  size_t size() const;
+
+ private:
+  using EntryKey = std::pair<uint32_t, Key>;
+
+  struct EntryKeyHash final {
+    inline size_t operator()(const EntryKey& k) const {
+      return std::hash<Key>{}(k.second) * 31 + k.first;
+    }
+  };
+
+  struct Entry final {
+    EntryKey key;
+    uint64_t generation;
+    bool used{false};
+    bool referenced{false};
+    std::vector<char> value;
+  };
+
+  struct Partition final {
+    long long version{-1};
+    uint64_t generation{0};
+    std::chrono::steady_clock::time_point verified;
+  };
+
+  struct Shard final {
+    mutable std::mutex barrier;
+    phmap::flat_hash_map<uint32_t, Partition> partitions;
+
+    phmap::flat_hash_map<EntryKey, size_t, EntryKeyHash> index;
+    std::vector<Entry> entries;
+    std::vector<size_t> free_entries;
+    size_t hand{0};
+    size_t size{0};
+
+    void erase(size_t entry_index);
+
+    void evict_one();
+  };
+
+  const size_t capacity_;  // Per shard.
+  const std::chrono::nanoseconds max_staleness_;
+
+  std::vector<Shard> shards_;
+
+  mutable std::shared_mutex table_ids_guard_;
+  std::unordered_map<std::string, uint32_t> table_ids_;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
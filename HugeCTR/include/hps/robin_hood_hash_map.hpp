@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <core/macro.hpp>
+#include <cstdint>
+#include <hps/database_backend_detail.hpp>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Default hash function for \p RobinHoodHashMap . Uses the same mixer as the partitioning logic of
+ * the database backends. The map consumes the upper half of the hash first, so that the bucket
+ * index is not correlated with the partition index.
+ */
+template <typename Key>
+struct RobinHoodHash final {
+  inline uint64_t operator()(const Key& key) const {
+    return rotr64(rrxmrrxmsx_0(static_cast<uint64_t>(key)), 32);
+  }
+};
+
+/**
+ * Open-addressing hash map that uses linear probing with Robin Hood displacement and backward-shift
+ * deletion. Inserting or erasing an entry costs amortized O(1) and entries are stored inline in a
+ * single bucket array.
+ *
+ * All storage is obtained through \p Allocator and referenced through its \p pointer type. Hence,
+ * if a boost::interprocess allocator is supplied, the map is position independent and can be placed
+ * in shared memory.
+ *
+ * The map itself is not thread-safe. However, it tolerates optimistic readers that validate their
+ * results through an external sequence counter (see \p HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_ ). To
+ * this end, \p find never probes beyond the bounds of a published bucket array, and bucket arrays
+ * that were replaced during a rehash are only released after the next rehash.
+ *
+ * @tparam Key Type of the keys. Must be trivially copyable.
+ * @tparam T Type of the mapped values. Must be default constructible.
+ */
+template <typename Key, typename T, typename Allocator = std::allocator<std::pair<Key, T>>,
+          typename Hash = RobinHoodHash<Key>>
+class RobinHoodHashMap final {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using size_type = size_t;
+  using allocator_type = Allocator;
+
+  static constexpr size_t min_capacity{16};
+  static constexpr size_t max_load_factor_num{4};
+  static constexpr size_t max_load_factor_den{5};
+
+ private:
+  struct Bucket final {
+    uint32_t dist;  // 0 = empty, otherwise length of the probe sequence + 1.
+    value_type value;
+  };
+  using BucketAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Bucket>;
+  using BucketTraits = std::allocator_traits<BucketAllocator>;
+  using BucketPtr = typename BucketTraits::pointer;
+
+  template <bool IS_CONST>
+  class basic_iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = RobinHoodHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IS_CONST, const value_type*, value_type*>;
+    using reference = std::conditional_t<IS_CONST, const value_type&, value_type&>;
+
+    basic_iterator() = default;
+
+    basic_iterator(Bucket* const pos, Bucket* const end) : pos_{pos}, end_{end} { skip_empty_(); }
+
+    template <bool OTHER_IS_CONST, typename = std::enable_if_t<IS_CONST && !OTHER_IS_CONST>>
+    basic_iterator(const basic_iterator<OTHER_IS_CONST>& other)
+        : pos_{other.pos_}, end_{other.end_} {}
+
+    inline reference operator*() const { return pos_->value; }
+
+    inline pointer operator->() const { return &pos_->value; }
+
+    inline basic_iterator& operator++() {
+      ++pos_;
+      skip_empty_();
+      return *this;
+    }
+
+    inline basic_iterator operator++(int) {
+      basic_iterator tmp{*this};
+      ++*this;
+      return tmp;
+    }
+
+    inline bool operator==(const basic_iterator& other) const { return pos_ == other.pos_; }
+
+    inline bool operator!=(const basic_iterator& other) const { return pos_ != other.pos_; }
+
+   private:
+    friend class RobinHoodHashMap;
+    template <bool>
+    friend class basic_iterator;
+
+    // `end()` is represented by `nullptr`, which keeps comparisons valid for optimistic readers
+    // that observed an outdated bucket array.
+    Bucket* pos_{};
+    Bucket* end_{};
+
+    inline void skip_empty_() {
+      for (; pos_ != end_; ++pos_) {
+        if (pos_->dist) {
+          return;
+        }
+      }
+      pos_ = nullptr;
+    }
+  };
+
+ public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  HCTR_DISALLOW_COPY(RobinHoodHashMap);
+
+  explicit RobinHoodHashMap(const Allocator& alloc = Allocator())
+      : alloc_(alloc), buckets_{}, retired_buckets_{}, retired_capacity_{0} {}
+
+  /**
+   * Move construction is only safe if there are no concurrent readers.
+   */
+  RobinHoodHashMap(RobinHoodHashMap&& other) noexcept
+      : alloc_(std::move(other.alloc_)),
+        buckets_{other.buckets_},
+        retired_buckets_{other.retired_buckets_},
+        retired_capacity_{other.retired_capacity_},
+        capacity_{other.capacity_.load(std::memory_order_relaxed)},
+        size_{other.size_.load(std::memory_order_relaxed)} {
+    other.buckets_ = nullptr;
+    other.retired_buckets_ = nullptr;
+    other.retired_capacity_ = 0;
+    other.capacity_.store(0, std::memory_order_relaxed);
+    other.size_.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * Move assignment is only safe if there are no concurrent readers. Both maps must use equal
+   * allocators.
+   */
+  RobinHoodHashMap& operator=(RobinHoodHashMap&& other) noexcept {
+    if (this != &other) {
+      clear();
+      buckets_ = other.buckets_;
+      retired_buckets_ = other.retired_buckets_;
+      retired_capacity_ = other.retired_capacity_;
+      capacity_.store(other.capacity_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      size_.store(other.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+      other.buckets_ = nullptr;
+      other.retired_buckets_ = nullptr;
+      other.retired_capacity_ = 0;
+      other.capacity_.store(0, std::memory_order_relaxed);
+      other.size_.store(0, std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  ~RobinHoodHashMap() { clear(); }
+
+  inline size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  inline bool empty() const { return size() == 0; }
+
+  inline size_t capacity() const { return capacity_.load(std::memory_order_relaxed); }
+
+  inline iterator begin() { return {raw_(buckets_), raw_(buckets_) + capacity()}; }
+  inline const_iterator begin() const { return {raw_(buckets_), raw_(buckets_) + capacity()}; }
+
+  inline iterator end() { return {}; }
+  inline const_iterator end() const { return {}; }
+
+  inline iterator find(const Key& key) {
+    Bucket* const b{find_(key)};
+    return b ? iterator{b, b + 1} : end();
+  }
+
+  inline const_iterator find(const Key& key) const {
+    Bucket* const b{find_(key)};
+    return b ? const_iterator{b, b + 1} : end();
+  }
+
+  inline bool contains(const Key& key) const { return find_(key) != nullptr; }
+
+  /**
+   * Hash value of \p key . Allows batched lookups to separate hashing from probing.
+   */
+  static inline uint64_t hash(const Key& key) { return Hash()(key); }
+
+  /**
+   * Hints the CPU to load the home bucket of a key with the given \p hash into the cache.
+   */
+  inline void prefetch(const uint64_t hash) const {
+    const size_t capacity{capacity_.load(std::memory_order_acquire)};
+    if (capacity) {
+      __builtin_prefetch(&raw_(buckets_)[hash & (capacity - 1)]);
+    }
+  }
+
+  /**
+   * Same as `find(key)`, but with a precomputed `hash(key)` .
+   */
+  inline iterator find(const Key& key, const uint64_t hash) {
+    Bucket* const b{find_(key, hash)};
+    return b ? iterator{b, b + 1} : end();
+  }
+
+  inline const_iterator find(const Key& key, const uint64_t hash) const {
+    Bucket* const b{find_(key, hash)};
+    return b ? const_iterator{b, b + 1} : end();
+  }
+
+  /**
+   * Inserts a default constructed value for \p key , if \p key is not yet present.
+   *
+   * @return Iterator pointing to the entry, and flag indicating whether it was inserted.
+   */
+  std::pair<iterator, bool> try_emplace(const Key& key) {
+    if (Bucket* const b{find_(key)}) {
+      return {iterator{b, b + 1}, false};
+    }
+
+    size_t capacity{this->capacity()};
+    if ((size() + 1) * max_load_factor_den > capacity * max_load_factor_num) {
+      rehash(std::max(capacity * 2, min_capacity));
+      capacity = this->capacity();
+    }
+
+    Bucket* const b{emplace_(raw_(buckets_), capacity - 1, Bucket{1, value_type{key, T{}}})};
+    size_.store(size() + 1, std::memory_order_relaxed);
+    return {iterator{b, b + 1}, true};
+  }
+
+  /**
+   * Removes the entry referenced by \p it . Subsequent entries of the same probe sequence are
+   * shifted backwards, which invalidates all iterators.
+   */
+  void erase(const const_iterator& it) {
+    Bucket* const buckets{raw_(buckets_)};
+    const size_t mask{capacity() - 1};
+
+    for (size_t i{static_cast<size_t>(it.pos_ - buckets)};;) {
+      const size_t j{(i + 1) & mask};
+      if (buckets[j].dist <= 1) {
+        buckets[i].dist = 0;
+        break;
+      }
+      buckets[i] = std::move(buckets[j]);
+      --buckets[i].dist;
+      i = j;
+    }
+    size_.store(size() - 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Resizes the bucket array to (at least) \p new_capacity buckets and redistributes all entries.
+   * The previous bucket array is retained until the next rehash, to give optimistic readers that
+   * might still be probing it a grace period.
+   */
+  void rehash(size_t new_capacity) {
+    new_capacity = next_pow2_(std::max(new_capacity, min_capacity));
+    const size_t old_capacity{capacity()};
+    if (new_capacity <= old_capacity) {
+      return;
+    }
+
+    const BucketPtr new_buckets{allocate_(new_capacity)};
+    {
+      Bucket* const dst{raw_(new_buckets)};
+      Bucket* const src{raw_(buckets_)};
+      for (Bucket* b{src}; b != &src[old_capacity]; ++b) {
+        if (b->dist) {
+          emplace_(dst, new_capacity - 1, Bucket{1, std::move(b->value)});
+        }
+      }
+    }
+
+    // Release the array retired in the previous cycle, and retire the current one.
+    deallocate_(retired_buckets_, retired_capacity_);
+    retired_buckets_ = buckets_;
+    retired_capacity_ = old_capacity;
+
+    // Publish the new array. Readers load `capacity_` first, so the array is at least that large.
+    buckets_ = new_buckets;
+    capacity_.store(new_capacity, std::memory_order_release);
+  }
+
+  inline void reserve(const size_t n) {
+    rehash((n * max_load_factor_den + max_load_factor_num - 1) / max_load_factor_num);
+  }
+
+  /**
+   * Removes all entries and releases all memory. Must not be called while there are readers.
+   */
+  void clear() {
+    deallocate_(retired_buckets_, retired_capacity_);
+    retired_buckets_ = nullptr;
+    retired_capacity_ = 0;
+
+    deallocate_(buckets_, capacity());
+    buckets_ = nullptr;
+    capacity_.store(0, std::memory_order_release);
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  BucketAllocator alloc_;
+  BucketPtr buckets_;
+  BucketPtr retired_buckets_;
+  size_t retired_capacity_;
+  std::atomic<size_t> capacity_{0};
+  std::atomic<size_t> size_{0};
+
+  static inline Bucket* raw_(const BucketPtr& p) { return p ? &*p : nullptr; }
+
+  static inline size_t next_pow2_(size_t n) {
+    --n;
+    for (size_t shift{1}; shift < 8 * sizeof(size_t); shift *= 2) {
+      n |= n >> shift;
+    }
+    return n + 1;
+  }
+
+  BucketPtr allocate_(const size_t n) {
+    const BucketPtr p{BucketTraits::allocate(alloc_, n)};
+    std::uninitialized_value_construct_n(raw_(p), n);
+    return p;
+  }
+
+  void deallocate_(const BucketPtr& p, const size_t n) {
+    if (p) {
+      std::destroy_n(raw_(p), n);
+      BucketTraits::deallocate(alloc_, p, n);
+    }
+  }
+
+  inline Bucket* find_(const Key& key) const { return find_(key, Hash()(key)); }
+
+  Bucket* find_(const Key& key, const uint64_t hash) const {
+    // Load capacity before the array to never exceed the bounds of the array (see `rehash`).
+    const size_t capacity{capacity_.load(std::memory_order_acquire)};
+    if (!capacity) {
+      return nullptr;
+    }
+    Bucket* const buckets{raw_(buckets_)};
+    const size_t mask{capacity - 1};
+
+    size_t i{hash & mask};
+    for (size_t dist{1}; dist <= capacity; ++dist) {
+      Bucket& b{buckets[i]};
+      // Robin Hood invariant: Our key would have displaced any entry closer to its home bucket.
+      if (b.dist < dist) {
+        break;
+      }
+      if (b.value.first == key) {
+        return &b;
+      }
+      i = (i + 1) & mask;
+    }
+    return nullptr;
+  }
+
+  static Bucket* emplace_(Bucket* const buckets, const size_t mask, Bucket&& bucket) {
+    Bucket* result{nullptr};
+
+    for (size_t i{Hash()(bucket.value.first) & mask};; i = (i + 1) & mask) {
+      Bucket& b{buckets[i]};
+      if (!b.dist) {
+        b = std::move(bucket);
+        return result ? result : &b;
+      }
+      if (b.dist < bucket.dist) {
+        std::swap(b, bucket);
+        if (!result) {
+          result = &b;
+        }
+      }
+      ++bucket.dist;
+    }
+  }
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
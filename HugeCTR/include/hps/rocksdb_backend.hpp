@@ -17,9 +17,12 @@
 
 #include <rocksdb/db.h>
 
+#include <atomic>
 #include <filesystem>
+#include <functional>
 #include <hps/database_backend.hpp>
 #include <hps/database_backend_detail.hpp>
+#include <hps/value_codec.hpp>
 #include <unordered_map>
 
 namespace HugeCTR {
@@ -34,6 +37,21 @@ struct RocksDBBackendParams final : public PersistentBackendParams {
   bool read_only{
       false};  // If \p true will open the database in \p read-only mode. This allows simultaneously
                // querying the same RocksDB database from multiple clients.
+  DatabaseValueCodec_t value_codec{
+      DatabaseValueCodec_t::Float32};  // Format in which values are stored. Must not be changed
+                                       // once the database contains data.
+  size_t block_cache_size{8L * 1024 * 1024};  // Size of the LRU block cache that is shared by all
+                                              // tables (0 = no block cache).
+  double bloom_filter_bits_per_key{10};  // Bits per key of the bloom filters (0 = no filters).
+  bool partitioned_filters{false};  // Partition index and filter blocks and keep them in the block
+                                    // cache. Bounds the memory required for very large databases.
+  bool use_direct_reads{false};  // Use direct I/O for reads (i.e., bypass the OS page cache).
+  size_t num_lookup_tasks{1};    // Batches of large queries are distributed across up to this
+                                 // many tasks, which issue their \p MultiGet requests concurrently.
+  size_t max_bulk_batch_size{16L * 1024 * 1024};  // Maximum number of pairs per bulk insertion
+                                                  // when loading dumps.
+  size_t bulk_file_size{256L * 1024 * 1024};  // Target size of the SST files written by bulk
+                                              // insertions.
 };
 
 /**
@@ -70,6 +88,13 @@ class RocksDBBackend final : public PersistentBackend<Key, RocksDBBackendParams>
   size_t insert(const std::string& table_name, size_t num_pairs, const Key* keys,
                 const char* values, uint32_t value_size, size_t value_stride) override;
 
+  /**
+   * Sorts the pairs in parallel, writes them to external SST files (in parallel), and then ingests
+   * these files into the database. This bypasses the memtable, the WAL and most of the compaction.
+   */
+  size_t bulk_insert(const std::string& table_name, size_t num_pairs, const Key* keys,
+                     const char* values, uint32_t value_size, size_t value_stride) override;
+
   size_t fetch(const std::string& table_name, size_t num_keys, const Key* keys, char* values,
                size_t value_stride, const DatabaseMissCallback& on_miss,
                const std::chrono::nanoseconds& time_budget) override;
@@ -92,6 +117,15 @@ class RocksDBBackend final : public PersistentBackend<Key, RocksDBBackendParams>
   size_t load_dump_sst(const std::string& table_name, const std::string& path) override;
 
  protected:
+  size_t max_bulk_batch_size() const override { return this->params_.max_bulk_batch_size; }
+
+  /**
+   * Splits \p num_items into ranges of whole batches, and calls \p fn(first, last) for each of
+   * them. Up to \p num_lookup_tasks ranges are processed concurrently.
+   */
+  void for_each_lookup_range_(size_t num_items,
+                              const std::function<void(size_t, size_t)>& fn) const;
+
   inline rocksdb::ColumnFamilyHandle* get_column_handle_(const std::string& table_name) const {
     const auto& it{column_handles_.find(table_name)};
     return it != column_handles_.end() ? it->second : nullptr;
@@ -112,10 +146,13 @@ class RocksDBBackend final : public PersistentBackend<Key, RocksDBBackendParams>
   std::unique_ptr<rocksdb::DB> db_;
   std::unordered_map<std::string, rocksdb::ColumnFamilyHandle*> column_handles_;
 
+  const ValueCodec codec_;
+
   rocksdb::ColumnFamilyOptions column_family_options_;
   rocksdb::ReadOptions read_options_;
   rocksdb::WriteOptions write_options_;
   rocksdb::IngestExternalFileOptions ingest_file_options_;
+  std::atomic<size_t> num_bulk_inserts_{0};
 };
 
 // TODO: Remove me!
@@ -53,8 +53,9 @@ namespace HugeCTR {
       const rocksdb::Status& s{statuses[idx]};                                                     \
       if (s.ok()) {                                                                                \
         const std::string& v_view{v_views[idx]};                                                   \
-        HCTR_CHECK(v_view.size() <= value_stride);                                                 \
-        std::copy(v_view.begin(), v_view.end(), &values[(k - keys) * value_stride]);               \
+        const size_t value_size{codec_.decoded_size(v_view.size())};                               \
+        HCTR_CHECK(value_size <= value_stride);                                                    \
+        codec_.decode(v_view.data(), value_size, &values[(k - keys) * value_stride]);              \
       } else if (s.IsNotFound()) {                                                                 \
         on_miss(k - keys);                                                                         \
         ++miss_count;                                                                              \
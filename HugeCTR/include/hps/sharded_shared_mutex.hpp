@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <core/macro.hpp>
+#include <cstddef>
+#include <shared_mutex>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Reader/writer lock that is split into per-thread shards. Readers only acquire the shard of the
+ * calling thread, which resides in a separate cache line. Hence, as long as there are no more
+ * concurrent threads than shards, readers never contend on a shared lock word. Writers, in turn,
+ * have to acquire all shards, which makes exclusive locking considerably more expensive.
+ *
+ * Satisfies the *SharedMutex* requirements, so that \p std::shared_lock and \p std::unique_lock
+ * can be used.
+ */
+class ShardedSharedMutex final {
+ public:
+  static constexpr size_t num_shards{64};
+
+  HCTR_DISALLOW_COPY_AND_MOVE(ShardedSharedMutex);
+
+  ShardedSharedMutex() = default;
+
+  /**
+   * Sequential index of the calling thread. Stable for the lifetime of the thread.
+   */
+  static inline size_t this_thread_index() {
+    static std::atomic<size_t> next_index{0};
+    thread_local const size_t index{next_index.fetch_add(1, std::memory_order_relaxed)};
+    return index;
+  }
+
+  /**
+   * Shard that is used by the calling thread.
+   */
+  static inline size_t this_thread_shard() { return this_thread_index() % num_shards; }
+
+  inline void lock_shared() { shards_[this_thread_shard()].mutex.lock_shared(); }
+
+  inline bool try_lock_shared() { return shards_[this_thread_shard()].mutex.try_lock_shared(); }
+
+  inline void unlock_shared() { shards_[this_thread_shard()].mutex.unlock_shared(); }
+
+  void lock() {
+    for (Shard& shard : shards_) {
+      shard.mutex.lock();
+    }
+  }
+
+  bool try_lock() {
+    for (auto it{shards_.begin()}; it != shards_.end(); ++it) {
+      if (!it->mutex.try_lock()) {
+        while (it != shards_.begin()) {
+          (--it)->mutex.unlock();
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void unlock() {
+    for (auto it{shards_.rbegin()}; it != shards_.rend(); ++it) {
+      it->mutex.unlock();
+    }
+  }
+
+  /**
+   * Waits until all readers that were active when calling this function have released their lock.
+   * Afterwards, resources that have been unpublished before the call can be reclaimed safely. Must
+   * not be called while the calling thread holds a shared lock.
+   */
+  void synchronize() {
+    for (Shard& shard : shards_) {
+      shard.mutex.lock();
+      shard.mutex.unlock();
+    }
+  }
+
+ private:
+  struct alignas(64) Shard final {
+    std::shared_mutex mutex;
+  };
+
+  std::array<Shard, num_shards> shards_;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
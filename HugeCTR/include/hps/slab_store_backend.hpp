@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <functional>
+#include <hps/database_backend.hpp>
+#include <hps/database_backend_detail.hpp>
+#include <hps/value_codec.hpp>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread_pool.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+struct SlabStoreBackendParams final : public PersistentBackendParams {
+  std::string path{"/tmp/slab_store"};  // Directory that contains the slab files.
+  bool read_only{false};                // If \p true , the slab files are not modified.
+  DatabaseValueCodec_t value_codec{
+      DatabaseValueCodec_t::Float32};  // Format in which values of new tables are stored.
+  bool use_direct_reads{true};  // Read with O_DIRECT (i.e., bypass the OS page cache), if the
+                                // file system supports it.
+  size_t num_lookup_tasks{4};   // Batches of large queries are distributed across up to this
+                                // many tasks, which issue their reads concurrently.
+  size_t io_depth{64};          // Maximum number of reads that each lookup task keeps in flight.
+  double compaction_threshold{0.5};  // Compact slab files in the background, once more than this
+                                     // fraction of their rows is outdated.
+};
+
+class SlabReader;
+
+/**
+ * \p DatabaseBackend implementation that stores fixed-size values in slab files on local
+ * (preferably solid-state) storage. Each table is a log of fixed-stride rows, which is indexed by
+ * an in-memory hash map. Hence, each lookup that hits costs exactly one read, which is issued
+ * asynchronously alongside the other reads of the same batch. Writes are appended to the log.
+ * Outdated rows are removed by compaction in the background.
+ *
+ * @tparam Key The data-type that is used for keys in this database.
+ */
+template <typename Key>
+class SlabStoreBackend final : public PersistentBackend<Key, SlabStoreBackendParams> {
+ public:
+  using Base = PersistentBackend<Key, SlabStoreBackendParams>;
+
+  HCTR_DISALLOW_COPY_AND_MOVE(SlabStoreBackend);
+
+  SlabStoreBackend() = delete;
+
+  /**
+   * Construct a new SlabStoreBackend object. Existing slab files in \p params.path are opened,
+   * and their indices are rebuilt.
+   */
+  SlabStoreBackend(const SlabStoreBackendParams& params);
+
+  virtual ~SlabStoreBackend();
+
+  const char* get_name() const override { return "SlabStore"; }
+
+  bool is_shared() const override { return false; }
+
+  size_t size(const std::string& table_name) const override;
+
+  size_t contains(const std::string& table_name, size_t num_keys, const Key* keys,
+                  const std::chrono::nanoseconds& time_budget) const override;
+
+  size_t insert(const std::string& table_name, size_t num_pairs, const Key* keys,
+                const char* values, uint32_t value_size, size_t value_stride) override;
+
+  size_t fetch(const std::string& table_name, size_t num_keys, const Key* keys, char* values,
+               size_t value_stride, const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t fetch(const std::string& table_name, size_t num_indices, const size_t* indices,
+               const Key* keys, char* values, size_t value_stride,
+               const DatabaseMissCallback& on_miss,
+               const std::chrono::nanoseconds& time_budget) override;
+
+  size_t evict(const std::string& table_name) override;
+
+  size_t evict(const std::string& table_name, size_t num_keys, const Key* keys) override;
+
+  std::vector<std::string> find_tables(const std::string& model_name) override;
+
+  size_t dump_bin(const std::string& table_name, std::ofstream& file) override;
+
+  size_t dump_sst(const std::string& table_name, rocksdb::SstFileWriter& file) override;
+
+  /**
+   * Rewrites the slab file of a table, so that it only contains the current rows. Usually
+   * triggered automatically (see \p compaction_threshold ).
+   *
+   * @return Number of rows that were removed.
+   */
+  size_t compact(const std::string& table_name);
+
+  /**
+   * @return Size of the slab file of a table in bytes.
+   */
+  size_t file_size(const std::string& table_name) const;
+
+ protected:
+  struct Table final {
+    std::string path;
+    uint32_t value_size;  // Size of decoded values.
+    ValueCodec codec;
+    size_t row_size;
+
+    int fd{-1};       // Used for writing, and reading outside of lookups.
+    int read_fd{-1};  // Used by lookups. Opened with O_DIRECT, if possible.
+    size_t num_rows{0};
+    phmap::flat_hash_map<Key, uint64_t> index;  // Key -> row.
+    bool compaction_pending{false};
+
+    // Lookups share access. Writers require exclusive access.
+    mutable std::shared_mutex guard;
+    // Held while compacting. Compactions of the same table run one at a time.
+    std::mutex compaction_guard;
+
+    Table(const std::string& path, uint32_t value_size, DatabaseValueCodec_t value_codec);
+  };
+
+  // Actual data. Altering the table map requires exclusive access.
+  std::unordered_map<std::string, std::unique_ptr<Table>> tables_;
+  mutable std::shared_mutex tables_guard_;
+
+  // Asynchronous I/O contexts are expensive to set up. Hence, they are recycled.
+  mutable std::mutex readers_guard_;
+  mutable std::vector<std::unique_ptr<SlabReader>> idle_readers_;
+
+  ThreadPool compaction_worker_{"slab compaction", 1};
+
+  inline Table* get_table_(const std::string& table_name) const {
+    const auto& it{tables_.find(table_name)};
+    return it != tables_.end() ? it->second.get() : nullptr;
+  }
+
+  // Opens the slab file of a table. Creates it, if \p value_size > 0 .
+  std::unique_ptr<Table> open_table_(const std::string& path, uint32_t value_size) const;
+
+  // (Re)opens the file descriptor used by lookups.
+  void open_read_fd_(Table& table) const;
+
+  // Appends rows to the slab file. Requires exclusive access to the table.
+  void append_rows_(Table& table, const char* rows, size_t num_rows) const;
+
+  // Reads a row, and decodes its value. Requires shared access to the table.
+  void read_value_(const Table& table, uint64_t row, char* value) const;
+
+  // Schedules compaction if too many rows are outdated. Requires exclusive access to the table.
+  void maybe_schedule_compaction_(const std::string& table_name, Table& table);
+
+  // Runs \p fn(reader, first, last) for ranges of whole batches. Up to \p num_lookup_tasks ranges
+  // are processed concurrently.
+  void for_each_lookup_range_(size_t num_items,
+                              const std::function<void(SlabReader&, size_t, size_t)>& fn) const;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
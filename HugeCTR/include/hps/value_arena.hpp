@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <core/macro.hpp>
+#include <cstdint>
+#include <hps/inference_utils.hpp>
+#include <map>
+#include <ostream>
+#include <set>
+#include <vector>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Memory usage of one or more \p ValueArena objects.
+ */
+struct ValueArenaStats final {
+  size_t num_pages{0};
+  size_t num_resident_pages{0};
+  size_t reserved_bytes{0};  // Address space of all pages.
+  size_t resident_bytes{0};  // Memory of pages that were not released to the OS.
+  size_t used_bytes{0};      // Memory occupied by live values (including padding).
+
+  /**
+   * Fraction of the resident memory that is not occupied by live values.
+   */
+  double fragmentation() const {
+    return resident_bytes
+               ? 1. - static_cast<double>(used_bytes) / static_cast<double>(resident_bytes)
+               : 0.;
+  }
+
+  ValueArenaStats& operator+=(const ValueArenaStats& other);
+};
+
+std::ostream& operator<<(std::ostream& os, const ValueArenaStats& stats);
+
+/**
+ * Pooled storage for fixed-size values. Memory is obtained from the OS in large pages via `mmap`,
+ * which can optionally be backed by huge pages, and be placed on a preferred NUMA node.
+ *
+ * Pages are carved into slots. New values are placed into the lowest numbered page that has free
+ * slots. Hence, the higher numbered pages tend to drain over time. Pages that no longer contain any
+ * live values are released to the OS, but their address range remains mapped. Thus, pointers into
+ * released pages can still be read (they yield zeroes) until the arena is destroyed. Lock-free
+ * readers that validate their results afterwards rely on this property.
+ *
+ * Compaction moves the values of sparsely occupied pages into the remaining pages (see
+ * \p begin_compaction ). Since the arena does not know who references its values, the owner has to
+ * relocate them.
+ *
+ * The arena is not thread-safe.
+ */
+class ValueArena final {
+ public:
+  HCTR_DISALLOW_COPY(ValueArena);
+
+  ValueArena() = delete;
+
+  /**
+   * @param value_size Size of each value in bytes.
+   * @param value_alignment Alignment of each value. Must be a power of 2.
+   * @param page_size Preferred amount of memory to obtain from the OS at once (rounded up).
+   * @param huge_pages How to back pages with huge pages.
+   * @param numa_node Preferred NUMA node, or `-1` to use the default policy of the process.
+   */
+  ValueArena(size_t value_size, size_t value_alignment, size_t page_size,
+             DatabaseHugePages_t huge_pages, int numa_node);
+
+  ValueArena(ValueArena&& other) noexcept;
+
+  ValueArena& operator=(ValueArena&& other) noexcept;
+
+  ~ValueArena();
+
+  inline size_t value_size() const { return value_size_; }
+
+  inline size_t slot_size() const { return slot_size_; }
+
+  inline size_t page_size() const { return page_size_; }
+
+  inline size_t slots_per_page() const { return slots_per_page_; }
+
+  /**
+   * Obtains a slot for a value.
+   */
+  char* allocate();
+
+  /**
+   * Returns a slot that was obtained through \p allocate .
+   */
+  void release(char* value);
+
+  /**
+   * Selects the highest numbered pages whose values fit into the free slots of the remaining pages,
+   * and excludes them from further allocations. The owner should then move all values for which
+   * \p is_draining yields `true` to new slots, and \p release the old ones. Drained pages are
+   * released to the OS.
+   *
+   * @param threshold Only compact if the arena's fragmentation exceeds this value.
+   *
+   * @return Number of values that need to be moved.
+   */
+  size_t begin_compaction(double threshold);
+
+  /**
+   * Whether the value is located in a page selected by \p begin_compaction .
+   */
+  bool is_draining(const char* value) const;
+
+  /**
+   * Makes pages that could not be drained available for allocation again.
+   */
+  void end_compaction();
+
+  ValueArenaStats stats() const;
+
+  /**
+   * Adopts \p num_values values that are stored in a file, starting at \p offset . The file must be
+   * laid out like the pages of this arena (i.e., \p slots_per_page values per \p page_size bytes).
+   * Pages are mapped privately. Hence, values are only read from the file once accessed, and
+   * modifications are copied on write. The file must not be truncated while the arena exists.
+   *
+   * @return Address of each adopted page. Value `i` is stored in slot `i % slots_per_page` of page
+   * `i / slots_per_page`.
+   */
+  std::vector<char*> map_image(int fd, size_t offset, size_t num_values);
+
+  /**
+   * NUMA node on which the memory for partition \p part_index should be placed, or `-1` if NUMA
+   * aware placement is not possible.
+   */
+  static int numa_node_for_partition(size_t part_index);
+
+ private:
+  struct Page final {
+    char* data;
+    uint32_t num_used;
+    uint32_t num_untouched;  // Slots at the end of the page that were never used.
+    std::vector<uint32_t> free_slots;
+    bool resident;
+    bool draining;
+  };
+
+  size_t value_size_;
+  size_t slot_size_;
+  size_t page_size_;
+  uint32_t slots_per_page_;
+  DatabaseHugePages_t huge_pages_;
+  int numa_node_;
+
+  std::vector<Page> pages_;
+  std::map<const char*, size_t> page_indices_;  // Base address -> page index.
+  std::set<size_t> open_pages_;                 // Resident pages that have free slots.
+  std::vector<size_t> released_pages_;
+  size_t num_used_{0};
+
+  size_t page_index_(const char* value) const;
+  void map_page_();
+  void release_page_(size_t page_index);
+  void unmap_pages_();
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
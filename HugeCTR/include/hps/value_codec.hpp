@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <hps/inference_utils.hpp>
+
+namespace HugeCTR {
+
+// TODO: Remove me!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wconversion"
+
+/**
+ * Converts values (i.e., `float` vectors) from and to the format in which a database stores them.
+ *
+ * - `Float32`: Values are stored as is. Applicable to values of any size.
+ * - `Float16` / `BFloat16`: Each element is rounded to the nearest 16 bit floating point number.
+ * - `Int8`: Each value is stored as `[scale, bias, q_0, q_1, ...]`, where `scale` and `bias` are
+ *   `float`s and the `q_i` are `uint8_t`s, such that `x_i ~= bias + scale * q_i`.
+ *
+ * Encoded values are not aligned. Hence, encoded values can be placed anywhere in memory.
+ */
+class ValueCodec final {
+ public:
+  ValueCodec(const DatabaseValueCodec_t type) : type_{type} {}
+
+  inline DatabaseValueCodec_t type() const { return type_; }
+
+  /**
+   * @param value_size Size of the decoded value in bytes.
+   *
+   * @return Size of the encoded value in bytes.
+   */
+  size_t encoded_size(size_t value_size) const;
+
+  /**
+   * @param encoded_size Size of the encoded value in bytes.
+   *
+   * @return Size of the decoded value in bytes.
+   */
+  size_t decoded_size(size_t encoded_size) const;
+
+  /**
+   * Encodes a value that consists of \p value_size bytes.
+   */
+  inline void encode(const char* const value, const size_t value_size, char* const encoded) const {
+    if (type_ == DatabaseValueCodec_t::Float32) {
+      std::copy_n(value, value_size, encoded);
+    } else {
+      encode_(value, value_size, encoded);
+    }
+  }
+
+  /**
+   * Decodes a value, that will consist of \p value_size bytes.
+   */
+  inline void decode(const char* const encoded, const size_t value_size, char* const value) const {
+    if (type_ == DatabaseValueCodec_t::Float32) {
+      std::copy_n(encoded, value_size, value);
+    } else {
+      decode_(encoded, value_size, value);
+    }
+  }
+
+ private:
+  DatabaseValueCodec_t type_;
+
+  void encode_(const char* value, size_t value_size, char* encoded) const;
+  void decode_(const char* encoded, size_t value_size, char* value) const;
+};
+
+// TODO: Remove me!
+#pragma GCC diagnostic pop
+
+}  // namespace HugeCTR
@@ -96,6 +96,7 @@ struct Solver {
   bool perf_logging;
   bool drop_incomplete_batch;
   std::string kafka_brokers;
+  std::string local_message_queue_path;
   DataSourceParams data_source_params;
   std::vector<std::shared_ptr<TrainingCallback>> training_callbacks;
   Solver() {}
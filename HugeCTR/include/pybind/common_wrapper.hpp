@@ -258,6 +258,8 @@ void CommonPybind(pybind11::module& m) {
              HugeCTR::DatabaseType_t::RedisCluster)
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseType_t::RocksDB),
              HugeCTR::DatabaseType_t::RocksDB)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseType_t::SlabStore),
+             HugeCTR::DatabaseType_t::SlabStore)
       .export_values();
   pybind11::enum_<HugeCTR::DatabaseOverflowPolicy_t>(m, "DatabaseOverflowPolicy_t")
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseOverflowPolicy_t::EvictRandom),
@@ -267,11 +269,37 @@ void CommonPybind(pybind11::module& m) {
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseOverflowPolicy_t::EvictOldest),
              HugeCTR::DatabaseOverflowPolicy_t::EvictOldest)
       .export_values();
+  pybind11::enum_<HugeCTR::DatabaseRecencySource_t>(m, "DatabaseRecencySource_t")
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseRecencySource_t::CoarseClock),
+             HugeCTR::DatabaseRecencySource_t::CoarseClock)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseRecencySource_t::LogicalEpoch),
+             HugeCTR::DatabaseRecencySource_t::LogicalEpoch)
+      .export_values();
+  pybind11::enum_<HugeCTR::DatabaseHugePages_t>(m, "DatabaseHugePages_t")
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseHugePages_t::Disabled),
+             HugeCTR::DatabaseHugePages_t::Disabled)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseHugePages_t::Transparent),
+             HugeCTR::DatabaseHugePages_t::Transparent)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseHugePages_t::Explicit),
+             HugeCTR::DatabaseHugePages_t::Explicit)
+      .export_values();
+  pybind11::enum_<HugeCTR::DatabaseValueCodec_t>(m, "DatabaseValueCodec_t")
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseValueCodec_t::Float32),
+             HugeCTR::DatabaseValueCodec_t::Float32)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseValueCodec_t::Float16),
+             HugeCTR::DatabaseValueCodec_t::Float16)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseValueCodec_t::BFloat16),
+             HugeCTR::DatabaseValueCodec_t::BFloat16)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::DatabaseValueCodec_t::Int8),
+             HugeCTR::DatabaseValueCodec_t::Int8)
+      .export_values();
   pybind11::enum_<HugeCTR::UpdateSourceType_t>(m, "UpdateSourceType_t")
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::UpdateSourceType_t::Null),
              HugeCTR::UpdateSourceType_t::Null)
       .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::UpdateSourceType_t::KafkaMessageQueue),
              HugeCTR::UpdateSourceType_t::KafkaMessageQueue)
+      .value(HugeCTR::hctr_enum_to_c_str(HugeCTR::UpdateSourceType_t::LocalMessageQueue),
+             HugeCTR::UpdateSourceType_t::LocalMessageQueue)
       .export_values();
 }
 
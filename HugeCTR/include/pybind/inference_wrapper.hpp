@@ -456,12 +456,14 @@ void InferencePybind(pybind11::module& m) {
           pybind11::init<DatabaseType_t,
                          // Backend specific.
                          const std::string&, const std::string&, const std::string&, size_t, size_t,
-                         size_t, const std::string&, bool, size_t, size_t, bool, const std::string&,
-                         const std::string&, const std::string&, const std::string&,
+                         DatabaseHugePages_t, bool, double, size_t, const std::string&, bool, bool,
+                         size_t, size_t, DatabaseValueCodec_t, bool, const std::string&,
+                         const std::string&, const std::string&, const std::string&, size_t,
+                         size_t,
                          // Overflow handling related.
-                         size_t, DatabaseOverflowPolicy_t, double,
+                         size_t, DatabaseOverflowPolicy_t, double, size_t, DatabaseRecencySource_t,
                          // Caching behavior related.
-                         bool, double, bool,
+                         bool, double, bool, const std::string&,
                          // Real-time update mechanism related.
                          const std::vector<std::string>&>(),
           pybind11::arg("type") = DatabaseType_t::ParallelHashMap,
@@ -470,23 +472,30 @@ void InferencePybind(pybind11::module& m) {
           pybind11::arg("password") = "",
           pybind11::arg("num_partitions") = std::min(16u, std::thread::hardware_concurrency()),
           pybind11::arg("allocation_rate") = 256L * 1024L * 1024L,
+          pybind11::arg("huge_pages") = DatabaseHugePages_t::Disabled,
+          pybind11::arg("numa_aware") = false, pybind11::arg("compaction_threshold") = 1.0,
           pybind11::arg("shared_memory_size") = 16L * 1024L * 1024L * 1024L,
           pybind11::arg("shared_memory_name") = "hctr_mp_hash_map_database",
           pybind11::arg("shared_memory_auto_remove") = true,
+          pybind11::arg("shared_memory_open_addressing") = false,
           pybind11::arg("num_node_connections") = 5, pybind11::arg("max_batch_size") = 64L * 1024L,
+          pybind11::arg("value_codec") = DatabaseValueCodec_t::Float32,
           pybind11::arg("enable_tls") = false,
           pybind11::arg("tls_ca_certificate") = "cacertbundle.crt",
           pybind11::arg("tls_client_certificate") = "client_cert.pem",
           pybind11::arg("tls_client_key") = "client_key.pem",
           pybind11::arg("tls_server_name_identification") = "redis.localhost",
+          pybind11::arg("near_cache_size") = 0, pybind11::arg("near_cache_max_staleness_ms") = 100,
           // Overflow handling related.
           pybind11::arg("overflow_margin") = std::numeric_limits<size_t>::max(),
           pybind11::arg("overflow_policy") = DatabaseOverflowPolicy_t::EvictRandom,
           pybind11::arg("overflow_resolution_target") = 0.8,
+          pybind11::arg("overflow_sample_size") = 0,
+          pybind11::arg("recency_source") = DatabaseRecencySource_t::CoarseClock,
           // Caching behavior related.
           pybind11::arg("initialize_after_startup") = true,
           pybind11::arg("initial_cache_rate") = 1.0,
-          pybind11::arg("cache_missed_embeddings") = false,
+          pybind11::arg("cache_missed_embeddings") = false, pybind11::arg("snapshot_path") = "",
           // Real-time update mechanism related.
           pybind11::arg("update_filters") = std::vector<std::string>{"^hps_.+$"});
 
@@ -495,7 +504,8 @@ void InferencePybind(pybind11::module& m) {
                                                                        "PersistentDatabaseParams")
       .def(pybind11::init<DatabaseType_t,
                           // Backend specific.
-                          const std::string&, size_t, bool, size_t,
+                          const std::string&, size_t, bool, size_t, DatabaseValueCodec_t,
+                          size_t, double, bool, bool, size_t, size_t, double,
                           // Caching behavior related.
                           bool,
                           // Real-time update mechanism related.
@@ -505,6 +515,12 @@ void InferencePybind(pybind11::module& m) {
            pybind11::arg("path") = (std::filesystem::temp_directory_path() / "rocksdb").string(),
            pybind11::arg("num_threads") = 16, pybind11::arg("read_only") = false,
            pybind11::arg("max_batch_size") = 64L * 1024L,
+           pybind11::arg("value_codec") = DatabaseValueCodec_t::Float32,
+           pybind11::arg("block_cache_size") = 8L * 1024L * 1024L,
+           pybind11::arg("bloom_filter_bits_per_key") = 10.0,
+           pybind11::arg("partitioned_filters") = false, pybind11::arg("use_direct_reads") = false,
+           pybind11::arg("num_lookup_tasks") = 1, pybind11::arg("io_depth") = 64,
+           pybind11::arg("compaction_threshold") = 0.5,
            // Caching behavior related.
            pybind11::arg("initialize_after_startup") = true,
            // Real-time update mechanism related.
@@ -514,14 +530,16 @@ void InferencePybind(pybind11::module& m) {
       infer, "UpdateSourceParams")
       .def(pybind11::init<UpdateSourceType_t,
                           // Backend specific.
-                          const std::string&, size_t, size_t, size_t, size_t, size_t, size_t>(),
+                          const std::string&, size_t, size_t, size_t, size_t, size_t, size_t,
+                          const std::string&>(),
            pybind11::arg("type") = UpdateSourceType_t::Null,
            // Backend specific.
            pybind11::arg("brokers") = "127.0.0.1:9092",
            pybind11::arg("metadata_refresh_interval_ms") = 30'000,
            pybind11::arg("receive_buffer_size") = 256 * 1024,
            pybind11::arg("poll_timeout_ms") = 500, pybind11::arg("max_batch_size") = 8 * 1024,
-           pybind11::arg("failure_backoff_ms") = 50, pybind11::arg("max_commit_interval") = 32);
+           pybind11::arg("failure_backoff_ms") = 50, pybind11::arg("max_commit_interval") = 32,
+           pybind11::arg("path") = "/tmp/hps_mq");
 
   pybind11::enum_<EmbeddingCacheType_t>(infer, "EmbeddingCacheType_t")
       .value("Dynamic", EmbeddingCacheType_t::Dynamic)
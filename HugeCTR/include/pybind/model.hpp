@@ -26,6 +26,7 @@
 #include <graph_wrapper.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/kafka_message.hpp>
+#include <hps/local_message.hpp>
 #include <hps/message.hpp>
 #include <inference/preallocated_buffer2.hpp>
 #include <io/filesystem.hpp>
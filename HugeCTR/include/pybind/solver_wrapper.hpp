@@ -36,7 +36,7 @@ std::unique_ptr<Solver> CreateSolver(
     bool eval_intra_iteration_overlap, bool eval_inter_iteration_overlap,
     DeviceMap::Layout device_layout, bool use_embedding_collection, AllReduceAlgo all_reduce_algo,
     bool grouped_all_reduce, size_t num_iterations_statistics, bool perf_logging,
-    bool drop_incomplete_batch, std::string& kafka_brokers,
+    bool drop_incomplete_batch, std::string& kafka_brokers, std::string& local_message_queue_path,
     const std::vector<std::shared_ptr<TrainingCallback>>& training_callbacks) {
   if (use_mixed_precision && enable_tf32_compute) {
     HCTR_OWN_THROW(Error_t::WrongInput,
@@ -82,6 +82,7 @@ std::unique_ptr<Solver> CreateSolver(
   solver->perf_logging = perf_logging;
   solver->drop_incomplete_batch = drop_incomplete_batch;
   solver->kafka_brokers = kafka_brokers;
+  solver->local_message_queue_path = local_message_queue_path;
   solver->training_callbacks = training_callbacks;
   return solver;
 }
@@ -147,6 +148,7 @@ void SolverPybind(pybind11::module& m) {
         pybind11::arg("grouped_all_reduce") = false,
         pybind11::arg("num_iterations_statistics") = 20, pybind11::arg("perf_logging") = false,
         pybind11::arg("drop_incomplete_batch") = true, pybind11::arg("kafka_brockers") = "",
+        pybind11::arg("local_message_queue_path") = "",
         pybind11::arg("training_callbacks") = std::vector<std::shared_ptr<TrainingCallback>>());
 }
 
@@ -130,6 +130,8 @@ class TensorBag2 {
 
   const std::vector<size_t> &get_dimensions() const { return dimensions_; }
 
+  std::shared_ptr<TensorBuffer2> get_buffer() const { return buffer_; }
+
   const void *get_ptr() const { return buffer_->get_ptr(); }
 
   void *get_ptr() { return buffer_->get_ptr(); }
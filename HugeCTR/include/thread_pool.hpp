@@ -51,8 +51,13 @@ class ThreadPool final {
 
   static ThreadPool& get();
 
+  // Waits for all tasks, before rethrowing the first exception (if any). Hence, tasks never
+  // outlive the state that the caller shares with them.
   template <typename Iterator>
   inline static void await(Iterator first, const Iterator& last) {
+    for (Iterator it{first}; it != last; it++) {
+      it->wait();
+    }
     for (; first != last; first++) {
       first->get();
     }
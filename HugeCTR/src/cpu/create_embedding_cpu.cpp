@@ -22,6 +22,7 @@ template <typename TypeFP>
 void create_embedding_cpu<TypeFP>::operator()(
     const InferenceParams& inference_params, const nlohmann::json& j_layers_array,
     std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+    std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
     std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
     std::vector<size_t>& embedding_table_slot_size, std::vector<TensorEntry>* tensor_entries,
     std::vector<std::shared_ptr<LayerCPU>>* embeddings,
@@ -77,19 +78,24 @@ void create_embedding_cpu<TypeFP>::operator()(
 
     std::vector<size_t> row_dims = {
         static_cast<size_t>(inference_params.max_batchsize * slot_num + 1)};
+    std::vector<size_t> row_indices_dims = {
+        static_cast<size_t>(inference_params.max_batchsize * max_feature_num_per_sample)};
     std::vector<size_t> embeddingvecs_dims = {
         static_cast<size_t>(inference_params.max_batchsize * max_feature_num_per_sample),
         static_cast<size_t>(embedding_vec_size)};
     std::shared_ptr<Tensor2<int>> row_tensor = std::make_shared<Tensor2<int>>();
+    std::shared_ptr<Tensor2<int>> row_indices_tensor = std::make_shared<Tensor2<int>>();
     std::shared_ptr<Tensor2<float>> embeddingvecs_tensor = std::make_shared<Tensor2<float>>();
     blobs_buff->reserve(row_dims, row_tensor.get());
+    blobs_buff->reserve(row_indices_dims, row_indices_tensor.get());
     blobs_buff->reserve(embeddingvecs_dims, embeddingvecs_tensor.get());
     rows.push_back(row_tensor);
+    row_indices.push_back(row_indices_tensor);
     embeddingvecs.push_back(embeddingvecs_tensor);
     Tensor2<TypeFP> embedding_output;
     embeddings->push_back(std::make_shared<EmbeddingFeatureCombinerCPU<TypeFP>>(
-        embeddingvecs[0], rows[0], embedding_output, inference_params.max_batchsize, slot_num,
-        feature_combiner_type, blobs_buff));
+        embeddingvecs.back(), rows.back(), embedding_output, inference_params.max_batchsize,
+        slot_num, feature_combiner_type, blobs_buff, row_indices.back()));
     tensor_entries->push_back({layer_top, embedding_output.shrink()});
   }
   HCTR_LOG(INFO, ROOT, "create cpu embedding for inference success\n");
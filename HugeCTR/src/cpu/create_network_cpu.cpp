@@ -34,6 +34,8 @@
 #include <cpu/layers/slice_layer_cpu.hpp>
 #include <cpu/layers/weight_multiply_layer_cpu.hpp>
 #include <cpu/network_cpu.hpp>
+#include <map>
+#include <set>
 
 #ifdef ENABLE_MPI
 #include <mpi.h>
@@ -46,6 +48,25 @@ struct InputOutputInfo {
   std::vector<std::string> output_names;
 };
 
+/**
+ * Hands out memory that is owned by another buffer (i.e., the weights of the source network).
+ */
+class BorrowedHostAllocator {
+ public:
+  BorrowedHostAllocator(void* ptr, size_t size) : ptr_(ptr), size_(size) {}
+  void* allocate(size_t size) const {
+    if (size != size_) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Network layout does not match the weights source.");
+    }
+    return ptr_;
+  }
+  void deallocate(void* ptr) const {}
+
+ private:
+  void* ptr_;
+  size_t size_;
+};
+
 static bool get_tensor_from_entries(const std::vector<TensorEntry> tensor_entries,
                                     const std::string& name, TensorBag2* bag) {
   for (const TensorEntry& entry : tensor_entries) {
@@ -82,6 +103,102 @@ static InputOutputInfo get_input_tensor_and_output_name(
   return {bottom_bags, top_names};
 }
 
+/**
+ * Fuses chains of layers, whose intermediate results are not used otherwise, into a single layer:
+ *  - InnerProduct -> ReLU and Add -> ReLU: The ReLU is applied by the first layer ("fuse_relu").
+ *  - Concat -> InnerProduct: The InnerProduct multiplies each input of the Concat with the
+ *    corresponding rows of its weights, and accumulates the results.
+ * Returns the rewritten layer array. Layers keep their order.
+ */
+static nlohmann::json fuse_layers(const nlohmann::json& j_array, size_t* num_fused) {
+  std::map<std::string, size_t> num_consumers;
+  std::map<std::string, std::string> consumer_types;
+  for (size_t i = 1; i < j_array.size(); i++) {
+    const auto type = get_value_from_json<std::string>(j_array[i], "type");
+    for (const auto& bottom_name : get_layer_names(get_json(j_array[i], "bottom"))) {
+      num_consumers[bottom_name]++;
+      consumer_types[bottom_name] = type;
+    }
+  }
+  auto is_sole_input_of = [&](const std::string& name, const std::string& type) {
+    return num_consumers[name] == 1 && consumer_types[name] == type;
+  };
+
+  nlohmann::json fused_array = nlohmann::json::array();
+  fused_array.push_back(j_array[0]);
+  std::map<std::string, nlohmann::json> concat_bottoms;
+  *num_fused = 0;
+  for (size_t i = 1; i < j_array.size(); i++) {
+    nlohmann::json j = j_array[i];
+    const auto type = get_value_from_json<std::string>(j, "type");
+    const auto top_names = get_layer_names(get_json(j, "top"));
+    if (type == "Concat" && top_names.size() == 1 &&
+        is_sole_input_of(top_names[0], "InnerProduct")) {
+      concat_bottoms[top_names[0]] = get_json(j, "bottom");
+      ++*num_fused;
+      continue;
+    }
+
+    if (type == "InnerProduct") {
+      const auto bottom_names = get_layer_names(get_json(j, "bottom"));
+      if (bottom_names.size() == 1 && concat_bottoms.count(bottom_names[0])) {
+        j["bottom"] = concat_bottoms[bottom_names[0]];
+      }
+    }
+    if ((type == "InnerProduct" || type == "Add") && top_names.size() == 1 &&
+        i + 1 < j_array.size() && is_sole_input_of(top_names[0], "ReLU")) {
+      const nlohmann::json& j_next = j_array[i + 1];
+      const auto next_bottom_names = get_layer_names(get_json(j_next, "bottom"));
+      if (get_value_from_json<std::string>(j_next, "type") == "ReLU" &&
+          next_bottom_names.size() == 1 && next_bottom_names[0] == top_names[0]) {
+        j["top"] = get_json(j_next, "top");
+        j["fuse_relu"] = true;
+        ++*num_fused;
+        ++i;
+      }
+    }
+    fused_array.push_back(j);
+  }
+  return fused_array;
+}
+
+/**
+ * Lets activations share memory if their lifetimes do not intersect. The lifetime of a tensor
+ * spans from the layer that produces it to the last layer that consumes it. The inputs of the
+ * network and its prediction are excluded, since they are accessed from outside.
+ */
+static void plan_activation_memory(
+    const nlohmann::json& j_array, const std::vector<TensorEntry>& tensor_entries,
+    size_t num_input_entries, const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff) {
+  std::map<std::string, std::shared_ptr<TensorBuffer2>> buffers;
+  std::set<TensorBuffer2*> excluded{tensor_entries.back().bag.get_buffer().get()};
+  for (size_t i = 0; i < tensor_entries.size(); i++) {
+    buffers[tensor_entries[i].name] = tensor_entries[i].bag.get_buffer();
+    if (i < num_input_entries) {
+      excluded.insert(tensor_entries[i].bag.get_buffer().get());
+    }
+  }
+
+  std::map<std::shared_ptr<TensorBuffer2>, std::pair<size_t, size_t>> lifetimes;
+  for (size_t i = 1; i < j_array.size(); i++) {
+    for (const auto& top_name : get_layer_names(get_json(j_array[i], "top"))) {
+      auto buffer = buffers.find(top_name);
+      if (buffer != buffers.end() && !excluded.count(buffer->second.get())) {
+        lifetimes.emplace(buffer->second, std::make_pair(i, i));
+      }
+    }
+    for (const auto& bottom_name : get_layer_names(get_json(j_array[i], "bottom"))) {
+      auto buffer = buffers.find(bottom_name);
+      if (buffer != buffers.end() && lifetimes.count(buffer->second)) {
+        lifetimes[buffer->second].second = i;
+      }
+    }
+  }
+  for (const auto& lifetime : lifetimes) {
+    blobs_buff->set_lifetime(lifetime.first, lifetime.second.first, lifetime.second.second);
+  }
+}
+
 void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tensor_entries,
                    const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
                    const std::shared_ptr<BufferBlock2<float>>& weight_buff,
@@ -325,24 +442,33 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
         // establish out tensor
         auto output = get_value_from_json<size_t>(j_fc_param, "num_output");
 
+        // set by fuse_layers
+        const bool fuse_relu = has_key_(j, "fuse_relu") && j["fuse_relu"].get<bool>();
+
         if (use_mixed_precision) {
-          Tensor2<__half> in_tensor = Tensor2<__half>::stretch_from(input_output_info.inputs[0]);
+          Tensors2<__half> in_tensors;
+          for (const TensorBag2& bag : input_output_info.inputs) {
+            in_tensors.push_back(Tensor2<__half>::stretch_from(bag));
+          }
           Tensor2<__half> fc_out_tensor;
-          blobs_buff->reserve({in_tensor.get_dimensions()[0], output}, &fc_out_tensor);
+          blobs_buff->reserve({in_tensors[0].get_dimensions()[0], output}, &fc_out_tensor);
 
           // establish layer
-          layers.emplace_back(new FullyConnectedLayerCPU<__half>(weight_buff, weight_buff_half,
-                                                                 wgrad_buff_half, blobs_buff,
-                                                                 in_tensor, fc_out_tensor));
+          layers.emplace_back(new FullyConnectedLayerCPU<__half>(
+              weight_buff, weight_buff_half, wgrad_buff_half, blobs_buff, in_tensors,
+              fc_out_tensor, fuse_relu));
           output_tensor_entries.push_back(
               {input_output_info.output_names[0], fc_out_tensor.shrink()});
         } else {
-          Tensor2<float> in_tensor = Tensor2<float>::stretch_from(input_output_info.inputs[0]);
+          Tensors2<float> in_tensors;
+          for (const TensorBag2& bag : input_output_info.inputs) {
+            in_tensors.push_back(Tensor2<float>::stretch_from(bag));
+          }
           Tensor2<float> fc_out_tensor;
-          blobs_buff->reserve({in_tensor.get_dimensions()[0], output}, &fc_out_tensor);
+          blobs_buff->reserve({in_tensors[0].get_dimensions()[0], output}, &fc_out_tensor);
           // establish layer
           layers.emplace_back(new FullyConnectedLayerCPU<float>(
-              weight_buff, wgrad_buff, in_tensor, fc_out_tensor, use_mixed_precision));
+              weight_buff, wgrad_buff, in_tensors, fc_out_tensor, use_mixed_precision, fuse_relu));
           output_tensor_entries.push_back(
               {input_output_info.output_names[0], fc_out_tensor.shrink()});
         }
@@ -598,6 +724,8 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
         break;
       }
       case Layer_t::Add: {
+        // set by fuse_layers
+        const bool fuse_relu = has_key_(j, "fuse_relu") && j["fuse_relu"].get<bool>();
         if (use_mixed_precision) {
           Tensors2<__half> in_tensors;
           for (const auto& bag : input_output_info.inputs) {
@@ -605,7 +733,8 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
           }
           Tensor2<__half> out_tensor;
           blobs_buff->reserve(in_tensors[0].get_dimensions(), &out_tensor);
-          layers.emplace_back(new AddLayerCPU<__half>(in_tensors, out_tensor, blobs_buff));
+          layers.emplace_back(
+              new AddLayerCPU<__half>(in_tensors, out_tensor, blobs_buff, fuse_relu));
           output_tensor_entries.push_back({input_output_info.output_names[0], out_tensor.shrink()});
         } else {
           Tensors2<float> in_tensors;
@@ -614,7 +743,8 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
           }
           Tensor2<float> out_tensor;
           blobs_buff->reserve(in_tensors[0].get_dimensions(), &out_tensor);
-          layers.emplace_back(new AddLayerCPU<float>(in_tensors, out_tensor, blobs_buff));
+          layers.emplace_back(
+              new AddLayerCPU<float>(in_tensors, out_tensor, blobs_buff, fuse_relu));
           output_tensor_entries.push_back({input_output_info.output_names[0], out_tensor.shrink()});
         }
         break;
@@ -657,7 +787,8 @@ void create_layers(const nlohmann::json& j_array, std::vector<TensorEntry>& tens
 NetworkCPU* NetworkCPU::create_network(const nlohmann::json& j_array,
                                        std::vector<TensorEntry>& tensor_entries,
                                        const std::shared_ptr<CPUResource>& cpu_resource,
-                                       bool use_mixed_precision) {
+                                       bool use_mixed_precision,
+                                       const NetworkCPU* weights_source) {
   NetworkCPU* network = new NetworkCPU(cpu_resource, use_mixed_precision);
 
   auto& layers = network->layers_;
@@ -665,14 +796,33 @@ NetworkCPU* NetworkCPU::create_network(const nlohmann::json& j_array,
   std::shared_ptr<GeneralBuffer2<HostAllocator>> blobs_buff =
       GeneralBuffer2<HostAllocator>::create();
 
-  std::shared_ptr<BufferBlock2<float>> weight_buff = blobs_buff->create_block<float>();
-  std::shared_ptr<BufferBlock2<__half>> weight_buff_half = blobs_buff->create_block<__half>();
+  // Weights are kept apart from the activations, so that replicas can share them. Since replicas
+  // reserve their weights in the same order, both buffers have the same layout.
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> params_buff;
+  std::shared_ptr<GeneralBuffer2<BorrowedHostAllocator>> shared_params_buff;
+  std::shared_ptr<BufferBlock2<float>> weight_buff;
+  std::shared_ptr<BufferBlock2<__half>> weight_buff_half;
+  if (weights_source) {
+    params_buff = weights_source->params_buff_;
+    shared_params_buff = GeneralBuffer2<BorrowedHostAllocator>::create(
+        BorrowedHostAllocator(params_buff->get_ptr(), params_buff->get_size_in_bytes()));
+    weight_buff = shared_params_buff->create_block<float>();
+    weight_buff_half = shared_params_buff->create_block<__half>();
+  } else {
+    params_buff = GeneralBuffer2<HostAllocator>::create();
+    weight_buff = params_buff->create_block<float>();
+    weight_buff_half = params_buff->create_block<__half>();
+  }
   std::shared_ptr<BufferBlock2<float>> wgrad_buff = blobs_buff->create_block<float>();
   std::shared_ptr<BufferBlock2<__half>> wgrad_buff_half = blobs_buff->create_block<__half>();
 
   // create layers
-  create_layers(j_array, tensor_entries, blobs_buff, weight_buff, weight_buff_half, wgrad_buff,
+  size_t num_fused = 0;
+  const nlohmann::json fused_array = fuse_layers(j_array, &num_fused);
+  const size_t num_input_entries = tensor_entries.size();
+  create_layers(fused_array, tensor_entries, blobs_buff, weight_buff, weight_buff_half, wgrad_buff,
                 wgrad_buff_half, use_mixed_precision, layers);
+  plan_activation_memory(fused_array, tensor_entries, num_input_entries, blobs_buff);
 
   TensorEntry pred_tensor_entry = tensor_entries.back();
   network->pred_tensor_ = Tensor2<float>::stretch_from(pred_tensor_entry.bag);
@@ -680,7 +830,15 @@ NetworkCPU* NetworkCPU::create_network(const nlohmann::json& j_array,
   network->weight_tensor_half_ = weight_buff_half->as_tensor();
   network->wgrad_tensor_ = wgrad_buff->as_tensor();
   network->wgrad_tensor_half_ = wgrad_buff_half->as_tensor();
+  network->params_buff_ = params_buff;
+  if (shared_params_buff) {
+    shared_params_buff->allocate();
+  } else {
+    params_buff->allocate();
+  }
   blobs_buff->allocate();
+  HCTR_LOG_S(DEBUG, ROOT) << "NetworkCPU: fused " << num_fused << " layers, activations occupy "
+                          << blobs_buff->get_size_in_bytes() << " bytes" << std::endl;
 
   return network;
 }
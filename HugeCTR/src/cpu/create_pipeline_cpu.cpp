@@ -25,11 +25,13 @@ void create_pipeline_inference_cpu(const nlohmann::json& config,
                                    const InferenceParams& inference_params,
                                    Tensor2<float>& dense_input,
                                    std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+                                   std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
                                    std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
                                    std::vector<size_t>& embedding_table_slot_size,
                                    std::vector<std::shared_ptr<LayerCPU>>* embeddings,
                                    NetworkCPU** network,
-                                   const std::shared_ptr<CPUResource>& cpu_resource) {
+                                   const std::shared_ptr<CPUResource>& cpu_resource,
+                                   const NetworkCPU* weights_source) {
   std::vector<TensorEntry> tensor_entries;
 
   auto j_layers_array = get_json(config, "layers");
@@ -47,30 +49,33 @@ void create_pipeline_inference_cpu(const nlohmann::json& config,
     tensor_entries.push_back({top_strs_dense, dense_input.shrink()});
   }
 
-  create_embedding_cpu<TypeEmbeddingComp>()(inference_params, j_layers_array, rows, embeddingvecs,
-                                            embedding_table_slot_size, &tensor_entries, embeddings,
-                                            input_buffer);
+  create_embedding_cpu<TypeEmbeddingComp>()(inference_params, j_layers_array, rows, row_indices,
+                                            embeddingvecs, embedding_table_slot_size,
+                                            &tensor_entries, embeddings, input_buffer);
   input_buffer->allocate();
 
   *network = NetworkCPU::create_network(j_layers_array, tensor_entries, cpu_resource,
-                                        inference_params.use_mixed_precision);
+                                        inference_params.use_mixed_precision, weights_source);
 }
 
 void create_pipeline_cpu(const nlohmann::json& config, std::map<std::string, bool> tensor_active,
                          const InferenceParams& inference_params, Tensor2<float>& dense_input,
                          std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+                         std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
                          std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
                          std::vector<size_t>& embedding_table_slot_size,
                          std::vector<std::shared_ptr<LayerCPU>>* embeddings, NetworkCPU** network,
-                         const std::shared_ptr<CPUResource>& cpu_resource) {
+                         const std::shared_ptr<CPUResource>& cpu_resource,
+                         const NetworkCPU* weights_source) {
   if (inference_params.use_mixed_precision) {
     create_pipeline_inference_cpu<__half>(config, tensor_active, inference_params, dense_input,
-                                          rows, embeddingvecs, embedding_table_slot_size,
-                                          embeddings, network, cpu_resource);
+                                          rows, row_indices, embeddingvecs,
+                                          embedding_table_slot_size, embeddings, network,
+                                          cpu_resource, weights_source);
   } else {
     create_pipeline_inference_cpu<float>(config, tensor_active, inference_params, dense_input, rows,
-                                         embeddingvecs, embedding_table_slot_size, embeddings,
-                                         network, cpu_resource);
+                                         row_indices, embeddingvecs, embedding_table_slot_size,
+                                         embeddings, network, cpu_resource, weights_source);
   }
 }
 
@@ -78,17 +83,19 @@ template void create_pipeline_inference_cpu<float>(
     const nlohmann::json& config, std::map<std::string, bool> tensor_active,
     const InferenceParams& inference_params, Tensor2<float>& dense_input,
     std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+    std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
     std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
     std::vector<size_t>& embedding_table_slot_size,
     std::vector<std::shared_ptr<LayerCPU>>* embeddings, NetworkCPU** network,
-    const std::shared_ptr<CPUResource>& cpu_resource);
+    const std::shared_ptr<CPUResource>& cpu_resource, const NetworkCPU* weights_source);
 template void create_pipeline_inference_cpu<__half>(
     const nlohmann::json& config, std::map<std::string, bool> tensor_active,
     const InferenceParams& inference_params, Tensor2<float>& dense_input,
     std::vector<std::shared_ptr<Tensor2<int>>>& rows,
+    std::vector<std::shared_ptr<Tensor2<int>>>& row_indices,
     std::vector<std::shared_ptr<Tensor2<float>>>& embeddingvecs,
     std::vector<size_t>& embedding_table_slot_size,
     std::vector<std::shared_ptr<LayerCPU>>* embeddings, NetworkCPU** network,
-    const std::shared_ptr<CPUResource>& cpu_resource);
+    const std::shared_ptr<CPUResource>& cpu_resource, const NetworkCPU* weights_source);
 
 }  // namespace HugeCTR
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <core23/logger.hpp>
+#include <cpu/embedding_cache_cpu.hpp>
+#include <cstring>
+#include <hps/database_backend_detail.hpp>
+#include <limits>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+namespace {
+
+constexpr size_t cache_line_size{64};
+constexpr size_t sketch_depth{4};
+constexpr uint8_t sketch_max_count{15};
+constexpr size_t sketch_sample_factor{10};  // Halve counters after this many accesses per slot.
+
+}  // namespace
+
+EmbeddingCacheCPUStats& EmbeddingCacheCPUStats::operator+=(const EmbeddingCacheCPUStats& other) {
+  num_hits += other.num_hits;
+  num_misses += other.num_misses;
+  num_admitted += other.num_admitted;
+  num_rejected += other.num_rejected;
+  num_evicted += other.num_evicted;
+  num_refreshed += other.num_refreshed;
+  size += other.size;
+  return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const EmbeddingCacheCPUStats& stats) {
+  return os << "hits = " << stats.num_hits << ", misses = " << stats.num_misses
+            << ", hit rate = " << stats.hit_rate() << ", admitted = " << stats.num_admitted
+            << ", rejected = " << stats.num_rejected << ", evicted = " << stats.num_evicted
+            << ", refreshed = " << stats.num_refreshed << ", size = " << stats.size;
+}
+
+template <typename Key>
+EmbeddingCacheCPU<Key>::EmbeddingCacheCPU(const EmbeddingCacheCPUParams& params,
+                                          const InferenceParams& inference_params,
+                                          HierParameterServerBase* const parameter_server)
+    : params_{params},
+      model_name_{inference_params.model_name},
+      parameter_server_{parameter_server},
+      tables_(inference_params.embedding_vecsize_per_table.size()) {
+  HCTR_CHECK(parameter_server_);
+  HCTR_CHECK(params_.capacity > 0 && params_.num_shards > 0);
+
+  const size_t slots_per_shard{(params_.capacity + params_.num_shards - 1) / params_.num_shards};
+  HCTR_CHECK(slots_per_shard <= std::numeric_limits<uint32_t>::max());
+  size_t sketch_width{cache_line_size};
+  while (sketch_width < slots_per_shard) {
+    sketch_width *= 2;
+  }
+
+  for (size_t table_id{0}; table_id < tables_.size(); ++table_id) {
+    Table& table{tables_[table_id]};
+    table.vector_size = inference_params.embedding_vecsize_per_table[table_id];
+    table.slot_size = (table.vector_size * sizeof(float) + cache_line_size - 1) /
+                      cache_line_size * cache_line_size / sizeof(float);
+    table.slots_per_shard = slots_per_shard;
+
+    table.shards = std::vector<Shard>(params_.num_shards);
+    for (Shard& shard : table.shards) {
+      shard.index.reserve(slots_per_shard);
+      shard.keys.resize(slots_per_shard);
+      shard.referenced.resize(slots_per_shard);
+      shard.vectors.reset(static_cast<float*>(std::aligned_alloc(
+          cache_line_size, slots_per_shard * table.slot_size * sizeof(float))));
+      HCTR_CHECK(shard.vectors);
+      shard.sketch.resize(sketch_depth * sketch_width);
+      shard.sketch_width = sketch_width;
+    }
+  }
+
+  HCTR_LOG_S(INFO, WORLD) << "Created CPU embedding cache for model " << model_name_ << " ("
+                          << tables_.size() << " tables, " << params_.capacity
+                          << " embeddings per table, " << params_.num_shards << " shards)."
+                          << std::endl;
+
+  if (params_.refresh_interval.count() > 0) {
+    refresher_ = std::thread(&EmbeddingCacheCPU::run_, this);
+  }
+}
+
+template <typename Key>
+EmbeddingCacheCPU<Key>::~EmbeddingCacheCPU() {
+  if (refresher_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(refresh_guard_);
+      terminate_ = true;
+    }
+    refresh_semaphore_.notify_one();
+    refresher_.join();
+  }
+
+  for (size_t table_id{0}; table_id < tables_.size(); ++table_id) {
+    HCTR_LOG_S(DEBUG, WORLD) << "CPU embedding cache; Model " << model_name_ << ", table "
+                             << table_id << ": " << stats(table_id) << '.' << std::endl;
+  }
+}
+
+template <typename Key>
+void EmbeddingCacheCPU<Key>::lookup(const size_t table_id, const Key* const keys,
+                                    const size_t num_keys, float* const vectors) {
+  HCTR_CHECK(table_id < tables_.size());
+  Table& table{tables_[table_id]};
+  const size_t vector_size{table.vector_size};
+
+  // Serve hits from the cache.
+  std::vector<size_t> shard_offsets;
+  std::vector<size_t> shard_indices;
+  {
+    const size_t num_partitions{table.shards.size()};
+    group_keys_by_part(num_partitions, num_keys, nullptr, keys, shard_offsets, shard_indices);
+  }
+
+  std::vector<size_t> missed_indices;
+  for (size_t shard_index{0}; shard_index < table.shards.size(); ++shard_index) {
+    Shard& shard{table.shards[shard_index]};
+    const size_t* const indices_end{&shard_indices[shard_offsets[shard_index + 1]]};
+    const size_t* i{&shard_indices[shard_offsets[shard_index]]};
+    if (i == indices_end) {
+      continue;
+    }
+
+    const std::lock_guard<std::mutex> lock(shard.guard);
+    for (; i != indices_end; ++i) {
+      const Key& key{keys[*i]};
+      frequency_(shard, key, true);
+
+      const auto& it{shard.index.find(key)};
+      if (it != shard.index.end()) {
+        std::copy_n(&shard.vectors.get()[it->second * table.slot_size], vector_size,
+                    &vectors[*i * vector_size]);
+        shard.referenced[it->second] = 1;
+        ++shard.stats.num_hits;
+      } else {
+        missed_indices.emplace_back(*i);
+        ++shard.stats.num_misses;
+      }
+    }
+  }
+  if (missed_indices.empty()) {
+    return;
+  }
+
+  // Fetch missing embeddings from the parameter server.
+  std::vector<Key> missed_keys;
+  missed_keys.reserve(missed_indices.size());
+  for (const size_t i : missed_indices) {
+    missed_keys.emplace_back(keys[i]);
+  }
+  std::vector<float> missed_vectors(missed_keys.size() * vector_size);
+  parameter_server_->lookup(missed_keys.data(), missed_keys.size(), missed_vectors.data(),
+                            model_name_, table_id);
+  for (size_t j{0}; j < missed_indices.size(); ++j) {
+    std::copy_n(&missed_vectors[j * vector_size], vector_size,
+                &vectors[missed_indices[j] * vector_size]);
+  }
+
+  // Offer them to the cache.
+  {
+    const size_t num_partitions{table.shards.size()};
+    group_keys_by_part(num_partitions, missed_keys.size(), nullptr, missed_keys.data(),
+                       shard_offsets, shard_indices);
+  }
+  for (size_t shard_index{0}; shard_index < table.shards.size(); ++shard_index) {
+    Shard& shard{table.shards[shard_index]};
+    const size_t* const indices_end{&shard_indices[shard_offsets[shard_index + 1]]};
+    const size_t* j{&shard_indices[shard_offsets[shard_index]]};
+    if (j == indices_end) {
+      continue;
+    }
+
+    const std::lock_guard<std::mutex> lock(shard.guard);
+    for (; j != indices_end; ++j) {
+      admit_(table, shard, missed_keys[*j], &missed_vectors[*j * vector_size]);
+    }
+  }
+}
+
+template <typename Key>
+void EmbeddingCacheCPU<Key>::refresh() {
+  std::vector<Key> keys;
+  std::vector<float> vectors;
+
+  for (size_t table_id{0}; table_id < tables_.size(); ++table_id) {
+    Table& table{tables_[table_id]};
+    const size_t vector_size{table.vector_size};
+
+    for (Shard& shard : table.shards) {
+      keys.clear();
+      {
+        const std::lock_guard<std::mutex> lock(shard.guard);
+        keys.reserve(shard.index.size());
+        for (const auto& pair : shard.index) {
+          keys.emplace_back(pair.first);
+        }
+      }
+      if (keys.empty()) {
+        continue;
+      }
+
+      // Query without holding the lock, so that lookups can proceed in the meantime.
+      vectors.resize(keys.size() * vector_size);
+      parameter_server_->lookup(keys.data(), keys.size(), vectors.data(), model_name_, table_id);
+
+      // Keys that were evicted in the meantime are skipped.
+      const std::lock_guard<std::mutex> lock(shard.guard);
+      for (size_t i{0}; i < keys.size(); ++i) {
+        const auto& it{shard.index.find(keys[i])};
+        if (it != shard.index.end()) {
+          std::copy_n(&vectors[i * vector_size], vector_size,
+                      &shard.vectors.get()[it->second * table.slot_size]);
+          ++shard.stats.num_refreshed;
+        }
+      }
+    }
+  }
+}
+
+template <typename Key>
+EmbeddingCacheCPUStats EmbeddingCacheCPU<Key>::stats(const size_t table_id) const {
+  HCTR_CHECK(table_id < tables_.size());
+
+  EmbeddingCacheCPUStats stats;
+  for (const Shard& shard : tables_[table_id].shards) {
+    const std::lock_guard<std::mutex> lock(shard.guard);
+    stats += shard.stats;
+  }
+  return stats;
+}
+
+template <typename Key>
+void EmbeddingCacheCPU<Key>::run_() {
+  hctr_set_thread_name("cpu ec refresh");
+
+  std::unique_lock<std::mutex> lock(refresh_guard_);
+  while (!refresh_semaphore_.wait_for(lock, params_.refresh_interval,
+                                      [&]() { return terminate_; })) {
+    lock.unlock();
+    try {
+      refresh();
+    } catch (const std::exception& error) {
+      HCTR_LOG_S(ERROR, WORLD) << "CPU embedding cache refresh failed for model " << model_name_
+                               << ". Error: " << error.what() << std::endl;
+    }
+    lock.lock();
+  }
+}
+
+template <typename Key>
+uint8_t EmbeddingCacheCPU<Key>::frequency_(Shard& shard, const Key& key, const bool record) const {
+  // Double hashing. Independent of the hash that selects the shard.
+  const uint64_t h1{rrxmrrxmsx_0(static_cast<uint64_t>(key) ^ UINT64_C(0x9E3779B97F4A7C15))};
+  const uint64_t h2{rotr64(h1, 32) | 1};
+  const size_t mask{shard.sketch_width - 1};
+
+  uint8_t count{sketch_max_count};
+  for (size_t row{0}; row < sketch_depth; ++row) {
+    uint8_t& counter{shard.sketch[row * shard.sketch_width + ((h1 + row * h2) & mask)]};
+    if (record && counter < sketch_max_count) {
+      ++counter;
+    }
+    count = std::min(count, counter);
+  }
+
+  // Age counters, so that keys that are no longer accessed lose their priority.
+  if (record && ++shard.sketch_additions >= sketch_sample_factor * shard.keys.size()) {
+    for (uint8_t& counter : shard.sketch) {
+      counter = static_cast<uint8_t>(counter / 2);
+    }
+    shard.sketch_additions = 0;
+  }
+  return count;
+}
+
+template <typename Key>
+void EmbeddingCacheCPU<Key>::admit_(const Table& table, Shard& shard, const Key& key,
+                                    const float* const vector) {
+  // Concurrent lookups may have missed the same key.
+  const auto& it{shard.index.find(key)};
+  if (it != shard.index.end()) {
+    std::copy_n(vector, table.vector_size, &shard.vectors.get()[it->second * table.slot_size]);
+    return;
+  }
+
+  size_t slot;
+  if (shard.size < shard.keys.size()) {
+    slot = shard.size++;
+  } else {
+    // Choose eviction candidate. Terminates within two rounds, because the first round clears all
+    // reference bits.
+    for (;;) {
+      if (shard.hand >= shard.keys.size()) {
+        shard.hand = 0;
+      }
+      slot = shard.hand++;
+      if (!shard.referenced[slot]) {
+        break;
+      }
+      shard.referenced[slot] = 0;
+    }
+
+    // TinyLFU admission.
+    const Key& victim{shard.keys[slot]};
+    if (frequency_(shard, key, false) <= frequency_(shard, victim, false)) {
+      ++shard.stats.num_rejected;
+      return;
+    }
+    shard.index.erase(victim);
+    ++shard.stats.num_evicted;
+  }
+
+  shard.keys[slot] = key;
+  shard.referenced[slot] = 0;
+  std::copy_n(vector, table.vector_size, &shard.vectors.get()[slot * table.slot_size]);
+  shard.index.emplace(key, static_cast<uint32_t>(slot));
+  shard.stats.size = shard.size;
+  ++shard.stats.num_admitted;
+}
+
+template class EmbeddingCacheCPU<unsigned int>;
+template class EmbeddingCacheCPU<long long>;
+
+}  // namespace HugeCTR
@@ -16,59 +16,145 @@
 
 #include <algorithm>
 #include <cpu/embedding_feature_combiner_cpu.hpp>
+#include <cpu/gemm_cpu.hpp>
 #include <functional>
 #include <utils.hpp>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 namespace HugeCTR {
 
 namespace {
 
+inline void store(float* const dst, const float value) { *dst = value; }
+
+inline void store(__half* const dst, const float value) { *dst = __float2half(value); }
+
+// Combines \p num_rows rows of \p input into \p output . These are either the consecutive rows
+// starting at \p input , or the rows listed in \p indices (if not null). Rows are accumulated in
+// chunks, one contiguous row segment at a time.
 template <typename TypeEmbedding>
-void embedding_feature_combine_cpu(const float* input, TypeEmbedding* output, const int* row_ptrs,
-                                   int batch_size, int slot_num, int embedding_vec_size,
-                                   EmbeddingFeatureCombiner_t combiner_type) {
-  for (int i = 0; i < batch_size; i++) {
-    for (int j = 0; j < slot_num; j++) {
-      int feature_row_index = i * slot_num + j;
-      int row_offset = row_ptrs[feature_row_index];  // row offset within input
-      int feature_num =
-          row_ptrs[feature_row_index + 1] - row_offset;  // num of feature vectors in one slot
+void combine_rows(const float* const input, const int* const indices, const int num_rows,
+                  const int embedding_vec_size, const bool mean, TypeEmbedding* const output) {
+  constexpr int chunk_size{64};
+  float acc[chunk_size];
+  for (int k0 = 0; k0 < embedding_vec_size; k0 += chunk_size) {
+    const int n = std::min(chunk_size, embedding_vec_size - k0);
+    std::fill_n(acc, n, 0.0f);
+    for (int l = 0; l < num_rows; l++) {
+      const float* const row = &input[(indices ? indices[l] : l) * embedding_vec_size + k0];
+      for (int k = 0; k < n; k++) {
+        acc[k] += row[k];
+      }
+    }
+    for (int k = 0; k < n; k++) {
+      store(&output[k0 + k], mean ? acc[k] / num_rows : acc[k]);
+    }
+  }
+}
+
+#if defined(__x86_64__)
 
-      for (int k = 0; k < embedding_vec_size; k++) {
-        float tmp = 0.0f;
-        for (int l = 0; l < feature_num; l++) {
-          tmp += input[(row_offset + l) * embedding_vec_size + k];
-        }  // end for l
-        if (combiner_type == EmbeddingFeatureCombiner_t::Mean) tmp /= feature_num;
-        output[feature_row_index * embedding_vec_size + k] = tmp;
-      }  // end for k
-    }    // end for j
-  }      // end for i
+__attribute__((target("avx2"))) inline void store8(float* const dst, const __m256 value) {
+  _mm256_storeu_ps(dst, value);
 }
 
-template <>
-void embedding_feature_combine_cpu(const float* input, __half* output, const int* row_ptrs,
-                                   int batch_size, int slot_num, int embedding_vec_size,
+__attribute__((target("avx2,f16c"))) inline void store8(__half* const dst, const __m256 value) {
+  static_assert(sizeof(__half) == sizeof(uint16_t));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                   _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+// Same as combine_rows, but keeps 32 columns in registers.
+template <typename TypeEmbedding>
+__attribute__((target("avx2,f16c"))) void combine_rows_avx2(const float* const input,
+                                                           const int* const indices,
+                                                           const int num_rows,
+                                                           const int embedding_vec_size,
+                                                           const bool mean,
+                                                           TypeEmbedding* const output) {
+  const __m256 divisor = _mm256_set1_ps(static_cast<float>(num_rows));
+  int k0 = 0;
+  for (; k0 + 32 <= embedding_vec_size; k0 += 32) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    for (int l = 0; l < num_rows; l++) {
+      const float* const row = &input[(indices ? indices[l] : l) * embedding_vec_size + k0];
+      acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(&row[0]));
+      acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(&row[8]));
+      acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(&row[16]));
+      acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(&row[24]));
+    }
+    if (mean) {
+      acc0 = _mm256_div_ps(acc0, divisor);
+      acc1 = _mm256_div_ps(acc1, divisor);
+      acc2 = _mm256_div_ps(acc2, divisor);
+      acc3 = _mm256_div_ps(acc3, divisor);
+    }
+    store8(&output[k0], acc0);
+    store8(&output[k0 + 8], acc1);
+    store8(&output[k0 + 16], acc2);
+    store8(&output[k0 + 24], acc3);
+  }
+  for (; k0 + 8 <= embedding_vec_size; k0 += 8) {
+    __m256 acc = _mm256_setzero_ps();
+    for (int l = 0; l < num_rows; l++) {
+      const float* const row = &input[(indices ? indices[l] : l) * embedding_vec_size + k0];
+      acc = _mm256_add_ps(acc, _mm256_loadu_ps(row));
+    }
+    store8(&output[k0], mean ? _mm256_div_ps(acc, divisor) : acc);
+  }
+  for (; k0 < embedding_vec_size; k0++) {
+    float acc = 0.0f;
+    for (int l = 0; l < num_rows; l++) {
+      acc += input[(indices ? indices[l] : l) * embedding_vec_size + k0];
+    }
+    store(&output[k0], mean ? acc / num_rows : acc);
+  }
+}
+
+#endif
+
+template <typename TypeEmbedding>
+void embedding_feature_combine_cpu(const float* input, TypeEmbedding* output, const int* row_ptrs,
+                                   const int* row_indices, int batch_size, int slot_num,
+                                   int embedding_vec_size,
                                    EmbeddingFeatureCombiner_t combiner_type) {
-  for (int i = 0; i < batch_size; i++) {
-    for (int j = 0; j < slot_num; j++) {
-      int feature_row_index = i * slot_num + j;
+  static const auto combine{[]() {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) {
+      return combine_rows_avx2<TypeEmbedding>;
+    }
+#endif
+    return combine_rows<TypeEmbedding>;
+  }()};
+
+  // Each task combines a contiguous range of (sample, slot) pairs.
+  const int num_feature_rows = batch_size * slot_num;
+  const size_t num_adds = static_cast<size_t>(row_ptrs[num_feature_rows] - row_ptrs[0]) *
+                          static_cast<size_t>(embedding_vec_size);
+  const size_t adds_per_row = num_feature_rows > 0 ? num_adds / num_feature_rows : 0;
+
+  parallel_for_rows_cpu(num_feature_rows, adds_per_row, [&](const size_t begin, const size_t end) {
+    for (int feature_row_index = static_cast<int>(begin); feature_row_index < static_cast<int>(end);
+         feature_row_index++) {
       int row_offset = row_ptrs[feature_row_index];  // row offset within input
       int feature_num =
           row_ptrs[feature_row_index + 1] - row_offset;  // num of feature vectors in one slot
-
-      for (int k = 0; k < embedding_vec_size; k++) {
-        float tmp = 0.0f;
-        for (int l = 0; l < feature_num; l++) {
-          tmp += __half2float(input[(row_offset + l) * embedding_vec_size + k]);
-        }  // end for l
-        if (combiner_type == EmbeddingFeatureCombiner_t::Mean && feature_num > 1) {
-          tmp /= feature_num;
-        }
-        output[feature_row_index * embedding_vec_size + k] = __float2half(tmp);
-      }  // end for k
-    }    // end for j
-  }      // end for i
+      bool mean = combiner_type == EmbeddingFeatureCombiner_t::Mean && feature_num > 1;
+      if (row_indices) {
+        combine(input, &row_indices[row_offset], feature_num, embedding_vec_size, mean,
+                &output[feature_row_index * embedding_vec_size]);
+      } else {
+        combine(&input[row_offset * embedding_vec_size], nullptr, feature_num, embedding_vec_size,
+                mean, &output[feature_row_index * embedding_vec_size]);
+      }
+    }
+  });
 }
 
 }  // end of namespace
@@ -78,7 +164,8 @@ EmbeddingFeatureCombinerCPU<TypeEmbedding>::EmbeddingFeatureCombinerCPU(
     const std::shared_ptr<Tensor2<float>>& in_tensor,
     const std::shared_ptr<Tensor2<int>>& row_ptrs_tensor, Tensor2<TypeEmbedding>& out_tensor,
     int batch_size, int slot_num, EmbeddingFeatureCombiner_t combiner_type,
-    const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff)
+    const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
+    const std::shared_ptr<Tensor2<int>>& row_indices_tensor)
     : LayerCPU(), batch_size_(batch_size), slot_num_(slot_num), combiner_type_(combiner_type) {
   try {
     // error input checking
@@ -100,6 +187,9 @@ EmbeddingFeatureCombinerCPU<TypeEmbedding>::EmbeddingFeatureCombinerCPU(
       HCTR_OWN_THROW(Error_t::WrongInput,
                      "The dimension of row pointers tensor mismatch number of samples");
     }
+    if (row_indices_tensor && row_indices_tensor->get_dimensions().size() != 1) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "The row indices tensor must be 1D");
+    }
 
     embedding_vec_size_ = in_dims[1];
     std::vector<size_t> out_dims{static_cast<size_t>(batch_size_), static_cast<size_t>(slot_num_),
@@ -108,6 +198,9 @@ EmbeddingFeatureCombinerCPU<TypeEmbedding>::EmbeddingFeatureCombinerCPU(
     out_tensors_.push_back(out_tensor);
     in_tensors_.push_back(in_tensor);
     row_ptrs_tensors_.push_back(row_ptrs_tensor);
+    if (row_indices_tensor) {
+      row_indices_tensors_.push_back(row_indices_tensor);
+    }
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
     throw;
@@ -124,10 +217,11 @@ void EmbeddingFeatureCombinerCPU<TypeEmbedding>::fprop(bool is_train) {
   float* input = in_tensors_[0]->get_ptr();
   TypeEmbedding* output = out_tensors_[0].get_ptr();
   int* row_ptrs = row_ptrs_tensors_[0]->get_ptr();
+  int* row_indices = row_indices_tensors_.empty() ? nullptr : row_indices_tensors_[0]->get_ptr();
 
   auto in_dims = in_tensors_[0]->get_dimensions();
   auto out_dims = out_tensors_[0].get_dimensions();
-  embedding_feature_combine_cpu(input, output, row_ptrs, batch_size_, slot_num_,
+  embedding_feature_combine_cpu(input, output, row_ptrs, row_indices, batch_size_, slot_num_,
                                 embedding_vec_size_, combiner_type_);
 }
 
@@ -0,0 +1,1118 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cpu/gemm_cpu.hpp>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <thread_pool.hpp>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace HugeCTR {
+
+namespace {
+
+// Cache blocking. A packed `mc_max x kc_max` block of A is meant to stay in L2, and a packed
+// `kc_max x nc_max` block of B in L3. mc_max and nc_max must be multiples of MR and NR of all
+// micro-kernels.
+constexpr size_t kc_max{256};
+constexpr size_t mc_max{96};
+constexpr size_t nc_max{512};
+constexpr size_t max_mr{8};
+constexpr size_t max_nr{32};
+
+// Products with at most this many rows are computed without packing.
+constexpr size_t small_m_max{4};
+
+// Splitting products into less multiply-adds per thread does not pay off.
+constexpr size_t min_macs_per_thread{size_t{1} << 18};
+
+// Splitting row-wise work of the CPU layers into less work per task does not pay off.
+constexpr size_t min_row_work_per_task{size_t{1} << 16};
+
+// Computes the `MR x NR` tile `c = a * b`, where \p a is a packed micro-panel of \p kc columns with
+// MR elements each, and \p b is a packed micro-panel of \p kc rows with NR elements each.
+using MicroKernel = void (*)(size_t kc, const float* a, const float* b, float* c);
+
+// Dot product of two vectors of length \p k .
+using DotKernel = float (*)(size_t k, const float* a, const float* b);
+
+// y += alpha * x, where \p x and \p y are vectors of length \p n .
+using AxpyKernel = void (*)(size_t n, float alpha, const float* x, float* y);
+
+// Converts \p n fp16 values to fp32.
+using ConvertKernel = void (*)(size_t n, const __half* src, float* dst);
+
+struct Kernel final {
+  const char* isa;
+  size_t mr;
+  size_t nr;
+  MicroKernel gemm;
+  DotKernel dot;
+  AxpyKernel axpy;
+  ConvertKernel convert;
+};
+
+template <size_t MR, size_t NR>
+void micro_kernel_generic(const size_t kc, const float* a, const float* b, float* const c) {
+  float acc[MR][NR]{};
+  for (size_t p{0}; p < kc; ++p, a += MR, b += NR) {
+    for (size_t i{0}; i < MR; ++i) {
+      for (size_t j{0}; j < NR; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+  }
+  std::memcpy(c, acc, sizeof(acc));
+}
+
+float dot_generic(const size_t k, const float* const a, const float* const b) {
+  // Independent partial sums, which the compiler can map to vector lanes.
+  constexpr size_t width{8};
+  float acc[width]{};
+  size_t p{0};
+  for (; p + width <= k; p += width) {
+    for (size_t j{0}; j < width; ++j) {
+      acc[j] += a[p + j] * b[p + j];
+    }
+  }
+  float sum{0};
+  for (; p < k; ++p) {
+    sum += a[p] * b[p];
+  }
+  for (size_t j{0}; j < width; ++j) {
+    sum += acc[j];
+  }
+  return sum;
+}
+
+void axpy_generic(const size_t n, const float alpha, const float* const x, float* const y) {
+  for (size_t j{0}; j < n; ++j) {
+    y[j] += alpha * x[j];
+  }
+}
+
+void convert_generic(const size_t n, const __half* const src, float* const dst) {
+  for (size_t j{0}; j < n; ++j) {
+    dst[j] = __half2float(src[j]);
+  }
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2,fma"))) void micro_kernel_avx2(const size_t kc, const float* a,
+                                                           const float* b, float* const c) {
+  constexpr size_t mr{6};
+  __m256 acc[mr][2];
+#pragma GCC unroll 8
+  for (size_t i = 0; i < mr; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+  for (size_t p{0}; p < kc; ++p, a += mr, b += 16) {
+    const __m256 b0{_mm256_loadu_ps(b)};
+    const __m256 b1{_mm256_loadu_ps(b + 8)};
+#pragma GCC unroll 8
+    for (size_t i = 0; i < mr; ++i) {
+      const __m256 ai{_mm256_broadcast_ss(&a[i])};
+      acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+    }
+  }
+#pragma GCC unroll 8
+  for (size_t i = 0; i < mr; ++i) {
+    _mm256_storeu_ps(&c[i * 16], acc[i][0]);
+    _mm256_storeu_ps(&c[i * 16 + 8], acc[i][1]);
+  }
+}
+
+__attribute__((target("avx512f"))) void micro_kernel_avx512(const size_t kc, const float* a,
+                                                            const float* b, float* const c) {
+  constexpr size_t mr{8};
+  __m512 acc[mr][2];
+#pragma GCC unroll 8
+  for (size_t i = 0; i < mr; ++i) {
+    acc[i][0] = _mm512_setzero_ps();
+    acc[i][1] = _mm512_setzero_ps();
+  }
+  for (size_t p{0}; p < kc; ++p, a += mr, b += 32) {
+    const __m512 b0{_mm512_loadu_ps(b)};
+    const __m512 b1{_mm512_loadu_ps(b + 16)};
+#pragma GCC unroll 8
+    for (size_t i = 0; i < mr; ++i) {
+      const __m512 ai{_mm512_set1_ps(a[i])};
+      acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+    }
+  }
+#pragma GCC unroll 8
+  for (size_t i = 0; i < mr; ++i) {
+    _mm512_storeu_ps(&c[i * 32], acc[i][0]);
+    _mm512_storeu_ps(&c[i * 32 + 16], acc[i][1]);
+  }
+}
+
+__attribute__((target("avx2,fma"))) float dot_avx2(const size_t k, const float* const a,
+                                                   const float* const b) {
+  __m256 acc0{_mm256_setzero_ps()};
+  __m256 acc1{_mm256_setzero_ps()};
+  size_t p{0};
+  for (; p + 16 <= k; p += 16) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[p]), _mm256_loadu_ps(&b[p]), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[p + 8]), _mm256_loadu_ps(&b[p + 8]), acc1);
+  }
+  for (; p + 8 <= k; p += 8) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&a[p]), _mm256_loadu_ps(&b[p]), acc0);
+  }
+  const __m256 acc{_mm256_add_ps(acc0, acc1)};
+  __m128 sum{_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1))};
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+  float result{_mm_cvtss_f32(sum)};
+  for (; p < k; ++p) {
+    result += a[p] * b[p];
+  }
+  return result;
+}
+
+__attribute__((target("avx2,fma"))) void axpy_avx2(const size_t n, const float alpha,
+                                                   const float* const x, float* const y) {
+  const __m256 alpha8{_mm256_set1_ps(alpha)};
+  size_t j{0};
+  for (; j + 8 <= n; j += 8) {
+    const __m256 yj{_mm256_fmadd_ps(alpha8, _mm256_loadu_ps(&x[j]), _mm256_loadu_ps(&y[j]))};
+    _mm256_storeu_ps(&y[j], yj);
+  }
+  for (; j < n; ++j) {
+    y[j] += alpha * x[j];
+  }
+}
+
+__attribute__((target("avx,f16c"))) void convert_f16c(const size_t n, const __half* const src,
+                                                     float* const dst) {
+  static_assert(sizeof(__half) == sizeof(uint16_t));
+  size_t j{0};
+  for (; j + 8 <= n; j += 8) {
+    const __m128i h{_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[j]))};
+    _mm256_storeu_ps(&dst[j], _mm256_cvtph_ps(h));
+  }
+  for (; j < n; ++j) {
+    dst[j] = __half2float(src[j]);
+  }
+}
+
+#endif
+
+const Kernel& kernel() {
+  static const Kernel kernel{[]() -> Kernel {
+#if defined(__x86_64__)
+    // All CPUs with AVX-512 or AVX2 also support F16C.
+    if (__builtin_cpu_supports("avx512f")) {
+      return {"AVX-512", 8, 32, micro_kernel_avx512, dot_avx2, axpy_avx2, convert_f16c};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return {"AVX2", 6, 16, micro_kernel_avx2, dot_avx2, axpy_avx2, convert_f16c};
+    }
+#endif
+    return {"generic",    4,           16, micro_kernel_generic<4, 16>,
+            dot_generic, axpy_generic, convert_generic};
+  }()};
+  return kernel;
+}
+
+std::atomic<size_t> max_num_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+
+ThreadPool& thread_pool() {
+  static ThreadPool pool("cpu gemm", std::max(std::thread::hardware_concurrency(), 1U));
+  return pool;
+}
+
+inline size_t div_up(const size_t a, const size_t b) { return (a + b - 1) / b; }
+
+inline size_t round_up(const size_t a, const size_t b) { return div_up(a, b) * b; }
+
+inline size_t choose_num_threads(const size_t num_macs) {
+  return std::max<size_t>(std::min(max_num_threads.load(std::memory_order_relaxed),
+                                   num_macs / min_macs_per_thread),
+                          1);
+}
+
+// Runs \p func for all task indices in `[0, num_tasks)`. The calling thread participates. Hence,
+// this never waits for the pool to become available, even if it is saturated.
+template <typename Func>
+void parallel_for(const size_t num_tasks, size_t num_threads, const Func& func) {
+  num_threads = std::min(num_threads, num_tasks);
+  if (num_threads <= 1) {
+    for (size_t task{0}; task < num_tasks; ++task) {
+      func(task);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_task{0};
+  const auto run{[&]() {
+    for (size_t task; (task = next_task.fetch_add(1, std::memory_order_relaxed)) < num_tasks;) {
+      func(task);
+    }
+  }};
+
+  std::vector<std::future<void>> helpers;
+  helpers.reserve(num_threads - 1);
+  ThreadPool& pool{thread_pool()};
+  for (size_t i{1}; i < num_threads; ++i) {
+    helpers.emplace_back(pool.submit(run));
+  }
+  try {
+    run();
+  } catch (...) {
+    for (auto& helper : helpers) {
+      helper.wait();
+    }
+    throw;
+  }
+  ThreadPool::await(helpers.begin(), helpers.end());
+}
+
+inline float to_float(const float x) { return x; }
+
+inline float to_float(const __half x) { return __half2float(x); }
+
+// Converts \p n consecutive inputs to fp32. Returns \p src if no conversion is required.
+inline const float* to_float(size_t, const float* const src, std::vector<float>&) {
+  return src;
+}
+
+inline const float* to_float(const size_t n, const __half* const src, std::vector<float>& buffer) {
+  buffer.resize(n);
+  kernel().convert(n, src, buffer.data());
+  return buffer.data();
+}
+
+// Packs the `mc x kc` block of A into micro-panels of `mr` rows, stored column by column. Missing
+// rows are zero-padded.
+template <typename T>
+void pack_a(const T* const a, const size_t lda, const size_t mc, const size_t kc, const size_t mr,
+            float* packed) {
+  thread_local std::vector<float> buffer;
+  for (size_t ir{0}; ir < mc; ir += mr, packed += mr * kc) {
+    const size_t rows{std::min(mr, mc - ir)};
+    for (size_t i{0}; i < rows; ++i) {
+      const float* const src{to_float(kc, &a[(ir + i) * lda], buffer)};
+      for (size_t p{0}; p < kc; ++p) {
+        packed[p * mr + i] = src[p];
+      }
+    }
+    for (size_t i{rows}; i < mr; ++i) {
+      for (size_t p{0}; p < kc; ++p) {
+        packed[p * mr + i] = 0;
+      }
+    }
+  }
+}
+
+// Packs the `kc x nc` block of B into micro-panels of `nr` columns, stored row by row. Missing
+// columns are zero-padded.
+template <typename T>
+void pack_b(const T* const b, const size_t ldb, const size_t kc, const size_t nc, const size_t nr,
+            float* packed) {
+  for (size_t jr{0}; jr < nc; jr += nr) {
+    const size_t cols{std::min(nr, nc - jr)};
+    for (size_t p{0}; p < kc; ++p, packed += nr) {
+      const T* const src{&b[p * ldb + jr]};
+      if constexpr (std::is_same_v<T, float>) {
+        std::memcpy(packed, src, cols * sizeof(float));
+      } else {
+        kernel().convert(cols, src, packed);
+      }
+      std::fill(packed + cols, packed + nr, 0.f);
+    }
+  }
+}
+
+// Packs the `k x n` matrix B into \p packed . Each `kc_max x n` block is stored as micro-panels of
+// NR columns (see \p pack_b ). That is, the panel at row \p p0 and column \p j0 (multiples of
+// kc_max and NR) begins at `p0 * round_up(n, NR) + j0 * kc`.
+template <typename T>
+void pack_matrix(const size_t k, const size_t n, const T* const b, const size_t num_threads,
+                 std::vector<float>& packed) {
+  const Kernel& kern{kernel()};
+  const size_t ldp{round_up(n, kern.nr)};
+  packed.resize(k * ldp);
+
+  const size_t k_blocks{div_up(k, kc_max)};
+  const size_t n_blocks{div_up(n, nc_max)};
+  parallel_for(k_blocks * n_blocks, num_threads, [&](const size_t task) {
+    const size_t p0{task / n_blocks * kc_max};
+    const size_t j0{task % n_blocks * nc_max};
+    const size_t kc{std::min(kc_max, k - p0)};
+    pack_b(&b[p0 * n + j0], n, kc, std::min(nc_max, n - j0), kern.nr,
+           &packed[p0 * ldp + j0 * kc]);
+  });
+}
+
+// Applies \p epilogue to the `mc x nc` block of C at column \p j0 , while it is still in cache.
+void apply_epilogue(const GemmEpilogueCPU& epilogue, const size_t mc, const size_t nc,
+                    const size_t j0, float* const c_block, const size_t ldc) {
+  if (!epilogue.bias && !epilogue.relu) {
+    return;
+  }
+  for (size_t i{0}; i < mc; ++i) {
+    float* const row{&c_block[i * ldc]};
+    if (epilogue.bias) {
+      const float* const bias{&epilogue.bias[j0]};
+      for (size_t j{0}; j < nc; ++j) {
+        row[j] += bias[j];
+      }
+    }
+    if (epilogue.relu) {
+      for (size_t j{0}; j < nc; ++j) {
+        row[j] = std::max(row[j], 0.f);
+      }
+    }
+  }
+}
+
+// Computes the `mc x nc` block of C at row \p i0 and column \p j0 , where \p b_packed is B packed
+// by \p pack_matrix . j0 must be a multiple of NR.
+template <typename TIn, typename TOut>
+void gemm_block(const size_t n, const size_t k, const TIn* const a, const float* const b_packed,
+                TOut* const c, const bool accumulate, const GemmEpilogueCPU& epilogue,
+                const size_t i0, const size_t mc, const size_t j0, const size_t nc) {
+  const Kernel& kern{kernel()};
+  const size_t ldp{round_up(n, kern.nr)};
+
+  thread_local std::vector<float> a_packed;
+  a_packed.resize(round_up(mc, kern.mr) * kc_max);
+
+  // Partial sums of reduced precision outputs are kept in fp32.
+  float* c_block;
+  size_t ldc;
+  thread_local std::vector<float> c_buffer;
+  if constexpr (std::is_same_v<TOut, float>) {
+    c_block = &c[i0 * n + j0];
+    ldc = n;
+  } else {
+    c_buffer.resize(mc * nc);
+    c_block = c_buffer.data();
+    ldc = nc;
+    if (accumulate) {
+      for (size_t i{0}; i < mc; ++i) {
+        for (size_t j{0}; j < nc; ++j) {
+          c_block[i * ldc + j] = to_float(c[(i0 + i) * n + j0 + j]);
+        }
+      }
+    }
+  }
+
+  float tile[max_mr * max_nr];
+  for (size_t p0{0}; p0 < k; p0 += kc_max) {
+    const size_t kc{std::min(kc_max, k - p0)};
+    pack_a(&a[i0 * k + p0], k, mc, kc, kern.mr, a_packed.data());
+
+    const bool add{accumulate || p0 > 0};
+    for (size_t jr{0}; jr < nc; jr += kern.nr) {
+      const size_t cols{std::min(kern.nr, nc - jr)};
+      const float* const b_panel{&b_packed[p0 * ldp + (j0 + jr) * kc]};
+      for (size_t ir{0}; ir < mc; ir += kern.mr) {
+        const size_t rows{std::min(kern.mr, mc - ir)};
+        kern.gemm(kc, &a_packed[ir * kc], b_panel, tile);
+
+        float* const dst{&c_block[ir * ldc + jr]};
+        for (size_t i{0}; i < rows; ++i) {
+          const float* const src{&tile[i * kern.nr]};
+          float* const dst_row{&dst[i * ldc]};
+          if (add) {
+            for (size_t j{0}; j < cols; ++j) {
+              dst_row[j] += src[j];
+            }
+          } else {
+            std::copy_n(src, cols, dst_row);
+          }
+        }
+      }
+    }
+  }
+  apply_epilogue(epilogue, mc, nc, j0, c_block, ldc);
+
+  if constexpr (!std::is_same_v<TOut, float>) {
+    for (size_t i{0}; i < mc; ++i) {
+      for (size_t j{0}; j < nc; ++j) {
+        c[(i0 + i) * n + j0 + j] = __float2half(c_block[i * ldc + j]);
+      }
+    }
+  }
+}
+
+// Computes columns `[j0, j0 + nc)` of C without packing, which does not pay off for few rows.
+template <typename TIn, typename TOut>
+void gemm_small_m(const size_t m, const size_t n, const size_t k, const TIn* const a,
+                  const TIn* const b, TOut* const c, const bool accumulate,
+                  const GemmEpilogueCPU& epilogue, const size_t j0, const size_t nc) {
+  const Kernel& kern{kernel()};
+
+  float* c_block;
+  size_t ldc;
+  thread_local std::vector<float> c_buffer;
+  if constexpr (std::is_same_v<TOut, float>) {
+    c_block = &c[j0];
+    ldc = n;
+  } else {
+    c_buffer.resize(m * nc);
+    c_block = c_buffer.data();
+    ldc = nc;
+  }
+  for (size_t i{0}; i < m; ++i) {
+    float* const dst{&c_block[i * ldc]};
+    if (!accumulate) {
+      std::fill_n(dst, nc, 0.f);
+    } else if constexpr (!std::is_same_v<TOut, float>) {
+      kern.convert(nc, &c[i * n + j0], dst);
+    }
+  }
+
+  thread_local std::vector<float> buffer;
+  for (size_t p{0}; p < k; ++p) {
+    const float* const b_row{to_float(nc, &b[p * n + j0], buffer)};
+    for (size_t i{0}; i < m; ++i) {
+      kern.axpy(nc, to_float(a[i * k + p]), b_row, &c_block[i * ldc]);
+    }
+  }
+  apply_epilogue(epilogue, m, nc, j0, c_block, ldc);
+
+  if constexpr (!std::is_same_v<TOut, float>) {
+    for (size_t i{0}; i < m; ++i) {
+      for (size_t j{0}; j < nc; ++j) {
+        c[i * n + j0 + j] = __float2half(c_block[i * ldc + j]);
+      }
+    }
+  }
+}
+
+// Handles empty products. Returns false if there is something to multiply.
+template <typename TOut>
+bool gemm_trivial(const size_t m, const size_t n, const size_t k, TOut* const c,
+                  const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  if (m == 0 || n == 0) {
+    return true;
+  }
+  if (k == 0) {
+    for (size_t i{0}; i < m; ++i) {
+      for (size_t j{0}; j < n; ++j) {
+        float value{accumulate ? to_float(c[i * n + j]) : 0.f};
+        if (epilogue.bias) {
+          value += epilogue.bias[j];
+        }
+        if (epilogue.relu) {
+          value = std::max(value, 0.f);
+        }
+        c[i * n + j] = TOut(value);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+// Multiplies A by B, which was packed by \p pack_matrix .
+template <typename TIn, typename TOut>
+void gemm_packed(const size_t m, const size_t n, const size_t k, const TIn* const a,
+                 const float* const b_packed, TOut* const c, const bool accumulate,
+                 const GemmEpilogueCPU& epilogue, const size_t num_threads) {
+  const Kernel& kern{kernel()};
+
+  // Split M and N into blocks. If there are fewer blocks than threads, N is split further.
+  const size_t m_blocks{div_up(m, mc_max)};
+  size_t n_blocks{div_up(n, nc_max)};
+  if (m_blocks * n_blocks < num_threads) {
+    n_blocks = std::min(div_up(num_threads, m_blocks), div_up(n, kern.nr));
+  }
+  const size_t mc{round_up(div_up(m, m_blocks), kern.mr)};
+  const size_t nc{round_up(div_up(n, n_blocks), kern.nr)};
+  n_blocks = div_up(n, nc);
+
+  parallel_for(m_blocks * n_blocks, num_threads, [&](const size_t task) {
+    const size_t i0{task / n_blocks * mc};
+    const size_t j0{task % n_blocks * nc};
+    gemm_block(n, k, a, b_packed, c, accumulate, epilogue, i0, std::min(mc, m - i0), j0,
+               std::min(nc, n - j0));
+  });
+}
+
+template <typename TIn, typename TOut>
+void gemm(const size_t m, const size_t n, const size_t k, const TIn* const a, const TIn* const b,
+          TOut* const c, const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  if (gemm_trivial(m, n, k, c, accumulate, epilogue)) {
+    return;
+  }
+
+  const Kernel& kern{kernel()};
+  const size_t num_threads{choose_num_threads(m * n * k)};
+
+  if (m <= small_m_max) {
+    const size_t nc{round_up(div_up(n, num_threads), kern.nr)};
+    parallel_for(div_up(n, nc), num_threads, [&](const size_t task) {
+      const size_t j0{task * nc};
+      gemm_small_m(m, n, k, a, b, c, accumulate, epilogue, j0, std::min(nc, n - j0));
+    });
+    return;
+  }
+
+  // B is packed once, and shared by all blocks along M.
+  thread_local std::vector<float> b_packed;
+  pack_matrix(k, n, b, num_threads, b_packed);
+  gemm_packed(m, n, k, a, b_packed.data(), c, accumulate, epilogue, num_threads);
+}
+
+template <typename TIn, typename TOut>
+void gemm(const size_t m, const TIn* const a, const PackedMatrixCPU& b, TOut* const c,
+          const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  const size_t n{b.get_n()};
+  const size_t k{b.get_k()};
+  if (gemm_trivial(m, n, k, c, accumulate, epilogue)) {
+    return;
+  }
+
+  // Few rows are computed by the same kernel. Packing A costs next to nothing then.
+  gemm_packed(m, n, k, a, b.get_packed(), c, accumulate, epilogue,
+              choose_num_threads(m * n * k));
+}
+
+// Packs \p m rows (given by pointers) of a `m x kc` block at column \p p0 into micro-panels of
+// `mr` rows, stored column by column. Missing rows are zero-padded.
+template <typename T>
+void pack_rows(const T* const* const rows, const size_t m, const size_t p0, const size_t kc,
+               const size_t mr, float* packed) {
+  thread_local std::vector<float> buffer;
+  for (size_t ir{0}; ir < m; ir += mr, packed += mr * kc) {
+    const size_t num_rows{std::min(mr, m - ir)};
+    for (size_t i{0}; i < num_rows; ++i) {
+      const float* const src{to_float(kc, &rows[ir + i][p0], buffer)};
+      for (size_t p{0}; p < kc; ++p) {
+        packed[p * mr + i] = src[p];
+      }
+    }
+    for (size_t i{num_rows}; i < mr; ++i) {
+      for (size_t p{0}; p < kc; ++p) {
+        packed[p * mr + i] = 0;
+      }
+    }
+  }
+}
+
+// X is packed twice, once as A (micro-panels of MR rows), and once as B = X^T (micro-panels of NR
+// columns, which have the same layout as micro-panels of NR rows of X).
+template <typename T>
+void gram_lower(const size_t m, const size_t k, const T* const* const rows, float* out) {
+  const Kernel& kern{kernel()};
+
+  thread_local std::vector<float> a_packed;
+  thread_local std::vector<float> b_packed;
+  thread_local std::vector<float> gram;
+  a_packed.resize(round_up(m, kern.mr) * std::min(k, kc_max));
+  b_packed.resize(round_up(m, kern.nr) * std::min(k, kc_max));
+  gram.assign(m * m, 0.f);
+
+  float tile[max_mr * max_nr];
+  for (size_t p0{0}; p0 < k; p0 += kc_max) {
+    const size_t kc{std::min(kc_max, k - p0)};
+    pack_rows(rows, m, p0, kc, kern.mr, a_packed.data());
+    pack_rows(rows, m, p0, kc, kern.nr, b_packed.data());
+
+    for (size_t jr{0}; jr < m; jr += kern.nr) {
+      const size_t cols{std::min(kern.nr, m - jr)};
+      for (size_t ir{0}; ir < m; ir += kern.mr) {
+        const size_t num_rows{std::min(kern.mr, m - ir)};
+        if (ir + num_rows <= jr + 1) {
+          continue;  // Above the diagonal.
+        }
+        kern.gemm(kc, &a_packed[ir * kc], &b_packed[jr * kc], tile);
+        for (size_t i{0}; i < num_rows; ++i) {
+          float* const dst{&gram[(ir + i) * m + jr]};
+          for (size_t j{0}; j < cols; ++j) {
+            dst[j] += tile[i * kern.nr + j];
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t i{1}; i < m; ++i) {
+    out = std::copy_n(&gram[i * m], i, out);
+  }
+}
+
+// Int8 GEMM. Products of quantized values are accumulated in int32. The micro-kernels multiply
+// groups of consecutive elements along K at once. With AVX2 and VNNI, a group consists of 4
+// unsigned (A) and 4 signed (B) 8-bit values. Hence, A is offset by 128, which is compensated with
+// the column sums of B. AVX2 adds pairs of products in 16 bits. To avoid saturation, B is limited
+// to 7 bits. The portable kernel multiplies pairs of 16-bit values.
+
+// Computes the int32 `MR x NR` tile `c = a * b`, where \p a is a packed micro-panel of
+// \p num_groups groups of MR x group values, and \p b of NR x group values.
+using Int8MicroKernel = void (*)(size_t num_groups, const void* a, const void* b, int32_t* c);
+
+struct Int8Kernel final {
+  const char* isa;
+  size_t mr;
+  size_t nr;
+  size_t group;
+  bool unsigned_a;  // If set, A is stored as uint8_t (offset by 128) and B as int8_t. Otherwise,
+                    // both are stored as int16_t.
+  float max_b;      // Largest magnitude of quantized values of B.
+  Int8MicroKernel gemm;
+};
+
+template <size_t MR, size_t NR>
+void int8_micro_kernel_generic(const size_t num_groups, const void* const a_packed,
+                               const void* const b_packed, int32_t* const c) {
+  const int16_t* a{static_cast<const int16_t*>(a_packed)};
+  const int16_t* b{static_cast<const int16_t*>(b_packed)};
+  int32_t acc[MR][NR]{};
+  for (size_t g{0}; g < num_groups; ++g, a += 2 * MR, b += 2 * NR) {
+    for (size_t i{0}; i < MR; ++i) {
+      for (size_t j{0}; j < NR; ++j) {
+        acc[i][j] += a[2 * i] * b[2 * j] + a[2 * i + 1] * b[2 * j + 1];
+      }
+    }
+  }
+  std::memcpy(c, acc, sizeof(acc));
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2"))) void int8_micro_kernel_avx2(const size_t num_groups,
+                                                            const void* const a_packed,
+                                                            const void* const b_packed,
+                                                            int32_t* const c) {
+  constexpr size_t mr{6};
+  const uint8_t* a{static_cast<const uint8_t*>(a_packed)};
+  const int8_t* b{static_cast<const int8_t*>(b_packed)};
+  const __m256i ones{_mm256_set1_epi16(1)};
+  __m256i acc[mr][2];
+  for (size_t i{0}; i < mr; ++i) {
+    acc[i][0] = _mm256_setzero_si256();
+    acc[i][1] = _mm256_setzero_si256();
+  }
+  for (size_t g{0}; g < num_groups; ++g, a += 4 * mr, b += 64) {
+    const __m256i b0{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b))};
+    const __m256i b1{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32))};
+    for (size_t i{0}; i < mr; ++i) {
+      int32_t quad;
+      std::memcpy(&quad, &a[4 * i], sizeof(quad));
+      const __m256i ai{_mm256_set1_epi32(quad)};
+      acc[i][0] =
+          _mm256_add_epi32(acc[i][0], _mm256_madd_epi16(_mm256_maddubs_epi16(ai, b0), ones));
+      acc[i][1] =
+          _mm256_add_epi32(acc[i][1], _mm256_madd_epi16(_mm256_maddubs_epi16(ai, b1), ones));
+    }
+  }
+  for (size_t i{0}; i < mr; ++i) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&c[i * 16]), acc[i][0]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&c[i * 16 + 8]), acc[i][1]);
+  }
+}
+
+__attribute__((target("avx512f,avx512vnni"))) void int8_micro_kernel_avx512_vnni(
+    const size_t num_groups, const void* const a_packed, const void* const b_packed,
+    int32_t* const c) {
+  constexpr size_t mr{8};
+  const uint8_t* a{static_cast<const uint8_t*>(a_packed)};
+  const int8_t* b{static_cast<const int8_t*>(b_packed)};
+  __m512i acc[mr][2];
+  for (size_t i{0}; i < mr; ++i) {
+    acc[i][0] = _mm512_setzero_si512();
+    acc[i][1] = _mm512_setzero_si512();
+  }
+  for (size_t g{0}; g < num_groups; ++g, a += 4 * mr, b += 128) {
+    const __m512i b0{_mm512_loadu_si512(b)};
+    const __m512i b1{_mm512_loadu_si512(b + 64)};
+    for (size_t i{0}; i < mr; ++i) {
+      int32_t quad;
+      std::memcpy(&quad, &a[4 * i], sizeof(quad));
+      const __m512i ai{_mm512_set1_epi32(quad)};
+      acc[i][0] = _mm512_dpbusd_epi32(acc[i][0], ai, b0);
+      acc[i][1] = _mm512_dpbusd_epi32(acc[i][1], ai, b1);
+    }
+  }
+  for (size_t i{0}; i < mr; ++i) {
+    _mm512_storeu_si512(&c[i * 32], acc[i][0]);
+    _mm512_storeu_si512(&c[i * 32 + 16], acc[i][1]);
+  }
+}
+
+#endif
+
+const Int8Kernel& int8_kernel() {
+  static const Int8Kernel kernel{[]() -> Int8Kernel {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vnni")) {
+      return {"AVX-512 VNNI", 8, 32, 4, true, 127, int8_micro_kernel_avx512_vnni};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return {"AVX2", 6, 16, 4, true, 63, int8_micro_kernel_avx2};
+    }
+#endif
+    return {"generic", 4, 16, 2, false, 127, int8_micro_kernel_generic<4, 16>};
+  }()};
+  return kernel;
+}
+
+// Rounds to the nearest quantized value in `[-127, 127]`.
+inline int32_t quantize(const float x, const float inv_scale) {
+  const float y{std::min(std::max(x * inv_scale, -127.f), 127.f)};
+  return static_cast<int32_t>(y + std::copysign(0.5f, y));
+}
+
+// Index of element (i, p) of a matrix that is packed into micro-panels of `mr` rows (or columns),
+// each of which is stored group by group.
+inline size_t int8_packed_index(const size_t i, const size_t p, const size_t mr,
+                                const size_t num_groups, const size_t group) {
+  return ((i / mr * num_groups + p / group) * mr + i % mr) * group + p % group;
+}
+
+template <typename TValue>
+inline void store_quantized(int8_t* const packed, const size_t index, const int32_t value) {
+  reinterpret_cast<TValue*>(packed)[index] = static_cast<TValue>(value);
+}
+
+// Quantizes \p k consecutive values, and adds \p offset .
+template <typename TValue>
+void quantize_row(const size_t k, const float* const src, const float inv_scale,
+                  const int32_t offset, TValue* const dst) {
+  for (size_t p{0}; p < k; ++p) {
+    dst[p] = static_cast<TValue>(quantize(src[p], inv_scale) + offset);
+  }
+}
+
+// Quantizes the first \p mc rows of A, and packs them into micro-panels. Stores the scale of each
+// row in \p row_scales . Rows are quantized contiguously, and then scattered group by group (a
+// group occupies 4 bytes with all micro-kernels).
+template <typename T>
+void pack_a_int8(const T* const a, const size_t k, const size_t mc, const float a_scale,
+                 int8_t* const packed, float* const row_scales) {
+  const Int8Kernel& kern{int8_kernel()};
+  const size_t num_groups{div_up(k, kern.group)};
+  constexpr size_t group_size{4};
+
+  thread_local std::vector<float> buffer;
+  thread_local std::vector<int8_t> row;
+  row.assign(num_groups * group_size, 0);
+  for (size_t i{0}; i < mc; ++i) {
+    const float* const src{to_float(k, &a[i * k], buffer)};
+    const float scale{a_scale > 0 ? a_scale : abs_max_cpu(k, src) / 127.f};
+    const float inv_scale{scale > 0 ? 1 / scale : 0.f};
+    row_scales[i] = scale;
+    if (kern.unsigned_a) {
+      quantize_row(k, src, inv_scale, 128, reinterpret_cast<uint8_t*>(row.data()));
+    } else {
+      quantize_row(k, src, inv_scale, 0, reinterpret_cast<int16_t*>(row.data()));
+    }
+
+    int8_t* const dst{&packed[(i / kern.mr * num_groups * kern.mr + i % kern.mr) * group_size]};
+    for (size_t g{0}; g < num_groups; ++g) {
+      std::memcpy(&dst[g * kern.mr * group_size], &row[g * group_size], group_size);
+    }
+  }
+}
+
+// Computes the `mc x nc` block of C at row \p i0 and column \p j0 . j0 must be a multiple of NR.
+template <typename TIn, typename TOut>
+void gemm_int8_block(const TIn* const a, const float a_scale, const Int8MatrixCPU& b,
+                     TOut* const c, const bool accumulate, const GemmEpilogueCPU& epilogue,
+                     const size_t i0, const size_t mc, const size_t j0, const size_t nc) {
+  const Int8Kernel& kern{int8_kernel()};
+  const size_t n{b.get_n()};
+  const size_t k{b.get_k()};
+  const size_t num_groups{div_up(k, kern.group)};
+  const size_t panel_size{num_groups * kern.group * (kern.unsigned_a ? 1 : 2)};
+
+  thread_local std::vector<int8_t> a_packed;
+  thread_local std::vector<float> row_scales;
+  a_packed.assign(round_up(mc, kern.mr) * panel_size, 0);
+  row_scales.resize(mc);
+  pack_a_int8(&a[i0 * k], k, mc, a_scale, a_packed.data(), row_scales.data());
+
+  float* c_block;
+  size_t ldc;
+  thread_local std::vector<float> c_buffer;
+  if constexpr (std::is_same_v<TOut, float>) {
+    c_block = &c[i0 * n + j0];
+    ldc = n;
+  } else {
+    c_buffer.resize(mc * nc);
+    c_block = c_buffer.data();
+    ldc = nc;
+    if (accumulate) {
+      for (size_t i{0}; i < mc; ++i) {
+        for (size_t j{0}; j < nc; ++j) {
+          c_block[i * ldc + j] = to_float(c[(i0 + i) * n + j0 + j]);
+        }
+      }
+    }
+  }
+
+  const float* const b_scales{&b.get_scales()[j0]};
+  const int32_t* const b_sums{&b.get_column_sums()[j0]};
+  int32_t tile[max_mr * max_nr];
+  for (size_t jr{0}; jr < nc; jr += kern.nr) {
+    const size_t cols{std::min(kern.nr, nc - jr)};
+    const int8_t* const b_panel{&b.get_packed()[(j0 + jr) * panel_size]};
+    for (size_t ir{0}; ir < mc; ir += kern.mr) {
+      const size_t rows{std::min(kern.mr, mc - ir)};
+      kern.gemm(num_groups, &a_packed[ir * panel_size], b_panel, tile);
+
+      // Dequantize.
+      for (size_t i{0}; i < rows; ++i) {
+        const int32_t* const src{&tile[i * kern.nr]};
+        float* const dst{&c_block[(ir + i) * ldc + jr]};
+        const float a_row_scale{row_scales[ir + i]};
+        for (size_t j{0}; j < cols; ++j) {
+          const int32_t offset{kern.unsigned_a ? 128 * b_sums[jr + j] : 0};
+          const float value{a_row_scale * b_scales[jr + j] * static_cast<float>(src[j] - offset)};
+          dst[j] = accumulate ? dst[j] + value : value;
+        }
+      }
+    }
+  }
+  apply_epilogue(epilogue, mc, nc, j0, c_block, ldc);
+
+  if constexpr (!std::is_same_v<TOut, float>) {
+    for (size_t i{0}; i < mc; ++i) {
+      for (size_t j{0}; j < nc; ++j) {
+        c[(i0 + i) * n + j0 + j] = __float2half(c_block[i * ldc + j]);
+      }
+    }
+  }
+}
+
+template <typename TIn, typename TOut>
+void gemm_int8(const size_t m, const TIn* const a, const float a_scale, const Int8MatrixCPU& b,
+               TOut* const c, const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  const size_t n{b.get_n()};
+  if (m == 0 || n == 0) {
+    return;
+  }
+
+  // Same split as the fp32 product. An int8 multiply-add costs a fraction of an fp32 one.
+  const Int8Kernel& kern{int8_kernel()};
+  const size_t num_threads{choose_num_threads(m * n * b.get_k() / 4)};
+  const size_t m_blocks{div_up(m, mc_max)};
+  size_t n_blocks{div_up(n, nc_max)};
+  if (m_blocks * n_blocks < num_threads) {
+    n_blocks = std::min(div_up(num_threads, m_blocks), div_up(n, kern.nr));
+  }
+  const size_t mc{round_up(div_up(m, m_blocks), kern.mr)};
+  const size_t nc{round_up(div_up(n, n_blocks), kern.nr)};
+  n_blocks = div_up(n, nc);
+
+  parallel_for(m_blocks * n_blocks, num_threads, [&](const size_t task) {
+    const size_t i0{task / n_blocks * mc};
+    const size_t j0{task % n_blocks * nc};
+    gemm_int8_block(a, a_scale, b, c, accumulate, epilogue, i0, std::min(mc, m - i0), j0,
+                    std::min(nc, n - j0));
+  });
+}
+
+}  // namespace
+
+void gemm_cpu(const size_t m, const size_t n, const size_t k, const float* const a,
+              const float* const b, float* const c, const bool accumulate,
+              const GemmEpilogueCPU& epilogue) {
+  gemm(m, n, k, a, b, c, accumulate, epilogue);
+}
+
+void gemm_cpu(const size_t m, const size_t n, const size_t k, const __half* const a,
+              const __half* const b, float* const c, const bool accumulate,
+              const GemmEpilogueCPU& epilogue) {
+  gemm(m, n, k, a, b, c, accumulate, epilogue);
+}
+
+void gemm_cpu(const size_t m, const size_t n, const size_t k, const __half* const a,
+              const __half* const b, __half* const c, const bool accumulate,
+              const GemmEpilogueCPU& epilogue) {
+  gemm(m, n, k, a, b, c, accumulate, epilogue);
+}
+
+PackedMatrixCPU::PackedMatrixCPU(const size_t k, const size_t n, const float* const b)
+    : k_(k), n_(n) {
+  pack_matrix(k, n, b, choose_num_threads(k * n), packed_);
+}
+
+PackedMatrixCPU::PackedMatrixCPU(const size_t k, const size_t n, const __half* const b)
+    : k_(k), n_(n) {
+  pack_matrix(k, n, b, choose_num_threads(k * n), packed_);
+}
+
+void gemm_cpu(const size_t m, const float* const a, const PackedMatrixCPU& b, float* const c,
+              const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  gemm(m, a, b, c, accumulate, epilogue);
+}
+
+void gemm_cpu(const size_t m, const __half* const a, const PackedMatrixCPU& b, float* const c,
+              const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  gemm(m, a, b, c, accumulate, epilogue);
+}
+
+void gemm_cpu(const size_t m, const __half* const a, const PackedMatrixCPU& b, __half* const c,
+              const bool accumulate, const GemmEpilogueCPU& epilogue) {
+  gemm(m, a, b, c, accumulate, epilogue);
+}
+
+Int8MatrixCPU::Int8MatrixCPU(const size_t k, const size_t n, const float* const b)
+    : k_(k), n_(n), scales_(n, 0.f), column_sums_(n, 0) {
+  for (size_t p{0}; p < k; ++p) {
+    for (size_t j{0}; j < n; ++j) {
+      scales_[j] = std::max(scales_[j], std::abs(b[p * n + j]));
+    }
+  }
+  const Int8Kernel& kern{int8_kernel()};
+  std::vector<float> inv_scales(n);
+  for (size_t j{0}; j < n; ++j) {
+    scales_[j] /= kern.max_b;
+    inv_scales[j] = scales_[j] > 0 ? 1 / scales_[j] : 0.f;
+  }
+
+  const size_t num_groups{div_up(k, kern.group)};
+  const size_t value_size{kern.unsigned_a ? sizeof(int8_t) : sizeof(int16_t)};
+  packed_.assign(round_up(n, kern.nr) * num_groups * kern.group * value_size, 0);
+  for (size_t p{0}; p < k; ++p) {
+    for (size_t j{0}; j < n; ++j) {
+      const size_t index{int8_packed_index(j, p, kern.nr, num_groups, kern.group)};
+      const int32_t value{quantize(b[p * n + j], inv_scales[j])};
+      column_sums_[j] += value;
+      if (kern.unsigned_a) {
+        store_quantized<int8_t>(packed_.data(), index, value);
+      } else {
+        store_quantized<int16_t>(packed_.data(), index, value);
+      }
+    }
+  }
+}
+
+void gemm_int8_cpu(const size_t m, const float* const a, const float a_scale,
+                   const Int8MatrixCPU& b, float* const c, const bool accumulate,
+                   const GemmEpilogueCPU& epilogue) {
+  gemm_int8(m, a, a_scale, b, c, accumulate, epilogue);
+}
+
+void gemm_int8_cpu(const size_t m, const __half* const a, const float a_scale,
+                   const Int8MatrixCPU& b, float* const c, const bool accumulate,
+                   const GemmEpilogueCPU& epilogue) {
+  gemm_int8(m, a, a_scale, b, c, accumulate, epilogue);
+}
+
+void gemm_int8_cpu(const size_t m, const __half* const a, const float a_scale,
+                   const Int8MatrixCPU& b, __half* const c, const bool accumulate,
+                   const GemmEpilogueCPU& epilogue) {
+  gemm_int8(m, a, a_scale, b, c, accumulate, epilogue);
+}
+
+void convert_cpu(const size_t n, const float* const src, __half* const dst) {
+  for (size_t i{0}; i < n; ++i) {
+    dst[i] = __float2half(src[i]);
+  }
+}
+
+float abs_max_cpu(const size_t n, const float* const x) {
+  // Independent partial maxima, which the compiler maps to vector registers.
+  constexpr size_t width{8};
+  float partial[width]{};
+  size_t i{0};
+  for (; i + width <= n; i += width) {
+    for (size_t t{0}; t < width; ++t) {
+      partial[t] = std::max(partial[t], std::abs(x[i + t]));
+    }
+  }
+  float result{*std::max_element(partial, partial + width)};
+  for (; i < n; ++i) {
+    result = std::max(result, std::abs(x[i]));
+  }
+  return result;
+}
+
+float abs_max_cpu(const size_t n, const __half* const x) {
+  constexpr size_t chunk_size{1024};
+  float buffer[chunk_size];
+  float result{0};
+  for (size_t i{0}; i < n; i += chunk_size) {
+    const size_t len{std::min(chunk_size, n - i)};
+    kernel().convert(len, &x[i], buffer);
+    result = std::max(result, abs_max_cpu(len, buffer));
+  }
+  return result;
+}
+
+void gemv_cpu(const size_t m, const size_t k, const float* const a, const float* const x,
+              float* const y) {
+  const DotKernel dot{kernel().dot};
+  const size_t num_threads{choose_num_threads(m * k)};
+  const size_t rows_per_task{div_up(m, num_threads)};
+  parallel_for(num_threads, num_threads, [&](const size_t task) {
+    const size_t end{std::min((task + 1) * rows_per_task, m)};
+    for (size_t i{task * rows_per_task}; i < end; ++i) {
+      y[i] = dot(k, &a[i * k], x);
+    }
+  });
+}
+
+void gram_lower_cpu(const size_t m, const size_t k, const float* const* const rows,
+                    float* const out) {
+  gram_lower(m, k, rows, out);
+}
+
+void gram_lower_cpu(const size_t m, const size_t k, const __half* const* const rows,
+                    float* const out) {
+  gram_lower(m, k, rows, out);
+}
+
+float dot_cpu(const size_t k, const float* const a, const float* const b) {
+  return kernel().dot(k, a, b);
+}
+
+void parallel_for_cpu(const size_t num_tasks, const size_t num_threads,
+                      const std::function<void(size_t)>& func) {
+  parallel_for(num_tasks, std::min(num_threads, max_num_threads.load(std::memory_order_relaxed)),
+               func);
+}
+
+void parallel_for_rows_cpu(const size_t num_rows, const size_t work_per_row,
+                           const std::function<void(size_t, size_t)>& func) {
+  const size_t num_tasks{
+      std::max<size_t>(std::min(num_rows * work_per_row / min_row_work_per_task, num_rows), 1)};
+  const size_t rows_per_task{div_up(num_rows, num_tasks)};
+  parallel_for_cpu(num_tasks, num_tasks, [&](const size_t task) {
+    const size_t begin{std::min(task * rows_per_task, num_rows)};
+    func(begin, std::min(begin + rows_per_task, num_rows));
+  });
+}
+
+void set_gemm_cpu_num_threads(const size_t num_threads) {
+  max_num_threads = std::max<size_t>(num_threads, 1);
+}
+
+const char* gemm_cpu_isa() { return kernel().isa; }
+
+const char* gemm_int8_cpu_isa() { return int8_kernel().isa; }
+
+}  // namespace HugeCTR
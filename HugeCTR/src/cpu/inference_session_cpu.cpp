@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cpu/create_pipeline_cpu.hpp>
+#include <cpu/gemm_cpu.hpp>
 #include <cpu/inference_session_cpu.hpp>
 #include <cpu_resource.hpp>
 #include <iostream>
@@ -25,34 +27,67 @@ namespace HugeCTR {
 template <typename TypeHashKey>
 InferenceSessionCPU<TypeHashKey>::InferenceSessionCPU(
     const std::string& model_config_path, const InferenceParams& inference_params,
-    const std::shared_ptr<HierParameterServerBase>& parameter_server)
+    const std::shared_ptr<HierParameterServerBase>& parameter_server,
+    const EmbeddingCacheCPUParams& embedding_cache_params,
+    const InferenceSessionCPUParams& session_params)
     : config_(read_json_file(model_config_path)),
       embedding_table_slot_size_({0}),
+      worker_batchsize_(inference_params.max_batchsize),
       parameter_server_(parameter_server),
       inference_parser_(config_),
       inference_params_(inference_params) {
   try {
+    HCTR_CHECK_HINT(session_params.num_workers > 0, "At least one worker context is required!");
     cpu_resource_.reset(new CPUResource(0, {}));
-    NetworkCPU* network_ptr;
-    std::map<std::string, bool> tensor_active;
-
-    // create pipeline and initialize network
-    create_pipeline_cpu(config_, tensor_active, inference_params_, dense_input_tensor_,
-                        row_ptrs_tensors_, embedding_features_tensors_, embedding_table_slot_size_,
-                        &embedding_feature_combiners_, &network_ptr, cpu_resource_);
-    network_ = std::move(std::unique_ptr<NetworkCPU>(network_ptr));
-    network_->initialize();
-    if (inference_params_.dense_model_file.size() > 0) {
-      network_->load_params_from_model(inference_params_.dense_model_file);
+
+    // The CPU batch norm normalizes with the statistics of the batch at hand. Hence, splitting
+    // batches would alter the predictions.
+    if (session_params.worker_batchsize > 0 &&
+        session_params.worker_batchsize < inference_params_.max_batchsize) {
+      bool has_batch_norm{false};
+      for (const nlohmann::json& j : get_json(config_, "layers")) {
+        has_batch_norm |= get_value_from_json<std::string>(j, "type") == "BatchNorm";
+      }
+      if (has_batch_norm) {
+        HCTR_LOG_S(WARNING, ROOT) << "Model \"" << inference_params_.model_name
+                                  << "\" contains BatchNorm layers. Batches will not be split."
+                                  << std::endl;
+      } else {
+        worker_batchsize_ = session_params.worker_batchsize;
+      }
     }
 
-    // allocate memory for embedding vector lookup
-    // h_keys_ is a void pointer, which serves key types of both long long and unsigned int
-    h_keys_ = malloc(inference_params_.max_batchsize *
-                     inference_parser_.max_feature_num_per_sample * sizeof(long long));
-    h_embedding_vectors_ =
-        (float*)malloc(inference_params_.max_batchsize *
-                       inference_parser_.max_embedding_vector_size_per_sample * sizeof(float));
+    // create worker contexts. All of them share the weights of the first one
+    for (size_t i = 0; i < session_params.num_workers; ++i) {
+      workers_.emplace_back(create_worker_(i ? workers_.front()->network.get() : nullptr));
+      idle_workers_.emplace_back(workers_.back().get());
+    }
+    if (workers_.size() > 1) {
+      predict_workers_ = std::make_unique<ThreadPool>("cpu predict", workers_.size());
+    }
+    const size_t num_embedding_tables{inference_parser_.num_embedding_tables};
+    if (num_embedding_tables > 1) {
+      const size_t num_lookup_workers{std::min<size_t>(
+          workers_.size() * (num_embedding_tables - 1), std::thread::hardware_concurrency())};
+      lookup_workers_ =
+          std::make_unique<ThreadPool>("cpu lookup", std::max<size_t>(num_lookup_workers, 1));
+    }
+
+    // create host memory embedding cache
+    if (embedding_cache_params.capacity > 0) {
+      HCTR_CHECK_HINT((inference_params_.i64_input_key == std::is_same_v<TypeHashKey, long long>),
+                      "Key type of the embedding cache must match i64_input_key!");
+      InferenceParams cache_inference_params{inference_params_};
+      cache_inference_params.embedding_vecsize_per_table =
+          inference_parser_.embed_vec_size_for_tables;
+      embedding_cache_ = std::make_unique<EmbeddingCacheCPU<TypeHashKey>>(
+          embedding_cache_params, cache_inference_params, parameter_server_.get());
+    }
+
+    HCTR_LOG_S(INFO, ROOT) << "Created CPU inference session for model \""
+                           << inference_params_.model_name << "\" with " << workers_.size()
+                           << " worker context(s) of batch size " << worker_batchsize_ << '.'
+                           << std::endl;
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
     throw;
@@ -61,92 +96,299 @@ InferenceSessionCPU<TypeHashKey>::InferenceSessionCPU(
 
 template <typename TypeHashKey>
 InferenceSessionCPU<TypeHashKey>::~InferenceSessionCPU() {
-  free(h_embedding_vectors_);
-  free(h_keys_);
+  predict_workers_.reset();
+  lookup_workers_.reset();
+  embedding_cache_.reset();
+}
+
+template <typename TypeHashKey>
+std::unique_ptr<typename InferenceSessionCPU<TypeHashKey>::WorkerContext>
+InferenceSessionCPU<TypeHashKey>::create_worker_(const NetworkCPU* weights_source) {
+  auto worker{std::make_unique<WorkerContext>()};
+
+  // create pipeline and initialize network
+  InferenceParams worker_params{inference_params_};
+  worker_params.max_batchsize = worker_batchsize_;
+  std::vector<size_t> embedding_table_slot_size({0});
+  std::map<std::string, bool> tensor_active;
+  NetworkCPU* network_ptr;
+  create_pipeline_cpu(config_, tensor_active, worker_params, worker->dense_input_tensor,
+                      worker->row_ptrs_tensors, worker->row_indices_tensors,
+                      worker->embedding_features_tensors,
+                      weights_source ? embedding_table_slot_size : embedding_table_slot_size_,
+                      &worker->embedding_feature_combiners, &network_ptr, cpu_resource_,
+                      weights_source);
+  worker->network.reset(network_ptr);
+  if (!weights_source) {
+    worker->network->initialize();
+    if (inference_params_.dense_model_file.size() > 0) {
+      worker->network->load_params_from_model(inference_params_.dense_model_file);
+    }
+  }
+  // The weights are constant from here on, so pack them for gemm_cpu once (or share the packed
+  // weights of weights_source).
+  worker->network->pack_weights(weights_source);
+
+  const size_t num_embedding_tables{inference_parser_.num_embedding_tables};
+  if (num_embedding_tables != worker->row_ptrs_tensors.size() ||
+      num_embedding_tables != worker->row_indices_tensors.size() ||
+      num_embedding_tables != worker->embedding_features_tensors.size() ||
+      num_embedding_tables != worker->embedding_feature_combiners.size()) {
+    HCTR_OWN_THROW(Error_t::IllegalCall, "embedding feature combiner inconsistent");
+  }
+
+  // allocate memory for the keys and row pointers of a sub-batch
+  worker->keys.resize(worker_batchsize_ * inference_parser_.max_feature_num_per_sample);
+  worker->unique_keys.resize(worker->keys.size());
+  for (const auto& embedding_features_tensor : worker->embedding_features_tensors) {
+    worker->unique_ops.emplace_back(embedding_features_tensor->get_dimensions()[0]);
+  }
+  size_t num_row_ptrs{0};
+  for (const auto& row_ptrs_tensor : worker->row_ptrs_tensors) {
+    num_row_ptrs += row_ptrs_tensor->get_num_elements();
+  }
+  worker->row_ptrs.resize(num_row_ptrs);
+
+  return worker;
+}
+
+template <typename TypeHashKey>
+typename InferenceSessionCPU<TypeHashKey>::WorkerContext*
+InferenceSessionCPU<TypeHashKey>::acquire_worker_() {
+  std::unique_lock lock(idle_workers_guard_);
+  idle_workers_semaphore_.wait(lock, [&]() { return !idle_workers_.empty(); });
+  WorkerContext* const worker{idle_workers_.back()};
+  idle_workers_.pop_back();
+  return worker;
+}
+
+template <typename TypeHashKey>
+void InferenceSessionCPU<TypeHashKey>::release_worker_(WorkerContext* const worker) {
+  {
+    const std::lock_guard lock(idle_workers_guard_);
+    idle_workers_.emplace_back(worker);
+  }
+  idle_workers_semaphore_.notify_one();
 }
 
 template <typename TypeHashKey>
 void InferenceSessionCPU<TypeHashKey>::predict(float* h_dense, void* h_embeddingcolumns,
                                                int* h_row_ptrs, float* h_output, int num_samples) {
-  size_t num_embedding_tables = inference_parser_.num_embedding_tables;
-  if (num_embedding_tables != row_ptrs_tensors_.size() ||
-      num_embedding_tables != embedding_features_tensors_.size() ||
-      num_embedding_tables != embedding_feature_combiners_.size()) {
-    HCTR_OWN_THROW(Error_t::IllegalCall, "embedding feature combiner inconsistent");
+  if (num_samples < 0 || static_cast<size_t>(num_samples) > inference_params_.max_batchsize) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "num_samples exceeds max_batchsize");
+  }
+
+  const size_t batch_size{static_cast<size_t>(num_samples)};
+  if (batch_size == 0) {
+    return;
+  }
+
+  // split the batch into sub-batches, which are processed concurrently
+  const size_t num_sub_batches{(batch_size + worker_batchsize_ - 1) / worker_batchsize_};
+  if (num_sub_batches == 1 || !predict_workers_) {
+    for (size_t first{0}; first < batch_size; first += worker_batchsize_) {
+      predict_(h_dense, h_embeddingcolumns, h_row_ptrs, h_output, batch_size, first,
+               std::min(first + worker_batchsize_, batch_size));
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(num_sub_batches);
+  for (size_t first{0}; first < batch_size; first += worker_batchsize_) {
+    tasks.emplace_back(predict_workers_->submit([&, first]() {
+      predict_(h_dense, h_embeddingcolumns, h_row_ptrs, h_output, batch_size, first,
+               std::min(first + worker_batchsize_, batch_size));
+    }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+}
+
+template <typename TypeHashKey>
+void InferenceSessionCPU<TypeHashKey>::quantize(float* h_dense, void* h_embeddingcolumns,
+                                                int* h_row_ptrs, int num_samples) {
+  if (num_samples < 0 || static_cast<size_t>(num_samples) > inference_params_.max_batchsize) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "num_samples exceeds max_batchsize");
+  }
+
+  // Calibrate with the first worker context, which owns the weights.
+  WorkerContext* const source{workers_.front().get()};
+  const size_t batch_size{static_cast<size_t>(num_samples)};
+  if (batch_size > 0) {
+    const size_t pred_dim{source->network->get_pred_tensor().get_num_elements() /
+                          worker_batchsize_};
+    std::vector<float> h_output(batch_size * pred_dim);
+    source->network->set_calibration(true);
+    for (size_t first{0}; first < batch_size; first += worker_batchsize_) {
+      predict_(source, h_dense, h_embeddingcolumns, h_row_ptrs, h_output.data(), batch_size,
+               first, std::min(first + worker_batchsize_, batch_size));
+    }
+    source->network->set_calibration(false);
+  }
+
+  source->network->quantize();
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    workers_[i]->network->quantize(source->network.get());
+  }
+  HCTR_LOG_S(INFO, ROOT) << "Quantized the dense network of model \""
+                         << inference_params_.model_name << "\" to int8 ("
+                         << gemm_int8_cpu_isa() << "), calibrated on " << batch_size
+                         << " sample(s)." << std::endl;
+}
+
+template <typename TypeHashKey>
+void InferenceSessionCPU<TypeHashKey>::predict_(const float* const h_dense,
+                                                const void* const h_embeddingcolumns,
+                                                const int* const h_row_ptrs, float* const h_output,
+                                                const size_t num_samples, const size_t first,
+                                                const size_t last) {
+  const auto release{[this](WorkerContext* const worker) { release_worker_(worker); }};
+  const std::unique_ptr<WorkerContext, decltype(release)> worker{acquire_worker_(), release};
+  predict_(worker.get(), h_dense, h_embeddingcolumns, h_row_ptrs, h_output, num_samples, first,
+           last);
+}
+
+template <typename TypeHashKey>
+void InferenceSessionCPU<TypeHashKey>::predict_(
+    WorkerContext* const worker, const float* const h_dense, const void* const h_embeddingcolumns,
+    const int* const h_row_ptrs, float* const h_output, const size_t num_samples,
+    const size_t first, const size_t last) {
+  const size_t num_embedding_tables{inference_parser_.num_embedding_tables};
+  const std::vector<size_t>& slot_num_for_tables{inference_parser_.slot_num_for_tables};
+  const size_t sub_batch_size{last - first};
+
+  // Gather row pointers of the sub-batch (table first), relative to its first key in each table.
+  // The keys of the sub-batch follow the keys of all preceding samples (sample first).
+  size_t keys_offset{0};
+  {
+    size_t row_ptrs_offset{0};
+    int* sub_batch_row_ptrs{worker->row_ptrs.data()};
+    for (size_t i = 0; i < num_embedding_tables; ++i) {
+      const int* const table_row_ptrs{h_row_ptrs + row_ptrs_offset +
+                                      first * slot_num_for_tables[i]};
+      const int base{table_row_ptrs[0]};
+      const size_t num_row_ptrs{sub_batch_size * slot_num_for_tables[i] + 1};
+      for (size_t j = 0; j < num_row_ptrs; ++j) {
+        sub_batch_row_ptrs[j] = table_row_ptrs[j] - base;
+      }
+      keys_offset += base;
+      row_ptrs_offset += num_samples * slot_num_for_tables[i] + 1;
+      sub_batch_row_ptrs += num_row_ptrs;
+    }
   }
 
   // Redistribute keys ：from sample first to table first
   if (inference_params_.i64_input_key) {
-    distribute_keys_per_table(static_cast<long long*>(h_keys_),
-                              static_cast<long long*>(h_embeddingcolumns), h_row_ptrs, num_samples,
-                              inference_parser_.slot_num_for_tables);
+    distribute_keys_per_table(
+        reinterpret_cast<long long*>(worker->keys.data()),
+        static_cast<const long long*>(h_embeddingcolumns) + keys_offset, worker->row_ptrs.data(),
+        sub_batch_size, slot_num_for_tables);
   } else {
-    distribute_keys_per_table(static_cast<unsigned int*>(h_keys_),
-                              static_cast<unsigned int*>(h_embeddingcolumns), h_row_ptrs,
-                              num_samples, inference_parser_.slot_num_for_tables);
+    distribute_keys_per_table(
+        reinterpret_cast<unsigned int*>(worker->keys.data()),
+        static_cast<const unsigned int*>(h_embeddingcolumns) + keys_offset,
+        worker->row_ptrs.data(), sub_batch_size, slot_num_for_tables);
   }
 
-  // parameter server lookup
-  size_t acc_vectors_offset{0};
-  size_t acc_row_ptrs_offset{0};
-  size_t acc_keys_offset{0};
-  size_t num_keys{0};
-  for (size_t i = 0; i < num_embedding_tables; ++i) {
-    acc_row_ptrs_offset += num_samples * inference_parser_.slot_num_for_tables[i] + 1;
-    num_keys = h_row_ptrs[acc_row_ptrs_offset - 1];
+  // deduplicate keys and look up the distinct ones in the parameter server (tables in parallel)
+  const auto lookup{[&](const size_t table_id, const size_t acc_keys_offset,
+                        const size_t num_keys) {
+    float* const vectors{worker->embedding_features_tensors[table_id]->get_ptr()};
+    int* const row_indices{worker->row_indices_tensors[table_id]->get_ptr()};
+    UniqueOpCPU& unique_op{worker->unique_ops[table_id]};
+    size_t num_unique_keys;
     if (inference_params_.i64_input_key) {
-      parameter_server_->lookup(static_cast<const long long*>(h_keys_) + acc_keys_offset, num_keys,
-                                h_embedding_vectors_ + acc_vectors_offset,
-                                inference_params_.model_name, i);
+      num_unique_keys = unique_op.unique(
+          reinterpret_cast<const long long*>(worker->keys.data()) + acc_keys_offset, num_keys,
+          row_indices, reinterpret_cast<long long*>(worker->unique_keys.data()) + acc_keys_offset);
+    } else {
+      num_unique_keys = unique_op.unique(
+          reinterpret_cast<const unsigned int*>(worker->keys.data()) + acc_keys_offset, num_keys,
+          row_indices,
+          reinterpret_cast<unsigned int*>(worker->unique_keys.data()) + acc_keys_offset);
+    }
+
+    if (embedding_cache_) {
+      embedding_cache_->lookup(
+          table_id,
+          reinterpret_cast<const TypeHashKey*>(worker->unique_keys.data()) + acc_keys_offset,
+          num_unique_keys, vectors);
+    } else if (inference_params_.i64_input_key) {
+      parameter_server_->lookup(reinterpret_cast<const long long*>(worker->unique_keys.data()) +
+                                    acc_keys_offset,
+                                num_unique_keys, vectors, inference_params_.model_name, table_id);
     } else {
-      parameter_server_->lookup(static_cast<const unsigned int*>(h_keys_) + acc_keys_offset,
-                                num_keys, h_embedding_vectors_ + acc_vectors_offset,
-                                inference_params_.model_name, i);
+      parameter_server_->lookup(
+          reinterpret_cast<const unsigned int*>(worker->unique_keys.data()) + acc_keys_offset,
+          num_unique_keys, vectors, inference_params_.model_name, table_id);
+    }
+  }};
+  {
+    // Validate all tables before the first lookup is submitted.
+    std::vector<size_t> num_keys(num_embedding_tables);
+    size_t acc_row_ptrs_offset{0};
+    for (size_t i = 0; i < num_embedding_tables; ++i) {
+      acc_row_ptrs_offset += sub_batch_size * slot_num_for_tables[i] + 1;
+      num_keys[i] = static_cast<size_t>(worker->row_ptrs[acc_row_ptrs_offset - 1]);
+      if (num_keys[i] > worker->embedding_features_tensors[i]->get_dimensions()[0]) {
+        HCTR_OWN_THROW(Error_t::WrongInput, "Number of keys exceeds max_feature_num_per_sample");
+      }
+    }
+
+    // Submitted lookups refer to `lookup` and `worker`. Hence, they must finish before an
+    // exception leaves this scope.
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(num_embedding_tables);
+    try {
+      size_t acc_keys_offset{0};
+      for (size_t i = 0; i < num_embedding_tables; ++i) {
+        const size_t n{num_keys[i]};
+        if (i + 1 < num_embedding_tables && lookup_workers_) {
+          tasks.emplace_back(lookup_workers_->submit(
+              [&lookup, i, acc_keys_offset, n]() { lookup(i, acc_keys_offset, n); }));
+        } else {
+          lookup(i, acc_keys_offset, n);
+        }
+        acc_keys_offset += n;
+      }
+    } catch (...) {
+      for (auto& task : tasks) {
+        task.wait();
+      }
+      throw;
     }
-    acc_keys_offset += num_keys;
-    acc_vectors_offset += inference_params_.max_batchsize *
-                          inference_parser_.max_feature_num_for_tables[i] *
-                          inference_parser_.embed_vec_size_for_tables[i];
+    ThreadPool::await(tasks.begin(), tasks.end());
   }
 
   // copy dense input to dense tensor
-  auto dense_dims = dense_input_tensor_.get_dimensions();
-  size_t dense_size = 1;
-  for (auto dim : dense_dims) {
-    dense_size *= dim;
-  }
-  size_t dense_size_in_bytes = dense_size * sizeof(float);
-  memcpy(dense_input_tensor_.get_ptr(), h_dense, dense_size_in_bytes);
+  const size_t dense_dim{worker->dense_input_tensor.get_dimensions()[1]};
+  memcpy(worker->dense_input_tensor.get_ptr(), h_dense + first * dense_dim,
+         sub_batch_size * dense_dim * sizeof(float));
 
-  acc_vectors_offset = 0;
-  acc_row_ptrs_offset = 0;
+  size_t acc_row_ptrs_offset{0};
   for (size_t i = 0; i < num_embedding_tables; ++i) {
-    // bind row ptrs input to row ptrs tensor
-    auto row_ptrs_dims = row_ptrs_tensors_[i]->get_dimensions();
-    std::shared_ptr<TensorBuffer2> row_ptrs_buff =
-        PreallocatedBuffer2<int>::create(h_row_ptrs + acc_row_ptrs_offset, row_ptrs_dims);
-    bind_tensor_to_buffer(row_ptrs_dims, row_ptrs_buff, row_ptrs_tensors_[i]);
-    acc_row_ptrs_offset += num_samples * inference_parser_.slot_num_for_tables[i] + 1;
-
-    // bind embedding vectors from looking up to embedding features tensor
-    auto embedding_features_dims = embedding_features_tensors_[i]->get_dimensions();
-    std::shared_ptr<TensorBuffer2> embeddding_features_buff = PreallocatedBuffer2<float>::create(
-        h_embedding_vectors_ + acc_vectors_offset, embedding_features_dims);
-    bind_tensor_to_buffer(embedding_features_dims, embeddding_features_buff,
-                          embedding_features_tensors_[i]);
-    acc_vectors_offset += inference_params_.max_batchsize *
-                          inference_parser_.max_feature_num_for_tables[i] *
-                          inference_parser_.embed_vec_size_for_tables[i];
+    // copy row ptrs to row ptrs tensor. Unused rows are left empty
+    Tensor2<int>& row_ptrs_tensor{*worker->row_ptrs_tensors[i]};
+    const int* const sub_batch_row_ptrs{worker->row_ptrs.data() + acc_row_ptrs_offset};
+    const size_t num_row_ptrs{sub_batch_size * slot_num_for_tables[i] + 1};
+    std::copy_n(sub_batch_row_ptrs, num_row_ptrs, row_ptrs_tensor.get_ptr());
+    std::fill(row_ptrs_tensor.get_ptr() + num_row_ptrs,
+              row_ptrs_tensor.get_ptr() + row_ptrs_tensor.get_num_elements(),
+              sub_batch_row_ptrs[num_row_ptrs - 1]);
+    acc_row_ptrs_offset += num_row_ptrs;
+
     // feature combiner feedforward
-    embedding_feature_combiners_[i]->fprop(false);
+    worker->embedding_feature_combiners[i]->fprop(false);
   }
 
   // dense network feedforward
-  network_->predict();
+  worker->network->predict();
 
   // copy the prediction result to output
-  float* h_pred = network_->get_pred_tensor().get_ptr();
-  memcpy(h_output, h_pred, network_->get_pred_tensor().get_num_elements() * sizeof(float));
+  Tensor2<float> pred_tensor{worker->network->get_pred_tensor()};
+  const size_t pred_dim{pred_tensor.get_num_elements() / worker_batchsize_};
+  memcpy(h_output + first * pred_dim, pred_tensor.get_ptr(),
+         sub_batch_size * pred_dim * sizeof(float));
 }
 
 template class InferenceSessionCPU<unsigned int>;
@@ -24,24 +24,24 @@ namespace HugeCTR {
 namespace {
 
 template <typename T>
-void add_cpu(T** input, T* output, size_t size, size_t num) {
+void add_cpu(T** input, T* output, size_t size, size_t num, bool relu) {
   for (size_t i = 0; i < size; i++) {
     float tmp = 0.f;
     for (size_t j = 0; j < num; j++) {
       tmp += input[j][i];
     }
-    output[i] = tmp;
+    output[i] = relu ? std::max(tmp, 0.f) : tmp;
   }
 }
 
 template <>
-void add_cpu(__half** input, __half* output, size_t size, size_t num) {
+void add_cpu(__half** input, __half* output, size_t size, size_t num, bool relu) {
   for (size_t i = 0; i < size; i++) {
     float tmp = 0.f;
     for (size_t j = 0; j < num; j++) {
       tmp += __half2float(input[j][i]);
     }
-    output[i] = __float2half(tmp);
+    output[i] = __float2half(relu ? std::max(tmp, 0.f) : tmp);
   }
 }
 
@@ -58,8 +58,9 @@ void add_dgrad_cpu(const T* top_grad, T** dgrad, size_t size, size_t num) {
 
 template <typename T>
 AddLayerCPU<T>::AddLayerCPU(const Tensors2<T>& in_tensors, const Tensor2<T>& out_tensor,
-                            const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff)
-    : LayerCPU() {
+                            const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
+                            bool fuse_relu)
+    : LayerCPU(), fuse_relu_(fuse_relu) {
   try {
     size_ = in_tensors[0].get_num_elements();
     num_ = in_tensors.size();
@@ -93,25 +94,15 @@ AddLayerCPU<T>::AddLayerCPU(const Tensors2<T>& in_tensors, const Tensor2<T>& out
   }
 }
 
+// The input pointers are gathered on every call, since replicas of a network are not initialized.
 template <typename T>
-void AddLayerCPU<T>::initialize() {
+void AddLayerCPU<T>::fprop(bool is_train) {
+  T* output = out_tensors_[0].get_ptr();
   for (size_t i = 0; i < num_; i++) {
     h_inputs_.get_ptr()[i] = in_tensors_[i].get_ptr();
   }
-}
-
-template <typename T>
-void AddLayerCPU<T>::fprop(bool is_train) {
-  T* output = out_tensors_[0].get_ptr();
-
-  add_cpu(h_inputs_.get_ptr(), output, size_, num_);
-}
-
-template <>
-void AddLayerCPU<__half>::fprop(bool is_train) {
-  __half* output = out_tensors_[0].get_ptr();
 
-  add_cpu(h_inputs_.get_ptr(), output, size_, num_);
+  add_cpu(h_inputs_.get_ptr(), output, size_, num_, fuse_relu_);
 }
 
 template <typename T>
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cpu/gemm_cpu.hpp>
 #include <cpu/layers/fully_connected_layer_cpu.hpp>
 #include <utils.hpp>
 #include <vector>
@@ -22,23 +24,6 @@ namespace HugeCTR {
 
 namespace {
 
-void cpu_mm(float* a, float* b, float* c, int m, int k, int n) {
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      c[i * n + j] = 0.0f;
-      for (int kk = 0; kk < k; ++kk) c[i * n + j] += a[i * k + kk] * b[kk * n + j];
-    }
-  }
-}
-
-void cpu_add_bias(float* out, float* bias, int m, int n) {
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      out[i * n + j] += bias[j];
-    }
-  }
-}
-
 void transpose(float* a, int m, int n) {
   std::unique_ptr<float[]> tmp(new float[m * n]);
   for (int i = 0; i < m; ++i)
@@ -52,22 +37,33 @@ FullyConnectedLayerCPU<float>::FullyConnectedLayerCPU(
     const std::shared_ptr<BufferBlock2<float>>& weight_buff,
     const std::shared_ptr<BufferBlock2<float>>& wgrad_buff, const Tensor2<float>& in_tensor,
     const Tensor2<float>& out_tensor, bool use_mixed_precision)
-    : LayerCPU(), use_mixed_precision_(use_mixed_precision) {
+    : FullyConnectedLayerCPU(weight_buff, wgrad_buff, Tensors2<float>{in_tensor}, out_tensor,
+                             use_mixed_precision) {}
+
+FullyConnectedLayerCPU<float>::FullyConnectedLayerCPU(
+    const std::shared_ptr<BufferBlock2<float>>& weight_buff,
+    const std::shared_ptr<BufferBlock2<float>>& wgrad_buff, const Tensors2<float>& in_tensors,
+    const Tensor2<float>& out_tensor, bool use_mixed_precision, bool fuse_relu)
+    : LayerCPU(), use_mixed_precision_(use_mixed_precision), fuse_relu_(fuse_relu) {
   try {
-    // check the in_tensor and out_tensor
-    const auto& in_tensor_dim = in_tensor.get_dimensions();
+    // check the in_tensors and out_tensor
     const auto& out_tensor_dim = out_tensor.get_dimensions();
     // 1. two dim?
-    if (in_tensor_dim.size() != 2 || out_tensor_dim.size() != 2) {
+    if (in_tensors.empty() || out_tensor_dim.size() != 2) {
       HCTR_OWN_THROW(Error_t::WrongInput, "input or output tensor doesn't has two dimensions");
     }
     // 2. dim match?
-    size_t m = in_tensor_dim[0];
     size_t n = out_tensor_dim[1];
-    size_t k = in_tensor_dim[1];
-    size_t m_ck = out_tensor_dim[0];
-    if (m != m_ck) {
-      HCTR_OWN_THROW(Error_t::WrongInput, "size of input / output tensor doesn't match");
+    size_t k = 0;
+    for (const Tensor2<float>& in_tensor : in_tensors) {
+      const auto& in_tensor_dim = in_tensor.get_dimensions();
+      if (in_tensor_dim.size() != 2) {
+        HCTR_OWN_THROW(Error_t::WrongInput, "input or output tensor doesn't has two dimensions");
+      }
+      if (in_tensor_dim[0] != out_tensor_dim[0]) {
+        HCTR_OWN_THROW(Error_t::WrongInput, "size of input / output tensor doesn't match");
+      }
+      k += in_tensor_dim[1];
     }
 
     std::vector<size_t> weight_dim = {k, n};
@@ -93,8 +89,14 @@ FullyConnectedLayerCPU<float>::FullyConnectedLayerCPU(
       wgrad_buff->reserve(bias_dim, &tensor);
       wgrad_.push_back(tensor);
     }
-    in_tensors_.push_back(in_tensor);
+    in_tensors_ = in_tensors;
     out_tensors_.push_back(out_tensor);
+    std::vector<size_t> input_widths;
+    for (const Tensor2<float>& in_tensor : in_tensors) {
+      input_widths.push_back(in_tensor.get_dimensions()[1]);
+    }
+    int8_ = QuantizedFullyConnectedCPU(input_widths);
+    packed_ = PackedFullyConnectedCPU(input_widths);
     // Where should we create this cuBLAS handle?
   } catch (const std::runtime_error& rt_err) {
     HCTR_LOG_S(ERROR, WORLD) << rt_err.what() << std::endl;
@@ -103,29 +105,59 @@ FullyConnectedLayerCPU<float>::FullyConnectedLayerCPU(
 }
 
 void FullyConnectedLayerCPU<float>::fprop(bool is_train) {
-  Tensor2<float>& in_tensor = get_in_tensors(is_train)[0];
+  Tensors2<float>& in_tensors = get_in_tensors(is_train);
   Tensor2<float>& out_tensor = out_tensors_[0];
 
   float* weight = weights_[0].get_ptr();
   float* bias = weights_[1].get_ptr();
-  float* in = in_tensor.get_ptr();
   float* out = out_tensor.get_ptr();
 
-  const auto& in_tensor_dim = in_tensor.get_dimensions();
   const auto& out_tensor_dim = out_tensor.get_dimensions();
+  size_t m = out_tensor_dim[0];
+  size_t n = out_tensor_dim[1];
 
-  int m, n, k;
-
-  m = in_tensor_dim[0];
-  n = out_tensor_dim[1];
-  k = in_tensor_dim[1];
+  std::vector<const float*> inputs;
+  for (size_t i = 0; i < in_tensors.size(); ++i) {
+    inputs.push_back(in_tensors[i].get_ptr());
+    int8_.calibrate(i, m, inputs.back());
+  }
+  if (int8_.is_quantized()) {
+    int8_.fprop(m, inputs, out, {bias, fuse_relu_});
+    return;
+  }
+  if (packed_.is_packed()) {
+    packed_.fprop(m, inputs, out, {bias, fuse_relu_});
+    return;
+  }
 
-  cpu_mm(in, weight, out, m, k, n);
-  cpu_add_bias(out, bias, m, n);
+  // Each input multiplies its own rows of the weight matrix. Bias and ReLU are applied by the
+  // last product, while the result is still in cache.
+  size_t k_offset = 0;
+  for (size_t i = 0; i < in_tensors.size(); ++i) {
+    size_t k = in_tensors[i].get_dimensions()[1];
+    GemmEpilogueCPU epilogue;
+    if (i + 1 == in_tensors.size()) {
+      epilogue = {bias, fuse_relu_};
+    }
+    gemm_cpu(m, n, k, in_tensors[i].get_ptr(), weight + k_offset * n, out, i > 0, epilogue);
+    k_offset += k;
+  }
 }
 
 void FullyConnectedLayerCPU<float>::bprop() {}
 
+void FullyConnectedLayerCPU<float>::quantize(const LayerCPU* weights_source) {
+  const auto* source = dynamic_cast<const FullyConnectedLayerCPU<float>*>(weights_source);
+  int8_.quantize(weights_[0].get_ptr(), out_tensors_[0].get_dimensions()[1],
+                 source ? &source->int8_ : nullptr);
+}
+
+void FullyConnectedLayerCPU<float>::pack_weights(const LayerCPU* weights_source) {
+  const auto* source = dynamic_cast<const FullyConnectedLayerCPU<float>*>(weights_source);
+  packed_.pack(weights_[0].get_ptr(), out_tensors_[0].get_dimensions()[1],
+               source ? &source->packed_ : nullptr);
+}
+
 template class FullyConnectedLayerCPU<float>;
 
 }  // namespace HugeCTR
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cpu/gemm_cpu.hpp>
 #include <cpu/layers/fully_connected_layer_half_cpu.hpp>
 #include <utils.hpp>
 
@@ -21,29 +23,6 @@ namespace HugeCTR {
 
 namespace {
 
-void cpu_mm(__half* c, const __half* a, bool transpose_a, const __half* b, bool transpose_b, int m,
-            int k, int n) {
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      float sum = 0.0f;
-      for (int kk = 0; kk < k; ++kk) {
-        int ai = transpose_a ? kk * m + i : i * k + kk;
-        int bi = transpose_b ? j * k + kk : kk * n + j;
-        sum += a[ai] * b[bi];
-      }
-      c[i * n + j] = sum;
-    }
-  }
-}
-
-void cpu_add_bias(__half* top, const __half* bias, int m, int n) {
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      top[i * n + j] = top[i * n + j] + bias[j];
-    }
-  }
-}
-
 void cpu_reverse_add_bias(__half* bias_grad, const __half* top, int m, int n) {
   for (int i = 0; i < n; ++i) {
     float sum = 0.0f;
@@ -60,17 +39,35 @@ FullyConnectedLayerCPU<__half>::FullyConnectedLayerCPU(
     const std::shared_ptr<BufferBlock2<__half>>& weights_grad_buff,
     const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
     const Tensor2<__half>& bottom_tensor, const Tensor2<__half>& top_tensor)
-    : LayerCPU() {
-  const auto& bottom_tensor_dim = bottom_tensor.get_dimensions();
+    : FullyConnectedLayerCPU(master_weights_buff, weights_buff, weights_grad_buff, blobs_buff,
+                             Tensors2<__half>{bottom_tensor}, top_tensor) {}
+
+FullyConnectedLayerCPU<__half>::FullyConnectedLayerCPU(
+    const std::shared_ptr<BufferBlock2<float>>& master_weights_buff,
+    const std::shared_ptr<BufferBlock2<__half>>& weights_buff,
+    const std::shared_ptr<BufferBlock2<__half>>& weights_grad_buff,
+    const std::shared_ptr<GeneralBuffer2<HostAllocator>>& blobs_buff,
+    const Tensors2<__half>& bottom_tensors, const Tensor2<__half>& top_tensor, bool fuse_relu)
+    : LayerCPU(), fuse_relu_(fuse_relu) {
   const auto& top_tensor_dim = top_tensor.get_dimensions();
 
-  if (bottom_tensor_dim.size() != 2 || top_tensor_dim.size() != 2) {
+  if (bottom_tensors.empty() || top_tensor_dim.size() != 2) {
     HCTR_OWN_THROW(Error_t::WrongInput, "input or output tensor doesn't has two dimensions");
   }
 
-  size_t m = bottom_tensor_dim[0];
+  size_t m = top_tensor_dim[0];
   size_t n = top_tensor_dim[1];
-  size_t k = bottom_tensor_dim[1];
+  size_t k = 0;
+  for (const Tensor2<__half>& bottom_tensor : bottom_tensors) {
+    const auto& bottom_tensor_dim = bottom_tensor.get_dimensions();
+    if (bottom_tensor_dim.size() != 2) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "input or output tensor doesn't has two dimensions");
+    }
+    if (bottom_tensor_dim[0] != m) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "size of input / output tensor doesn't match");
+    }
+    k += bottom_tensor_dim[1];
+  }
 
   std::vector<size_t> kernel_dim = {k, n};
   std::vector<size_t> bias_dim = {1, n};
@@ -108,29 +105,81 @@ FullyConnectedLayerCPU<__half>::FullyConnectedLayerCPU(
   }
   blobs_buff->reserve(identity_dim, &identity_tensor_);
 
-  bottom_tensor_ = bottom_tensor;
+  bottom_tensors_ = bottom_tensors;
   top_tensor_ = top_tensor;
+  std::vector<size_t> input_widths;
+  for (const Tensor2<__half>& bottom_tensor : bottom_tensors) {
+    input_widths.push_back(bottom_tensor.get_dimensions()[1]);
+  }
+  int8_ = QuantizedFullyConnectedCPU(input_widths);
+  packed_ = PackedFullyConnectedCPU(input_widths);
 }
 
 void FullyConnectedLayerCPU<__half>::fprop(bool is_train) {
   const __half* kernel = weights_half_[0].get_ptr();
-  const __half* bias = weights_half_[1].get_ptr();
-  const __half* bottom = get_bottom_tensor(is_train).get_ptr();
+  // The master copy of the bias is added to the fp32 partial sums.
+  const float* bias = weights_[1].get_ptr();
+  Tensors2<__half>& bottom_tensors = get_bottom_tensors(is_train);
   __half* top = top_tensor_.get_ptr();
 
-  const auto& bottom_tensor_dim = get_bottom_tensor(is_train).get_dimensions();
   const auto& top_tensor_dim = top_tensor_.get_dimensions();
-
-  size_t m = bottom_tensor_dim[0];
+  size_t m = top_tensor_dim[0];
   size_t n = top_tensor_dim[1];
-  size_t k = bottom_tensor_dim[1];
 
-  cpu_mm(top, bottom, false, kernel, false, m, k, n);
-  cpu_add_bias(top, bias, m, n);
+  std::vector<const __half*> bottoms;
+  for (size_t i = 0; i < bottom_tensors.size(); ++i) {
+    bottoms.push_back(bottom_tensors[i].get_ptr());
+    int8_.calibrate(i, m, bottoms.back());
+  }
+  if (int8_.is_quantized()) {
+    int8_.fprop(m, bottoms, top, {bias, fuse_relu_});
+    return;
+  }
+  if (packed_.is_packed()) {
+    packed_.fprop(m, bottoms, top, {bias, fuse_relu_});
+    return;
+  }
+
+  if (bottom_tensors.size() == 1) {
+    gemm_cpu(m, n, bottom_tensors[0].get_dimensions()[1], bottoms[0], kernel, top, false,
+             {bias, fuse_relu_});
+    return;
+  }
+
+  // Each input multiplies its own rows of the kernel. The partial sums are kept in fp32, and
+  // rounded once. Bias and ReLU are applied by the last product, while the result is still in
+  // cache.
+  thread_local std::vector<float> sums;
+  sums.resize(m * n);
+  size_t k_offset = 0;
+  for (size_t i = 0; i < bottom_tensors.size(); ++i) {
+    size_t k = bottom_tensors[i].get_dimensions()[1];
+    GemmEpilogueCPU epilogue;
+    if (i + 1 == bottom_tensors.size()) {
+      epilogue = {bias, fuse_relu_};
+    }
+    gemm_cpu(m, n, k, bottoms[i], kernel + k_offset * n, sums.data(), i > 0, epilogue);
+    k_offset += k;
+  }
+  convert_cpu(m * n, sums.data(), top);
 }
 
 void FullyConnectedLayerCPU<__half>::bprop() {}
 
+void FullyConnectedLayerCPU<__half>::quantize(const LayerCPU* weights_source) {
+  // The int8 weights are quantized from the fp32 master copy.
+  const auto* source = dynamic_cast<const FullyConnectedLayerCPU<__half>*>(weights_source);
+  int8_.quantize(weights_[0].get_ptr(), top_tensor_.get_dimensions()[1],
+                 source ? &source->int8_ : nullptr);
+}
+
+void FullyConnectedLayerCPU<__half>::pack_weights(const LayerCPU* weights_source) {
+  // Packed from the fp16 kernel, so that results do not depend on whether weights are packed.
+  const auto* source = dynamic_cast<const FullyConnectedLayerCPU<__half>*>(weights_source);
+  packed_.pack(weights_half_[0].get_ptr(), top_tensor_.get_dimensions()[1],
+               source ? &source->packed_ : nullptr);
+}
+
 template class FullyConnectedLayerCPU<__half>;
 
 }  // namespace HugeCTR
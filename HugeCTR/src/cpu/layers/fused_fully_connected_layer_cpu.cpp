@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cpu/gemm_cpu.hpp>
 #include <cpu/layers/fused_fully_connected_layer_cpu.hpp>
 #include <utils.hpp>
 
@@ -21,31 +23,6 @@ namespace HugeCTR {
 
 namespace {
 
-void cpu_mm(__half* c, const __half* a, bool transpose_a, const __half* b, bool transpose_b, int m,
-            int k, int n) {
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      float sum = 0.0f;
-      for (int kk = 0; kk < k; ++kk) {
-        int ai = transpose_a ? kk * m + i : i * k + kk;
-        int bi = transpose_b ? j * k + kk : kk * n + j;
-        sum += a[ai] * b[bi];
-      }
-      c[i * n + j] = sum;
-    }
-  }
-}
-
-void cpu_add_bias_and_re(__half* top, __half* middle, const __half* bias, int m, int n) {
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      __half t = top[i * n + j] + bias[j];
-      middle[i * n + j] = t;
-      top[i * n + j] = t < 0 ? __float2half(0.0f) : t;
-    }
-  }
-}
-
 void cpu_reverse_add_bias_and_re(__half* bias_grad, __half* middle, const __half* top, int m,
                                  int n) {
   for (int i = 0; i < m; ++i)
@@ -127,15 +104,17 @@ FusedFullyConnectedLayerCPU::FusedFullyConnectedLayerCPU(
 
   bottom_tensor_ = bottom_tensor;
   top_tensor_ = top_tensor;
-  blobs_buff->reserve(top_tensor_.get_dimensions(), &middle_tensor_);
+  // The pre-activation output (middle_tensor_) is only needed for bprop, which is not supported.
   blobs_buff->reserve(bias_dim, &bias_grad_tensor_);
+  int8_ = QuantizedFullyConnectedCPU({k});
+  packed_ = PackedFullyConnectedCPU({k});
 }
 
 void FusedFullyConnectedLayerCPU::fprop(bool is_train) {
   const __half* kernel = weights_half_[0].get_ptr();
-  const __half* bias = weights_half_[1].get_ptr();
+  // The master copy of the bias is added to the fp32 partial sums.
+  const float* bias = weights_[1].get_ptr();
   const __half* bottom = get_bottom_tensor(is_train).get_ptr();
-  __half* middle = middle_tensor_.get_ptr();
   __half* top = top_tensor_.get_ptr();
 
   const auto& bottom_tensor_dim = get_bottom_tensor(is_train).get_dimensions();
@@ -145,10 +124,32 @@ void FusedFullyConnectedLayerCPU::fprop(bool is_train) {
   size_t n = top_tensor_dim[1];
   size_t k = bottom_tensor_dim[1];
 
-  cpu_mm(top, bottom, false, kernel, false, m, k, n);
-  cpu_add_bias_and_re(top, middle, bias, m, n);
+  int8_.calibrate(0, m, bottom);
+  if (int8_.is_quantized()) {
+    int8_.fprop(m, {bottom}, top, {bias, true});
+    return;
+  }
+  if (packed_.is_packed()) {
+    packed_.fprop(m, {bottom}, top, {bias, true});
+    return;
+  }
+  gemm_cpu(m, n, k, bottom, kernel, top, false, {bias, true});
 }
 
 void FusedFullyConnectedLayerCPU::bprop() {}
 
+void FusedFullyConnectedLayerCPU::quantize(const LayerCPU* weights_source) {
+  // The int8 weights are quantized from the fp32 master copy.
+  const auto* source = dynamic_cast<const FusedFullyConnectedLayerCPU*>(weights_source);
+  int8_.quantize(weights_[0].get_ptr(), top_tensor_.get_dimensions()[1],
+                 source ? &source->int8_ : nullptr);
+}
+
+void FusedFullyConnectedLayerCPU::pack_weights(const LayerCPU* weights_source) {
+  // Packed from the fp16 kernel, so that results do not depend on whether weights are packed.
+  const auto* source = dynamic_cast<const FusedFullyConnectedLayerCPU*>(weights_source);
+  packed_.pack(weights_half_[0].get_ptr(), top_tensor_.get_dimensions()[1],
+               source ? &source->packed_ : nullptr);
+}
+
 }  // namespace HugeCTR
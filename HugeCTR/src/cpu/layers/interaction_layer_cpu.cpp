@@ -20,7 +20,9 @@
 #include <device_launch_parameters.h>
 #include <mma.h>
 
+#include <algorithm>
 #include <common.hpp>
+#include <cpu/gemm_cpu.hpp>
 #include <cpu/layers/interaction_layer_cpu.hpp>
 #include <type_traits>
 #include <utils.hpp>
@@ -29,79 +31,41 @@ namespace HugeCTR {
 
 namespace {
 
-template <uint x>
-struct Log2 {
-  static constexpr uint value = 1 + Log2<x / 2>::value;
-};
-template <>
-struct Log2<1> {
-  static constexpr uint value = 0;
-};
-
-struct __align__(8) half4 {
-  half2 vals[2];
-};
-
+// Each output row is the bottom MLP output of the sample, followed by the pairwise dot products of
+// its features (i.e., the strictly lower triangle of X * X^T, where the rows of X are the bottom
+// MLP output and the embeddings), followed by a zero for padding. The concatenation is thus fused
+// into the output, and the upper triangle of X * X^T is never computed.
 template <typename T>
-void concat_cpu(size_t height, size_t in_width, size_t out_width, size_t n_ins, size_t n_emb,
-                bool fprop, T *h_concat, T *h_in_mlp, T *h_in_emb) {
-  for (size_t ni = 0; ni < n_ins; ni++) {
-    for (size_t h = 0; h < height; h++) {
-      size_t in_idx_base = (ni == 0) ? h * in_width : h * in_width * n_emb;
-      for (size_t w = 0; w < in_width; w++) {
-        size_t in_idx = in_idx_base + w;
-        size_t out_idx = h * out_width + ni * in_width + w;
-        if (fprop) {
-          h_concat[out_idx] = (ni == 0) ? h_in_mlp[in_idx] : h_in_emb[(ni - 1) * in_width + in_idx];
-        } else {
-          if (ni == 0) {
-            h_in_mlp[in_idx] = h_in_mlp[in_idx] + h_concat[out_idx];
-          } else {
-            h_in_emb[in_idx + (ni - 1) * in_width] = h_concat[out_idx];
-          }
-        }
-      }
+void interaction_fprop_cpu(size_t height, size_t in_width, size_t n_emb, const T *h_in_mlp,
+                           const T *h_in_emb, T *h_out) {
+  const size_t n_ins = 1 + n_emb;
+  const size_t n_pairs = n_ins * (n_ins - 1) / 2;
+  const size_t out_width = in_width + n_pairs + 1;
+
+  parallel_for_rows_cpu(height, n_pairs * in_width, [&](const size_t begin, const size_t end) {
+    std::vector<const T *> rows(n_ins);
+    std::vector<float> pairs;
+    if constexpr (!std::is_same<T, float>::value) {
+      pairs.resize(n_pairs);
     }
-  }
-}
-
-template <typename T>
-void matmul_cpu(size_t height, size_t in_width, size_t n_ins, T *h_concat, T *h_mat) {
-  for (size_t p = 0; p < height; p++) {
-    size_t concat_stride = n_ins * in_width * p;
-    size_t mat_stride = n_ins * n_ins * p;
-    for (size_t m = 0; m < n_ins; m++) {
-      for (size_t n = 0; n < n_ins; n++) {
-        float accum = 0.0f;
-        for (size_t k = 0; k < in_width; k++) {
-          accum += h_concat[concat_stride + m * in_width + k] *
-                   h_concat[concat_stride + n * in_width + k];
-        }
-        h_mat[mat_stride + m * n_ins + n] = accum;
+    for (size_t p = begin; p < end; p++) {
+      rows[0] = h_in_mlp + p * in_width;
+      for (size_t i = 1; i < n_ins; i++) {
+        rows[i] = h_in_emb + (p * n_emb + i - 1) * in_width;
       }
-    }
-  }
-}
-
-template <typename T>
-void gather_concat_cpu(size_t height, size_t in_width, size_t n_ins, T *h_in_mlp, T *h_mat,
-                       T *h_ref) {
-  size_t out_len = in_width + (n_ins * (n_ins + 1) / 2 - n_ins) + 1;
-  for (size_t p = 0; p < height; p++) {
-    size_t cur_idx = 0;
-    size_t out_stride = p * out_len;
-    size_t mat_stride = p * n_ins * n_ins;
-    for (size_t i = 0; i < in_width; i++) {
-      h_ref[out_stride + cur_idx++] = h_in_mlp[p * in_width + i];
-    }
-    for (size_t n = 0; n < n_ins; n++) {
-      for (size_t m = 0; m < n_ins; m++) {
-        if (n > m) {
-          h_ref[out_stride + cur_idx++] = h_mat[mat_stride + m * n_ins + n];
+      T *out = h_out + p * out_width;
+      std::copy_n(rows[0], in_width, out);
+      if constexpr (std::is_same<T, float>::value) {
+        gram_lower_cpu(n_ins, in_width, rows.data(), out + in_width);
+      } else {
+        gram_lower_cpu(n_ins, in_width, rows.data(), pairs.data());
+        for (size_t i = 0; i < n_pairs; i++) {
+          out[in_width + i] = TypeConvert<T, float>::convert(pairs[i]);
         }
       }
+      out[out_width - 1] = TypeConvert<T, float>::convert(0.f);
     }
-  }
+  });
 }
 
 }  // anonymous namespace
@@ -132,28 +96,6 @@ InteractionLayerCPU<T>::InteractionLayerCPU(
     }
 
     size_t n_ins = 1 + second_in_dims[1];
-    if (std::is_same<T, __half>::value == false) {
-      size_t concat_dims_width = first_in_dims[1] + second_in_dims[1] * second_in_dims[2];
-      std::vector<size_t> concat_dims = {first_in_dims[0], concat_dims_width};
-
-      {
-        Tensor2<T> tensor;
-        blobs_buff->reserve(concat_dims, &tensor);
-        internal_tensors_.push_back(tensor);
-      }
-      {
-        std::vector<size_t> mat_dims = {first_in_dims[0], n_ins * n_ins};
-        Tensor2<T> tensor;
-        blobs_buff->reserve(mat_dims, &tensor);
-        internal_tensors_.push_back(tensor);
-      }
-      {
-        Tensor2<T> tensor;
-        blobs_buff->reserve(concat_dims, &tensor);
-        internal_tensors_.push_back(tensor);
-      }
-    }
-
     int concat_len = n_ins * (n_ins + 1) / 2 - n_ins;
     std::vector<size_t> out_dims = {first_in_dims[0], first_in_dims[1] + concat_len + 1};
     blobs_buff->reserve(out_dims, &out_tensor);
@@ -173,20 +115,14 @@ InteractionLayerCPU<T>::~InteractionLayerCPU(){};
 
 template <typename T>
 void InteractionLayerCPU<T>::fprop(bool is_train) {
-  T *concat = internal_tensors_[0].get_ptr();
   T *in_mlp = get_in_tensors(is_train)[0].get_ptr();
   T *in_emb = get_in_tensors(is_train)[1].get_ptr();
-  T *mat = internal_tensors_[1].get_ptr();
-  T *gather = out_tensors_[0].get_ptr();
-  size_t h = internal_tensors_[0].get_dimensions()[0];
-  size_t out_w = internal_tensors_[0].get_dimensions()[1];
+  T *out = out_tensors_[0].get_ptr();
+  size_t h = get_in_tensors(is_train)[0].get_dimensions()[0];
   size_t in_w = get_in_tensors(is_train)[0].get_dimensions()[1];
   size_t n_emb = get_in_tensors(is_train)[1].get_dimensions()[1];
-  size_t n_ins = 1 + n_emb;
 
-  concat_cpu(h, in_w, out_w, n_ins, n_emb, true, concat, in_mlp, in_emb);
-  matmul_cpu(h, in_w, n_ins, concat, mat);
-  gather_concat_cpu(h, in_w, n_ins, in_mlp, mat, gather);
+  interaction_fprop_cpu(h, in_w, n_emb, in_mlp, in_emb, out);
 }
 
 template <typename T>
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cpu/gemm_cpu.hpp>
 #include <cpu/layers/multi_cross_layer_cpu.hpp>
 #include <utils.hpp>
 #include <vector>
@@ -22,51 +24,32 @@ namespace HugeCTR {
 
 namespace {
 
-void matrix_vec_mul(float* out, const float* in_m, const float* in_v, size_t h, size_t w) {
+// out = in_m_1 * diag(in_v_1) + in_m_2 + in_v_2 (i.e., row scaling, matrix add and bias add)
+void row_scaling_add(float* out, const float* in_m_1, const float* in_v_1, const float* in_m_2,
+                     const float* in_v_2, size_t h, size_t w) {
   for (size_t j = 0; j < h; j++) {
-    out[j] = 0.0f;
     for (size_t i = 0; i < w; i++) {
       size_t k = j * w + i;
-      out[j] += in_m[k] * in_v[i];
-    }
-  }
-}
-
-void row_scaling(float* out, const float* in_m, const float* in_v, size_t h, size_t w) {
-  for (size_t j = 0; j < h; j++) {
-    for (size_t i = 0; i < w; i++) {
-      size_t k = j * w + i;
-      out[k] = in_m[k] * in_v[j];
-    }
-  }
-}
-
-void matrix_add(float* out, const float* in_m_1, const float* in_m_2, size_t h, size_t w) {
-  for (size_t j = 0; j < h; j++) {
-    for (size_t i = 0; i < w; i++) {
-      size_t k = j * w + i;
-      out[k] = in_m_1[k] + in_m_2[k];
-    }
-  }
-}
-
-void matrix_vec_add(float* out, const float* in_m, const float* in_v, size_t h, size_t w) {
-  for (size_t j = 0; j < h; j++) {
-    for (size_t i = 0; i < w; i++) {
-      size_t k = j * w + i;
-      out[k] = in_m[k] + in_v[i];
+      out[k] = in_m_1[k] * in_v_1[j] + in_m_2[k] + in_v_2[i];
     }
   }
 }
 
+// Cross layers are independent across rows. Hence, each task takes its rows through all layers,
+// one row at a time, which keeps the row in cache between the dot product and the update.
 void multi_cross_fprop_cpu(int layers, size_t batchsize, size_t w, float** h_outputs,
                            float* h_input, float** h_hiddens, float** h_kernels, float** h_biases) {
-  for (int i = 0; i < layers; i++) {
-    matrix_vec_mul(h_hiddens[i], i == 0 ? h_input : h_outputs[i - 1], h_kernels[i], batchsize, w);
-    row_scaling(h_outputs[i], h_input, h_hiddens[i], batchsize, w);
-    matrix_add(h_outputs[i], h_outputs[i], i == 0 ? h_input : h_outputs[i - 1], batchsize, w);
-    matrix_vec_add(h_outputs[i], h_outputs[i], h_biases[i], batchsize, w);
-  }
+  parallel_for_rows_cpu(batchsize, w * layers, [&](const size_t begin, const size_t end) {
+    for (size_t j = begin; j < end; j++) {
+      const float* x0 = h_input + j * w;
+      for (int i = 0; i < layers; i++) {
+        const float* prev = i == 0 ? x0 : h_outputs[i - 1] + j * w;
+        float* hidden = h_hiddens[i] + j;
+        *hidden = dot_cpu(w, prev, h_kernels[i]);
+        row_scaling_add(h_outputs[i] + j * w, x0, hidden, prev, h_biases[i], 1, w);
+      }
+    }
+  });
 }
 
 }  // namespace
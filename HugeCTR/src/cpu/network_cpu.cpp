@@ -33,9 +33,6 @@ void NetworkCPU::conv_weight_(Tensor2<__half>& target, const Tensor2<float>& sou
 }
 
 void NetworkCPU::predict() {
-  if (use_mixed_precision_) {
-    conv_weight_(weight_tensor_half_, weight_tensor_);
-  }
   // forward
   for (auto& layer : layers_) {
     layer->fprop(false);
@@ -52,6 +49,9 @@ void NetworkCPU::load_params_from_model(const std::string& model_file) {
   }
   model_stream.read((char*)weight_tensor_.get_ptr(), weight_tensor_.get_size_in_bytes());
   model_stream.close();
+  if (use_mixed_precision_) {
+    conv_weight_(weight_tensor_half_, weight_tensor_);
+  }
   return;
 }
 
@@ -59,6 +59,33 @@ void NetworkCPU::initialize() {
   for (auto& layer : layers_) {
     layer->initialize();
   }
+  if (use_mixed_precision_) {
+    conv_weight_(weight_tensor_half_, weight_tensor_);
+  }
+}
+
+void NetworkCPU::set_calibration(bool calibrating) {
+  for (auto& layer : layers_) {
+    layer->set_calibration(calibrating);
+  }
+}
+
+void NetworkCPU::quantize(const NetworkCPU* weights_source) {
+  if (weights_source && weights_source->layers_.size() != layers_.size()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "weights_source has a different configuration");
+  }
+  for (size_t i = 0; i < layers_.size(); i++) {
+    layers_[i]->quantize(weights_source ? weights_source->layers_[i].get() : nullptr);
+  }
+}
+
+void NetworkCPU::pack_weights(const NetworkCPU* weights_source) {
+  if (weights_source && weights_source->layers_.size() != layers_.size()) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "weights_source has a different configuration");
+  }
+  for (size_t i = 0; i < layers_.size(); i++) {
+    layers_[i]->pack_weights(weights_source ? weights_source->layers_[i].get() : nullptr);
+  }
 }
 
 }  // namespace HugeCTR
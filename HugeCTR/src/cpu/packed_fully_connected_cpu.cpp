@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <common.hpp>
+#include <cpu/packed_fully_connected_cpu.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace HugeCTR {
+
+PackedFullyConnectedCPU::PackedFullyConnectedCPU(std::vector<size_t> input_widths)
+    : input_widths_(std::move(input_widths)) {}
+
+template <typename T>
+void PackedFullyConnectedCPU::pack(const T* const weights, const size_t n,
+                                   const PackedFullyConnectedCPU* const source) {
+  if (source) {
+    if (source->input_widths_ != input_widths_) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Packed weights of a different shape");
+    }
+    weights_ = source->weights_;
+    return;
+  }
+
+  auto packed{std::make_shared<std::vector<PackedMatrixCPU>>()};
+  size_t k_offset{0};
+  for (const size_t k : input_widths_) {
+    packed->emplace_back(k, n, weights + k_offset * n);
+    k_offset += k;
+  }
+  weights_ = std::move(packed);
+}
+
+template <typename T>
+void PackedFullyConnectedCPU::fprop(const size_t m, const std::vector<const T*>& inputs,
+                                    T* const out, const GemmEpilogueCPU& epilogue) const {
+  // Partial sums of reduced precision outputs are kept in fp32 across the inputs.
+  if constexpr (!std::is_same_v<T, float>) {
+    if (inputs.size() > 1) {
+      const size_t n{weights_->front().get_n()};
+      thread_local std::vector<float> sums;
+      sums.resize(m * n);
+      for (size_t i{0}; i < inputs.size(); ++i) {
+        gemm_cpu(m, inputs[i], (*weights_)[i], sums.data(), i > 0,
+                 i + 1 == inputs.size() ? epilogue : GemmEpilogueCPU{});
+      }
+      convert_cpu(m * n, sums.data(), out);
+      return;
+    }
+  }
+
+  // Bias and ReLU are applied by the last product, while the result is still in cache.
+  for (size_t i{0}; i < inputs.size(); ++i) {
+    gemm_cpu(m, inputs[i], (*weights_)[i], out, i > 0,
+             i + 1 == inputs.size() ? epilogue : GemmEpilogueCPU{});
+  }
+}
+
+template void PackedFullyConnectedCPU::pack(const float* weights, size_t n,
+                                            const PackedFullyConnectedCPU* source);
+template void PackedFullyConnectedCPU::pack(const __half* weights, size_t n,
+                                            const PackedFullyConnectedCPU* source);
+template void PackedFullyConnectedCPU::fprop(size_t m, const std::vector<const float*>& inputs,
+                                             float* out, const GemmEpilogueCPU& epilogue) const;
+template void PackedFullyConnectedCPU::fprop(size_t m, const std::vector<const __half*>& inputs,
+                                             __half* out, const GemmEpilogueCPU& epilogue) const;
+
+}  // namespace HugeCTR
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <common.hpp>
+#include <cpu/quantized_fully_connected_cpu.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace HugeCTR {
+
+namespace {
+
+// Layers with fewer outputs stay in fp32.
+constexpr size_t min_quantized_outputs{16};
+
+}  // namespace
+
+QuantizedFullyConnectedCPU::QuantizedFullyConnectedCPU(std::vector<size_t> input_widths)
+    : input_widths_(std::move(input_widths)), input_abs_max_(input_widths_.size(), 0.f) {}
+
+template <typename T>
+void QuantizedFullyConnectedCPU::calibrate(const size_t i, const size_t m, const T* const input) {
+  if (calibrating_) {
+    input_abs_max_[i] = std::max(input_abs_max_[i], abs_max_cpu(m * input_widths_[i], input));
+  }
+}
+
+void QuantizedFullyConnectedCPU::quantize(const float* const weights, const size_t n,
+                                          const QuantizedFullyConnectedCPU* const source) {
+  if (source) {
+    if (source->input_widths_ != input_widths_) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Quantized weights of a different shape");
+    }
+    input_scales_ = source->input_scales_;
+    weights_ = source->weights_;
+    return;
+  }
+  if (n < min_quantized_outputs) {
+    return;
+  }
+
+  input_scales_.clear();
+  auto quantized{std::make_shared<std::vector<Int8MatrixCPU>>()};
+  size_t k_offset{0};
+  for (size_t i{0}; i < input_widths_.size(); ++i) {
+    input_scales_.push_back(input_abs_max_[i] / 127.f);
+    quantized->emplace_back(input_widths_[i], n, weights + k_offset * n);
+    k_offset += input_widths_[i];
+  }
+  weights_ = std::move(quantized);
+}
+
+template <typename T>
+void QuantizedFullyConnectedCPU::fprop(const size_t m, const std::vector<const T*>& inputs,
+                                       T* const out, const GemmEpilogueCPU& epilogue) const {
+  // Partial sums of reduced precision outputs are kept in fp32 across the inputs.
+  if constexpr (!std::is_same_v<T, float>) {
+    if (inputs.size() > 1) {
+      const size_t n{weights_->front().get_n()};
+      thread_local std::vector<float> sums;
+      sums.resize(m * n);
+      for (size_t i{0}; i < inputs.size(); ++i) {
+        gemm_int8_cpu(m, inputs[i], input_scales_[i], (*weights_)[i], sums.data(), i > 0,
+                      i + 1 == inputs.size() ? epilogue : GemmEpilogueCPU{});
+      }
+      convert_cpu(m * n, sums.data(), out);
+      return;
+    }
+  }
+
+  for (size_t i{0}; i < inputs.size(); ++i) {
+    gemm_int8_cpu(m, inputs[i], input_scales_[i], (*weights_)[i], out, i > 0,
+                  i + 1 == inputs.size() ? epilogue : GemmEpilogueCPU{});
+  }
+}
+
+template void QuantizedFullyConnectedCPU::calibrate(size_t i, size_t m, const float* input);
+template void QuantizedFullyConnectedCPU::calibrate(size_t i, size_t m, const __half* input);
+template void QuantizedFullyConnectedCPU::fprop(size_t m, const std::vector<const float*>& inputs,
+                                                float* out, const GemmEpilogueCPU& epilogue) const;
+template void QuantizedFullyConnectedCPU::fprop(size_t m, const std::vector<const __half*>& inputs,
+                                                __half* out,
+                                                const GemmEpilogueCPU& epilogue) const;
+
+}  // namespace HugeCTR
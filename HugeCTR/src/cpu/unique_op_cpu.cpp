@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <common.hpp>
+#include <cpu/gemm_cpu.hpp>
+#include <cpu/unique_op_cpu.hpp>
+#include <cstdint>
+#include <thread>
+
+namespace HugeCTR {
+
+namespace {
+
+// Splitting the keys does not pay off, unless each partition receives at least this many keys.
+constexpr size_t min_keys_per_partition{size_t{1} << 14};
+
+// Finalizer of MurmurHash3 (64 bit). The low bits select the hash table slot, and the high bits
+// select the partition.
+inline uint64_t hash_key(const uint64_t key) {
+  uint64_t h{key};
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline size_t partition_of(const uint64_t hash, const size_t num_partitions) {
+  return static_cast<size_t>(((hash >> 32) * num_partitions) >> 32);
+}
+
+// Power of 2 that keeps the load factor of a hash table with num_keys keys below 0.5.
+inline size_t num_slots_for(const size_t num_keys) {
+  size_t num_slots{16};
+  while (num_slots < 2 * num_keys) {
+    num_slots <<= 1;
+  }
+  return num_slots;
+}
+
+// Deduplicates keys with linear probing. The distinct keys are stored in the order of their first
+// occurrence.
+template <typename TypeHashKey>
+size_t unique_keys_serial(const TypeHashKey* const keys, const size_t num_keys, int* const slots,
+                          const size_t num_slots, int* const output_index,
+                          TypeHashKey* const unique_keys) {
+  std::fill_n(slots, num_slots, -1);
+  const size_t mask{num_slots - 1};
+  int num_unique{0};
+  for (size_t i = 0; i < num_keys; i++) {
+    const TypeHashKey key{keys[i]};
+    size_t slot{hash_key(key) & mask};
+    while (true) {
+      const int index{slots[slot]};
+      if (index < 0) {
+        slots[slot] = num_unique;
+        unique_keys[num_unique] = key;
+        output_index[i] = num_unique++;
+        break;
+      }
+      if (unique_keys[index] == key) {
+        output_index[i] = index;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+  return num_unique;
+}
+
+}  // namespace
+
+UniqueOpCPU::UniqueOpCPU(const size_t capacity)
+    : capacity_(capacity),
+      part_keys_(capacity),
+      part_unique_keys_(capacity),
+      part_positions_(capacity),
+      part_index_(capacity),
+      slots_(num_slots_for(capacity)) {}
+
+template <typename TypeHashKey>
+size_t UniqueOpCPU::unique(const TypeHashKey* const keys, const size_t len, int* const output_index,
+                           TypeHashKey* const unique_keys) {
+  static_assert(sizeof(TypeHashKey) <= sizeof(long long));
+  if (len > capacity_) {
+    HCTR_OWN_THROW(Error_t::OutOfBound, "Number of keys exceeds the capacity of the unique op");
+  }
+
+  const size_t num_partitions{std::min<size_t>(len / min_keys_per_partition,
+                                               std::max(std::thread::hardware_concurrency(), 1U))};
+  if (num_partitions <= 1) {
+    return unique_keys_serial(keys, len, slots_.data(), num_slots_for(len), output_index,
+                              unique_keys);
+  }
+
+  // Count the keys of each chunk (i.e., a contiguous range of the input) per partition.
+  const size_t keys_per_chunk{(len + num_partitions - 1) / num_partitions};
+  std::vector<size_t> offsets(num_partitions * num_partitions, 0);
+  parallel_for_cpu(num_partitions, num_partitions, [&](const size_t chunk) {
+    size_t* const counts{&offsets[chunk * num_partitions]};
+    const size_t end{std::min((chunk + 1) * keys_per_chunk, len)};
+    for (size_t i = chunk * keys_per_chunk; i < end; i++) {
+      counts[partition_of(hash_key(keys[i]), num_partitions)]++;
+    }
+  });
+
+  // Partitions are stored one after another. Within a partition, keys keep their input order.
+  std::vector<size_t> part_begin(num_partitions + 1);
+  std::vector<size_t> slots_begin(num_partitions + 1);
+  size_t acc_offset{0};
+  for (size_t p = 0; p < num_partitions; p++) {
+    part_begin[p] = acc_offset;
+    for (size_t chunk = 0; chunk < num_partitions; chunk++) {
+      const size_t count{offsets[chunk * num_partitions + p]};
+      offsets[chunk * num_partitions + p] = acc_offset;
+      acc_offset += count;
+    }
+    slots_begin[p + 1] = slots_begin[p] + num_slots_for(acc_offset - part_begin[p]);
+  }
+  part_begin[num_partitions] = acc_offset;
+  if (slots_.size() < slots_begin[num_partitions]) {
+    slots_.resize(slots_begin[num_partitions]);
+  }
+
+  TypeHashKey* const part_keys{reinterpret_cast<TypeHashKey*>(part_keys_.data())};
+  TypeHashKey* const part_unique_keys{reinterpret_cast<TypeHashKey*>(part_unique_keys_.data())};
+  parallel_for_cpu(num_partitions, num_partitions, [&](const size_t chunk) {
+    size_t* const next{&offsets[chunk * num_partitions]};
+    const size_t end{std::min((chunk + 1) * keys_per_chunk, len)};
+    for (size_t i = chunk * keys_per_chunk; i < end; i++) {
+      const size_t j{next[partition_of(hash_key(keys[i]), num_partitions)]++};
+      part_keys[j] = keys[i];
+      part_positions_[j] = static_cast<int>(i);
+    }
+  });
+
+  // Deduplicate each partition, then concatenate the distinct keys and scatter the inverse index.
+  std::vector<size_t> unique_begin(num_partitions + 1, 0);
+  parallel_for_cpu(num_partitions, num_partitions, [&](const size_t p) {
+    const size_t begin{part_begin[p]};
+    unique_begin[p + 1] = unique_keys_serial(
+        part_keys + begin, part_begin[p + 1] - begin, &slots_[slots_begin[p]],
+        slots_begin[p + 1] - slots_begin[p], &part_index_[begin], part_unique_keys + begin);
+  });
+  for (size_t p = 0; p < num_partitions; p++) {
+    unique_begin[p + 1] += unique_begin[p];
+  }
+  parallel_for_cpu(num_partitions, num_partitions, [&](const size_t p) {
+    const size_t begin{part_begin[p]};
+    const int base{static_cast<int>(unique_begin[p])};
+    std::copy_n(part_unique_keys + begin, unique_begin[p + 1] - unique_begin[p],
+                unique_keys + base);
+    for (size_t j = begin; j < part_begin[p + 1]; j++) {
+      output_index[part_positions_[j]] = base + part_index_[j];
+    }
+  });
+  return unique_begin[num_partitions];
+}
+
+template size_t UniqueOpCPU::unique(const unsigned int* keys, size_t len, int* output_index,
+                                    unsigned int* unique_keys);
+template size_t UniqueOpCPU::unique(const long long* keys, size_t len, int* output_index,
+                                    long long* unique_keys);
+
+}  // namespace HugeCTR
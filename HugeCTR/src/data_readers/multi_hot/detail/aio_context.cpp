@@ -41,6 +41,7 @@ AIOContext::~AIOContext() {
   // app can't exit with AIO requests inflight
   (void)collect(num_inflight_, 1e6);  // wait 1s
   assert(num_inflight_ == 0);
+  io_queue_release(ctx_);
 }
 
 void AIOContext::submit(const IORequest& request) {
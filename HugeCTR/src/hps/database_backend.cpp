@@ -80,6 +80,8 @@ size_t DatabaseBackendBase<Key>::dump(const std::string& table_name, const std::
       format = DatabaseTableDumpFormat_t::Raw;
     } else if (ext == ".sst") {
       format = DatabaseTableDumpFormat_t::SST;
+    } else if (ext == ".snap") {
+      format = DatabaseTableDumpFormat_t::Snapshot;
     } else {
       HCTR_DIE("Unsupported file extension!");
     }
@@ -117,6 +119,10 @@ size_t DatabaseBackendBase<Key>::dump(const std::string& table_name, const std::
       HCTR_ROCKSDB_CHECK(file.Finish());
     } break;
 
+    case DatabaseTableDumpFormat_t::Snapshot: {
+      hit_count = dump_snapshot(table_name, path);
+    } break;
+
     default: {
       HCTR_DIE("Unsupported DB table dump format!");
     } break;
@@ -125,6 +131,14 @@ size_t DatabaseBackendBase<Key>::dump(const std::string& table_name, const std::
   return hit_count;
 }
 
+template <typename Key>
+size_t DatabaseBackendBase<Key>::bulk_insert(const std::string& table_name, const size_t num_pairs,
+                                             const Key* const keys, const char* const values,
+                                             const uint32_t value_size,
+                                             const size_t value_stride) {
+  return insert(table_name, num_pairs, keys, values, value_size, value_stride);
+}
+
 template <typename Key>
 size_t DatabaseBackendBase<Key>::load_dump(const std::string& table_name, const std::string& path) {
   const std::string ext = std::filesystem::path(path).extension();
@@ -132,6 +146,8 @@ size_t DatabaseBackendBase<Key>::load_dump(const std::string& table_name, const
     return load_dump_bin(table_name, path);
   } else if (ext == ".sst") {
     return load_dump_sst(table_name, path);
+  } else if (ext == ".snap") {
+    return load_dump_snapshot(table_name, path);
   } else {
     HCTR_DIE("Unsupported file extension!");
     return 0;
@@ -167,11 +183,12 @@ size_t DatabaseBackendBase<Key>::load_dump_bin(const std::string& table_name,
   }
   HCTR_CHECK(file);
 
+  const size_t batch_size{max_bulk_batch_size()};
   size_t hit_count{0};
   std::vector<Key> keys;
-  keys.reserve(max_batch_size_);
+  keys.reserve(batch_size);
   std::vector<char> values;
-  values.reserve(max_batch_size_ * value_size);
+  values.reserve(batch_size * value_size);
 
   std::vector<char> tmp(std::max<size_t>(sizeof(Key), value_size));
   while (!file.eof()) {
@@ -189,8 +206,8 @@ size_t DatabaseBackendBase<Key>::load_dump_bin(const std::string& table_name,
     values.insert(values.end(), tmp.begin(), tmp.begin() + value_size);
 
     // Put batch into table.
-    if (keys.size() >= max_batch_size_) {
-      insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
+    if (keys.size() >= batch_size) {
+      bulk_insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
       hit_count += keys.size();
       keys.clear();
       values.clear();
@@ -199,7 +216,7 @@ size_t DatabaseBackendBase<Key>::load_dump_bin(const std::string& table_name,
 
   // Fill remaining KVs into table.
   if (!keys.empty()) {
-    insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
+    bulk_insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
     hit_count += keys.size();
   }
 
@@ -217,6 +234,7 @@ size_t DatabaseBackendBase<Key>::load_dump_sst(const std::string& table_name,
   std::unique_ptr<rocksdb::Iterator> it{file.NewIterator(read_options)};
   it->SeekToFirst();
 
+  const size_t batch_size{max_bulk_batch_size()};
   size_t hit_count{0};
   uint32_t value_size{0};
   std::vector<Key> keys;
@@ -239,8 +257,8 @@ size_t DatabaseBackendBase<Key>::load_dump_sst(const std::string& table_name,
     values.insert(values.end(), v_view.data(), v_view.data() + value_size);
 
     // If buffer full, insert.
-    if (keys.size() >= max_batch_size_) {
-      insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
+    if (keys.size() >= batch_size) {
+      bulk_insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
       hit_count += keys.size();
       keys.clear();
       values.clear();
@@ -249,13 +267,27 @@ size_t DatabaseBackendBase<Key>::load_dump_sst(const std::string& table_name,
 
   // If buffer not yet empty.
   if (!keys.empty()) {
-    insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
+    bulk_insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
     hit_count += keys.size();
   }
 
   return hit_count;
 }
 
+template <typename Key>
+size_t DatabaseBackendBase<Key>::dump_snapshot(const std::string& table_name,
+                                               const std::string& path) {
+  HCTR_DIE(get_name(), " backend does not support snapshots!");
+  return 0;
+}
+
+template <typename Key>
+size_t DatabaseBackendBase<Key>::load_dump_snapshot(const std::string& table_name,
+                                                    const std::string& path) {
+  HCTR_DIE(get_name(), " backend does not support snapshots!");
+  return 0;
+}
+
 template class DatabaseBackendBase<unsigned int>;
 template class DatabaseBackendBase<long long>;
 
@@ -14,11 +14,18 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <atomic>
 #include <core23/logger.hpp>
+#include <cstddef>
 #include <cstring>
 #include <execution>
+#include <filesystem>
+#include <fstream>
 #include <hps/hash_map_backend.hpp>
 #include <hps/hash_map_backend_detail.hpp>
 #include <hps/hier_parameter_server_base.hpp>
@@ -29,6 +36,101 @@
 
 namespace HugeCTR {
 
+namespace {
+
+/**
+ * Snapshot files consist of a \p SnapshotHeader , followed by a \p SnapshotPartition record for
+ * each partition. Then, for each partition, the keys and an image of the value pages follow. The
+ * image is laid out like the pages of a \p ValueArena , so that it can be mapped instead of being
+ * copied. Key arrays and images start at OS page boundaries. Values are not checksummed, because
+ * that would require reading the entire image.
+ */
+constexpr char snapshot_magic[8]{'h', 'p', 's', 's', 'n', 'a', 'p', '\0'};
+constexpr uint64_t snapshot_version{1};
+
+struct SnapshotHeader final {
+  char magic[8];
+  uint64_t version;
+  uint64_t key_size;
+  uint64_t value_size;  // Decoded.
+  uint64_t value_codec;
+  uint64_t slot_size;
+  uint64_t page_size;
+  uint64_t slots_per_page;
+  uint64_t num_partitions;
+  uint64_t checksum;  // Of all preceding fields and the partition records.
+};
+
+struct SnapshotPartition final {
+  uint64_t num_entries;
+  uint64_t keys_offset;
+  uint64_t values_offset;
+  uint64_t keys_checksum;
+};
+
+inline uint64_t snapshot_checksum(const uint64_t checksum, const uint64_t x) {
+  return rotr64(checksum, 1) ^ rrxmrrxmsx_0(x);
+}
+
+uint64_t snapshot_checksum(const SnapshotHeader& header,
+                           const std::vector<SnapshotPartition>& part_headers) {
+  static_assert(offsetof(SnapshotHeader, checksum) % sizeof(uint64_t) == 0);
+  static_assert(sizeof(SnapshotPartition) % sizeof(uint64_t) == 0);
+
+  uint64_t checksum{0};
+  const auto update = [&](const void* const data, const size_t size) {
+    for (size_t i{0}; i < size; i += sizeof(uint64_t)) {
+      uint64_t x;
+      std::memcpy(&x, &static_cast<const char*>(data)[i], sizeof(uint64_t));
+      checksum = snapshot_checksum(checksum, x);
+    }
+  };
+  update(&header, offsetof(SnapshotHeader, checksum));
+  update(part_headers.data(), part_headers.size() * sizeof(SnapshotPartition));
+  return checksum;
+}
+
+/**
+ * Read-only mapping of a snapshot file. The file descriptor is needed to map value images.
+ */
+struct SnapshotFile final {
+  int fd{-1};
+  size_t size{0};
+  const char* data{nullptr};
+
+  HCTR_DISALLOW_COPY_AND_MOVE(SnapshotFile);
+
+  explicit SnapshotFile(const std::string& path) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      HCTR_OWN_THROW(Error_t::FileCannotOpen, "Unable to open snapshot '" + path + "'.");
+    }
+    size = std::filesystem::file_size(path);
+    if (size) {
+      void* const ptr{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+      if (ptr == MAP_FAILED) {
+        close(fd);
+        HCTR_OWN_THROW(Error_t::WrongInput, "Unable to map snapshot '" + path + "'.");
+      }
+      data = static_cast<const char*>(ptr);
+    }
+  }
+
+  ~SnapshotFile() {
+    if (data) {
+      munmap(const_cast<char*>(data), size);
+    }
+    close(fd);
+  }
+};
+
+inline size_t os_page_align(const size_t n) {
+  static const size_t os_page_size{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+  return (n + os_page_size - 1) / os_page_size * os_page_size;
+}
+
+}  // namespace
+
 template <typename Key>
 HashMapBackend<Key>::HashMapBackend(const HashMapBackendParams& params) : Base(params) {
   HCTR_LOG_C(DEBUG, WORLD, "Created blank database backend in local memory!\n");
@@ -36,7 +138,7 @@ HashMapBackend<Key>::HashMapBackend(const HashMapBackendParams& params) : Base(p
 
 template <typename Key>
 size_t HashMapBackend<Key>::size(const std::string& table_name) const {
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_lock lock(read_guard_);
 
   // Locate the partitions.
   const auto& tables_it{tables_.find(table_name)};
@@ -54,7 +156,7 @@ size_t HashMapBackend<Key>::contains(const std::string& table_name, const size_t
                                      const Key* const keys,
                                      const std::chrono::nanoseconds& time_budget) const {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_lock lock(read_guard_);
 
   // Locate partitions.
   const auto& tables_it{tables_.find(table_name)};
@@ -83,7 +185,7 @@ size_t HashMapBackend<Key>::contains(const std::string& table_name, const size_t
 
       const size_t prev_hit_count{hit_count};
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
-      HCTR_HPS_HASH_MAP_CONTAINS_(SEQUENTIAL_DIRECT);
+      HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_(SEQUENTIAL_DIRECT);
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (k - keys - 1) / max_batch_size, ": ", hit_count - prev_hit_count,
@@ -107,7 +209,7 @@ size_t HashMapBackend<Key>::contains(const std::string& table_name, const size_t
 
         const size_t prev_hit_count{hit_count};
         size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_CONTAINS_(PARALLEL_DIRECT);
+        HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_(PARALLEL_DIRECT);
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", num_batches, ": ", hit_count - prev_hit_count, " / ", batch_size,
@@ -135,23 +237,24 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
   const std::unique_lock lock(read_write_guard_);
 
   // Locate the partitions, or create them, if they do not exist yet.
-  const auto& tables_it{tables_.try_emplace(table_name).first};
-  std::vector<Partition>& parts{tables_it->second};
-  if (parts.empty()) {
-    HCTR_CHECK(value_size > 0 && value_size <= this->params_.allocation_rate);
+  auto tables_it{tables_.find(table_name)};
+  if (tables_it == tables_.end()) {
+    std::vector<Partition> parts{make_partitions_(value_size)};
 
-    parts.reserve(this->params_.num_partitions);
-    while (parts.size() < this->params_.num_partitions) {
-      parts.emplace_back(value_size, this->params_);
-    }
+    // Altering the table map requires exclusive access.
+    const std::unique_lock exclusive_lock(read_guard_);
+    tables_it = tables_.emplace(table_name, std::move(parts)).first;
   }
+  std::vector<Partition>& parts{tables_it->second};
 
   const Key* const keys_end{&keys[num_pairs]};
   const size_t num_partitions{parts.size()};
   const size_t max_batch_size{this->params_.max_batch_size};
   const DatabaseOverflowPolicy_t overflow_policy{this->params_.overflow_policy};
+  const bool track_samples{this->params_.overflow_sample_size > 0};
 
   size_t num_inserts{0};
+  std::atomic<bool> rehashed{false};
 
   if (num_pairs == 0) {
     // Do nothing ;-).
@@ -160,17 +263,33 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size == value_size);
 
+    // Grow the map at most once per call (see below).
+    const size_t prev_capacity{part.entries.capacity()};
+    {
+      const size_t num_new_keys{static_cast<size_t>(
+          std::count_if(keys, keys_end, [&](const Key& k) { return !part.entries.contains(k); }))};
+
+      const SeqLockWriteGuard part_guard(part);
+      part.entries.reserve(part.entries.size() + num_new_keys);
+    }
+    rehashed = part.entries.capacity() != prev_capacity;
+
     // Step through batch-by-batch.
     for (const Key* k{keys}; k != keys_end;) {
+      const SeqLockWriteGuard part_guard(part);
+
       // Check overflow condition.
       if (part.entries.size() >= this->params_.overflow_margin) {
         resolve_overflow_(table_name, part_index, part);
+        compact_(table_name, part_index, part);
       }
 
       // Perform insertion.
       const size_t prev_num_inserts{num_inserts};
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
-      HCTR_HPS_HASH_MAP_INSERT_(SEQUENTIAL_DIRECT);
+      HCTR_HPS_HASH_MAP_INSERT_(SEQUENTIAL_DIRECT, if (track_samples && res.second) {
+        part.sample_keys.emplace_back(*k);
+      });
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (k - keys - 1) / max_batch_size, ": Inserted ",
@@ -186,18 +305,40 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
 
       size_t num_inserts{0};
 
+      // Grow the map at most once per call (see below).
+      const size_t prev_capacity{part.entries.capacity()};
+      {
+        size_t num_new_keys{0};
+        for (const Key* k{keys}; k != keys_end; ++k) {
+          if (HCTR_HPS_KEY_TO_PART_INDEX_(*k) == part_index) {
+            num_new_keys += !part.entries.contains(*k);
+          }
+        }
+
+        const SeqLockWriteGuard part_guard(part);
+        part.entries.reserve(part.entries.size() + num_new_keys);
+      }
+      if (part.entries.capacity() != prev_capacity) {
+        rehashed = true;
+      }
+
       // Step through batch-by-batch.
       size_t num_batches{0};
       for (const Key* k{keys}; k != keys_end; ++num_batches) {
+        const SeqLockWriteGuard part_guard(part);
+
         // Check overflow condition.
         if (part.entries.size() >= this->params_.overflow_margin) {
           resolve_overflow_(table_name, part_index, part);
+          compact_(table_name, part_index, part);
         }
 
         // Perform insertion.
         const size_t prev_num_inserts{num_inserts};
         size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_INSERT_(PARALLEL_DIRECT);
+        HCTR_HPS_HASH_MAP_INSERT_(PARALLEL_DIRECT, if (track_samples && res.second) {
+          part.sample_keys.emplace_back(*k);
+        });
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", num_batches, ": Inserted ", num_inserts - prev_num_inserts,
@@ -211,6 +352,12 @@ size_t HashMapBackend<Key>::insert(const std::string& table_name, const size_t n
     num_inserts += joint_num_inserts;
   }
 
+  // Lookups may still probe the bucket array that was replaced by the last rehash. It is released
+  // with the next rehash. Hence, we must wait for them to finish, before another write can happen.
+  if (rehashed) {
+    read_guard_.synchronize();
+  }
+
   HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Inserted ", num_inserts,
              " + updated ", num_pairs - num_inserts, " = ", num_pairs, " entries.\n");
   return num_inserts;
@@ -222,7 +369,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
                                   const size_t value_stride, const DatabaseMissCallback& on_miss,
                                   const std::chrono::nanoseconds& time_budget) {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_lock lock(read_guard_);
 
   // Locate the partitions.
   const auto& tables_it{tables_.find(table_name)};
@@ -253,14 +400,21 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
 
       const size_t prev_miss_count{miss_count};
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
-      HCTR_HPS_HASH_MAP_FETCH_(SEQUENTIAL_DIRECT);
+      HCTR_HPS_HASH_MAP_BATCHED_FETCH_(SEQUENTIAL_DIRECT);
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (k - keys - 1) / max_batch_size, ": ",
                  batch_size - miss_count + prev_miss_count, " / ", batch_size,
                  " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
     }
+
+    try_merge_access_stats_(part);
   } else {
+    // Group keys by partition, so that each partition only needs to visit its own keys.
+    std::vector<size_t> part_offsets;
+    std::vector<size_t> part_indices;
+    group_keys_by_part(num_partitions, num_keys, nullptr, keys, part_offsets, part_indices);
+
     std::atomic<size_t> joint_miss_count{0};
     std::atomic<size_t> joint_skip_count{0};
 
@@ -268,25 +422,31 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size <= value_stride);
 
+      const size_t* const part_indices_begin{part_indices.data() + part_offsets[part_index]};
+      const size_t* const indices_end{part_indices.data() + part_offsets[part_index + 1]};
+
       size_t miss_count{0};
+      size_t skip_count{0};
 
       // Step through input batch-by-batch.
       std::chrono::nanoseconds elapsed;
-      size_t num_batches{0};
-      for (const Key* k{keys}; k != keys_end; ++num_batches) {
-        HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_DIRECT, on_miss);
+      for (const size_t* i{part_indices_begin}; i != indices_end;) {
+        HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
 
         const size_t prev_miss_count{miss_count};
-        size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_FETCH_(PARALLEL_DIRECT);
+        const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};
+        HCTR_HPS_HASH_MAP_BATCHED_FETCH_(SEQUENTIAL_INDIRECT);
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
-                   ", batch ", num_batches, ": ", batch_size - miss_count + prev_miss_count, " / ",
-                   batch_size, " hits. Time: ", elapsed.count(), " / ", time_budget.count(),
-                   " ns.\n");
+                   ", batch ", (i - part_indices_begin - 1) / max_batch_size, ": ",
+                   batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                   " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
       }
 
+      try_merge_access_stats_(part);
+
       joint_miss_count += miss_count;
+      joint_skip_count += skip_count;
     });
 
     miss_count += joint_miss_count;
@@ -306,7 +466,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
                                   const DatabaseMissCallback& on_miss,
                                   const std::chrono::nanoseconds& time_budget) {
   const auto begin{std::chrono::high_resolution_clock::now()};
-  const std::shared_lock lock(read_write_guard_);
+  const std::shared_lock lock(read_guard_);
 
   // Locate the partitions.
   const auto& tables_it{tables_.find(table_name)};
@@ -327,7 +487,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
   if (num_indices == 0) {
     // Do nothing ;-).
   } else if (num_indices == 1 || num_partitions == 1) {
-    const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
+    const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(keys[*indices])};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size <= value_stride);
 
@@ -338,14 +498,21 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
 
       const size_t prev_miss_count{miss_count};
       const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};
-      HCTR_HPS_HASH_MAP_FETCH_(SEQUENTIAL_INDIRECT);
+      HCTR_HPS_HASH_MAP_BATCHED_FETCH_(SEQUENTIAL_INDIRECT);
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (i - indices - 1) / max_batch_size, ": ",
                  batch_size - miss_count + prev_miss_count, " / ", batch_size,
                  " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
     }
+
+    try_merge_access_stats_(part);
   } else {
+    // Group keys by partition, so that each partition only needs to visit its own keys.
+    std::vector<size_t> part_offsets;
+    std::vector<size_t> part_indices;
+    group_keys_by_part(num_partitions, num_indices, indices, keys, part_offsets, part_indices);
+
     std::atomic<size_t> joint_miss_count{0};
     std::atomic<size_t> joint_skip_count{0};
 
@@ -353,25 +520,31 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
       Partition& part{parts[part_index]};
       HCTR_CHECK(part.value_size <= value_stride);
 
+      const size_t* const part_indices_begin{part_indices.data() + part_offsets[part_index]};
+      const size_t* const indices_end{part_indices.data() + part_offsets[part_index + 1]};
+
       size_t miss_count{0};
+      size_t skip_count{0};
 
       // Step through input batch-by-batch.
       std::chrono::nanoseconds elapsed;
-      size_t num_batches{0};
-      for (const size_t* i{indices}; i != indices_end; ++num_batches) {
-        HCTR_HPS_DB_CHECK_TIME_BUDGET_(PARALLEL_INDIRECT, on_miss);
+      for (const size_t* i{part_indices_begin}; i != indices_end;) {
+        HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
 
         const size_t prev_miss_count{miss_count};
-        size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_FETCH_(PARALLEL_INDIRECT);
+        const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};
+        HCTR_HPS_HASH_MAP_BATCHED_FETCH_(SEQUENTIAL_INDIRECT);
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
-                   ", batch ", num_batches, ": ", batch_size - miss_count + prev_miss_count, " / ",
-                   batch_size, " hits. Time: ", elapsed.count(), " / ", time_budget.count(),
-                   " ns.\n");
+                   ", batch ", (i - part_indices_begin - 1) / max_batch_size, ": ",
+                   batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                   " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
       }
 
+      try_merge_access_stats_(part);
+
       joint_miss_count += miss_count;
+      joint_skip_count += skip_count;
     });
 
     miss_count += joint_miss_count;
@@ -387,6 +560,7 @@ size_t HashMapBackend<Key>::fetch(const std::string& table_name, const size_t nu
 template <typename Key>
 size_t HashMapBackend<Key>::evict(const std::string& table_name) {
   const std::unique_lock lock(read_write_guard_);
+  const std::unique_lock exclusive_lock(read_guard_);
 
   // Locate the partitions.
   const auto& tables_it{tables_.find(table_name)};
@@ -433,6 +607,8 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t nu
 
     // Step through input batch-by-batch.
     for (const Key* k{keys}; k != keys_end;) {
+      const SeqLockWriteGuard part_guard(part);
+
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
       const size_t prev_num_deletions{num_deletions};
       HCTR_HPS_HASH_MAP_EVICT_(SEQUENTIAL_DIRECT);
@@ -441,6 +617,9 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t nu
                  ", batch ", (k - keys - 1) / max_batch_size, ": Erased ",
                  num_deletions - prev_num_deletions, " entries.\n");
     }
+
+    const SeqLockWriteGuard part_guard(part);
+    compact_(table_name, part_index, part);
   } else {
     std::atomic<size_t> joint_num_deletions{0};
 
@@ -452,6 +631,8 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t nu
       // Step through input batch-by-batch.
       size_t num_batches{0};
       for (const Key* k{keys}; k != keys_end; ++num_batches) {
+        const SeqLockWriteGuard part_guard(part);
+
         const size_t prev_num_deletions{num_deletions};
         size_t batch_size{0};
         HCTR_HPS_HASH_MAP_EVICT_(PARALLEL_DIRECT);
@@ -461,6 +642,11 @@ size_t HashMapBackend<Key>::evict(const std::string& table_name, const size_t nu
                    batch_size, " entries.\n");
       }
 
+      {
+        const SeqLockWriteGuard part_guard(part);
+        compact_(table_name, part_index, part);
+      }
+
       joint_num_deletions += num_deletions;
     });
 
@@ -502,13 +688,15 @@ size_t HashMapBackend<Key>::dump_bin(const std::string& table_name, std::ofstrea
   const uint32_t value_size{parts.empty() ? 0 : parts.front().value_size};
   file.write(reinterpret_cast<const char*>(&value_size), sizeof(uint32_t));
 
-  // Store values.
+  // Store values (decoded, so that dumps do not depend on the storage format).
   size_t num_entries{0};
+  std::vector<char> value(value_size);
 
   for (const Partition& part : parts) {
     for (const Entry& entry : part.entries) {
       file.write(reinterpret_cast<const char*>(&entry.first), sizeof(Key));
-      file.write(entry.second.value, value_size);
+      part.codec.decode(entry.second.value, value_size, value.data());
+      file.write(value.data(), value_size);
     }
     num_entries += part.entries.size();
   }
@@ -528,36 +716,422 @@ size_t HashMapBackend<Key>::dump_sst(const std::string& table_name, rocksdb::Sst
   const std::vector<Partition>& parts{tables_it->second};
 
   // Sort keys by value.
-  std::vector<const Entry*> entries;
+  std::vector<std::pair<const Entry*, const Partition*>> entries;
   entries.reserve(
       std::accumulate(parts.begin(), parts.end(), UINT64_C(0),
                       [](const size_t a, const Partition& b) { return a + b.entries.size(); }));
   for (const Partition& part : parts) {
     for (const Entry& entry : part.entries) {
-      entries.emplace_back(&entry);
+      entries.emplace_back(&entry, &part);
     }
   }
   // TODO: Copy or ref? Chose ref because low memory footprint, but has worse cache locality.
   // Benchmark?
   std::sort(entries.begin(), entries.end(),
-            [](const auto& a, const auto& b) { return a->first < b->first; });
+            [](const auto& a, const auto& b) { return a.first->first < b.first->first; });
 
-  // Iterate over pairs and insert.
+  // Iterate over pairs and insert (values are decoded).
+  std::vector<char> value(parts.empty() ? 0 : parts.front().value_size);
   rocksdb::Slice k_view{nullptr, sizeof(Key)};
-  rocksdb::Slice v_view{nullptr, parts.empty() ? 0 : parts.front().value_size};
+  rocksdb::Slice v_view{value.data(), value.size()};
 
-  for (const Entry* const entry : entries) {
+  for (const auto& [entry, part] : entries) {
     k_view.data_ = reinterpret_cast<const char*>(&entry->first);
-    v_view.data_ = entry->second.value;
+    part->codec.decode(entry->second.value, value.size(), value.data());
     HCTR_ROCKSDB_CHECK(file.Put(k_view, v_view));
   }
 
   return entries.size();
 }
 
+template <typename Key>
+size_t HashMapBackend<Key>::dump_snapshot(const std::string& table_name,
+                                          const std::string& path) {
+  SnapshotHeader header{};
+  std::copy_n(snapshot_magic, sizeof(snapshot_magic), header.magic);
+  header.version = snapshot_version;
+  header.key_size = sizeof(Key);
+
+  // Tables could be replaced while we are not holding the lock.
+  const auto& is_same_table = [&](const std::vector<Partition>& parts) {
+    const Partition& part{parts.front()};
+    return parts.size() == header.num_partitions && part.value_size == header.value_size &&
+           static_cast<uint64_t>(part.codec.type()) == header.value_codec &&
+           part.value_arena.slot_size() == header.slot_size &&
+           part.value_arena.page_size() == header.page_size;
+  };
+
+  {
+    const std::shared_lock lock(read_write_guard_);
+
+    // Locate the partitions.
+    const auto& tables_it{tables_.find(table_name)};
+    if (tables_it == tables_.end()) {
+      return 0;
+    }
+    const std::vector<Partition>& parts{tables_it->second};
+    const Partition& part{parts.front()};
+
+    header.value_size = part.value_size;
+    header.value_codec = static_cast<uint64_t>(part.codec.type());
+    header.slot_size = part.value_arena.slot_size();
+    header.page_size = part.value_arena.page_size();
+    header.slots_per_page = part.value_arena.slots_per_page();
+    header.num_partitions = parts.size();
+  }
+  std::vector<SnapshotPartition> part_headers(header.num_partitions);
+
+  // Write to a temporary file first. Tables restored from a previous snapshot may still map it.
+  const std::string tmp_path{path + ".tmp"};
+  std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Unable to create snapshot '" + tmp_path + "'.");
+  }
+
+  const size_t encoded_value_size{
+      ValueCodec(static_cast<DatabaseValueCodec_t>(header.value_codec))
+          .encoded_size(header.value_size)};
+  const std::vector<char> padding(header.slot_size);
+  const size_t page_padding{header.page_size - header.slots_per_page * header.slot_size};
+
+  size_t offset{
+      os_page_align(sizeof(SnapshotHeader) + part_headers.size() * sizeof(SnapshotPartition))};
+  size_t num_entries{0};
+
+  for (size_t part_index{0}; part_index < part_headers.size(); ++part_index) {
+    // Writers hold `read_write_guard_` exclusively. Hence, all writers wait while a partition is
+    // written, and can only proceed between partitions.
+    const std::shared_lock lock(read_write_guard_);
+
+    const auto& tables_it{tables_.find(table_name)};
+    if (tables_it == tables_.end() || !is_same_table(tables_it->second)) {
+      HCTR_LOG_S(WARNING, WORLD) << get_name() << " backend; Table " << table_name
+                                 << " was altered while writing snapshot '" << path
+                                 << "'. Snapshot discarded." << std::endl;
+      file.close();
+      std::filesystem::remove(tmp_path);
+      return 0;
+    }
+    const Partition& part{tables_it->second[part_index]};
+    SnapshotPartition& part_header{part_headers[part_index]};
+    part_header.num_entries = part.entries.size();
+
+    // Store keys.
+    part_header.keys_offset = offset;
+    file.seekp(static_cast<std::streamoff>(offset));
+    for (const Entry& entry : part.entries) {
+      file.write(reinterpret_cast<const char*>(&entry.first), sizeof(Key));
+      part_header.keys_checksum =
+          snapshot_checksum(part_header.keys_checksum, static_cast<uint64_t>(entry.first));
+    }
+    offset = os_page_align(offset + part_header.num_entries * sizeof(Key));
+
+    // Store values (encoded) in the same order, laid out like the pages of a `ValueArena`.
+    part_header.values_offset = offset;
+    file.seekp(static_cast<std::streamoff>(offset));
+    size_t slot_index{0};
+    for (const Entry& entry : part.entries) {
+      file.write(entry.second.value, static_cast<std::streamsize>(encoded_value_size));
+      file.write(padding.data(),
+                 static_cast<std::streamsize>(header.slot_size - encoded_value_size));
+      if (++slot_index == header.slots_per_page) {
+        file.write(padding.data(), static_cast<std::streamsize>(page_padding));
+        slot_index = 0;
+      }
+    }
+    offset += (part_header.num_entries + header.slots_per_page - 1) / header.slots_per_page *
+              header.page_size;
+
+    num_entries += part_header.num_entries;
+  }
+
+  // Store header.
+  header.checksum = snapshot_checksum(header, part_headers);
+  file.seekp(0);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(SnapshotHeader));
+  file.write(reinterpret_cast<const char*>(part_headers.data()),
+             static_cast<std::streamsize>(part_headers.size() * sizeof(SnapshotPartition)));
+  file.close();
+  if (!file) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Unable to write snapshot '" + tmp_path + "'.");
+  }
+
+  // Value images must cover whole pages (the tail of the last page is left sparse).
+  std::filesystem::resize_file(tmp_path, offset);
+  std::filesystem::rename(tmp_path, path);
+
+  HCTR_LOG_C(DEBUG, WORLD, get_name(), " backend; Table ", table_name, ": Wrote snapshot of ",
+             num_entries, " entries to '", path, "'.\n");
+  return num_entries;
+}
+
+template <typename Key>
+size_t HashMapBackend<Key>::load_dump_snapshot(const std::string& table_name,
+                                               const std::string& path) {
+  const SnapshotFile file(path);
+  const auto& check = [&](const bool condition, const char* const what) {
+    if (!condition) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Snapshot '" + path + "' is invalid: " + what + ".");
+    }
+  };
+
+  // Parse and validate headers.
+  check(file.size >= sizeof(SnapshotHeader), "truncated header");
+  SnapshotHeader header;
+  std::memcpy(&header, file.data, sizeof(SnapshotHeader));
+  check(std::equal(header.magic, &header.magic[sizeof(snapshot_magic)], snapshot_magic),
+        "not a snapshot");
+  check(header.version == snapshot_version, "unsupported version");
+  check(header.key_size == sizeof(Key), "key size mismatch");
+  check(header.num_partitions > 0 && header.slots_per_page > 0 &&
+            header.slots_per_page * header.slot_size <= header.page_size,
+        "bad layout");
+  check(file.size >= sizeof(SnapshotHeader) + header.num_partitions * sizeof(SnapshotPartition),
+        "truncated header");
+
+  std::vector<SnapshotPartition> part_headers(header.num_partitions);
+  std::memcpy(part_headers.data(), &file.data[sizeof(SnapshotHeader)],
+              part_headers.size() * sizeof(SnapshotPartition));
+  check(header.checksum == snapshot_checksum(header, part_headers), "header checksum mismatch");
+
+  const ValueCodec codec{static_cast<DatabaseValueCodec_t>(header.value_codec)};
+  const uint32_t value_size{static_cast<uint32_t>(header.value_size)};
+  const size_t encoded_value_size{codec.encoded_size(value_size)};
+  check(encoded_value_size <= header.slot_size, "bad layout");
+
+  for (const SnapshotPartition& part_header : part_headers) {
+    const size_t num_pages{(part_header.num_entries + header.slots_per_page - 1) /
+                           header.slots_per_page};
+    check(part_header.keys_offset == os_page_align(part_header.keys_offset) &&
+              part_header.values_offset == os_page_align(part_header.values_offset),
+          "misaligned partition");
+    check(part_header.keys_offset + part_header.num_entries * sizeof(Key) <= file.size &&
+              part_header.values_offset + num_pages * header.page_size <= file.size,
+          "truncated partition");
+
+    const Key* const keys{reinterpret_cast<const Key*>(&file.data[part_header.keys_offset])};
+    check(std::accumulate(keys, &keys[part_header.num_entries], UINT64_C(0),
+                          [](const uint64_t a, const Key& k) {
+                            return snapshot_checksum(a, static_cast<uint64_t>(k));
+                          }) == part_header.keys_checksum,
+          "key checksum mismatch");
+  }
+
+  std::vector<Partition> parts{make_partitions_(value_size)};
+  const size_t num_partitions{parts.size()};
+  const size_t num_entries{std::accumulate(
+      part_headers.begin(), part_headers.end(), UINT64_C(0),
+      [](const size_t a, const SnapshotPartition& b) { return a + b.num_entries; })};
+
+  // Values can only be mapped if they would end up in the same partition and slot layout.
+  const Partition& first_part{parts.front()};
+  if (num_partitions != header.num_partitions || first_part.codec.type() != codec.type() ||
+      first_part.value_arena.slot_size() != header.slot_size ||
+      first_part.value_arena.page_size() != header.page_size) {
+    HCTR_LOG_S(INFO, WORLD) << get_name() << " backend; Snapshot '" << path
+                            << "' does not match the value storage layout of table "
+                            << table_name << ". Copying values instead." << std::endl;
+    parts.clear();
+    evict(table_name);
+
+    const size_t batch_size{this->max_bulk_batch_size()};
+    std::vector<char> values(batch_size * value_size);
+
+    for (const SnapshotPartition& part_header : part_headers) {
+      const Key* const keys{reinterpret_cast<const Key*>(&file.data[part_header.keys_offset])};
+      const char* const image{&file.data[part_header.values_offset]};
+
+      for (size_t i{0}; i < part_header.num_entries; i += batch_size) {
+        const size_t n{std::min(part_header.num_entries - i, batch_size)};
+        for (size_t j{0}; j < n; ++j) {
+          const size_t slot{i + j};
+          codec.decode(&image[slot / header.slots_per_page * header.page_size +
+                              slot % header.slots_per_page * header.slot_size],
+                       value_size, &values[j * value_size]);
+        }
+        insert(table_name, n, &keys[i], values.data(), value_size, value_size);
+      }
+    }
+    return num_entries;
+  }
+
+  // Rebuild the maps, and adopt the value images.
+  const bool track_samples{this->params_.overflow_sample_size > 0};
+
+  HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
+    Partition& part{parts[part_index]};
+    const SnapshotPartition& part_header{part_headers[part_index]};
+    const Key* const keys{reinterpret_cast<const Key*>(&file.data[part_header.keys_offset])};
+
+    const std::vector<char*> pages{
+        part.value_arena.map_image(file.fd, part_header.values_offset, part_header.num_entries)};
+    const size_t slot_size{part.value_arena.slot_size()};
+    const size_t slots_per_page{part.value_arena.slots_per_page()};
+
+    // Fresh entries have no access history (0 = not accessed).
+    const uint64_t last_access{this->params_.overflow_policy ==
+                                       DatabaseOverflowPolicy_t::EvictOldest
+                                   ? part.recency_clock.now()
+                                   : 0};
+
+    part.entries.reserve(part_header.num_entries);
+    if (track_samples) {
+      part.sample_keys.reserve(part_header.num_entries);
+    }
+    for (size_t i{0}; i < part_header.num_entries; ++i) {
+      const Key& k{keys[i]};
+      HCTR_CHECK_HINT(HCTR_HPS_KEY_TO_PART_INDEX_(k) == part_index,
+                      "Snapshot key ", k, " is stored in the wrong partition!");
+
+      const auto& res{part.entries.try_emplace(k)};
+      HCTR_CHECK_HINT(res.second, "Snapshot contains duplicate key ", k, '!');
+      Payload& payload{res.first->second};
+      payload.last_access = last_access;
+      payload.value = &pages[i / slots_per_page][i % slots_per_page * slot_size];
+
+      if (track_samples) {
+        part.sample_keys.emplace_back(k);
+      }
+    }
+  });
+
+  {
+    const std::unique_lock lock(read_write_guard_);
+    const std::unique_lock exclusive_lock(read_guard_);
+    tables_.insert_or_assign(table_name, std::move(parts));
+  }
+
+  HCTR_LOG_C(DEBUG, WORLD, get_name(), " backend; Table ", table_name, ": Mapped snapshot of ",
+             num_entries, " entries from '", path, "'.\n");
+  return num_entries;
+}
+
+template <typename Key>
+ValueArenaStats HashMapBackend<Key>::memory_stats(const std::string& table_name) const {
+  // Writers hold `read_write_guard_` exclusively.
+  const std::shared_lock lock(read_write_guard_);
+
+  ValueArenaStats stats;
+
+  // Locate the partitions.
+  const auto& tables_it{tables_.find(table_name)};
+  if (tables_it != tables_.end()) {
+    for (const Partition& part : tables_it->second) {
+      stats += part.value_arena.stats();
+    }
+  }
+  return stats;
+}
+
+template <typename Key>
+std::vector<typename HashMapBackend<Key>::Partition> HashMapBackend<Key>::make_partitions_(
+    const uint32_t value_size) const {
+  HCTR_CHECK(value_size > 0 && value_size <= this->params_.allocation_rate);
+
+  std::vector<Partition> parts;
+  parts.reserve(this->params_.num_partitions);
+  while (parts.size() < this->params_.num_partitions) {
+    const int numa_node{this->params_.numa_aware
+                            ? ValueArena::numa_node_for_partition(parts.size())
+                            : -1};
+    parts.emplace_back(value_size, this->params_, numa_node);
+  }
+  return parts;
+}
+
+template <typename Key>
+void HashMapBackend<Key>::compact_(const std::string& table_name, const size_t part_index,
+                                   Partition& part) const {
+  ValueArena& arena{part.value_arena};
+
+  const size_t num_moves{arena.begin_compaction(this->params_.compaction_threshold)};
+  if (num_moves) {
+    const ValueArenaStats prev_stats{arena.stats()};
+
+    // Lookups in progress detect the relocation through the partition version.
+    for (auto& entry : part.entries) {
+      Payload& payload{entry.second};
+      if (arena.is_draining(payload.value)) {
+        const ValuePtr value{arena.allocate()};
+        std::copy_n(payload.value, arena.value_size(), value);
+        arena.release(payload.value);
+        payload.value = value;
+      }
+    }
+
+    HCTR_LOG_S(DEBUG, WORLD) << get_name() << " backend; Partition " << table_name << '/'
+                             << part_index << ": Compacted " << num_moves << " values ("
+                             << prev_stats << ") -> (" << arena.stats() << ")." << std::endl;
+  }
+  arena.end_compaction();
+}
+
+template <typename Key>
+void HashMapBackend<Key>::merge_access_stats_(Partition& part) const {
+  const DatabaseOverflowPolicy_t overflow_policy{this->params_.overflow_policy};
+
+  for (AccessStats& stats : part.access_stats) {
+    // Readers may hold the lock while waiting for us to release the partition. Hence, we must not
+    // block here. Statistics of shards that are currently busy will be merged next time.
+    const std::unique_lock stats_lock(stats.guard, std::try_to_lock);
+    if (!stats_lock.owns_lock()) {
+      continue;
+    }
+
+    for (const auto& [key, value] : stats.values) {
+      const auto& it{part.entries.find(key)};
+      if (it == part.entries.end()) {
+        continue;
+      }
+
+      Payload& payload{it->second};
+      switch (overflow_policy) {
+        case DatabaseOverflowPolicy_t::EvictRandom:
+          break;
+        case DatabaseOverflowPolicy_t::EvictLeastUsed:
+          payload.access_count += value;
+          break;
+        case DatabaseOverflowPolicy_t::EvictOldest:
+          payload.last_access = std::max(payload.last_access, value);
+          break;
+      }
+    }
+    // Release the memory as well. Otherwise, a burst of distinct keys would pin it indefinitely.
+    stats.values = {};
+  }
+}
+
+template <typename Key>
+void HashMapBackend<Key>::try_merge_access_stats_(Partition& part) const {
+  if (this->params_.overflow_policy == DatabaseOverflowPolicy_t::EvictRandom) {
+    return;
+  }
+
+  // Tables that seldom overflow would otherwise keep dropping the statistics of new keys.
+  {
+    AccessStats& stats{part.access_stats[ShardedSharedMutex::this_thread_shard()]};
+    const std::unique_lock stats_lock(stats.guard, std::try_to_lock);
+    if (!stats_lock.owns_lock() || stats.values.size() < AccessStats::max_size / 2) {
+      return;
+    }
+  }
+
+  // Only statistics are updated, which lock-free readers never look at. Hence, the partition
+  // version remains unchanged.
+  const std::unique_lock part_lock(part.write_guard, std::try_to_lock);
+  if (part_lock.owns_lock()) {
+    merge_access_stats_(part);
+  }
+}
+
 template <typename Key>
 size_t HashMapBackend<Key>::resolve_overflow_(const std::string& table_name,
                                               const size_t part_index, Partition& part) {
+  merge_access_stats_(part);
+  if (this->params_.overflow_sample_size) {
+    return resolve_overflow_sampled_(table_name, part_index, part);
+  }
+
   const size_t max_batch_size{this->params_.max_batch_size};
 
   size_t num_deletions{0};
@@ -651,8 +1225,8 @@ size_t HashMapBackend<Key>::resolve_overflow_(const std::string& table_name,
     } break;
 
     case DatabaseOverflowPolicy_t::EvictOldest: {
-      // Fetch keys and insert times.
-      std::vector<std::pair<Key, time_t>> keys_metas;
+      // Fetch keys and recency stamps.
+      std::vector<std::pair<Key, uint64_t>> keys_metas;
       keys_metas.reserve(part.entries.size());
       for (const auto& entry : part.entries) {
         keys_metas.emplace_back(entry.first, entry.second.last_access);
@@ -685,6 +1259,91 @@ size_t HashMapBackend<Key>::resolve_overflow_(const std::string& table_name,
   return num_deletions;
 }
 
+template <typename Key>
+size_t HashMapBackend<Key>::resolve_overflow_sampled_(const std::string& table_name,
+                                                      const size_t part_index, Partition& part) {
+  const DatabaseOverflowPolicy_t overflow_policy{this->params_.overflow_policy};
+  const size_t sample_size{overflow_policy == DatabaseOverflowPolicy_t::EvictRandom
+                               ? 1
+                               : this->params_.overflow_sample_size};
+  std::vector<Key>& sample_keys{part.sample_keys};
+
+  // Purge evicted keys, if they make up the majority. Amortized O(1) per eviction.
+  if (sample_keys.size() > 2 * part.entries.size()) {
+    sample_keys.erase(std::remove_if(sample_keys.begin(), sample_keys.end(),
+                                     [&](const Key& k) { return !part.entries.contains(k); }),
+                      sample_keys.end());
+  }
+
+  // Instead of going straight for the resolution target, we only evict the overflowing entries plus
+  // as many as we can afford with `max_batch_size` samples. This bounds the time that the partition
+  // remains locked. Subsequent insertions will continue to work towards the target.
+  const size_t num_evictions{std::min(
+      part.entries.size() - this->overflow_resolution_margin_,
+      std::max(part.entries.size() - this->params_.overflow_margin + 1,
+               std::max<size_t>(this->params_.max_batch_size / sample_size, 1)))};
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
+             " is overflowing (size = ", part.entries.size(), " > ", this->params_.overflow_margin,
+             "): Attempting to evict ", num_evictions, " SAMPLED key/value pairs!\n");
+
+  // TODO: This randomizer shoud fetch its seed from a central source.
+  thread_local std::mt19937_64 gen{std::random_device()()};
+
+  size_t num_deletions{0};
+
+  // Approximate the policy by evicting the worst out of a few randomly drawn entries per iteration.
+  // Compared to sorting, this only costs O(sample_size) per evicted entry.
+  while (num_deletions < num_evictions && !sample_keys.empty()) {
+    size_t victim_index{sample_keys.size()};
+    uint64_t victim_score{std::numeric_limits<uint64_t>::max()};
+
+    for (size_t n{0}; n < sample_keys.size() && n < sample_size;) {
+      const size_t i{std::uniform_int_distribution<size_t>(0, sample_keys.size() - 1)(gen)};
+      const auto& it{part.entries.find(sample_keys[i])};
+
+      // Lazily purge keys that were evicted by other means.
+      if (it == part.entries.end()) {
+        if (victim_index == sample_keys.size() - 1) {
+          victim_index = i;
+        }
+        sample_keys[i] = sample_keys.back();
+        sample_keys.pop_back();
+        continue;
+      }
+      ++n;
+
+      const Payload& payload{it->second};
+      uint64_t score{0};
+      switch (overflow_policy) {
+        case DatabaseOverflowPolicy_t::EvictRandom:
+          break;
+        case DatabaseOverflowPolicy_t::EvictLeastUsed:
+          score = payload.access_count;
+          break;
+        case DatabaseOverflowPolicy_t::EvictOldest:
+          score = payload.last_access;
+          break;
+      }
+      if (score < victim_score) {
+        victim_index = i;
+        victim_score = score;
+      }
+    }
+    if (victim_index >= sample_keys.size()) {
+      break;
+    }
+
+    // Evict the selected entry.
+    const Key* const k{&sample_keys[victim_index]};
+    HCTR_HPS_HASH_MAP_EVICT_K_();
+    sample_keys[victim_index] = sample_keys.back();
+    sample_keys.pop_back();
+  }
+
+  return num_deletions;
+}
+
 template class HashMapBackend<unsigned int>;
 template class HashMapBackend<long long>;
 
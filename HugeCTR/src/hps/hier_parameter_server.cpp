@@ -20,14 +20,34 @@
 #include <hps/hash_map_backend.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/kafka_message.hpp>
+#include <hps/local_message.hpp>
 #include <hps/modelloader.hpp>
 #include <hps/mp_hash_map_backend.hpp>
 #include <hps/redis_backend.hpp>
 #include <hps/rocksdb_backend.hpp>
+#include <hps/slab_store_backend.hpp>
 #include <regex>
 
 namespace HugeCTR {
 
+namespace {
+
+// Most recent modification of any file in \p paths (directories are searched recursively).
+std::filesystem::file_time_type last_write_time(const std::vector<std::string>& paths) {
+  std::filesystem::file_time_type time = std::filesystem::file_time_type::min();
+  for (const std::string& path : paths) {
+    time = std::max(time, std::filesystem::last_write_time(path));
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+        time = std::max(time, entry.last_write_time());
+      }
+    }
+  }
+  return time;
+}
+
+}  // namespace
+
 std::string HierParameterServerBase::make_tag_name(const std::string& model_name,
                                                    const std::string& embedding_table_name,
                                                    const bool check_arguments) {
@@ -118,6 +138,12 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
             conf.overflow_policy,
             conf.overflow_resolution_target,
             conf.allocation_rate,
+            conf.overflow_sample_size,
+            conf.recency_source,
+            conf.huge_pages,
+            conf.numa_aware,
+            conf.compaction_threshold,
+            conf.value_codec,
         };
         volatile_db_ = std::make_unique<HashMapBackend<TypeHashKey>>(params);
       } break;
@@ -136,6 +162,9 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
             conf.shared_memory_name,
             std::chrono::milliseconds{100},  // heart_beat_frequency
             conf.shared_memory_auto_remove,
+            conf.shared_memory_open_addressing,
+            conf.recency_source,
+            conf.value_codec,
         };
         volatile_db_ = std::make_unique<MultiProcessHashMapBackend<TypeHashKey>>(params);
       } break;
@@ -157,6 +186,8 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
             conf.tls_client_certificate,
             conf.tls_client_key,
             conf.tls_server_name_identification,
+            conf.near_cache_size,
+            conf.near_cache_max_staleness_ms,
         };
         volatile_db_ = std::make_unique<RedisClusterBackend<TypeHashKey>>(params);
       } break;
@@ -168,10 +199,27 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
     volatile_db_initialize_after_startup_ = conf.initialize_after_startup;
     volatile_db_cache_rate_ = conf.initial_cache_rate;
     volatile_db_cache_missed_embeddings_ = conf.cache_missed_embeddings;
+    if (!conf.snapshot_path.empty()) {
+      if (conf.type == DatabaseType_t::HashMap || conf.type == DatabaseType_t::ParallelHashMap) {
+        std::filesystem::create_directories(conf.snapshot_path);
+        volatile_db_snapshot_path_ = conf.snapshot_path;
+      } else {
+        HCTR_LOG_S(WARNING, WORLD) << "Volatile DB: snapshots are not supported by the "
+                                   << volatile_db_->get_name() << " backend." << std::endl;
+      }
+    }
     HCTR_LOG_S(INFO, WORLD) << "Volatile DB: initial cache rate = " << volatile_db_cache_rate_
                             << std::endl;
     HCTR_LOG_S(INFO, WORLD) << "Volatile DB: cache missed embeddings = "
                             << volatile_db_cache_missed_embeddings_ << std::endl;
+
+    // Embeddings that are found in the persistent DB are promoted in batches. Limit the backlog,
+    // so that the volatile DB cannot fall behind indefinitely.
+    if (volatile_db_ && volatile_db_cache_missed_embeddings_) {
+      volatile_db_promotion_queue_ = std::make_unique<PromotionQueue<TypeHashKey>>(
+          volatile_db_.get(), conf.max_batch_size, 4 * conf.max_batch_size,
+          std::chrono::milliseconds{10});
+    }
   }
 
   // Connect to persistent database.
@@ -188,10 +236,31 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
             conf.path,
             conf.num_threads,
             conf.read_only,
+            conf.value_codec,
+            conf.block_cache_size,
+            conf.bloom_filter_bits_per_key,
+            conf.partitioned_filters,
+            conf.use_direct_reads,
+            conf.num_lookup_tasks,
         };
         persistent_db_ = std::make_unique<RocksDBBackend<TypeHashKey>>(params);
       } break;
 
+      case DatabaseType_t::SlabStore: {
+        HCTR_LOG_S(INFO, WORLD) << "Creating SlabStore backend..." << std::endl;
+        SlabStoreBackendParams params{
+            conf.max_batch_size,
+            conf.path,
+            conf.read_only,
+            conf.value_codec,
+            conf.use_direct_reads,
+            conf.num_lookup_tasks,
+            conf.io_depth,
+            conf.compaction_threshold,
+        };
+        persistent_db_ = std::make_unique<SlabStoreBackend<TypeHashKey>>(params);
+      } break;
+
       default:
         HCTR_DIE("Selected backend (persistent_db.type = %d) is not supported!", conf.type);
         break;
@@ -231,7 +300,10 @@ HierParameterServer<TypeHashKey>::HierParameterServer(const parameter_server_con
 template <typename TypeHashKey>
 HierParameterServer<TypeHashKey>::~HierParameterServer() {
   // Await all pending volatile database transactions.
-  volatile_db_async_inserter_.await_idle();
+  if (volatile_db_promotion_queue_) {
+    volatile_db_promotion_queue_->flush();
+  }
+  snapshot_worker_.await_idle();
 
   for (auto it = model_cache_map_.begin(); it != model_cache_map_.end(); it++) {
     for (auto& v : it->second) {
@@ -245,8 +317,9 @@ HierParameterServer<TypeHashKey>::~HierParameterServer() {
 template <typename TypeHashKey>
 void HierParameterServer<TypeHashKey>::update_database_per_model(
     const InferenceParams& inference_params) {
+  // Embeddings are consumed iteration by iteration. Fault in each iteration in parallel.
   IModelLoader* rawreader =
-      ModelLoader<TypeHashKey, float>::CreateLoader(DatabaseTableDumpFormat_t::Raw);
+      ModelLoader<TypeHashKey, float>::CreateLoader(DatabaseTableDumpFormat_t::Raw, true);
   size_t num_tables = inference_params.fuse_embedding_table
                           ? inference_params.fused_sparse_model_files.size()
                           : inference_params.sparse_model_files.size();
@@ -286,8 +359,38 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
               : static_cast<size_t>(
                     volatile_db_cache_rate_ * static_cast<double>(volatile_capacity) + 0.5);
 
-      volatile_db_async_inserter_.await_idle();
-      if (!inference_params.fuse_embedding_table) {
+      if (volatile_db_promotion_queue_) {
+        volatile_db_promotion_queue_->flush();
+      }
+
+      // Restore the table from its snapshot, if the snapshot is more recent than the model.
+      const std::string snapshot_path =
+          volatile_db_snapshot_path_.empty()
+              ? std::string()
+              : (std::filesystem::path(volatile_db_snapshot_path_) / (tag_name + ".snap"))
+                    .string();
+      bool restored = false;
+      if (!snapshot_path.empty() && std::filesystem::exists(snapshot_path)) {
+        const std::vector<std::string>& model_paths =
+            inference_params.fuse_embedding_table
+                ? inference_params.fused_sparse_model_files[j]
+                : std::vector<std::string>{inference_params.sparse_model_files[j]};
+        if (std::filesystem::last_write_time(snapshot_path) > last_write_time(model_paths)) {
+          try {
+            volatile_db_->load_dump_snapshot(tag_name, snapshot_path);
+            restored = true;
+          } catch (const std::exception& error) {
+            HCTR_LOG_S(WARNING, WORLD) << "Table: " << tag_name << "; unable to restore snapshot ("
+                                       << error.what() << "). Loading model files instead."
+                                       << std::endl;
+          }
+        }
+      }
+
+      if (restored) {
+        HCTR_LOG_S(INFO, WORLD) << "Table: " << tag_name << "; restored from snapshot "
+                                << snapshot_path << '.' << std::endl;
+      } else if (!inference_params.fuse_embedding_table) {
         for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
           std::pair<void*, size_t> key_result = rawreader->getkeys(i);
           std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
@@ -312,6 +415,18 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
         }
       }
 
+      // Snapshot the freshly populated table, so that the next startup can skip the above.
+      if (!restored && !snapshot_path.empty()) {
+        snapshot_worker_.submit([this, tag_name, snapshot_path]() {
+          try {
+            volatile_db_->dump_snapshot(tag_name, snapshot_path);
+          } catch (const std::exception& error) {
+            HCTR_LOG_S(WARNING, WORLD) << "Table: " << tag_name << "; unable to write snapshot ("
+                                       << error.what() << ")." << std::endl;
+          }
+        });
+      }
+
       HCTR_LOG_S(INFO, WORLD) << "Table: " << tag_name << "; cached " << volatile_cache_amount
                               << " / " << num_key << " embeddings in volatile database ("
                               << volatile_db_->get_name()
@@ -329,10 +444,11 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
         for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
           std::pair<void*, size_t> key_result = rawreader->getkeys(i);
           std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
-          persistent_db_->insert(tag_name, key_result.second,
-                                 reinterpret_cast<const TypeHashKey*>(key_result.first),
-                                 reinterpret_cast<const char*>(vec_result.first),
-                                 embedding_size * sizeof(float), embedding_size * sizeof(float));
+          persistent_db_->bulk_insert(tag_name, key_result.second,
+                                      reinterpret_cast<const TypeHashKey*>(key_result.first),
+                                      reinterpret_cast<const char*>(vec_result.first),
+                                      embedding_size * sizeof(float),
+                                      embedding_size * sizeof(float));
         }
       } else {
         for (int table_id = 0; table_id < inference_params.fused_sparse_model_files[j].size();
@@ -342,10 +458,11 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
           for (size_t i = 0; i < rawreader->get_num_iterations(); i++) {
             std::pair<void*, size_t> key_result = rawreader->getkeys(i);
             std::pair<void*, size_t> vec_result = rawreader->getvectors(i, embedding_size);
-            persistent_db_->insert(tag_name, key_result.second,
-                                   reinterpret_cast<const TypeHashKey*>(key_result.first),
-                                   reinterpret_cast<const char*>(vec_result.first),
-                                   embedding_size * sizeof(float), embedding_size * sizeof(float));
+            persistent_db_->bulk_insert(tag_name, key_result.second,
+                                        reinterpret_cast<const TypeHashKey*>(key_result.first),
+                                        reinterpret_cast<const char*>(vec_result.first),
+                                        embedding_size * sizeof(float),
+                                        embedding_size * sizeof(float));
           }
         }
         HCTR_LOG_S(INFO, WORLD) << "Table: " << tag_name << "; cached " << num_key
@@ -420,6 +537,50 @@ void HierParameterServer<TypeHashKey>::update_database_per_model(
       }
       break;
 
+    case UpdateSourceType_t::LocalMessageQueue:
+      // Consumer groups and tag filters work the same way as for Kafka. But offsets are tracked in
+      // the message queue directory. Hence, the host name is part of the consumer group, unless the
+      // database is shared.
+      if (volatile_db_ && !inference_params.volatile_db.update_filters.empty()) {
+        std::ostringstream consumer_group;
+        consumer_group << kafka_group_prefix << "volatile";
+        if (!volatile_db_->is_shared()) {
+          consumer_group << '.' << host_name;
+        }
+
+        std::vector<std::string> tag_filters;
+        std::transform(inference_params.volatile_db.update_filters.begin(),
+                       inference_params.volatile_db.update_filters.end(),
+                       std::back_inserter(tag_filters), kafka_prepare_filter);
+
+        volatile_db_source_ = std::make_unique<LocalMessageSource<TypeHashKey>>(
+            inference_params.update_source.path, consumer_group.str(), tag_filters,
+            inference_params.update_source.poll_timeout_ms,
+            inference_params.update_source.max_batch_size,
+            inference_params.update_source.failure_backoff_ms,
+            inference_params.update_source.max_commit_interval);
+      }
+      if (persistent_db_ && !inference_params.persistent_db.update_filters.empty()) {
+        std::ostringstream consumer_group;
+        consumer_group << kafka_group_prefix << "persistent";
+        if (!persistent_db_->is_shared()) {
+          consumer_group << '.' << host_name;
+        }
+
+        std::vector<std::string> tag_filters;
+        std::transform(inference_params.persistent_db.update_filters.begin(),
+                       inference_params.persistent_db.update_filters.end(),
+                       std::back_inserter(tag_filters), kafka_prepare_filter);
+
+        persistent_db_source_ = std::make_unique<LocalMessageSource<TypeHashKey>>(
+            inference_params.update_source.path, consumer_group.str(), tag_filters,
+            inference_params.update_source.poll_timeout_ms,
+            inference_params.update_source.max_batch_size,
+            inference_params.update_source.failure_backoff_ms,
+            inference_params.update_source.max_commit_interval);
+      }
+      break;
+
     default:
       HCTR_DIE("Unsupported update source!\n");
       break;
@@ -462,8 +623,9 @@ template <typename TypeHashKey>
 void HierParameterServer<TypeHashKey>::init_ec(
     InferenceParams& inference_params,
     std::map<int64_t, std::shared_ptr<EmbeddingCacheBase>> embedding_cache_map) {
+  // Embeddings are consumed iteration by iteration. Fault in each iteration in parallel.
   IModelLoader* rawreader =
-      ModelLoader<TypeHashKey, float>::CreateLoader(DatabaseTableDumpFormat_t::Raw);
+      ModelLoader<TypeHashKey, float>::CreateLoader(DatabaseTableDumpFormat_t::Raw, true);
   size_t num_tables = inference_params.fuse_embedding_table
                           ? inference_params.fused_sparse_model_files.size()
                           : inference_params.sparse_model_files.size();
@@ -720,6 +882,10 @@ void HierParameterServer<TypeHashKey>::parse_hps_configuraion(
 template <typename TypeHashKey>
 void HierParameterServer<TypeHashKey>::profiler_print() {
   hps_profiler->print();
+  if (volatile_db_promotion_queue_) {
+    HCTR_LOG_S(INFO, WORLD) << "Volatile DB promotion: " << volatile_db_promotion_queue_->stats()
+                            << std::endl;
+  }
 }
 
 template <typename TypeHashKey>
@@ -768,65 +934,105 @@ void HierParameterServer<TypeHashKey>::lookup(const void* const h_keys, const si
 
   // If have volatile and persistant database.
   if (volatile_db_ && persistent_db_) {
-    // Do a sequential lookup in the volatile DB, and remember the missing keys.
-    constexpr size_t invalid_index{std::numeric_limits<size_t>::max()};
-    std::vector<size_t> indices(length, invalid_index);
+    const TypeHashKey* const keys{reinterpret_cast<const TypeHashKey*>(h_keys)};
 
-    start = profiler::start();
-    hit_count += volatile_db_->fetch(tag_name, length, reinterpret_cast<const TypeHashKey*>(h_keys),
-                                     reinterpret_cast<char*>(h_vectors), expected_value_size,
-                                     [&](const size_t index) { indices[index] = index; });
-    hps_profiler->end(start, "Lookup the embedding key from VDB");
+    // Large requests are processed in chunks. The persistent DB lookup for the missing keys of
+    // chunk N runs in the background, while the volatile DB is probed for chunk N + 1. Since both
+    // lookups write to disjoint sections of `h_vectors`, no further synchronization is required.
+    const size_t num_chunks{(length + lookup_chunk_size - 1) / lookup_chunk_size};
 
-    HCTR_LOG_C(TRACE, WORLD, volatile_db_->get_name(), ": ", hit_count, " hits, ",
-               length - hit_count, " missing!\n");
-
-    if (hit_count != length) {
-      // Compress indices (Erase-remove idiom).
-      indices.erase(std::remove(indices.begin(), indices.end(), invalid_index), indices.end());
+    // Missing keys of the current and the previous chunk. Reused across calls.
+    constexpr size_t invalid_index{std::numeric_limits<size_t>::max()};
+    thread_local std::vector<size_t> chunk_indices[2];
+
+    // Fills the gaps of a chunk from the persistent DB, and promotes the embeddings found there.
+    size_t pdb_hit_count{0};
+    const auto lookup_pdb{[&](const size_t offset, std::vector<size_t>& indices) {
+      float* const chunk_vectors{&h_vectors[offset * embedding_size]};
+
+      // Keys that are missing in the persistent DB as well (`indices` is sorted). The database may
+      // invoke `on_miss` from other threads. Hence, refer to this thread's buffer explicitly.
+      thread_local std::vector<char> missing_buffer;
+      std::vector<char>& missing{missing_buffer};
+      if (volatile_db_promotion_queue_) {
+        missing.assign(indices.back() + 1, false);
+      }
 
-      // Do a sparse lookup in the persisent DB, to fill gaps and set others to default.
-      start = profiler::start();
-      hit_count += persistent_db_->fetch(
-          tag_name, indices.size(), indices.data(), reinterpret_cast<const TypeHashKey*>(h_keys),
-          reinterpret_cast<char*>(h_vectors), expected_value_size, fill_default);
+      BaseUnit* const start{profiler::start()};
+      pdb_hit_count += persistent_db_->fetch(
+          tag_name, indices.size(), indices.data(), &keys[offset],
+          reinterpret_cast<char*>(chunk_vectors), expected_value_size, [&](const size_t index) {
+            std::fill_n(&chunk_vectors[index * embedding_size], embedding_size,
+                        default_vec_value);
+            if (volatile_db_promotion_queue_) {
+              missing[index] = true;
+            }
+          });
       hps_profiler->end(start, "Lookup the missing embedding key from the PDB");
 
-      HCTR_LOG_C(TRACE, WORLD, persistent_db_->get_name(), ": ", hit_count, " hits, ",
-                 length - hit_count, " still missing!\n");
-
       // Elevate KV pairs if desired and possible.
-      if (volatile_db_cache_missed_embeddings_) {
-        // If the layer 0 cache should be optimized as we go, elevate missed keys.
-        auto keys_to_elevate{std::make_shared<std::vector<TypeHashKey>>(indices.size())};
-        auto values_to_elevate{
-            std::make_shared<std::vector<float>>(indices.size() * embedding_size)};
-
-        start = profiler::start();
-        for (size_t i{}; i != indices.size(); ++i) {
-          const size_t index{indices[i]};
+      if (volatile_db_promotion_queue_) {
+        indices.erase(std::remove_if(indices.begin(), indices.end(),
+                                     [&](const size_t index) { return missing[index]; }),
+                      indices.end());
+        volatile_db_promotion_queue_->submit(tag_name, indices.size(), indices.data(),
+                                             &keys[offset],
+                                             reinterpret_cast<const char*>(chunk_vectors),
+                                             expected_value_size);
+      }
+    }};
 
-          (*keys_to_elevate)[i] = reinterpret_cast<const TypeHashKey*>(h_keys)[index];
-          std::copy_n(&h_vectors[index * embedding_size], embedding_size,
-                      &(*values_to_elevate)[i * embedding_size]);
-        }
-        hps_profiler->end(start, "Insert the missing embedding key into the VDB");
+    std::future<void> pdb_lookup;
+    try {
+      for (size_t chunk{0}; chunk != num_chunks; ++chunk) {
+        const size_t offset{chunk * lookup_chunk_size};
+        const size_t chunk_length{std::min(lookup_chunk_size, length - offset)};
 
-        HCTR_LOG_C(DEBUG, WORLD, "Attempting to migrate ", keys_to_elevate->size(),
-                   " embeddings from ", persistent_db_->get_name(), " to ",
-                   volatile_db_->get_name(), ".\n");
+        // Do a sequential lookup in the volatile DB, and remember the missing keys.
+        std::vector<size_t>& indices{chunk_indices[chunk % 2]};
+        indices.assign(chunk_length, invalid_index);
 
         start = profiler::start();
-        volatile_db_async_inserter_.submit([this, tag_name, keys_to_elevate, values_to_elevate,
-                                            expected_value_size, start]() {
-          volatile_db_->insert(tag_name, keys_to_elevate->size(), keys_to_elevate->data(),
-                               reinterpret_cast<char*>(values_to_elevate->data()),
-                               expected_value_size, expected_value_size);
-          hps_profiler->end(
-              start, "Insert the missing embedding key from the PDB into the VDB asynchronously");
-        });
+        const size_t vdb_hit_count{volatile_db_->fetch(
+            tag_name, chunk_length, &keys[offset],
+            reinterpret_cast<char*>(&h_vectors[offset * embedding_size]), expected_value_size,
+            [&](const size_t index) { indices[index] = index; })};
+        hps_profiler->end(start, "Lookup the embedding key from VDB");
+        hit_count += vdb_hit_count;
+
+        // Compress indices (Erase-remove idiom).
+        if (vdb_hit_count != chunk_length) {
+          indices.erase(std::remove(indices.begin(), indices.end(), invalid_index), indices.end());
+        } else {
+          indices.clear();
+        }
+
+        // Persistent DB lookups are serialized. Hence, at most one chunk is in flight.
+        if (pdb_lookup.valid()) {
+          pdb_lookup.get();
+        }
+        if (!indices.empty()) {
+          if (chunk + 1 == num_chunks) {
+            lookup_pdb(offset, indices);
+          } else {
+            pdb_lookup = persistent_db_lookup_pool_.submit(
+                [&lookup_pdb, offset, &indices]() { lookup_pdb(offset, indices); });
+          }
+        }
+      }
+    } catch (...) {
+      // The background lookup refers to local state.
+      if (pdb_lookup.valid()) {
+        pdb_lookup.wait();
       }
+      throw;
     }
+
+    HCTR_LOG_C(TRACE, WORLD, volatile_db_->get_name(), ": ", hit_count, " hits, ",
+               length - hit_count, " missing!\n");
+    hit_count += pdb_hit_count;
+    HCTR_LOG_C(TRACE, WORLD, persistent_db_->get_name(), ": ", hit_count, " hits, ",
+               length - hit_count, " still missing!\n");
   } else {
     // If any database.
     DatabaseBackendBase<TypeHashKey>* const db =
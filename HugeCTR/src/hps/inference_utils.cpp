@@ -36,19 +36,27 @@ bool VolatileDatabaseParams::operator==(const VolatileDatabaseParams& p) const {
          // Backend specific.
          address == p.address && user_name == p.user_name && password == p.password &&
          num_partitions == p.num_partitions && allocation_rate == p.allocation_rate &&
+         huge_pages == p.huge_pages && numa_aware == p.numa_aware &&
+         compaction_threshold == p.compaction_threshold &&
          shared_memory_size == p.shared_memory_size && shared_memory_name == p.shared_memory_name &&
          shared_memory_auto_remove == p.shared_memory_auto_remove &&
+         shared_memory_open_addressing == p.shared_memory_open_addressing &&
          num_node_connections == p.num_node_connections && max_batch_size == p.max_batch_size &&
-         enable_tls == p.enable_tls && tls_ca_certificate == p.tls_ca_certificate &&
+         value_codec == p.value_codec && enable_tls == p.enable_tls &&
+         tls_ca_certificate == p.tls_ca_certificate &&
          tls_client_certificate == p.tls_client_certificate && tls_client_key == p.tls_client_key &&
          tls_server_name_identification == p.tls_server_name_identification &&
+         near_cache_size == p.near_cache_size &&
+         near_cache_max_staleness_ms == p.near_cache_max_staleness_ms &&
          // Overflow handling related.
          overflow_margin == p.overflow_margin && overflow_policy == p.overflow_policy &&
          overflow_resolution_target == p.overflow_resolution_target &&
+         overflow_sample_size == p.overflow_sample_size && recency_source == p.recency_source &&
          // Caching behavior related.
          initialize_after_startup == p.initialize_after_startup &&
          initial_cache_rate == p.initial_cache_rate &&
          cache_missed_embeddings == p.cache_missed_embeddings &&
+         snapshot_path == p.snapshot_path &&
          // Real-time update mechanism related.
          update_filters == p.update_filters;
 }
@@ -60,7 +68,12 @@ bool PersistentDatabaseParams::operator==(const PersistentDatabaseParams& p) con
   return type == p.type &&
          // Backend specific.
          path == p.path && num_threads == p.num_threads && read_only == p.read_only &&
-         max_batch_size == p.max_batch_size &&
+         max_batch_size == p.max_batch_size && value_codec == p.value_codec &&
+         block_cache_size == p.block_cache_size &&
+         bloom_filter_bits_per_key == p.bloom_filter_bits_per_key &&
+         partitioned_filters == p.partitioned_filters && use_direct_reads == p.use_direct_reads &&
+         num_lookup_tasks == p.num_lookup_tasks && io_depth == p.io_depth &&
+         compaction_threshold == p.compaction_threshold &&
          // Caching behavior related.
          initialize_after_startup == p.initialize_after_startup &&
          // Real-time update mechanism related.
@@ -76,7 +89,7 @@ bool UpdateSourceParams::operator==(const UpdateSourceParams& p) const {
          brokers == p.brokers && metadata_refresh_interval_ms == p.metadata_refresh_interval_ms &&
          receive_buffer_size == p.receive_buffer_size && poll_timeout_ms == p.poll_timeout_ms &&
          max_batch_size == p.max_batch_size && failure_backoff_ms == p.failure_backoff_ms &&
-         max_commit_interval == p.max_commit_interval;
+         max_commit_interval == p.max_commit_interval && path == p.path;
 }
 bool UpdateSourceParams::operator!=(const UpdateSourceParams& p) const { return !operator==(p); }
 
@@ -89,17 +102,22 @@ VolatileDatabaseParams::VolatileDatabaseParams(
     const DatabaseType_t type,
     // Backend specific.
     const std::string& address, const std::string& user_name, const std::string& password,
-    const size_t num_partitions, const size_t allocation_rate, const size_t shared_memory_size,
+    const size_t num_partitions, const size_t allocation_rate, const DatabaseHugePages_t huge_pages,
+    const bool numa_aware, const double compaction_threshold, const size_t shared_memory_size,
     const std::string& shared_memory_name, const bool shared_memory_auto_remove,
-    const size_t num_node_connections, const size_t max_batch_size, const bool enable_tls,
+    const bool shared_memory_open_addressing, const size_t num_node_connections,
+    const size_t max_batch_size, const DatabaseValueCodec_t value_codec, const bool enable_tls,
     const std::string& tls_ca_certificate, const std::string& tls_client_certificate,
-    const std::string& tls_client_key, const std::string& tls_server_name_identification,
+    const std::string& tls_client_key,
+    const std::string& tls_server_name_identification, const size_t near_cache_size,
+    const size_t near_cache_max_staleness_ms,
     // Overflow handling related.
     const size_t overflow_margin, const DatabaseOverflowPolicy_t overflow_policy,
-    const double overflow_resolution_target,
+    const double overflow_resolution_target, const size_t overflow_sample_size,
+    const DatabaseRecencySource_t recency_source,
     // Caching behavior related.
     const bool initialize_after_startup, const double initial_cache_rate,
-    const bool cache_missed_embeddings,
+    const bool cache_missed_embeddings, const std::string& snapshot_path,
     // Real-time update mechanism related.
     const std::vector<std::string>& update_filters)
     : type{type},
@@ -109,24 +127,34 @@ VolatileDatabaseParams::VolatileDatabaseParams(
       password{password},
       num_partitions{num_partitions},
       allocation_rate{allocation_rate},
+      huge_pages{huge_pages},
+      numa_aware{numa_aware},
+      compaction_threshold{compaction_threshold},
       shared_memory_size{shared_memory_size},
       shared_memory_name{shared_memory_name},
       shared_memory_auto_remove{shared_memory_auto_remove},
+      shared_memory_open_addressing{shared_memory_open_addressing},
       num_node_connections{num_node_connections},
       max_batch_size{max_batch_size},
+      value_codec{value_codec},
       enable_tls{enable_tls},
       tls_ca_certificate{tls_ca_certificate},
       tls_client_certificate{tls_client_certificate},
       tls_client_key{tls_client_key},
       tls_server_name_identification{tls_server_name_identification},
+      near_cache_size{near_cache_size},
+      near_cache_max_staleness_ms{near_cache_max_staleness_ms},
       // Overflow handling related.
       overflow_margin{overflow_margin},
       overflow_policy{overflow_policy},
       overflow_resolution_target{overflow_resolution_target},
+      overflow_sample_size{overflow_sample_size},
+      recency_source{recency_source},
       // Caching behavior related.
       initialize_after_startup{initialize_after_startup},
       initial_cache_rate{initial_cache_rate},
       cache_missed_embeddings{cache_missed_embeddings},
+      snapshot_path{snapshot_path},
       // Real-time update mechanism related.
       update_filters{update_filters} {}
 
@@ -138,6 +166,14 @@ PersistentDatabaseParams::PersistentDatabaseParams(const DatabaseType_t type,
                                                    const std::string& path,
                                                    const size_t num_threads, const bool read_only,
                                                    const size_t max_batch_size,
+                                                   const DatabaseValueCodec_t value_codec,
+                                                   const size_t block_cache_size,
+                                                   const double bloom_filter_bits_per_key,
+                                                   const bool partitioned_filters,
+                                                   const bool use_direct_reads,
+                                                   const size_t num_lookup_tasks,
+                                                   const size_t io_depth,
+                                                   const double compaction_threshold,
                                                    // Caching behavior related.
                                                    const bool initialize_after_startup,
                                                    // Real-time update mechanism related.
@@ -148,6 +184,14 @@ PersistentDatabaseParams::PersistentDatabaseParams(const DatabaseType_t type,
       num_threads(num_threads),
       read_only(read_only),
       max_batch_size(max_batch_size),
+      value_codec(value_codec),
+      block_cache_size(block_cache_size),
+      bloom_filter_bits_per_key(bloom_filter_bits_per_key),
+      partitioned_filters(partitioned_filters),
+      use_direct_reads(use_direct_reads),
+      num_lookup_tasks(num_lookup_tasks),
+      io_depth(io_depth),
+      compaction_threshold(compaction_threshold),
       // Caching behavior related.
       initialize_after_startup{initialize_after_startup},
       // Real-time update mechanism related.
@@ -160,7 +204,8 @@ UpdateSourceParams::UpdateSourceParams(const UpdateSourceType_t type,
                                        const size_t receive_buffer_size,
                                        const size_t poll_timeout_ms, const size_t max_batch_size,
                                        const size_t failure_backoff_ms,
-                                       const size_t max_commit_interval)
+                                       const size_t max_commit_interval,
+                                       const std::string& path)
     : type(type),
       // Backend specific.
       brokers(brokers),
@@ -169,7 +214,8 @@ UpdateSourceParams::UpdateSourceParams(const UpdateSourceType_t type,
       poll_timeout_ms(poll_timeout_ms),
       max_batch_size(max_batch_size),
       failure_backoff_ms(failure_backoff_ms),
-      max_commit_interval(max_commit_interval) {}
+      max_commit_interval(max_commit_interval),
+      path(path) {}
 
 InferenceParams::InferenceParams(
     const std::string& model_name, const size_t max_batchsize, const float hit_rate_threshold,
@@ -402,6 +448,7 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
         get_value_from_json_soft(update_source, "failure_backoff_ms", params.failure_backoff_ms);
     params.max_commit_interval =
         get_value_from_json_soft(update_source, "max_commit_interval", params.max_commit_interval);
+    params.path = get_value_from_json_soft(update_source, "path", params.path);
   }
 
   // Persistent database parameters.
@@ -418,6 +465,20 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
 
     params.max_batch_size =
         get_value_from_json_soft(persistent_db, "max_batch_size", params.max_batch_size);
+    params.value_codec = get_hps_value_codec(persistent_db, "value_codec", params.value_codec);
+    params.block_cache_size =
+        get_value_from_json_soft(persistent_db, "block_cache_size", params.block_cache_size);
+    params.bloom_filter_bits_per_key = get_value_from_json_soft(
+        persistent_db, "bloom_filter_bits_per_key", params.bloom_filter_bits_per_key);
+    params.partitioned_filters =
+        get_value_from_json_soft(persistent_db, "partitioned_filters", params.partitioned_filters);
+    params.use_direct_reads =
+        get_value_from_json_soft(persistent_db, "use_direct_reads", params.use_direct_reads);
+    params.num_lookup_tasks =
+        get_value_from_json_soft(persistent_db, "num_lookup_tasks", params.num_lookup_tasks);
+    params.io_depth = get_value_from_json_soft(persistent_db, "io_depth", params.io_depth);
+    params.compaction_threshold = get_value_from_json_soft(persistent_db, "compaction_threshold",
+                                                           params.compaction_threshold);
 
     if (persistent_db.find("update_filters") != persistent_db.end()) {
       params.update_filters.clear();
@@ -447,6 +508,10 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
 
     params.allocation_rate =
         get_value_from_json_soft(volatile_db, "allocation_rate", params.allocation_rate);
+    params.huge_pages = get_hps_huge_pages(volatile_db, "huge_pages", params.huge_pages);
+    params.numa_aware = get_value_from_json_soft(volatile_db, "numa_aware", params.numa_aware);
+    params.compaction_threshold = get_value_from_json_soft(volatile_db, "compaction_threshold",
+                                                           params.compaction_threshold);
 
     params.shared_memory_size =
         get_value_from_json_soft(volatile_db, "shared_memory_size", params.shared_memory_size);
@@ -454,12 +519,15 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
         get_value_from_json_soft(volatile_db, "shared_memory_name", params.shared_memory_name);
     params.shared_memory_auto_remove = get_value_from_json_soft(
         volatile_db, "shared_memory_auto_remove", params.shared_memory_auto_remove);
+    params.shared_memory_open_addressing = get_value_from_json_soft(
+        volatile_db, "shared_memory_open_addressing", params.shared_memory_open_addressing);
 
     params.num_node_connections =
         get_value_from_json_soft(volatile_db, "num_node_connections", params.num_node_connections);
 
     params.max_batch_size =
         get_value_from_json_soft(volatile_db, "max_batch_size", params.max_batch_size);
+    params.value_codec = get_hps_value_codec(volatile_db, "value_codec", params.value_codec);
 
     params.enable_tls = get_value_from_json_soft(volatile_db, "enable_tls", params.enable_tls);
     params.tls_ca_certificate =
@@ -471,6 +539,11 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
     params.tls_server_name_identification = get_value_from_json_soft(
         volatile_db, "tls_server_name_identification", params.tls_server_name_identification);
 
+    params.near_cache_size =
+        get_value_from_json_soft(volatile_db, "near_cache_size", params.near_cache_size);
+    params.near_cache_max_staleness_ms = get_value_from_json_soft(
+        volatile_db, "near_cache_max_staleness_ms", params.near_cache_max_staleness_ms);
+
     // Overflow handling related.
     params.overflow_margin =
         get_value_from_json_soft(volatile_db, "overflow_margin", params.overflow_margin);
@@ -478,6 +551,10 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
         get_hps_overflow_policy(volatile_db, "overflow_policy", params.overflow_policy);
     params.overflow_resolution_target = get_value_from_json_soft(
         volatile_db, "overflow_resolution_target", params.overflow_resolution_target);
+    params.overflow_sample_size =
+        get_value_from_json_soft(volatile_db, "overflow_sample_size", params.overflow_sample_size);
+    params.recency_source =
+        get_hps_recency_source(volatile_db, "recency_source", params.recency_source);
 
     // Caching behavior related.
     params.initial_cache_rate =
@@ -486,6 +563,9 @@ void parameter_server_config::init(const std::string& hps_json_config_file) {
     params.cache_missed_embeddings = get_value_from_json_soft(
         volatile_db, "cache_missed_embeddings", params.cache_missed_embeddings);
 
+    params.snapshot_path =
+        get_value_from_json_soft(volatile_db, "snapshot_path", params.snapshot_path);
+
     // Real-time update mechanism related.
     if (volatile_db.find("update_filters") != volatile_db.end()) {
       params.update_filters.clear();
@@ -891,6 +971,13 @@ DatabaseType_t get_hps_database_type(const nlohmann::json& json, const std::stri
       return enum_value;
     }
 
+  enum_value = DatabaseType_t::SlabStore;
+  names = {hctr_enum_to_c_str(enum_value), "slabstore", "slab"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
   return default_value;
 }
 
@@ -917,6 +1004,13 @@ UpdateSourceType_t get_hps_updatesource_type(const nlohmann::json& json, const s
       return enum_value;
     }
 
+  enum_value = UpdateSourceType_t::LocalMessageQueue;
+  names = {hctr_enum_to_c_str(enum_value), "local_mq", "local"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
   return default_value;
 }
 
@@ -985,4 +1079,103 @@ DatabaseOverflowPolicy_t get_hps_overflow_policy(const nlohmann::json& json, con
   return default_value;
 }
 
+DatabaseRecencySource_t get_hps_recency_source(const nlohmann::json& json, const std::string& key,
+                                               const DatabaseRecencySource_t default_value) {
+  if (json.find(key) == json.end()) {
+    return default_value;
+  }
+  std::string tmp = get_value_from_json<std::string>(json, key);
+  DatabaseRecencySource_t enum_value;
+  std::unordered_set<const char*> names;
+
+  enum_value = DatabaseRecencySource_t::CoarseClock;
+  names = {hctr_enum_to_c_str(enum_value), "clock"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = DatabaseRecencySource_t::LogicalEpoch;
+  names = {hctr_enum_to_c_str(enum_value), "epoch"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  return default_value;
+}
+
+DatabaseHugePages_t get_hps_huge_pages(const nlohmann::json& json, const std::string& key,
+                                       const DatabaseHugePages_t default_value) {
+  if (json.find(key) == json.end()) {
+    return default_value;
+  }
+  std::string tmp = get_value_from_json<std::string>(json, key);
+  DatabaseHugePages_t enum_value;
+  std::unordered_set<const char*> names;
+
+  enum_value = DatabaseHugePages_t::Disabled;
+  names = {hctr_enum_to_c_str(enum_value), "none", "off"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = DatabaseHugePages_t::Transparent;
+  names = {hctr_enum_to_c_str(enum_value), "thp"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = DatabaseHugePages_t::Explicit;
+  names = {hctr_enum_to_c_str(enum_value), "hugetlb"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  return default_value;
+}
+
+DatabaseValueCodec_t get_hps_value_codec(const nlohmann::json& json, const std::string& key,
+                                         const DatabaseValueCodec_t default_value) {
+  if (json.find(key) == json.end()) {
+    return default_value;
+  }
+  std::string tmp = get_value_from_json<std::string>(json, key);
+  DatabaseValueCodec_t enum_value;
+  std::unordered_set<const char*> names;
+
+  enum_value = DatabaseValueCodec_t::Float32;
+  names = {hctr_enum_to_c_str(enum_value), "fp32", "none"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = DatabaseValueCodec_t::Float16;
+  names = {hctr_enum_to_c_str(enum_value), "fp16", "half"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = DatabaseValueCodec_t::BFloat16;
+  names = {hctr_enum_to_c_str(enum_value), "bf16"};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  enum_value = DatabaseValueCodec_t::Int8;
+  names = {hctr_enum_to_c_str(enum_value)};
+  for (const char* name : names)
+    if (tmp == name) {
+      return enum_value;
+    }
+
+  return default_value;
+}
+
 }  // namespace HugeCTR
@@ -67,6 +67,10 @@ const size_t HCTR_KAFKA_ERROR_STRING_LENGTH = 512;
 const uint32_t HCTR_KAFKA_VALUE_PREFIX =
     (uint32_t)('H') | ((uint32_t)('C') << 8) | ((uint32_t)('T') << 16) | ((uint32_t)('R') << 24);
 
+// The payload was encoded by a `MessageCodec`.
+const uint32_t HCTR_KAFKA_ENCODED_VALUE_PREFIX =
+    (uint32_t)('H') | ((uint32_t)('C') << 8) | ((uint32_t)('T') << 16) | ((uint32_t)('E') << 24);
+
 void kafka_conf_set_and_check(rd_kafka_conf_t* const conf, const char* const key,
                               const char* const value) {
   // HCTR_LOG_S(DEBUG, WORLD) << key << " = " << value << std::endl;
@@ -122,9 +126,7 @@ KafkaMessageSink<Key>::KafkaMessageSink(const KafkaMessageSinkParams& params)
   send_buffers_.reserve(params.num_send_buffers);
   for (auto it = send_buffer_memory_.begin(); it != send_buffer_memory_.end();
        it += params.send_buffer_size) {
-    char* send_buffer = &(*it);
-    *reinterpret_cast<uint32_t*>(send_buffer) = HCTR_KAFKA_VALUE_PREFIX;
-    send_buffers_.push_back(send_buffer);
+    send_buffers_.push_back(&(*it));
   }
   HCTR_CHECK(send_buffers_.size() == params.num_send_buffers);
 
@@ -218,9 +220,11 @@ void KafkaMessageSink<Key>::post(const std::string& tag, size_t num_pairs, const
   // Get topic, or create if it doesn't exist yet.
   rd_kafka_topic_t* const topic = resolve_topic(tag);
 
-  if (num_pairs == 0) {
+  if (num_pairs != 0 && !this->codec_.is_identity()) {
+    post_encoded(topic, num_pairs, keys, values, value_size);
+  } else if (num_pairs == 0) {
     // Request send buffer to hold the payload.
-    char* const payload = acquire_send_buffer(value_size);
+    char* const payload = acquire_send_buffer(value_size, HCTR_KAFKA_VALUE_PREFIX);
     const size_t p_length = sizeof(uint32_t) * 2;
 
     // Add nothing. This is just a beacon.
@@ -233,7 +237,7 @@ void KafkaMessageSink<Key>::post(const std::string& tag, size_t num_pairs, const
     const size_t part_index{HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
 
     // Request send buffer to hold the payload.
-    char* const payload = acquire_send_buffer(value_size);
+    char* const payload = acquire_send_buffer(value_size, HCTR_KAFKA_VALUE_PREFIX);
     size_t p_length = sizeof(uint32_t) * 2;
 
     // Append key & value.
@@ -265,12 +269,12 @@ void KafkaMessageSink<Key>::post(const std::string& tag, size_t num_pairs, const
             blocking_produce(topic, payload, p_length, part_index);
 
             // Get new send buffer.
-            payload = acquire_send_buffer(value_size);
+            payload = acquire_send_buffer(value_size, HCTR_KAFKA_VALUE_PREFIX);
             p_length = sizeof(uint32_t) * 2;
           }
         } else {
           // Request send buffer to hold the payload.
-          payload = acquire_send_buffer(value_size);
+          payload = acquire_send_buffer(value_size, HCTR_KAFKA_VALUE_PREFIX);
           p_length = sizeof(uint32_t) * 2;
         }
 
@@ -336,7 +340,55 @@ rd_kafka_topic_t* KafkaMessageSink<Key>::resolve_topic(const std::string& tag) {
 }
 
 template <typename Key>
-char* KafkaMessageSink<Key>::acquire_send_buffer(uint32_t value_size) {
+void KafkaMessageSink<Key>::post_encoded(rd_kafka_topic_t* const topic, const size_t num_pairs,
+                                         const Key* const keys, const char* const values,
+                                         const uint32_t value_size) {
+  const size_t header_size = sizeof(uint32_t) * 2;
+  const size_t max_batch_size =
+      this->codec_.max_num_pairs(this->params_.send_buffer_size - header_size, value_size);
+  HCTR_CHECK(max_batch_size > 0);
+
+  std::vector<Key> batch_keys;
+  std::vector<char> batch_values;
+  batch_keys.reserve(std::min(num_pairs, max_batch_size));
+  batch_values.reserve(batch_keys.capacity() * value_size);
+
+  auto send = [&](const size_t part_index) {
+    char* const payload = acquire_send_buffer(value_size, HCTR_KAFKA_ENCODED_VALUE_PREFIX);
+    const size_t p_length =
+        header_size + this->codec_.encode(batch_keys.size(), batch_keys.data(),
+                                          batch_values.data(), value_size, &payload[header_size]);
+    blocking_produce(topic, payload, p_length, part_index);
+    batch_keys.clear();
+    batch_values.clear();
+  };
+
+  const Key* const keys_end = &keys[num_pairs];
+  const size_t num_partitions{this->params_.num_partitions};
+  for (size_t part_index = 0; part_index < num_partitions; ++part_index) {
+    for (const Key* k = keys; k != keys_end; ++k) {
+      // Only consider keys that belong to current group.
+      if (HCTR_HPS_KEY_TO_PART_INDEX_(*k) != part_index) {
+        continue;
+      }
+
+      batch_keys.push_back(*k);
+      const char* const value = &values[(k - keys) * value_size];
+      batch_values.insert(batch_values.end(), value, &value[value_size]);
+      if (batch_keys.size() >= max_batch_size) {
+        send(part_index);
+      }
+    }
+
+    // Sent any unsent pairs.
+    if (!batch_keys.empty()) {
+      send(part_index);
+    }
+  }
+}
+
+template <typename Key>
+char* KafkaMessageSink<Key>::acquire_send_buffer(const uint32_t value_size, const uint32_t prefix) {
   // Wait until buffer becomes available.
   char* send_buffer;
   {
@@ -350,7 +402,8 @@ char* KafkaMessageSink<Key>::acquire_send_buffer(uint32_t value_size) {
     // HCTR_LOG_S(DEBUG, WORLD) << "Borrowed buffer " << send_buffers_.size() << '.' << std::endl;
   }
 
-  // Note the value size.
+  // Note the format and value size.
+  *reinterpret_cast<uint32_t*>(send_buffer) = prefix;
   *reinterpret_cast<uint32_t*>(&send_buffer[sizeof(uint32_t)]) = value_size;
 
   return send_buffer;
@@ -710,7 +763,8 @@ void KafkaMessageSource<Key>::run(std::function<HCTR_MESSAGE_SOURCE_CALLBACK> ca
     // Parse header.
     const char* p = static_cast<char*>(msg->payload);
     const char* const p_end = &p[msg->len];
-    if (*reinterpret_cast<const uint32_t*>(p) != HCTR_KAFKA_VALUE_PREFIX) {
+    const uint32_t prefix = *reinterpret_cast<const uint32_t*>(p);
+    if (prefix != HCTR_KAFKA_VALUE_PREFIX && prefix != HCTR_KAFKA_ENCODED_VALUE_PREFIX) {
       HCTR_LOG(WARNING, WORLD,
                "Kafka message header contains unexpected values. Message discarded!\n");
       continue;
@@ -744,6 +798,33 @@ void KafkaMessageSource<Key>::run(std::function<HCTR_MESSAGE_SOURCE_CALLBACK> ca
       buf.value_size = value_size;
     }
 
+    // Decode data into receive buffer. Encoded messages are appended as a whole.
+    if (prefix == HCTR_KAFKA_ENCODED_VALUE_PREFIX) {
+      const size_t num_keys = buf.keys.size();
+      const size_t num_values = buf.values.size();
+      try {
+        uint32_t decoded_value_size;
+        MessageCodec<Key>::decode(p, static_cast<size_t>(p_end - p), buf.keys, buf.values,
+                                  decoded_value_size);
+        HCTR_THROW_IF(decoded_value_size != value_size, Error_t::DataCheckError,
+                      "Value size mismatch (", decoded_value_size, " <> ", value_size, " bytes).");
+      } catch (const std::exception& error) {
+        HCTR_LOG_S(WARNING, WORLD) << "Kafka topic '" << topic << "': Unable to decode message ("
+                                   << error.what() << "). Message discarded!" << std::endl;
+        buf.keys.resize(num_keys);
+        buf.values.resize(num_values);
+      }
+      p = p_end;
+
+      if (buf.keys.size() >= max_batch_size_) {
+        HCTR_LOG_S(TRACE, WORLD) << "Kafka topic '" << topic << "': Receive buffer is full."
+                                 << std::endl;
+        if (!deliver(topic, buf)) {
+          break;
+        }
+      }
+    }
+
     // Copy data to receive buffer.
     while (p != p_end) {
       buf.keys.push_back(*reinterpret_cast<const Key*>(p));
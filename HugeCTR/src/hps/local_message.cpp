@@ -0,0 +1,678 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <hps/local_message.hpp>
+#include <regex>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+/**
+ * Segment files consist of a sequence of messages. Each message is a \p LocalMessageHeader ,
+ * followed by the payload, padded to a multiple of 8 bytes. The payload is either just the keys
+ * followed by the values, or it was encoded by a \p MessageCodec . The writer fills in the
+ * payload first, and then publishes the message by setting \p magic . Since segment files are
+ * created zero-filled, readers stop at the first message whose \p magic is still 0.
+ */
+struct LocalMessageHeader final {
+  uint32_t magic;
+  uint32_t key_size;
+  uint32_t value_size;
+  uint32_t encoding;
+  uint64_t num_pairs;
+  uint64_t payload_size;
+  uint64_t checksum;
+};
+static_assert(sizeof(LocalMessageHeader) % sizeof(uint64_t) == 0);
+
+const uint32_t HCTR_LOCAL_MQ_MESSAGE =
+    (uint32_t)('H') | ((uint32_t)('C') << 8) | ((uint32_t)('T') << 16) | ((uint32_t)('R') << 24);
+
+enum LocalMessageEncoding : uint32_t {
+  HCTR_LOCAL_MQ_RAW = 0,
+  HCTR_LOCAL_MQ_ENCODED = 1,
+};
+
+// Marks the end of a segment. The next message is at the beginning of the next segment.
+const uint32_t HCTR_LOCAL_MQ_END_OF_SEGMENT =
+    (uint32_t)('H') | ((uint32_t)('E') << 8) | ((uint32_t)('O') << 16) | ((uint32_t)('S') << 24);
+
+namespace {
+
+inline size_t local_mq_message_size(const size_t payload_size) {
+  const size_t size{sizeof(LocalMessageHeader) + payload_size};
+  return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+}
+
+// Detects messages that are only partially on disk (e.g., after a power failure). The padding
+// bytes are always 0. Hence, the payload can be summed in 8 byte words.
+inline uint64_t local_mq_checksum(const LocalMessageHeader& header, const size_t message_size) {
+  const char* const first{reinterpret_cast<const char*>(&header + 1)};
+  const char* const last{&reinterpret_cast<const char*>(&header)[message_size]};
+
+  uint64_t sum{header.num_pairs * 0x9e3779b97f4a7c15ULL + header.payload_size +
+               (static_cast<uint64_t>(header.encoding) << 32 | header.value_size)};
+  for (const char* p{first}; p != last; p += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(uint64_t));
+    sum += word;
+  }
+  return sum;
+}
+
+inline uint32_t local_mq_load_magic(const LocalMessageHeader& header) {
+  return __atomic_load_n(&header.magic, __ATOMIC_ACQUIRE);
+}
+
+inline void local_mq_publish(LocalMessageHeader& header, const uint32_t magic) {
+  __atomic_store_n(&header.magic, magic, __ATOMIC_RELEASE);
+}
+
+std::string local_mq_segment_path(const std::filesystem::path& dir, const size_t index) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%020zu.seg", index);
+  return (dir / name).string();
+}
+
+// Indices of all segments in a directory (sorted).
+std::vector<size_t> local_mq_list_segments(const std::filesystem::path& dir) {
+  std::vector<size_t> indices;
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+    const std::filesystem::path& path{entry.path()};
+    if (path.extension() == ".seg") {
+      const std::string& stem{path.stem().string()};
+      if (!stem.empty() && std::all_of(stem.begin(), stem.end(), ::isdigit)) {
+        indices.emplace_back(std::stoull(stem));
+      }
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+}  // namespace
+
+LocalMessageSegment::LocalMessageSegment(const std::string& path, const bool writable) {
+  const int fd{open(path.c_str(), writable ? O_RDWR : O_RDONLY)};
+  if (fd == -1) {
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't open " + path);
+  }
+  struct stat stats;
+  if (fstat(fd, &stats) != 0) {
+    close(fd);
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't stat " + path);
+  }
+  size_ = static_cast<size_t>(stats.st_size);
+  HCTR_CHECK_HINT(size_ > sizeof(LocalMessageHeader), "Segment file ", path, " is too small.");
+
+  const int prot{writable ? PROT_READ | PROT_WRITE : PROT_READ};
+  data_ = static_cast<char*>(mmap(nullptr, size_, prot, MAP_SHARED, fd, 0));
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Fail mmap file " + path);
+  }
+
+  // Segments are written and consumed front to back.
+  madvise(data_, size_, MADV_SEQUENTIAL);
+}
+
+LocalMessageSegment::~LocalMessageSegment() { munmap(data_, size_); }
+
+void LocalMessageSegment::create(const std::string& path, const size_t size) {
+  // Readers must never see a segment file that is not yet fully sized. Hence, we rename it only
+  // after resizing.
+  const std::string tmp_path{path + ".tmp"};
+  const int fd{open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+  if (fd == -1) {
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't create " + tmp_path);
+  }
+  const bool resized{ftruncate(fd, static_cast<off_t>(size)) == 0};
+  close(fd);
+  if (!resized || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't create " + path);
+  }
+}
+
+void LocalMessageSegment::sync(size_t offset, size_t length, const bool blocking) const {
+  static const size_t page_size{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+  length += offset % page_size;
+  offset -= offset % page_size;
+  if (offset >= size_ || !length) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+  HCTR_CHECK_HINT(!msync(&data_[offset], length, blocking ? MS_SYNC : MS_ASYNC),
+                  "Unable to sync local message queue segment (errno = ", errno, ").");
+}
+
+template <typename Key>
+LocalMessageSink<Key>::LocalMessageSink(const LocalMessageSinkParams& params) : Base(params) {
+  HCTR_CHECK(params.segment_size >= 64 * 1024);
+  std::filesystem::create_directories(params.path);
+  HCTR_LOG_S(DEBUG, WORLD) << "Local message queue sink '" << params.path
+                           << "' initialization complete!" << std::endl;
+}
+
+template <typename Key>
+LocalMessageSink<Key>::~LocalMessageSink() {
+  flush();
+  for (auto& [tag, log] : logs_) {
+    log.segment.reset();
+    close(log.lock_fd);
+  }
+}
+
+template <typename Key>
+void LocalMessageSink<Key>::post(const std::string& tag, const size_t num_pairs,
+                                 const Key* const keys, const char* const values,
+                                 const uint32_t value_size) {
+  Log& log{resolve_log(tag)};
+  const size_t key_value_size{sizeof(Key) + value_size};
+  const bool encode{!this->codec_.is_identity()};
+
+  for (size_t i{0}; i < num_pairs;) {
+    // Always leave room for the end of segment marker.
+    const size_t capacity{log.segment->size() - log.position - sizeof(LocalMessageHeader)};
+    const size_t max_payload_size{capacity > sizeof(LocalMessageHeader) + sizeof(uint64_t)
+                                      ? capacity - sizeof(LocalMessageHeader) - sizeof(uint64_t)
+                                      : 0};
+    const size_t max_batch_size{encode ? this->codec_.max_num_pairs(max_payload_size, value_size)
+                                       : max_payload_size / key_value_size};
+    const size_t batch_size{std::min(num_pairs - i, max_batch_size)};
+    if (!batch_size) {
+      HCTR_CHECK_HINT(log.position, "Local message queue segment_size (",
+                      this->params_.segment_size, " bytes) is too small for values of ",
+                      value_size, " bytes.");
+      rotate(tag, log);
+      continue;
+    }
+
+    // Write the payload, and then publish the message.
+    char* const message{&log.segment->data()[log.position]};
+    LocalMessageHeader& header{*reinterpret_cast<LocalMessageHeader*>(message)};
+    header.key_size = static_cast<uint32_t>(sizeof(Key));
+    header.value_size = value_size;
+    header.num_pairs = batch_size;
+
+    char* const payload{&message[sizeof(LocalMessageHeader)]};
+    if (encode) {
+      header.encoding = HCTR_LOCAL_MQ_ENCODED;
+      header.payload_size =
+          this->codec_.encode(batch_size, &keys[i], &values[i * value_size], value_size, payload);
+    } else {
+      header.encoding = HCTR_LOCAL_MQ_RAW;
+      header.payload_size = batch_size * key_value_size;
+      std::memcpy(payload, &keys[i], batch_size * sizeof(Key));
+      std::memcpy(&payload[batch_size * sizeof(Key)], &values[i * value_size],
+                  batch_size * value_size);
+    }
+
+    const size_t message_size{local_mq_message_size(header.payload_size)};
+    header.checksum = local_mq_checksum(header, message_size);
+    local_mq_publish(header, HCTR_LOCAL_MQ_MESSAGE);
+
+    log.position += message_size;
+    i += batch_size;
+  }
+
+  // Update metrics.
+  Base::post(tag, num_pairs, keys, values, value_size);
+}
+
+template <typename Key>
+void LocalMessageSink<Key>::flush() {
+  for (auto& [tag, log] : logs_) {
+    log.segment->sync(log.synced_position, log.position - log.synced_position, true);
+    log.synced_position = log.position;
+  }
+
+  // Update metrics.
+  Base::flush();
+}
+
+template <typename Key>
+typename LocalMessageSink<Key>::Log& LocalMessageSink<Key>::resolve_log(const std::string& tag) {
+  const auto logs_it{logs_.find(tag)};
+  if (logs_it != logs_.end()) {
+    return logs_it->second;
+  }
+
+  HCTR_CHECK_HINT(!tag.empty() && tag.find('/') == std::string::npos && tag[0] != '.',
+                  "Invalid local message queue tag '", tag, "'.");
+  const std::filesystem::path dir{std::filesystem::path(this->params_.path) / tag};
+  std::filesystem::create_directories(dir);
+
+  Log log;
+
+  // Make sure we are the only writer.
+  const std::string lock_path{(dir / ".lock").string()};
+  log.lock_fd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (log.lock_fd == -1) {
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't open " + lock_path);
+  }
+  if (flock(log.lock_fd, LOCK_EX | LOCK_NB) != 0) {
+    close(log.lock_fd);
+    HCTR_OWN_THROW(Error_t::WrongInput,
+                   "Local message queue '" + dir.string() + "' is used by another sink.");
+  }
+
+  // If a previous sink was interrupted, its last segment may end with a partially written message.
+  // We never append to it, but seal it at the last intact message and begin a new segment.
+  const std::vector<size_t>& segments{local_mq_list_segments(dir)};
+  if (!segments.empty()) {
+    log.segment_index = segments.back();
+    log.segment = std::make_unique<LocalMessageSegment>(
+        local_mq_segment_path(dir, log.segment_index), true);
+
+    const char* const data{log.segment->data()};
+    const size_t size{log.segment->size()};
+    while (log.position + sizeof(LocalMessageHeader) <= size) {
+      const LocalMessageHeader& header{
+          *reinterpret_cast<const LocalMessageHeader*>(&data[log.position])};
+      if (header.magic != HCTR_LOCAL_MQ_MESSAGE) {
+        break;
+      }
+      const size_t message_size{local_mq_message_size(header.payload_size)};
+      if (header.payload_size > size || log.position + message_size > size ||
+          header.checksum != local_mq_checksum(header, message_size)) {
+        break;
+      }
+      log.position += message_size;
+    }
+    HCTR_LOG_S(INFO, WORLD) << "Resuming local message queue '" << dir.string()
+                            << "' after segment " << log.segment_index << '.' << std::endl;
+  }
+
+  Log& new_log{logs_.emplace(tag, std::move(log)).first->second};
+  rotate(tag, new_log);
+  return new_log;
+}
+
+template <typename Key>
+void LocalMessageSink<Key>::rotate(const std::string& tag, Log& log) {
+  const std::filesystem::path dir{std::filesystem::path(this->params_.path) / tag};
+
+  // Seal the current segment. Readers that reach the end of segment marker before the next segment
+  // exists, will wait for it. If we crash in between, the next sink will create it.
+  const size_t next_index{log.segment ? log.segment_index + 1 : 0};
+  if (log.segment) {
+    LocalMessageHeader& header{
+        *reinterpret_cast<LocalMessageHeader*>(&log.segment->data()[log.position])};
+    local_mq_publish(header, HCTR_LOCAL_MQ_END_OF_SEGMENT);
+    log.segment->sync(log.synced_position,
+                      log.position + sizeof(LocalMessageHeader) - log.synced_position, false);
+  }
+  LocalMessageSegment::create(local_mq_segment_path(dir, next_index), this->params_.segment_size);
+
+  log.segment_index = next_index;
+  log.segment = std::make_unique<LocalMessageSegment>(local_mq_segment_path(dir, next_index), true);
+  log.position = 0;
+  log.synced_position = 0;
+  HCTR_LOG_S(DEBUG, WORLD) << "Local message queue '" << dir.string() << "': Began segment "
+                           << next_index << '.' << std::endl;
+
+  // Apply retention policy. Readers can finish segments that they have already mapped.
+  const size_t num_retained{this->params_.num_retained_segments};
+  if (num_retained && next_index >= num_retained) {
+    for (const size_t index : local_mq_list_segments(dir)) {
+      if (index > next_index - num_retained) {
+        break;
+      }
+      std::filesystem::remove(local_mq_segment_path(dir, index));
+    }
+  }
+}
+
+template class LocalMessageSink<unsigned int>;
+template class LocalMessageSink<long long>;
+
+/**
+ * Read position of a \p LocalMessageSource in the log of a tag.
+ */
+struct LocalMessageCursor final {
+  std::filesystem::path dir;
+  std::string offset_path;
+
+  size_t segment_index{0};
+  std::unique_ptr<LocalMessageSegment> segment;
+  size_t position{0};
+
+  size_t num_messages{0};  // Messages delivered since the last commit.
+  size_t num_keys{0};      // Keys delivered since the last commit.
+  bool corrupt{false};
+
+  // Crash-safe commit. Replaces the offset file atomically.
+  void commit() {
+    const std::string tmp_path{offset_path + ".tmp"};
+    {
+      std::ofstream file(tmp_path, std::ios::trunc);
+      file << segment_index << ' ' << position << std::endl;
+      HCTR_CHECK_HINT(file.good(), "Unable to write ", tmp_path, '.');
+    }
+    const int fd{open(tmp_path.c_str(), O_RDONLY)};
+    if (fd != -1) {
+      fsync(fd);
+      close(fd);
+    }
+    HCTR_CHECK_HINT(std::rename(tmp_path.c_str(), offset_path.c_str()) == 0,
+                    "Unable to commit local message queue offset ", offset_path, '.');
+    num_messages = 0;
+    num_keys = 0;
+  }
+
+  // Maps the segment with the given index, or the next older segment that still exists.
+  bool open_segment(const size_t index) {
+    const std::vector<size_t>& segments{local_mq_list_segments(dir)};
+    const auto it{std::lower_bound(segments.begin(), segments.end(), index)};
+    if (it == segments.end()) {
+      return false;
+    }
+    if (*it != index) {
+      HCTR_LOG_S(WARNING, WORLD) << "Local message queue '" << dir.string() << "': Segments "
+                                 << index << " to " << *it - 1
+                                 << " were deleted before they could be consumed!" << std::endl;
+      position = 0;
+    }
+    segment_index = *it;
+    segment = std::make_unique<LocalMessageSegment>(local_mq_segment_path(dir, *it), false);
+    return true;
+  }
+};
+
+template <typename Key>
+LocalMessageSource<Key>::LocalMessageSource(const std::string& path,
+                                            const std::string& consumer_group_id,
+                                            const std::vector<std::string>& tag_filters,
+                                            const size_t poll_timeout_ms,
+                                            const size_t max_batch_size,
+                                            const size_t failure_backoff_ms,
+                                            const size_t max_commit_interval)
+    : Base(),
+      path_(path),
+      consumer_group_id_(consumer_group_id.empty() ? "default" : consumer_group_id),
+      tag_filters_(tag_filters),
+      poll_timeout_ms_(poll_timeout_ms),
+      max_batch_size_(max_batch_size),
+      failure_backoff_ms_(failure_backoff_ms),
+      max_commit_interval_(max_commit_interval) {
+  // Make sure that there is at least one valid subscription pattern.
+  HCTR_CHECK_HINT(!tag_filters_.empty(),
+                  "Must provide at least subscription tag filter for the local message queue.");
+  HCTR_CHECK_HINT(consumer_group_id_.find('/') == std::string::npos, "Invalid consumer group '",
+                  consumer_group_id_, "'.");
+
+  // Make sure numeric arguments have sane values.
+  HCTR_CHECK(poll_timeout_ms > 0);
+  HCTR_CHECK(max_batch_size > 0);
+  HCTR_CHECK(max_commit_interval > 0);
+
+  std::filesystem::create_directories(path_);
+}
+
+template <typename Key>
+LocalMessageSource<Key>::~LocalMessageSource() {
+  // Stop processing events.
+  terminate_ = true;
+  if (event_handler_.joinable()) {
+    event_handler_.join();
+  }
+}
+
+template <typename Key>
+void LocalMessageSource<Key>::engage(std::function<HCTR_MESSAGE_SOURCE_CALLBACK> callback) {
+  // Stop processing events (if already doing so).
+  terminate_ = true;
+  if (event_handler_.joinable()) {
+    event_handler_.join();
+  }
+
+  // Start new thread with updated function pointer.
+  terminate_ = false;
+  event_handler_ = std::thread(&LocalMessageSource<Key>::run, this, std::move(callback));
+}
+
+template <typename Key>
+void LocalMessageSource<Key>::run(std::function<HCTR_MESSAGE_SOURCE_CALLBACK> callback) {
+  hctr_set_thread_name("local mq source");
+
+  std::vector<std::regex> tag_filters;
+  tag_filters.reserve(tag_filters_.size());
+  for (const std::string& tag_filter : tag_filters_) {
+    tag_filters.emplace_back(tag_filter);
+  }
+
+  std::unordered_map<std::string, LocalMessageCursor> cursors;
+  auto subscribe = [&]() {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(path_, error)) {
+      if (!entry.is_directory()) {
+        continue;
+      }
+      const std::string& tag{entry.path().filename().string()};
+      if (cursors.find(tag) != cursors.end() ||
+          std::none_of(tag_filters.begin(), tag_filters.end(),
+                       [&](const std::regex& filter) { return std::regex_search(tag, filter); })) {
+        continue;
+      }
+
+      LocalMessageCursor cursor;
+      cursor.dir = entry.path();
+      cursor.offset_path = (cursor.dir / (consumer_group_id_ + ".offset")).string();
+
+      // Resume from last commit (if any).
+      {
+        std::ifstream file(cursor.offset_path);
+        size_t segment_index, position;
+        if (file >> segment_index >> position) {
+          cursor.segment_index = segment_index;
+          cursor.position = position;
+        } else {
+          const std::vector<size_t>& segments{local_mq_list_segments(cursor.dir)};
+          if (!segments.empty()) {
+            cursor.segment_index = segments.front();
+          }
+        }
+      }
+      HCTR_LOG_S(INFO, WORLD) << "Subscribed to local message queue '" << cursor.dir.string()
+                              << "' (group = " << consumer_group_id_
+                              << ", segment = " << cursor.segment_index
+                              << ", position = " << cursor.position << ")." << std::endl;
+      cursors.emplace(tag, std::move(cursor));
+    }
+  };
+
+  auto deliver = [&](const std::string& tag, const size_t num_pairs, const Key* const keys,
+                     const char* const values, const size_t value_size) -> bool {
+    // Retry until receiver signals that the delivery was successful.
+    while (!callback(tag, num_pairs, keys, values, value_size)) {
+      if (terminate_) {
+        return false;
+      }
+
+      HCTR_LOG_S(WARNING, WORLD) << "Unable to deliver " << num_pairs
+                                 << " key/value pairs from local message queue " << tag << '.'
+                                 << std::endl;
+      std::this_thread::sleep_for(failure_backoff_ms_);
+    }
+    num_keys_delivered_ += num_pairs;
+    return true;
+  };
+
+  auto commit = [&](LocalMessageCursor& cursor) {
+    if (!cursor.num_messages) {
+      return;
+    }
+    HCTR_LOG_S(TRACE, WORLD) << "Committing local message queue '" << cursor.dir.string()
+                             << "': { segment = " << cursor.segment_index
+                             << ", position = " << cursor.position << " }" << std::endl;
+    num_keys_committed_ += cursor.num_keys;
+    num_messages_committed_ += cursor.num_messages;
+    cursor.commit();
+  };
+
+  // Reused to decode encoded messages.
+  std::vector<Key> decoded_keys;
+  std::vector<char> decoded_values;
+
+  // Consumes up to `max_commit_interval_` messages. Returns the number of messages consumed.
+  auto consume = [&](const std::string& tag, LocalMessageCursor& cursor) -> size_t {
+    size_t num_messages{0};
+    while (num_messages < max_commit_interval_ && !terminate_) {
+      if (!cursor.segment && !cursor.open_segment(cursor.segment_index)) {
+        break;
+      }
+
+      const char* const data{cursor.segment->data()};
+      const size_t size{cursor.segment->size()};
+      HCTR_CHECK(cursor.position + sizeof(LocalMessageHeader) <= size);
+      const LocalMessageHeader& header{
+          *reinterpret_cast<const LocalMessageHeader*>(&data[cursor.position])};
+
+      const uint32_t magic{local_mq_load_magic(header)};
+      if (magic == HCTR_LOCAL_MQ_END_OF_SEGMENT) {
+        // Keep the old segment mapped until the next one is available.
+        LocalMessageCursor next;
+        next.dir = cursor.dir;
+        if (!next.open_segment(cursor.segment_index + 1)) {
+          break;
+        }
+        cursor.segment_index = next.segment_index;
+        cursor.segment = std::move(next.segment);
+        cursor.position = 0;
+        continue;
+      }
+      if (magic != HCTR_LOCAL_MQ_MESSAGE) {
+        break;  // No new messages.
+      }
+
+      // Validate message.
+      if (header.key_size != sizeof(Key)) {
+        if (!cursor.corrupt) {
+          HCTR_LOG_S(ERROR, WORLD) << "Local message queue '" << cursor.dir.string()
+                                   << "': Key size mismatch (" << header.key_size << " <> "
+                                   << sizeof(Key) << " bytes)!" << std::endl;
+          cursor.corrupt = true;
+        }
+        break;
+      }
+      const size_t message_size{local_mq_message_size(header.payload_size)};
+      if (header.payload_size > size || cursor.position + message_size > size ||
+          header.checksum != local_mq_checksum(header, message_size)) {
+        // Can only happen if the sink was interrupted. Wait for the next sink to seal the segment.
+        if (!cursor.corrupt) {
+          HCTR_LOG_S(WARNING, WORLD)
+              << "Local message queue '" << cursor.dir.string() << "': Message at segment "
+              << cursor.segment_index << ", position " << cursor.position
+              << " is incomplete or corrupted. Waiting for sink to recover." << std::endl;
+          cursor.corrupt = true;
+        }
+        break;
+      }
+      cursor.corrupt = false;
+
+      const char* const payload{&data[cursor.position + sizeof(header)]};
+      size_t num_pairs{header.num_pairs};
+      const Key* keys;
+      const char* values;
+      uint32_t value_size{header.value_size};
+      if (header.encoding == HCTR_LOCAL_MQ_ENCODED) {
+        decoded_keys.clear();
+        decoded_values.clear();
+        try {
+          num_pairs = MessageCodec<Key>::decode(payload, header.payload_size, decoded_keys,
+                                                decoded_values, value_size);
+        } catch (const std::exception& error) {
+          // The checksum matched. Hence, the sink encoded something that we cannot decode.
+          HCTR_LOG_S(ERROR, WORLD) << "Local message queue '" << cursor.dir.string()
+                                   << "': Unable to decode message at segment "
+                                   << cursor.segment_index << ", position " << cursor.position
+                                   << ". Skipping! Reason: " << error.what() << std::endl;
+          num_pairs = 0;
+        }
+        keys = decoded_keys.data();
+        values = decoded_values.data();
+      } else {
+        // Hand over keys and values directly from the mapped segment.
+        HCTR_CHECK(header.payload_size == num_pairs * (sizeof(Key) + value_size));
+        keys = reinterpret_cast<const Key*>(payload);
+        values = reinterpret_cast<const char*>(&keys[num_pairs]);
+      }
+      for (size_t i{0}; i < num_pairs; i += max_batch_size_) {
+        const size_t batch_size{std::min(num_pairs - i, max_batch_size_)};
+        if (!deliver(tag, batch_size, &keys[i], &values[i * value_size], value_size)) {
+          return num_messages;
+        }
+      }
+
+      cursor.position += message_size;
+      cursor.num_keys += num_pairs;
+      ++num_messages;
+
+      // If reached maximum commit interval, commit now.
+      if (++cursor.num_messages >= max_commit_interval_) {
+        commit(cursor);
+      }
+    }
+    return num_messages;
+  };
+
+  while (!terminate_) {
+    subscribe();
+
+    size_t num_messages{0};
+    for (auto& [tag, cursor] : cursors) {
+      const size_t n{consume(tag, cursor)};
+      if (!n) {
+        // Caught up. Commit anything that is pending.
+        commit(cursor);
+      }
+      num_messages += n;
+    }
+
+    // Nothing to do. Wait for more messages.
+    if (!num_messages) {
+      const auto deadline{std::chrono::steady_clock::now() + poll_timeout_ms_};
+      while (!terminate_ && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::min(poll_timeout_ms_, std::chrono::milliseconds(10)));
+      }
+    }
+  }
+
+  // Commit whatever was already delivered.
+  for (auto& [tag, cursor] : cursors) {
+    commit(cursor);
+  }
+}
+
+template class LocalMessageSource<unsigned int>;
+template class LocalMessageSource<long long>;
+
+}  // namespace HugeCTR
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_MESSAGE_COMPRESSION
+#include <lz4.h>
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <core23/logger.hpp>
+#include <cstring>
+#include <hps/message_codec.hpp>
+#include <numeric>
+#include <thread_pool.hpp>
+#include <type_traits>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+namespace {
+
+const uint32_t HCTR_MESSAGE_CODEC_PREFIX =
+    (uint32_t)('H') | ((uint32_t)('C') << 8) | ((uint32_t)('T') << 16) | ((uint32_t)('C') << 24);
+
+constexpr uint8_t HCTR_MESSAGE_CODEC_DELTA_KEYS{0x1};
+
+// All fields are accessed through `memcpy`. Hence, payloads need not be aligned.
+struct MessagePayloadHeader final {
+  uint32_t magic;
+  uint8_t key_size;
+  uint8_t flags;
+  uint8_t value_codec;
+  uint8_t compression;
+  uint32_t value_size;
+  uint32_t num_blocks;
+  uint64_t num_pairs;
+};
+
+// If `stored_size == raw_size`, the block is stored uncompressed.
+struct MessageBlockInfo final {
+  uint32_t num_pairs;
+  uint32_t raw_size;
+  uint32_t stored_size;
+};
+
+constexpr size_t max_varint_size{10};
+
+inline char* write_varint(char* p, uint64_t x) {
+  while (x >= 0x80) {
+    *p++ = static_cast<char>(x | 0x80);
+    x >>= 7;
+  }
+  *p++ = static_cast<char>(x);
+  return p;
+}
+
+inline const char* read_varint(const char* p, const char* const end, uint64_t& x) {
+  x = 0;
+  for (int shift{0}; p != end && shift < 64; shift += 7) {
+    const uint64_t byte{static_cast<uint8_t>(*p++)};
+    x |= (byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return p;
+    }
+  }
+  HCTR_OWN_THROW(Error_t::WrongInput, "Message payload is corrupted (invalid key delta).");
+  return p;
+}
+
+// Runs `fn(0), ..., fn(n - 1)` in parallel. Awaits all of them before rethrowing any exception.
+template <typename Fn>
+void parallel_for(const size_t n, Fn fn) {
+  if (n <= 1) {
+    if (n) {
+      fn(0);
+    }
+    return;
+  }
+
+  ThreadPool& pool{ThreadPool::get()};
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(n);
+  for (size_t i{0}; i < n; ++i) {
+    tasks.emplace_back(pool.submit([&fn, i]() { fn(i); }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+}
+
+#ifndef ENABLE_MESSAGE_COMPRESSION
+[[noreturn]] void throw_compression_unavailable() {
+  HCTR_OWN_THROW(Error_t::WrongInput,
+                 "Please install LZ4 and Zstd and compile HugeCTR with ENABLE_MESSAGE_COMPRESSION "
+                 "to use message compression.");
+  std::terminate();
+}
+#endif
+
+// Returns the compressed size, or 0 if compression failed or was not worthwhile.
+size_t compress(const MessageCompression_t compression, const int level, const char* const src,
+                const size_t src_size, std::vector<char>& dst) {
+#ifdef ENABLE_MESSAGE_COMPRESSION
+  size_t dst_size{0};
+  switch (compression) {
+    case MessageCompression_t::LZ4: {
+      const int src_size_i{static_cast<int>(src_size)};
+      dst.resize(static_cast<size_t>(LZ4_compressBound(src_size_i)));
+      const int dst_capacity{static_cast<int>(dst.size())};
+      // For LZ4, the level is the acceleration factor (higher = faster).
+      const int n{LZ4_compress_fast(src, dst.data(), src_size_i, dst_capacity, std::max(level, 1))};
+      dst_size = n > 0 ? static_cast<size_t>(n) : 0;
+    } break;
+    case MessageCompression_t::Zstd: {
+      dst.resize(ZSTD_compressBound(src_size));
+      const size_t n{ZSTD_compress(dst.data(), dst.size(), src, src_size,
+                                   level ? level : ZSTD_CLEVEL_DEFAULT)};
+      dst_size = ZSTD_isError(n) ? 0 : n;
+    } break;
+    default:
+      HCTR_DIE("Unsupported message compression!");
+  }
+  return dst_size < src_size ? dst_size : 0;
+#else
+  throw_compression_unavailable();
+#endif
+}
+
+void decompress(const MessageCompression_t compression, const char* const src,
+                const size_t src_size, char* const dst, const size_t dst_size) {
+#ifdef ENABLE_MESSAGE_COMPRESSION
+  bool success;
+  switch (compression) {
+    case MessageCompression_t::LZ4:
+      success = LZ4_decompress_safe(src, dst, static_cast<int>(src_size),
+                                    static_cast<int>(dst_size)) == static_cast<int>(dst_size);
+      break;
+    case MessageCompression_t::Zstd:
+      success = ZSTD_decompress(dst, dst_size, src, src_size) == dst_size;
+      break;
+    default:
+      success = false;
+      break;
+  }
+  if (!success) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Message payload is corrupted (decompression failed).");
+  }
+#else
+  throw_compression_unavailable();
+#endif
+}
+
+}  // namespace
+
+bool MessageCodecParams::operator==(const MessageCodecParams& p) const {
+  return delta_keys == p.delta_keys && value_codec == p.value_codec &&
+         compression == p.compression && compression_level == p.compression_level &&
+         block_size == p.block_size;
+}
+bool MessageCodecParams::operator!=(const MessageCodecParams& p) const { return !operator==(p); }
+
+template <typename Key>
+MessageCodec<Key>::MessageCodec(const MessageCodecParams& params)
+    : params_{params},
+      value_codec_{params.value_codec},
+      identity_{!params.delta_keys && params.value_codec == DatabaseValueCodec_t::Float32 &&
+                params.compression == MessageCompression_t::None} {
+  HCTR_CHECK(params_.block_size > 0);
+#ifndef ENABLE_MESSAGE_COMPRESSION
+  if (params_.compression != MessageCompression_t::None) {
+    throw_compression_unavailable();
+  }
+#endif
+}
+
+template <typename Key>
+size_t MessageCodec<Key>::max_encoded_size(const size_t num_pairs,
+                                           const uint32_t value_size) const {
+  const size_t num_blocks{(num_pairs + params_.block_size - 1) / params_.block_size};
+  const size_t key_size{params_.delta_keys ? max_varint_size : sizeof(Key)};
+  return sizeof(MessagePayloadHeader) + num_blocks * sizeof(MessageBlockInfo) +
+         num_pairs * (key_size + value_codec_.encoded_size(value_size));
+}
+
+template <typename Key>
+size_t MessageCodec<Key>::max_num_pairs(const size_t max_payload_size,
+                                        const uint32_t value_size) const {
+  const size_t overhead{sizeof(MessagePayloadHeader) + sizeof(MessageBlockInfo)};
+  if (max_payload_size <= overhead) {
+    return 0;
+  }
+  const size_t key_size{params_.delta_keys ? max_varint_size : sizeof(Key)};
+  const size_t pair_size{key_size + value_codec_.encoded_size(value_size)};
+
+  size_t num_pairs{(max_payload_size - overhead) / pair_size};
+  while (num_pairs && max_encoded_size(num_pairs, value_size) > max_payload_size) {
+    const size_t excess{max_encoded_size(num_pairs, value_size) - max_payload_size};
+    num_pairs -= std::min(num_pairs, (excess + pair_size - 1) / pair_size);
+  }
+  return num_pairs;
+}
+
+template <typename Key>
+size_t MessageCodec<Key>::encode(const size_t num_pairs, const Key* const keys,
+                                 const char* const values, const uint32_t value_size,
+                                 char* const payload) const {
+  const size_t block_size{params_.block_size};
+  const size_t num_blocks{(num_pairs + block_size - 1) / block_size};
+  const size_t encoded_value_size{value_codec_.encoded_size(value_size)};
+  HCTR_CHECK(block_size * (max_varint_size + encoded_value_size) <=
+             std::numeric_limits<uint32_t>::max());
+
+  const MessagePayloadHeader header{HCTR_MESSAGE_CODEC_PREFIX,
+                                    static_cast<uint8_t>(sizeof(Key)),
+                                    params_.delta_keys ? HCTR_MESSAGE_CODEC_DELTA_KEYS : uint8_t{0},
+                                    static_cast<uint8_t>(params_.value_codec),
+                                    static_cast<uint8_t>(params_.compression),
+                                    value_size,
+                                    static_cast<uint32_t>(num_blocks),
+                                    num_pairs};
+  std::memcpy(payload, &header, sizeof(header));
+
+  // Encode blocks in parallel, then concatenate them.
+  std::vector<MessageBlockInfo> infos(num_blocks);
+  std::vector<std::vector<char>> raw_blocks(num_blocks);
+  std::vector<std::vector<char>> compressed_blocks(num_blocks);
+
+  parallel_for(num_blocks, [&](const size_t block) {
+    const size_t first{block * block_size};
+    const size_t n{std::min(block_size, num_pairs - first)};
+    const Key* const block_keys{&keys[first]};
+    const char* const block_values{&values[first * value_size]};
+
+    std::vector<char>& raw{raw_blocks[block]};
+    raw.resize(n * ((params_.delta_keys ? max_varint_size : sizeof(Key)) + encoded_value_size));
+    char* p{raw.data()};
+
+    if (params_.delta_keys) {
+      std::vector<uint32_t> order(n);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return block_keys[a] < block_keys[b];
+      });
+
+      // Differences are computed modulo 2^64. Hence, negative keys are fine as well.
+      using UKey = std::make_unsigned_t<Key>;
+      uint64_t prev{0};
+      for (const uint32_t i : order) {
+        const uint64_t k{static_cast<UKey>(block_keys[i])};
+        p = write_varint(p, k - prev);
+        prev = k;
+      }
+      for (const uint32_t i : order) {
+        value_codec_.encode(&block_values[i * value_size], value_size, p);
+        p += encoded_value_size;
+      }
+    } else {
+      std::memcpy(p, block_keys, n * sizeof(Key));
+      p += n * sizeof(Key);
+      if (value_codec_.type() == DatabaseValueCodec_t::Float32) {
+        std::memcpy(p, block_values, n * value_size);
+        p += n * value_size;
+      } else {
+        for (size_t i{0}; i < n; ++i) {
+          value_codec_.encode(&block_values[i * value_size], value_size, p);
+          p += encoded_value_size;
+        }
+      }
+    }
+
+    MessageBlockInfo& info{infos[block]};
+    info.num_pairs = static_cast<uint32_t>(n);
+    info.raw_size = static_cast<uint32_t>(p - raw.data());
+    info.stored_size = info.raw_size;
+    if (params_.compression != MessageCompression_t::None) {
+      const size_t compressed_size{compress(params_.compression, params_.compression_level,
+                                            raw.data(), info.raw_size, compressed_blocks[block])};
+      if (compressed_size) {
+        info.stored_size = static_cast<uint32_t>(compressed_size);
+      }
+    }
+  });
+
+  char* p{&payload[sizeof(header)]};
+  std::memcpy(p, infos.data(), num_blocks * sizeof(MessageBlockInfo));
+  p += num_blocks * sizeof(MessageBlockInfo);
+  for (size_t block{0}; block < num_blocks; ++block) {
+    const MessageBlockInfo& info{infos[block]};
+    const std::vector<char>& src{info.stored_size == info.raw_size ? raw_blocks[block]
+                                                                    : compressed_blocks[block]};
+    std::memcpy(p, src.data(), info.stored_size);
+    p += info.stored_size;
+  }
+  return static_cast<size_t>(p - payload);
+}
+
+template <typename Key>
+size_t MessageCodec<Key>::decode(const char* const payload, const size_t payload_size,
+                                 std::vector<Key>& keys, std::vector<char>& values,
+                                 uint32_t& value_size) {
+  const char* const payload_end{&payload[payload_size]};
+
+  MessagePayloadHeader header;
+  HCTR_THROW_IF(payload_size < sizeof(header), Error_t::DataCheckError,
+                "Message payload is too small.");
+  std::memcpy(&header, payload, sizeof(header));
+  HCTR_THROW_IF(header.magic != HCTR_MESSAGE_CODEC_PREFIX, Error_t::DataCheckError,
+                "Unknown message payload format.");
+  HCTR_THROW_IF(header.key_size != sizeof(Key), Error_t::DataCheckError,
+                "Message key size mismatch (", static_cast<size_t>(header.key_size), " <> ",
+                sizeof(Key), " bytes).");
+
+  // ValueCodec aborts on formats it does not support. Hence, they are rejected here.
+  HCTR_THROW_IF(header.value_codec > static_cast<uint64_t>(DatabaseValueCodec_t::Int8),
+                Error_t::DataCheckError, "Unknown message value codec (",
+                static_cast<size_t>(header.value_codec), ").");
+  HCTR_THROW_IF(header.value_codec != static_cast<uint64_t>(DatabaseValueCodec_t::Float32) &&
+                    header.value_size % sizeof(float) != 0,
+                Error_t::DataCheckError, "Message value size (",
+                static_cast<size_t>(header.value_size), " bytes) does not match its codec.");
+
+  const bool delta_keys{(header.flags & HCTR_MESSAGE_CODEC_DELTA_KEYS) != 0};
+  const ValueCodec value_codec{static_cast<DatabaseValueCodec_t>(header.value_codec)};
+  const MessageCompression_t compression{static_cast<MessageCompression_t>(header.compression)};
+  value_size = header.value_size;
+  const size_t encoded_value_size{value_codec.encoded_size(value_size)};
+
+  // Locate blocks.
+  const size_t num_blocks{header.num_blocks};
+  const char* p{&payload[sizeof(header)]};
+  HCTR_THROW_IF(num_blocks * sizeof(MessageBlockInfo) > static_cast<size_t>(payload_end - p),
+                Error_t::DataCheckError, "Message payload is truncated.");
+  std::vector<MessageBlockInfo> infos(num_blocks);
+  std::memcpy(infos.data(), p, num_blocks * sizeof(MessageBlockInfo));
+  p += num_blocks * sizeof(MessageBlockInfo);
+
+  std::vector<const char*> block_data(num_blocks);
+  std::vector<size_t> block_first(num_blocks);
+  size_t num_pairs{0};
+  for (size_t block{0}; block < num_blocks; ++block) {
+    const MessageBlockInfo& info{infos[block]};
+    HCTR_THROW_IF(info.stored_size > static_cast<size_t>(payload_end - p),
+                  Error_t::DataCheckError, "Message payload is truncated.");
+    block_data[block] = p;
+    block_first[block] = num_pairs;
+    p += info.stored_size;
+    num_pairs += info.num_pairs;
+  }
+  HCTR_THROW_IF(num_pairs != header.num_pairs, Error_t::DataCheckError,
+                "Message payload is corrupted.");
+
+  // Decode blocks in parallel.
+  const size_t keys_offset{keys.size()};
+  const size_t values_offset{values.size()};
+  keys.resize(keys_offset + num_pairs);
+  values.resize(values_offset + num_pairs * value_size);
+
+  parallel_for(num_blocks, [&](const size_t block) {
+    const MessageBlockInfo& info{infos[block]};
+    const size_t n{info.num_pairs};
+    Key* const block_keys{&keys[keys_offset + block_first[block]]};
+    char* const block_values{&values[values_offset + block_first[block] * value_size]};
+
+    const char* raw{block_data[block]};
+    std::vector<char> buffer;
+    if (info.stored_size != info.raw_size) {
+      buffer.resize(info.raw_size);
+      decompress(compression, raw, info.stored_size, buffer.data(), buffer.size());
+      raw = buffer.data();
+    }
+    const char* const raw_end{&raw[info.raw_size]};
+
+    const char* q{raw};
+    if (delta_keys) {
+      using UKey = std::make_unsigned_t<Key>;
+      uint64_t k{0};
+      for (size_t i{0}; i < n; ++i) {
+        uint64_t delta;
+        q = read_varint(q, raw_end, delta);
+        k += delta;
+        block_keys[i] = static_cast<Key>(static_cast<UKey>(k));
+      }
+    } else {
+      HCTR_THROW_IF(n * sizeof(Key) > info.raw_size, Error_t::DataCheckError,
+                    "Message payload is corrupted.");
+      std::memcpy(block_keys, q, n * sizeof(Key));
+      q += n * sizeof(Key);
+    }
+
+    HCTR_THROW_IF(n * encoded_value_size != static_cast<size_t>(raw_end - q),
+                  Error_t::DataCheckError, "Message payload is corrupted.");
+    if (value_codec.type() == DatabaseValueCodec_t::Float32) {
+      std::memcpy(block_values, q, n * value_size);
+    } else {
+      for (size_t i{0}; i < n; ++i) {
+        value_codec.decode(q, value_size, &block_values[i * value_size]);
+        q += encoded_value_size;
+      }
+    }
+  });
+
+  return num_pairs;
+}
+
+template class MessageCodec<unsigned int>;
+template class MessageCodec<long long>;
+
+}  // namespace HugeCTR
@@ -14,16 +14,81 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <common.hpp>
 #include <hps/inference_utils.hpp>
 #include <hps/modelloader.hpp>
+#include <io/io_utils.hpp>
 #include <parser.hpp>
+#include <thread_pool.hpp>
 #include <unordered_set>
 #include <utils.hpp>
 
 namespace HugeCTR {
 
+MappedModelFile::MappedModelFile(const std::string& path) {
+  const int fd{open(path.c_str(), O_RDONLY)};
+  if (fd == -1) {
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't open " + path);
+  }
+  struct stat stats;
+  if (fstat(fd, &stats) != 0) {
+    close(fd);
+    HCTR_OWN_THROW(Error_t::FileCannotOpen, "Can't stat " + path);
+  }
+  size_ = static_cast<size_t>(stats.st_size);
+  if (size_ == 0) {
+    close(fd);
+    HCTR_OWN_THROW(Error_t::WrongInput, "Can't mmap empty file " + path);
+  }
+
+  data_ = static_cast<char*>(mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0));
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    HCTR_OWN_THROW(Error_t::WrongInput, "Fail mmap file " + path);
+  }
+
+  // Model files are consumed front to back. Hence, read ahead aggressively.
+  madvise(data_, size_, MADV_SEQUENTIAL);
+}
+
+MappedModelFile::~MappedModelFile() { munmap(data_, size_); }
+
+void MappedModelFile::prefault(const size_t offset, size_t length) const {
+  if (offset >= size_) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+
+  static const size_t page_size{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+  const auto touch{[this](const size_t first, const size_t last) {
+    const volatile char* const data{data_};
+    for (size_t i{first / page_size * page_size}; i < last; i += page_size) {
+      data[i];
+    }
+  }};
+
+  constexpr size_t chunk_size{16 * 1024 * 1024};
+  if (length <= chunk_size) {
+    touch(offset, offset + length);
+    return;
+  }
+
+  ThreadPool& pool{ThreadPool::get()};
+  std::vector<std::future<void>> tasks;
+  tasks.reserve((length + chunk_size - 1) / chunk_size);
+  for (size_t first{offset}; first < offset + length; first += chunk_size) {
+    const size_t last{std::min(first + chunk_size, offset + length)};
+    tasks.emplace_back(pool.submit([&touch, first, last]() { touch(first, last); }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+}
+
 template <typename TKey, typename TValue>
 void* UnifiedEmbeddingTable<TKey, TValue>::get_cache_keys() {
   return this->keys.data();
@@ -55,7 +120,8 @@ size_t UnifiedEmbeddingTable<TKey, TValue>::get_uvm_key_count() {
 }
 
 template <typename TKey, typename TValue>
-RawModelLoader<TKey, TValue>::RawModelLoader() : IModelLoader() {
+RawModelLoader<TKey, TValue>::RawModelLoader(const bool prefault)
+    : IModelLoader(), prefault_{prefault} {
   HCTR_LOG_S(DEBUG, WORLD) << "Created raw model loader in local memory!" << std::endl;
   embedding_table_ = new UnifiedEmbeddingTable<TKey, TValue>();
 }
@@ -109,18 +175,31 @@ void RawModelLoader<TKey, TValue>::load_emb(const std::string& table_name,
   embedding_table_->keys.resize(embedding_table_->key_count);
   embedding_table_->vectors.resize(embedding_table_->vec_elem_count);
 
-  if (std::is_same<TKey, long long>::value) {
-    fs->read(key_file, embedding_table_->keys.data() + key_offset_in_elements,
-             key_file_size_in_byte, 0);
+  if (IOUtils::is_local_path(path)) {
+    // Copy directly from the page cache. Keys are converted on the fly.
+    const MappedModelFile mapped_key_file(key_file);
+    const long long* const keys{reinterpret_cast<const long long*>(mapped_key_file.data())};
+    std::transform(keys, &keys[num_key], embedding_table_->keys.begin() + key_offset_in_elements,
+                   [](const long long key) { return static_cast<TKey>(key); });
+
+    const MappedModelFile mapped_vec_file(vec_file);
+    const TValue* const vectors{reinterpret_cast<const TValue*>(mapped_vec_file.data())};
+    std::copy_n(vectors, num_float_val_in_vec_file,
+                embedding_table_->vectors.begin() + vec_offset_in_elements);
   } else {
-    std::vector<long long> i64_key_vec(num_key, 0);
-    fs->read(key_file, i64_key_vec.data(), key_file_size_in_byte, 0);
-    std::transform(i64_key_vec.begin(), i64_key_vec.end(),
-                   embedding_table_->keys.begin() + key_offset_in_elements,
-                   [](long long key) { return static_cast<unsigned>(key); });
+    if (std::is_same<TKey, long long>::value) {
+      fs->read(key_file, embedding_table_->keys.data() + key_offset_in_elements,
+               key_file_size_in_byte, 0);
+    } else {
+      std::vector<long long> i64_key_vec(num_key, 0);
+      fs->read(key_file, i64_key_vec.data(), key_file_size_in_byte, 0);
+      std::transform(i64_key_vec.begin(), i64_key_vec.end(),
+                     embedding_table_->keys.begin() + key_offset_in_elements,
+                     [](long long key) { return static_cast<unsigned>(key); });
+    }
+    fs->read(vec_file, embedding_table_->vectors.data() + vec_offset_in_elements,
+             vec_file_size_in_byte, 0);
   }
-  fs->read(vec_file, embedding_table_->vectors.data() + vec_offset_in_elements,
-           vec_file_size_in_byte, 0);
 }
 
 template <typename TKey, typename TValue>
@@ -155,6 +234,15 @@ void RawModelLoader<TKey, TValue>::load(const std::string& table_name, const std
   const size_t num_key = key_file_size_in_byte / key_size_in_byte;
   embedding_table_->total_key_count = num_key;
 
+  // Local files are mapped instead of read. Release the previous mappings first, to avoid
+  // holding on to two tables at once.
+  key_file_.reset();
+  vec_file_.reset();
+  if (IOUtils::is_local_path(path)) {
+    key_file_ = std::make_unique<MappedModelFile>(key_file);
+    vec_file_ = std::make_unique<MappedModelFile>(vec_file);
+  }
+
   if (std::filesystem::exists(meta_file)) {
     const size_t meta_file_size_in_byte = fs_->get_file_size(meta_file);
     if (meta_file_size_in_byte == 0) {
@@ -193,6 +281,8 @@ void RawModelLoader<TKey, TValue>::load(const std::string& table_name, const std
 
 template <typename TKey, typename TValue>
 void RawModelLoader<TKey, TValue>::delete_table() {
+  key_file_.reset();
+  vec_file_.reset();
   std::vector<TKey>().swap(embedding_table_->keys);
   std::vector<TValue>().swap(embedding_table_->vectors);
   std::vector<TKey>().swap(embedding_table_->meta);
@@ -280,12 +370,31 @@ void RawModelLoader<TKey, TValue>::get_cache_uvm(size_t iteration, size_t emb_si
 template <typename TKey, typename TValue>
 std::pair<void*, size_t> RawModelLoader<TKey, TValue>::getkeys(size_t iteration) {
   const std::string key_file = embedding_folder_path + "/" + "key";
-  embedding_table_->keys.resize(key_iteration);
   size_t iteration_reading_amount = key_iteration;
   if ((iteration + 1) * key_iteration > embedding_table_->total_key_count) {
     iteration_reading_amount = embedding_table_->total_key_count - iteration * key_iteration;
   }
 
+  if (key_file_) {
+    const size_t offset = iteration * key_iteration * sizeof(long long);
+    if (prefault_) {
+      key_file_->prefault(offset, iteration_reading_amount * sizeof(long long));
+    }
+    const long long* const keys{reinterpret_cast<const long long*>(&key_file_->data()[offset])};
+    if constexpr (std::is_same<TKey, long long>::value) {
+      // Zero-copy. Callers may read `key_iteration` keys. Hence, only full iterations qualify. The
+      // mapping is read-only (see \p IModelLoader::getkeys ).
+      if (iteration_reading_amount == key_iteration) {
+        return std::make_pair(const_cast<long long*>(keys), iteration_reading_amount);
+      }
+    }
+    embedding_table_->keys.assign(key_iteration, 0);
+    std::transform(keys, &keys[iteration_reading_amount], embedding_table_->keys.begin(),
+                   [](const long long key) { return static_cast<TKey>(key); });
+    return std::make_pair(embedding_table_->keys.data(), iteration_reading_amount);
+  }
+
+  embedding_table_->keys.resize(key_iteration);
   if (std::is_same<TKey, long long>::value) {
     fs_->read(key_file, embedding_table_->keys.data(), iteration_reading_amount * sizeof(TKey),
               iteration * key_iteration * sizeof(TKey));
@@ -303,12 +412,31 @@ template <typename TKey, typename TValue>
 std::pair<void*, size_t> RawModelLoader<TKey, TValue>::getvectors(size_t iteration,
                                                                   size_t emb_size) {
   const std::string vec_file = embedding_folder_path + "/" + "emb_vector";
-  embedding_table_->vectors.resize(key_iteration * emb_size);
   size_t iteration_reading_amount = key_iteration * emb_size;
   if ((iteration + 1) * key_iteration * emb_size > embedding_table_->total_key_count * emb_size) {
     iteration_reading_amount =
         embedding_table_->total_key_count * emb_size - iteration * key_iteration * emb_size;
   }
+
+  if (vec_file_) {
+    const size_t offset = key_iteration * emb_size * iteration * sizeof(TValue);
+    HCTR_CHECK_HINT(offset + iteration_reading_amount * sizeof(TValue) <= vec_file_->size(),
+                    "Error: embeddings vector file is too small for embedding size ", emb_size);
+    if (prefault_) {
+      vec_file_->prefault(offset, iteration_reading_amount * sizeof(TValue));
+    }
+    // Zero-copy, unless this is a short final iteration (see \p getkeys ).
+    if (iteration_reading_amount == key_iteration * emb_size) {
+      return std::make_pair(const_cast<char*>(&vec_file_->data()[offset]),
+                            iteration_reading_amount);
+    }
+    embedding_table_->vectors.assign(key_iteration * emb_size, 0);
+    std::copy_n(reinterpret_cast<const TValue*>(&vec_file_->data()[offset]),
+                iteration_reading_amount, embedding_table_->vectors.begin());
+    return std::make_pair(embedding_table_->vectors.data(), iteration_reading_amount);
+  }
+
+  embedding_table_->vectors.resize(key_iteration * emb_size);
   fs_->read(vec_file, embedding_table_->vectors.data(), iteration_reading_amount * sizeof(TValue),
             key_iteration * emb_size * iteration * sizeof(TValue));
   return std::make_pair(embedding_table_->vectors.data(), iteration_reading_amount);
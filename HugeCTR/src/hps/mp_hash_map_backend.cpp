@@ -21,6 +21,7 @@
 #include <hps/hash_map_backend_detail.hpp>
 #include <hps/hier_parameter_server_base.hpp>
 #include <hps/mp_hash_map_backend.hpp>
+#include <optional>
 #include <random>
 
 // TODO: Remove me!
@@ -36,12 +37,14 @@ MultiProcessHashMapBackend<Key>::MultiProcessHashMapBackend(
                   params.shared_memory_size),
       char_allocator_{sm_segment_.get_allocator<char>()},
       value_page_allocator_{sm_segment_.get_allocator<ValuePage>()},
-      partition_allocator_{sm_segment_.get_allocator<Partition>()},
-      sm_{sm_segment_.find_or_construct<SharedMemory>("sm")(params.heart_beat_frequency,
-                                                            params.auto_remove, sm_segment_)} {
+      sm_{sm_segment_.find_or_construct<SharedMemory>("sm")(
+          params.heart_beat_frequency, params.auto_remove, params.open_addressing, sm_segment_)} {
   HCTR_CHECK(sm_);
   HCTR_CHECK(sm_->heart_beat_frequency == params.heart_beat_frequency);
   HCTR_CHECK(sm_->auto_remove == params.auto_remove);
+  HCTR_CHECK_HINT(sm_->open_addressing == params.open_addressing,
+                  "Shared memory '", params.shared_memory_name,
+                  "' was created with a different storage mode!");
 
   HCTR_LOG_S(INFO, WORLD) << "Connecting to shared memory '" << params.shared_memory_name << "'..."
                           << std::endl;
@@ -112,11 +115,19 @@ MultiProcessHashMapBackend<Key>::~MultiProcessHashMapBackend() {
 
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::size(const std::string& table_name) const {
+  return sm_->open_addressing ? size_(sm_->open_tables, table_name)
+                              : size_(sm_->tables, table_name);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::size_(const SharedTables<Partition>& tables,
+                                              const std::string& table_name) const {
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return 0;
   }
   const SharedVector<Partition>& parts{tables_it->second};
@@ -129,12 +140,24 @@ template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::contains(
     const std::string& table_name, const size_t num_keys, const Key* const keys,
     const std::chrono::nanoseconds& time_budget) const {
+  return sm_->open_addressing
+             ? contains_(sm_->open_tables, table_name, num_keys, keys, time_budget)
+             : contains_(sm_->tables, table_name, num_keys, keys, time_budget);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::contains_(
+    const SharedTables<Partition>& tables, const std::string& table_name, const size_t num_keys,
+    const Key* const keys, const std::chrono::nanoseconds& time_budget) const {
+  constexpr bool optimistic{std::is_same_v<Partition, OpenPartition>};
+
   const auto begin{std::chrono::high_resolution_clock::now()};
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   // Locate partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return Base::contains(table_name, num_keys, keys, time_budget);
   }
   const SharedVector<Partition>& parts{tables_it->second};
@@ -159,7 +182,11 @@ size_t MultiProcessHashMapBackend<Key>::contains(
 
       const size_t prev_hit_count{hit_count};
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
-      HCTR_HPS_HASH_MAP_CONTAINS_(SEQUENTIAL_DIRECT);
+      if constexpr (optimistic) {
+        HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_(SEQUENTIAL_DIRECT);
+      } else {
+        HCTR_HPS_HASH_MAP_CONTAINS_(SEQUENTIAL_DIRECT);
+      }
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (k - keys - 1) / max_batch_size, ": ", hit_count - prev_hit_count,
@@ -183,7 +210,11 @@ size_t MultiProcessHashMapBackend<Key>::contains(
 
         const size_t prev_hit_count{hit_count};
         size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_CONTAINS_(PARALLEL_DIRECT);
+        if constexpr (optimistic) {
+          HCTR_HPS_HASH_MAP_OPTIMISTIC_CONTAINS_(PARALLEL_DIRECT);
+        } else {
+          HCTR_HPS_HASH_MAP_CONTAINS_(PARALLEL_DIRECT);
+        }
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", num_batches, ": ", hit_count - prev_hit_count, " / ", batch_size,
@@ -207,27 +238,72 @@ size_t MultiProcessHashMapBackend<Key>::insert(const std::string& table_name,
                                                const size_t num_pairs, const Key* const keys,
                                                const char* const values, const uint32_t value_size,
                                                const size_t value_stride) {
+  return sm_->open_addressing
+             ? insert_(sm_->open_tables, table_name, num_pairs, keys, values, value_size,
+                       value_stride)
+             : insert_(sm_->tables, table_name, num_pairs, keys, values, value_size, value_stride);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::insert_(SharedTables<Partition>& tables,
+                                                const std::string& table_name,
+                                                const size_t num_pairs, const Key* const keys,
+                                                const char* const values,
+                                                const uint32_t value_size,
+                                                const size_t value_stride) {
+  constexpr bool optimistic{std::is_same_v<Partition, OpenPartition>};
   HCTR_CHECK(value_size <= value_stride);
 
-  const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
+  // In open-addressing mode, partitions are locked individually. Hence, shared access suffices.
+  using Mutex = boost::interprocess::interprocess_sharable_mutex;
+  std::conditional_t<optimistic, boost::interprocess::sharable_lock<Mutex>,
+                     boost::interprocess::scoped_lock<Mutex>>
+      lock(sm_->read_write_guard);
 
   // Locate the partitions, or create them, if they do not exist yet.
-  const auto& tables_it{
-      sm_->tables.try_emplace({table_name.c_str(), char_allocator_}, partition_allocator_).first};
-  SharedVector<Partition>& parts{tables_it->second};
-  if (parts.empty()) {
-    HCTR_CHECK(value_size > 0 && value_size <= this->params_.allocation_rate);
+  const SharedString shared_table_name{table_name.c_str(), char_allocator_};
+  auto tables_it{tables.find(shared_table_name)};
+  while (tables_it == tables.end()) {
+    const auto& create_parts{[&]() {
+      SharedVector<Partition>& parts{
+          tables.try_emplace(shared_table_name, sm_segment_.get_allocator<Partition>())
+              .first->second};
+      if (parts.empty()) {
+        HCTR_CHECK(value_size > 0 && value_size <= this->params_.allocation_rate);
+
+        parts.reserve(this->params_.num_partitions);
+        while (parts.size() < this->params_.num_partitions) {
+          parts.emplace_back(value_size, this->params_, sm_segment_);
+        }
+      }
+    }};
 
-    parts.reserve(this->params_.num_partitions);
-    while (parts.size() < this->params_.num_partitions) {
-      parts.emplace_back(value_size, this->params_, sm_segment_);
+    if constexpr (optimistic) {
+      // Altering the table map requires exclusive access.
+      lock.unlock();
+      {
+        const boost::interprocess::scoped_lock exclusive_lock(sm_->read_write_guard);
+        create_parts();
+      }
+      lock.lock();
+    } else {
+      create_parts();
     }
+    tables_it = tables.find(shared_table_name);
   }
+  SharedVector<Partition>& parts{tables_it->second};
 
   const Key* const keys_end{&keys[num_pairs]};
   const size_t num_partitions{parts.size()};
   const size_t max_batch_size{this->params_.max_batch_size};
 
+  // Statistics gathered by lock-free lookups must be applied before resolving overflows.
+  std::vector<PartitionAccessStats>* table_stats{nullptr};
+  if constexpr (optimistic) {
+    table_stats = &get_access_stats_(table_name, num_partitions);
+  }
+
   size_t num_inserts{0};
 
   if (num_pairs == 0) {
@@ -240,8 +316,13 @@ size_t MultiProcessHashMapBackend<Key>::insert(const std::string& table_name,
 
     // Step through batch-by-batch.
     for (const Key* k{keys}; k != keys_end;) {
+      const SeqLockWriteGuard part_guard(part);
+
       // Check overflow condition.
       if (part.entries.size() >= part.overflow_margin) {
+        if constexpr (optimistic) {
+          merge_access_stats_(part, (*table_stats)[part_index]);
+        }
         resolve_overflow_(table_name, part_index, part);
       }
 
@@ -268,8 +349,13 @@ size_t MultiProcessHashMapBackend<Key>::insert(const std::string& table_name,
       // Step through batch-by-batch.
       size_t num_batches{0};
       for (const Key* k{keys}; k != keys_end; ++num_batches) {
+        const SeqLockWriteGuard part_guard(part);
+
         // Check overflow condition.
         if (part.entries.size() >= part.overflow_margin) {
+          if constexpr (optimistic) {
+            merge_access_stats_(part, (*table_stats)[part_index]);
+          }
           resolve_overflow_(table_name, part_index, part);
         }
 
@@ -302,12 +388,28 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
                                               const size_t value_stride,
                                               const DatabaseMissCallback& on_miss,
                                               const std::chrono::nanoseconds& time_budget) {
+  return sm_->open_addressing ? fetch_(sm_->open_tables, table_name, num_keys, keys, values,
+                                       value_stride, on_miss, time_budget)
+                              : fetch_(sm_->tables, table_name, num_keys, keys, values,
+                                       value_stride, on_miss, time_budget);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::fetch_(SharedTables<Partition>& tables,
+                                               const std::string& table_name,
+                                               const size_t num_keys, const Key* const keys,
+                                               char* const values, const size_t value_stride,
+                                               const DatabaseMissCallback& on_miss,
+                                               const std::chrono::nanoseconds& time_budget) {
+  constexpr bool optimistic{std::is_same_v<Partition, OpenPartition>};
+
   const auto begin{std::chrono::high_resolution_clock::now()};
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return Base::fetch(table_name, num_keys, keys, values, value_stride, on_miss, time_budget);
   }
   SharedVector<Partition>& parts{tables_it->second};
@@ -316,6 +418,12 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
   const size_t num_partitions{parts.size()};
   const size_t max_batch_size{this->params_.max_batch_size};
 
+  // Lock-free lookups record access statistics process-locally.
+  std::vector<PartitionAccessStats>* table_stats{nullptr};
+  if constexpr (optimistic) {
+    table_stats = &get_access_stats_(table_name, num_partitions);
+  }
+
   size_t miss_count{0};
   size_t skip_count{0};
 
@@ -334,13 +442,22 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
 
       const size_t prev_miss_count{miss_count};
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
-      HCTR_HPS_HASH_MAP_FETCH_(SEQUENTIAL_DIRECT);
+      if constexpr (optimistic) {
+        PartitionAccessStats& part_stats{(*table_stats)[part_index]};
+        HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_(SEQUENTIAL_DIRECT);
+      } else {
+        HCTR_HPS_HASH_MAP_FETCH_(SEQUENTIAL_DIRECT);
+      }
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (k - keys - 1) / max_batch_size, ": ",
                  batch_size - miss_count + prev_miss_count, " / ", batch_size,
                  " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
     }
+
+    if constexpr (optimistic) {
+      try_merge_access_stats_(part, (*table_stats)[part_index]);
+    }
   } else {
     std::atomic<size_t> joint_miss_count{0};
     std::atomic<size_t> joint_skip_count{0};
@@ -360,7 +477,12 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
 
         const size_t prev_miss_count{miss_count};
         size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_FETCH_(PARALLEL_DIRECT);
+        if constexpr (optimistic) {
+          PartitionAccessStats& part_stats{(*table_stats)[part_index]};
+          HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_(PARALLEL_DIRECT);
+        } else {
+          HCTR_HPS_HASH_MAP_FETCH_(PARALLEL_DIRECT);
+        }
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", num_batches, ": ", batch_size - miss_count + prev_miss_count, " / ",
@@ -368,6 +490,10 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name, con
                    " ns.\n");
       }
 
+      if constexpr (optimistic) {
+        try_merge_access_stats_(part, (*table_stats)[part_index]);
+      }
+
       joint_miss_count += miss_count;
     });
 
@@ -388,12 +514,27 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
                                               const size_t value_stride,
                                               const DatabaseMissCallback& on_miss,
                                               const std::chrono::nanoseconds& time_budget) {
+  return sm_->open_addressing ? fetch_(sm_->open_tables, table_name, num_indices, indices, keys,
+                                       values, value_stride, on_miss, time_budget)
+                              : fetch_(sm_->tables, table_name, num_indices, indices, keys, values,
+                                       value_stride, on_miss, time_budget);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::fetch_(
+    SharedTables<Partition>& tables, const std::string& table_name, const size_t num_indices,
+    const size_t* const indices, const Key* const keys, char* const values,
+    const size_t value_stride, const DatabaseMissCallback& on_miss,
+    const std::chrono::nanoseconds& time_budget) {
+  constexpr bool optimistic{std::is_same_v<Partition, OpenPartition>};
+
   const auto begin{std::chrono::high_resolution_clock::now()};
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return Base::fetch(table_name, num_indices, indices, keys, values, value_stride, on_miss,
                        time_budget);
   }
@@ -403,13 +544,19 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
   const size_t num_partitions{parts.size()};
   const size_t max_batch_size{this->params_.max_batch_size};
 
+  // Lock-free lookups record access statistics process-locally.
+  std::vector<PartitionAccessStats>* table_stats{nullptr};
+  if constexpr (optimistic) {
+    table_stats = &get_access_stats_(table_name, num_partitions);
+  }
+
   size_t miss_count{0};
   size_t skip_count{0};
 
   if (num_indices == 0) {
     // Do nothing ;-).
   } else if (num_indices == 1 || num_partitions == 1) {
-    const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(*keys)};
+    const size_t part_index{num_partitions == 1 ? 0 : HCTR_HPS_KEY_TO_PART_INDEX_(keys[*indices])};
     Partition& part{parts[part_index]};
     HCTR_CHECK(part.value_size <= value_stride);
     const DatabaseOverflowPolicy_t overflow_policy{part.overflow_policy};
@@ -421,13 +568,22 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
 
       const size_t prev_miss_count{miss_count};
       const size_t batch_size{std::min<size_t>(indices_end - i, max_batch_size)};
-      HCTR_HPS_HASH_MAP_FETCH_(SEQUENTIAL_INDIRECT);
+      if constexpr (optimistic) {
+        PartitionAccessStats& part_stats{(*table_stats)[part_index]};
+        HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_(SEQUENTIAL_INDIRECT);
+      } else {
+        HCTR_HPS_HASH_MAP_FETCH_(SEQUENTIAL_INDIRECT);
+      }
 
       HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                  ", batch ", (i - indices - 1) / max_batch_size, ": ",
                  batch_size - miss_count + prev_miss_count, " / ", batch_size,
                  " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
     }
+
+    if constexpr (optimistic) {
+      try_merge_access_stats_(part, (*table_stats)[part_index]);
+    }
   } else {
     std::atomic<size_t> joint_miss_count{0};
     std::atomic<size_t> joint_skip_count{0};
@@ -447,7 +603,12 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
 
         const size_t prev_miss_count{miss_count};
         size_t batch_size{0};
-        HCTR_HPS_HASH_MAP_FETCH_(PARALLEL_INDIRECT);
+        if constexpr (optimistic) {
+          PartitionAccessStats& part_stats{(*table_stats)[part_index]};
+          HCTR_HPS_HASH_MAP_OPTIMISTIC_FETCH_(PARALLEL_INDIRECT);
+        } else {
+          HCTR_HPS_HASH_MAP_FETCH_(PARALLEL_INDIRECT);
+        }
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", num_batches, ": ", batch_size - miss_count + prev_miss_count, " / ",
@@ -455,6 +616,10 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
                    " ns.\n");
       }
 
+      if constexpr (optimistic) {
+        try_merge_access_stats_(part, (*table_stats)[part_index]);
+      }
+
       joint_miss_count += miss_count;
     });
 
@@ -470,11 +635,19 @@ size_t MultiProcessHashMapBackend<Key>::fetch(const std::string& table_name,
 
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name) {
+  return sm_->open_addressing ? evict_(sm_->open_tables, table_name)
+                              : evict_(sm_->tables, table_name);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::evict_(SharedTables<Partition>& tables,
+                                               const std::string& table_name) {
   const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return 0;
   }
   const SharedVector<Partition>& parts{tables_it->second};
@@ -484,7 +657,11 @@ size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name) {
   for (const Partition& part : parts) {
     num_deletions += part.entries.size();
   }
-  sm_->tables.erase(tables_it);
+  tables.erase(tables_it);
+  {
+    const std::unique_lock stats_lock(access_stats_guard_);
+    access_stats_.erase(table_name);
+  }
 
   HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Erased ", num_deletions,
              " entries.\n");
@@ -494,11 +671,26 @@ size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name) {
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name, const size_t num_keys,
                                               const Key* const keys) {
-  const boost::interprocess::scoped_lock lock(sm_->read_write_guard);
+  return sm_->open_addressing ? evict_(sm_->open_tables, table_name, num_keys, keys)
+                              : evict_(sm_->tables, table_name, num_keys, keys);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::evict_(SharedTables<Partition>& tables,
+                                               const std::string& table_name,
+                                               const size_t num_keys, const Key* const keys) {
+  constexpr bool optimistic{std::is_same_v<Partition, OpenPartition>};
+
+  // In open-addressing mode, partitions are locked individually. Hence, shared access suffices.
+  using Mutex = boost::interprocess::interprocess_sharable_mutex;
+  const std::conditional_t<optimistic, boost::interprocess::sharable_lock<Mutex>,
+                           boost::interprocess::scoped_lock<Mutex>>
+      lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return 0;
   }
   SharedVector<Partition>& parts{tables_it->second};
@@ -517,6 +709,8 @@ size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name, con
 
     // Step through input batch-by-batch.
     for (const Key* k{keys}; k != keys_end;) {
+      const SeqLockWriteGuard part_guard(part);
+
       const size_t prev_num_deletions{num_deletions};
       const size_t batch_size{std::min<size_t>(keys_end - k, max_batch_size)};
       HCTR_HPS_HASH_MAP_EVICT_(SEQUENTIAL_DIRECT);
@@ -536,6 +730,8 @@ size_t MultiProcessHashMapBackend<Key>::evict(const std::string& table_name, con
       // Step through input batch-by-batch.
       size_t num_batches{0};
       for (const Key* k{keys}; k != keys_end; ++num_batches) {
+        const SeqLockWriteGuard part_guard(part);
+
         const size_t prev_num_deletions{num_deletions};
         size_t batch_size{0};
         HCTR_HPS_HASH_MAP_EVICT_(PARALLEL_DIRECT);
@@ -564,37 +760,67 @@ std::vector<std::string> MultiProcessHashMapBackend<Key>::find_tables(
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   std::vector<std::string> matches;
-  for (const auto& pair : sm_->tables) {
+  if (sm_->open_addressing) {
+    find_tables_(sm_->open_tables, tag_prefix, matches);
+  } else {
+    find_tables_(sm_->tables, tag_prefix, matches);
+  }
+  return matches;
+}
+
+template <typename Key>
+template <typename Partition>
+void MultiProcessHashMapBackend<Key>::find_tables_(const SharedTables<Partition>& tables,
+                                                   const std::string& tag_prefix,
+                                                   std::vector<std::string>& matches) const {
+  for (const auto& pair : tables) {
     if (pair.first.find(tag_prefix) == 0) {
       matches.push_back(pair.first);
     }
   }
-  return matches;
 }
 
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::dump_bin(const std::string& table_name,
                                                  std::ofstream& file) {
+  return sm_->open_addressing ? dump_bin_(sm_->open_tables, table_name, file)
+                              : dump_bin_(sm_->tables, table_name, file);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::dump_bin_(SharedTables<Partition>& tables,
+                                                  const std::string& table_name,
+                                                  std::ofstream& file) {
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return 0;
   }
-  const SharedVector<Partition>& parts{tables_it->second};
+  SharedVector<Partition>& parts{tables_it->second};
+
+  // Block writers that only hold a shared lock (open-addressing mode).
+  std::vector<std::unique_lock<boost::interprocess::interprocess_mutex>> part_locks;
+  part_locks.reserve(parts.size());
+  for (Partition& part : parts) {
+    part_locks.emplace_back(part.write_guard);
+  }
 
   // Store value size.
   const uint32_t value_size{parts.empty() ? 0 : parts.front().value_size};
   file.write(reinterpret_cast<const char*>(&value_size), sizeof(uint32_t));
 
-  // Store values.
+  // Store values (decoded, so that dumps do not depend on the storage format).
   size_t num_entries{0};
+  std::vector<char> value(value_size);
 
   for (const Partition& part : parts) {
-    for (const Entry& entry : part.entries) {
+    for (const auto& entry : part.entries) {
       file.write(reinterpret_cast<const char*>(&entry.first), sizeof(Key));
-      file.write(entry.second.value.get(), value_size);
+      part.codec.decode(entry.second.value.get(), value_size, value.data());
+      file.write(value.data(), value_size);
     }
     num_entries += part.entries.size();
   }
@@ -605,37 +831,56 @@ size_t MultiProcessHashMapBackend<Key>::dump_bin(const std::string& table_name,
 template <typename Key>
 size_t MultiProcessHashMapBackend<Key>::dump_sst(const std::string& table_name,
                                                  rocksdb::SstFileWriter& file) {
+  return sm_->open_addressing ? dump_sst_(sm_->open_tables, table_name, file)
+                              : dump_sst_(sm_->tables, table_name, file);
+}
+
+template <typename Key>
+template <typename Partition>
+size_t MultiProcessHashMapBackend<Key>::dump_sst_(SharedTables<Partition>& tables,
+                                                  const std::string& table_name,
+                                                  rocksdb::SstFileWriter& file) {
+  using Entry = typename Partition::Entry;
+
   const boost::interprocess::sharable_lock lock(sm_->read_write_guard);
 
   // Locate the partitions.
-  const auto& tables_it{sm_->tables.find({table_name.c_str(), char_allocator_})};
-  if (tables_it == sm_->tables.end()) {
+  const auto& tables_it{tables.find({table_name.c_str(), char_allocator_})};
+  if (tables_it == tables.end()) {
     return 0;
   }
-  const SharedVector<Partition>& parts{tables_it->second};
+  SharedVector<Partition>& parts{tables_it->second};
+
+  // Block writers that only hold a shared lock (open-addressing mode).
+  std::vector<std::unique_lock<boost::interprocess::interprocess_mutex>> part_locks;
+  part_locks.reserve(parts.size());
+  for (Partition& part : parts) {
+    part_locks.emplace_back(part.write_guard);
+  }
 
   // Sort keys by value.
-  std::vector<const Entry*> entries;
+  std::vector<std::pair<const Entry*, const Partition*>> entries;
   entries.reserve(
       std::accumulate(parts.begin(), parts.end(), UINT64_C(0),
                       [](const size_t a, const Partition& b) { return a + b.entries.size(); }));
   for (const Partition& part : parts) {
     for (const Entry& entry : part.entries) {
-      entries.emplace_back(&entry);
+      entries.emplace_back(&entry, &part);
     }
   }
   // TODO: Copy or ref? Chose ref because low memory footprint, but has worse cache locality.
   // Benchmark?
   std::sort(entries.begin(), entries.end(),
-            [](const auto& a, const auto& b) { return a->first < b->first; });
+            [](const auto& a, const auto& b) { return a.first->first < b.first->first; });
 
-  // Iterate over pairs and insert.
+  // Iterate over pairs and insert (values are decoded).
+  std::vector<char> value(parts.empty() ? 0 : parts.front().value_size);
   rocksdb::Slice k_view{nullptr, sizeof(Key)};
-  rocksdb::Slice v_view{nullptr, parts.empty() ? 0 : parts.front().value_size};
+  rocksdb::Slice v_view{value.data(), value.size()};
 
-  for (const Entry* const entry : entries) {
+  for (const auto& [entry, part] : entries) {
     k_view.data_ = reinterpret_cast<const char*>(&entry->first);
-    v_view.data_ = entry->second.value.get();
+    part->codec.decode(entry->second.value.get(), value.size(), value.data());
     HCTR_ROCKSDB_CHECK(file.Put(k_view, v_view));
   }
 
@@ -643,6 +888,125 @@ size_t MultiProcessHashMapBackend<Key>::dump_sst(const std::string& table_name,
 }
 
 template <typename Key>
+template <typename Partition>
+typename MultiProcessHashMapBackend<Key>::ValuePtr MultiProcessHashMapBackend<Key>::allocate_value_(
+    Partition& part) {
+  // If no free space, allocate another buffer, and fill pointer queue.
+  if (part.value_slots.empty()) {
+    const size_t value_size{part.codec.encoded_size(part.value_size)};
+    const size_t stride{(value_size + value_page_alignment - 1) / value_page_alignment *
+                        value_page_alignment};
+    const size_t num_values{part.allocation_rate / stride};
+    HCTR_CHECK(num_values > 0);
+
+    // Get more memory.
+    part.value_pages.emplace_back(num_values * stride, char_allocator_);
+    ValuePage& value_page{part.value_pages.back()};
+
+    // Stock up slot references.
+    part.value_slots.reserve(part.value_slots.size() + num_values);
+    for (auto it{value_page.end()}; it != value_page.begin();) {
+      it -= stride;
+      part.value_slots.emplace_back(&*it);
+    }
+  }
+
+  // Fetch storage slot.
+  const ValuePtr value{part.value_slots.back()};
+  part.value_slots.pop_back();
+  return value;
+}
+
+template <typename Key>
+template <typename Partition>
+void MultiProcessHashMapBackend<Key>::release_value_(Partition& part, const ValuePtr& value) {
+  // Stash pointer for reuse.
+  part.value_slots.emplace_back(value);
+}
+
+template <typename Key>
+auto MultiProcessHashMapBackend<Key>::get_access_stats_(const std::string& table_name,
+                                                        const size_t num_partitions)
+    -> std::vector<PartitionAccessStats>& {
+  {
+    const std::shared_lock lock(access_stats_guard_);
+    const auto& it{access_stats_.find(table_name)};
+    if (it != access_stats_.end() && it->second.size() == num_partitions) {
+      return it->second;
+    }
+  }
+
+  const std::unique_lock lock(access_stats_guard_);
+  std::vector<PartitionAccessStats>& table_stats{access_stats_[table_name]};
+  if (table_stats.size() != num_partitions) {
+    // Another process might have recreated the table with a different number of partitions.
+    std::vector<PartitionAccessStats>(num_partitions).swap(table_stats);
+  }
+  return table_stats;
+}
+
+template <typename Key>
+void MultiProcessHashMapBackend<Key>::merge_access_stats_(OpenPartition& part,
+                                                          PartitionAccessStats& part_stats) const {
+  const DatabaseOverflowPolicy_t overflow_policy{part.overflow_policy};
+
+  for (AccessStats& stats : part_stats) {
+    // Readers may hold the lock. Statistics of shards that are currently busy will be merged next
+    // time.
+    const std::unique_lock stats_lock(stats.guard, std::try_to_lock);
+    if (!stats_lock.owns_lock()) {
+      continue;
+    }
+
+    for (const auto& [key, value] : stats.values) {
+      const auto& it{part.entries.find(key)};
+      if (it == part.entries.end()) {
+        continue;
+      }
+
+      Payload& payload{it->second};
+      switch (overflow_policy) {
+        case DatabaseOverflowPolicy_t::EvictRandom:
+          break;
+        case DatabaseOverflowPolicy_t::EvictLeastUsed:
+          payload.access_count += value;
+          break;
+        case DatabaseOverflowPolicy_t::EvictOldest:
+          payload.last_access = std::max(payload.last_access, value);
+          break;
+      }
+    }
+    stats.values.clear();
+  }
+}
+
+template <typename Key>
+void MultiProcessHashMapBackend<Key>::try_merge_access_stats_(
+    OpenPartition& part, PartitionAccessStats& part_stats) const {
+  if (part.overflow_policy == DatabaseOverflowPolicy_t::EvictRandom) {
+    return;
+  }
+
+  // Processes that never insert would otherwise never apply their statistics.
+  {
+    AccessStats& stats{part_stats[ShardedSharedMutex::this_thread_shard()]};
+    const std::unique_lock stats_lock(stats.guard, std::try_to_lock);
+    if (!stats_lock.owns_lock() || stats.values.size() < AccessStats::max_size / 2) {
+      return;
+    }
+  }
+
+  // Only statistics are updated, which lock-free readers never look at. Hence, the partition
+  // version remains unchanged.
+  const boost::interprocess::scoped_lock part_lock(part.write_guard,
+                                                   boost::interprocess::try_to_lock);
+  if (part_lock.owns()) {
+    merge_access_stats_(part, part_stats);
+  }
+}
+
+template <typename Key>
+template <typename Partition>
 size_t MultiProcessHashMapBackend<Key>::resolve_overflow_(const std::string& table_name,
                                                           const size_t part_index,
                                                           Partition& part) {
@@ -737,8 +1101,8 @@ size_t MultiProcessHashMapBackend<Key>::resolve_overflow_(const std::string& tab
     } break;
 
     case DatabaseOverflowPolicy_t::EvictOldest: {
-      // Fetch keys and insert times.
-      std::vector<std::pair<Key, time_t>> keys_metas;
+      // Fetch keys and recency stamps.
+      std::vector<std::pair<Key, uint64_t>> keys_metas;
       keys_metas.reserve(part.entries.size());
       for (const auto& entry : part.entries) {
         keys_metas.emplace_back(entry.first, entry.second.last_access);
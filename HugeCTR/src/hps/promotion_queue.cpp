@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <core23/logger.hpp>
+#include <hps/promotion_queue.hpp>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+std::ostream& operator<<(std::ostream& os, const PromotionQueueStats& stats) {
+  return os << "submitted = " << stats.num_submitted << ", duplicates = " << stats.num_duplicates
+            << ", dropped = " << stats.num_dropped << ", promoted = " << stats.num_promoted
+            << ", batches = " << stats.num_batches << ", queue depth = " << stats.queue_depth
+            << ", promotion rate = " << stats.promotion_rate << " keys/s";
+}
+
+template <typename Key>
+PromotionQueue<Key>::PromotionQueue(DatabaseBackendBase<Key>* const db,
+                                    const size_t max_batch_size, const size_t max_queue_size,
+                                    const std::chrono::microseconds max_delay)
+    : db_{db},
+      max_batch_size_{max_batch_size},
+      max_queue_size_{std::max(max_queue_size, max_batch_size)},
+      max_delay_{max_delay},
+      last_insert_time_{std::chrono::steady_clock::now()} {
+  HCTR_CHECK(db_);
+  HCTR_CHECK(max_batch_size_ > 0);
+  inserter_ = std::thread(&PromotionQueue::run_, this);
+}
+
+template <typename Key>
+PromotionQueue<Key>::~PromotionQueue() {
+  {
+    std::lock_guard<std::mutex> lock(barrier_);
+    terminate_ = true;
+  }
+  ready_semaphore_.notify_one();
+  inserter_.join();
+}
+
+template <typename Key>
+size_t PromotionQueue<Key>::submit(const std::string& table_name, const size_t num_indices,
+                                   const size_t* const indices, const Key* const keys,
+                                   const char* const values, const size_t value_size) {
+  size_t num_queued{0};
+  bool batch_full;
+  {
+    std::lock_guard<std::mutex> lock(barrier_);
+    stats_.num_submitted += num_indices;
+
+    Table& table{queued_[table_name]};
+    if (table.keys.empty()) {
+      table.value_size = value_size;
+    } else {
+      HCTR_CHECK_HINT(table.value_size == value_size, "Value size mismatch for table '",
+                      table_name, "' (", table.value_size, " <> ", value_size, " bytes)!");
+    }
+
+    // Keys of the batch that is currently being inserted count as duplicates as well. Only the
+    // background thread modifies `inserting_`, and only while holding the lock.
+    const auto inserting_it{inserting_.find(table_name)};
+    const std::unordered_set<Key>* const inserting_keys{
+        inserting_it != inserting_.end() ? &inserting_it->second.queued_keys : nullptr};
+
+    for (const size_t* it{indices}; it != &indices[num_indices]; ++it) {
+      if (stats_.queue_depth >= max_queue_size_) {
+        stats_.num_dropped += static_cast<size_t>(&indices[num_indices] - it);
+        break;
+      }
+
+      const Key& key{keys[*it]};
+      const bool inserting{inserting_keys && inserting_keys->count(key)};
+      if (inserting || !table.queued_keys.emplace(key).second) {
+        ++stats_.num_duplicates;
+        continue;
+      }
+      table.keys.emplace_back(key);
+      const char* const value{&values[*it * value_size]};
+      table.values.insert(table.values.end(), value, &value[value_size]);
+      ++stats_.queue_depth;
+      ++num_queued;
+    }
+
+    batch_full = stats_.queue_depth >= max_batch_size_;
+  }
+  if (batch_full) {
+    ready_semaphore_.notify_one();
+  }
+
+  return num_queued;
+}
+
+template <typename Key>
+void PromotionQueue<Key>::flush() {
+  std::unique_lock<std::mutex> lock(barrier_);
+  ++num_flushing_;
+  ready_semaphore_.notify_one();
+  idle_semaphore_.wait(lock, [&]() { return !stats_.queue_depth && !busy_; });
+  --num_flushing_;
+}
+
+template <typename Key>
+PromotionQueueStats PromotionQueue<Key>::stats() const {
+  std::lock_guard<std::mutex> lock(barrier_);
+  return stats_;
+}
+
+template <typename Key>
+void PromotionQueue<Key>::run_() {
+  hctr_set_thread_name("promotion queue");
+
+  std::unique_lock<std::mutex> lock(barrier_);
+  while (true) {
+    // Wait for a batch to fill up, or for the oldest keys to time out.
+    ready_semaphore_.wait_for(lock, max_delay_, [&]() {
+      return terminate_ || (stats_.queue_depth && num_flushing_) ||
+             stats_.queue_depth >= max_batch_size_;
+    });
+    if (!stats_.queue_depth) {
+      if (terminate_) {
+        break;
+      }
+      continue;
+    }
+
+    queued_.swap(inserting_);
+    const size_t num_keys{stats_.queue_depth};
+    stats_.queue_depth = 0;
+    busy_ = true;
+
+    // Insert without holding the lock, so that new keys can be queued in the meantime.
+    lock.unlock();
+    size_t num_batches{0};
+    for (const auto& [table_name, table] : inserting_) {
+      if (table.keys.empty()) {
+        continue;
+      }
+      try {
+        db_->insert(table_name, table.keys.size(), table.keys.data(), table.values.data(),
+                    static_cast<uint32_t>(table.value_size), table.value_size);
+      } catch (const std::exception& error) {
+        HCTR_LOG_S(ERROR, WORLD) << "Unable to promote " << table.keys.size()
+                                 << " embeddings to " << db_->get_name() << ", table '"
+                                 << table_name << "'. Error: " << error.what() << std::endl;
+      }
+      ++num_batches;
+    }
+    lock.lock();
+
+    for (auto& [table_name, table] : inserting_) {
+      table.queued_keys.clear();
+      table.keys.clear();
+      table.values.clear();
+    }
+    busy_ = false;
+
+    // Exponentially smoothed promotion rate.
+    const auto now{std::chrono::steady_clock::now()};
+    const double elapsed{std::chrono::duration<double>(now - last_insert_time_).count()};
+    last_insert_time_ = now;
+    if (elapsed > 0) {
+      stats_.promotion_rate =
+          0.75 * stats_.promotion_rate + 0.25 * static_cast<double>(num_keys) / elapsed;
+    }
+    stats_.num_promoted += num_keys;
+    stats_.num_batches += num_batches;
+
+    HCTR_LOG_S(TRACE, WORLD) << "Promoted " << num_keys << " embeddings to " << db_->get_name()
+                             << " (" << stats_ << ")." << std::endl;
+    idle_semaphore_.notify_all();
+  }
+}
+
+template class PromotionQueue<unsigned int>;
+template class PromotionQueue<long long>;
+
+}  // namespace HugeCTR
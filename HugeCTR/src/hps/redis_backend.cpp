@@ -50,6 +50,12 @@ inline std::string make_hkey(const std::string& table_name, const size_t part, c
 #define HCTR_DEFINE_REDIS_META_HKEY_() \
   const std::string& hkey_m { make_hkey(table_name, part_index, 't') }
 
+#ifdef HCTR_DEFINE_REDIS_VERSION_HKEY_
+#error HCTR_DEFINE_REDIS_VERSION_HKEY_ should not be defined!
+#endif
+#define HCTR_DEFINE_REDIS_VERSION_HKEY_() \
+  const std::string& hkey_r { make_hkey(table_name, part_index, 'r') }
+
 #define HCTR_RETHROW_REDIS_ERRORS_(...)                             \
   do {                                                              \
     try {                                                           \
@@ -116,6 +122,15 @@ RedisClusterBackend<Key>::RedisClusterBackend(const RedisClusterBackendParams& p
   HCTR_LOG_C(INFO, WORLD, get_name(), ": Connecting via ", options.host, ':', options.port,
              "...\n");
   redis_ = std::make_unique<sw::redis::RedisCluster>(options, pool_options);
+
+  // Create near cache.
+  if (params.near_cache_size > 0) {
+    HCTR_LOG_C(INFO, WORLD, get_name(), ": Enabling near cache (size = ", params.near_cache_size,
+               " bytes, max staleness = ", params.near_cache_max_staleness_ms, " ms).\n");
+    near_cache_ = std::make_unique<RedisNearCache<Key>>(
+        params.near_cache_size, params.num_partitions,
+        std::chrono::milliseconds(params.near_cache_max_staleness_ms));
+  }
 }
 
 template <typename Key>
@@ -244,6 +259,7 @@ size_t RedisClusterBackend<Key>::insert(const std::string& table_name, const siz
     HCTR_RETHROW_REDIS_ERRORS_({
       HCTR_DEFINE_REDIS_VALUE_HKEY_();
       HCTR_DEFINE_REDIS_META_HKEY_();
+      HCTR_DEFINE_REDIS_VERSION_HKEY_();
 
       std::vector<std::pair<sw::redis::StringView, sw::redis::StringView>> kv_views;
       std::vector<std::pair<sw::redis::StringView, sw::redis::StringView>> km_views;
@@ -257,6 +273,7 @@ size_t RedisClusterBackend<Key>::insert(const std::string& table_name, const siz
         if (!HCTR_HPS_REDIS_INSERT_(SEQUENTIAL_DIRECT)) {
           break;
         }
+        invalidate_near_cache_(table_name, part_index);
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", (k - keys - 1) / max_batch_size, ": Inserted ",
@@ -275,6 +292,7 @@ size_t RedisClusterBackend<Key>::insert(const std::string& table_name, const siz
     HCTR_HPS_DB_PARALLEL_FOR_EACH_PART_({
       HCTR_DEFINE_REDIS_VALUE_HKEY_();
       HCTR_DEFINE_REDIS_META_HKEY_();
+      HCTR_DEFINE_REDIS_VERSION_HKEY_();
 
       size_t num_inserts{0};
 
@@ -292,6 +310,7 @@ size_t RedisClusterBackend<Key>::insert(const std::string& table_name, const siz
           if (!HCTR_HPS_REDIS_INSERT_(PARALLEL_DIRECT)) {
             break;
           }
+          invalidate_near_cache_(table_name, part_index);
 
           HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                      ", batch ", num_batches, ": Inserted ", num_inserts - prev_num_inserts,
@@ -331,6 +350,8 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
   size_t miss_count{0};
   size_t skip_count{0};
 
+  const uint32_t near_cache_table_id{near_cache_ ? near_cache_->table_id(table_name) : 0};
+
   if (num_keys == 0) {
     // Do nothing ;-).
   } else if (num_keys == 1 || num_partitions == 1) {
@@ -342,6 +363,7 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
       std::shared_ptr<std::vector<Key>> touched_keys;
       HCTR_HPS_REDIS_FETCH_DEFINE_V_VIEWS();
       std::vector<sw::redis::StringView> k_views;
+      std::vector<sw::redis::StringView> hit_views;
       k_views.reserve(std::min(num_keys, max_batch_size));
 
       // Step through input batch-by-batch.
@@ -379,6 +401,7 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
         std::shared_ptr<std::vector<Key>> touched_keys;
         HCTR_HPS_REDIS_FETCH_DEFINE_V_VIEWS();
         std::vector<sw::redis::StringView> k_views;
+        std::vector<sw::redis::StringView> hit_views;
         k_views.reserve(std::min(num_keys / num_partitions, max_batch_size));
 
         // Step through input batch-by-batch.
@@ -433,6 +456,8 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
   size_t miss_count{0};
   size_t skip_count{0};
 
+  const uint32_t near_cache_table_id{near_cache_ ? near_cache_->table_id(table_name) : 0};
+
   if (num_indices == 0) {
     // Do nothing ;-).
   } else if (num_indices == 1 || num_partitions == 1) {
@@ -444,6 +469,7 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
       std::shared_ptr<std::vector<Key>> touched_keys;
       HCTR_HPS_REDIS_FETCH_DEFINE_V_VIEWS();
       std::vector<sw::redis::StringView> k_views;
+      std::vector<sw::redis::StringView> hit_views;
       k_views.reserve(std::min(num_indices, max_batch_size));
 
       // Step through input batch-by-batch.
@@ -481,6 +507,7 @@ size_t RedisClusterBackend<Key>::fetch(const std::string& table_name, const size
         std::shared_ptr<std::vector<Key>> touched_keys;
         HCTR_HPS_REDIS_FETCH_DEFINE_V_VIEWS();
         std::vector<sw::redis::StringView> k_views;
+        std::vector<sw::redis::StringView> hit_views;
         k_views.reserve(std::min(num_indices / num_partitions, max_batch_size));
 
         // Step through input batch-by-batch.
@@ -526,14 +553,17 @@ size_t RedisClusterBackend<Key>::evict(const std::string& table_name) {
   const auto evict_part = [&](const size_t part_index) -> size_t {
     HCTR_DEFINE_REDIS_VALUE_HKEY_();
     HCTR_DEFINE_REDIS_META_HKEY_();
+    HCTR_DEFINE_REDIS_VERSION_HKEY_();
 
     HCTR_RETHROW_REDIS_ERRORS_({
       sw::redis::Pipeline pipe{redis_->pipeline(hkey_v, false)};
       pipe.hlen(hkey_v);
       pipe.del(hkey_v);
       pipe.del(hkey_m);
+      pipe.incr(hkey_r);
 
       sw::redis::QueuedReplies replies{pipe.exec()};
+      invalidate_near_cache_(table_name, part_index);
       return replies.get<long long>(0);
     });
   };
@@ -580,6 +610,7 @@ size_t RedisClusterBackend<Key>::evict(const std::string& table_name, const size
     HCTR_RETHROW_REDIS_ERRORS_({
       HCTR_DEFINE_REDIS_VALUE_HKEY_();
       HCTR_DEFINE_REDIS_META_HKEY_();
+      HCTR_DEFINE_REDIS_VERSION_HKEY_();
 
       std::vector<sw::redis::StringView> k_views;
       k_views.reserve(std::min(num_keys, max_batch_size));
@@ -590,6 +621,7 @@ size_t RedisClusterBackend<Key>::evict(const std::string& table_name, const size
         if (!HCTR_HPS_REDIS_EVICT_(SEQUENTIAL_DIRECT)) {
           break;
         }
+        invalidate_near_cache_(table_name, part_index);
 
         HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                    ", batch ", (k - keys - 1) / max_batch_size, ": Erased ",
@@ -605,6 +637,7 @@ size_t RedisClusterBackend<Key>::evict(const std::string& table_name, const size
       HCTR_RETHROW_REDIS_ERRORS_({
         HCTR_DEFINE_REDIS_VALUE_HKEY_();
         HCTR_DEFINE_REDIS_META_HKEY_();
+        HCTR_DEFINE_REDIS_VERSION_HKEY_();
 
         std::vector<sw::redis::StringView> k_views;
         k_views.reserve(std::min(num_keys / num_partitions, max_batch_size));
@@ -616,6 +649,7 @@ size_t RedisClusterBackend<Key>::evict(const std::string& table_name, const size
           if (!HCTR_HPS_REDIS_EVICT_(PARALLEL_DIRECT)) {
             break;
           }
+          invalidate_near_cache_(table_name, part_index);
 
           HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, '/', part_index,
                      ", batch ", num_batches, ": Erased ", num_deletions - prev_num_deletions,
@@ -654,6 +688,10 @@ std::vector<std::string> RedisClusterBackend<Key>::find_tables(const std::string
     if (part_name.find("hps_et{") != 0) {
       continue;
     }
+    // Version counters outlive evicted tables.
+    if (part_name.back() == 'r') {
+      continue;
+    }
 
     size_t end = part_name.find_last_of('/');
     if (end == 0 || end == std::string::npos) {
@@ -794,15 +832,18 @@ void RedisClusterBackend<Key>::resolve_overflow_(const std::string& table_name,
 
   HCTR_DEFINE_REDIS_VALUE_HKEY_();
   HCTR_DEFINE_REDIS_META_HKEY_();
+  HCTR_DEFINE_REDIS_VERSION_HKEY_();
 
   const auto delete_batch = [&](const std::vector<sw::redis::StringView>& k_views) {
     sw::redis::Pipeline pipe{redis_->pipeline(hkey_m, false)};
     pipe.hdel(hkey_m, k_views.begin(), k_views.end());
     pipe.hdel(hkey_v, k_views.begin(), k_views.end());
     pipe.hlen(hkey_v);
+    pipe.incr(hkey_r);
 
     sw::redis::QueuedReplies replies{pipe.exec()};
-    part_size = std::max(replies.get<long long>(replies.size() - 1), 0LL);
+    part_size = std::max(replies.get<long long>(replies.size() - 2), 0LL);
+    invalidate_near_cache_(table_name, part_index);
   };
 
   switch (this->params_.overflow_policy) {
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <core23/logger.hpp>
+#include <hps/redis_near_cache.hpp>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+template <typename Key>
+RedisNearCache<Key>::RedisNearCache(const size_t capacity, const size_t num_partitions,
+                                    const std::chrono::nanoseconds max_staleness)
+    : capacity_{capacity / std::max<size_t>(num_partitions, 1)},
+      max_staleness_{max_staleness},
+      shards_(std::max<size_t>(num_partitions, 1)) {}
+
+template <typename Key>
+uint32_t RedisNearCache<Key>::table_id(const std::string& table_name) {
+  {
+    const std::shared_lock lock(table_ids_guard_);
+    const auto& it{table_ids_.find(table_name)};
+    if (it != table_ids_.end()) {
+      return it->second;
+    }
+  }
+
+  const std::unique_lock lock(table_ids_guard_);
+  const uint32_t next_id{static_cast<uint32_t>(table_ids_.size())};
+  return table_ids_.try_emplace(table_name, next_id).first->second;
+}
+
+template <typename Key>
+typename RedisNearCache<Key>::Snapshot RedisNearCache<Key>::snapshot(
+    const uint32_t table_id, const size_t part_index) const {
+  const Shard& shard{shards_[part_index]};
+  const std::lock_guard lock(shard.barrier);
+
+  const auto& it{shard.partitions.find(table_id)};
+  if (it == shard.partitions.end()) {
+    return {-1, 0, false};
+  }
+  const Partition& part{it->second};
+  return {part.version, part.generation,
+          part.version >= 0 && std::chrono::steady_clock::now() - part.verified < max_staleness_};
+}
+
+template <typename Key>
+size_t RedisNearCache<Key>::find(const uint32_t table_id, const size_t part_index,
+                                 const uint64_t generation, const Key& key, char* const value,
+                                 const size_t value_stride) {
+  Shard& shard{shards_[part_index]};
+  const std::lock_guard lock(shard.barrier);
+
+  const auto& it{shard.index.find({table_id, key})};
+  if (it == shard.index.end()) {
+    return 0;
+  }
+  Entry& entry{shard.entries[it->second]};
+  if (entry.generation != generation) {
+    return 0;
+  }
+
+  HCTR_CHECK(entry.value.size() <= value_stride);
+  std::copy(entry.value.begin(), entry.value.end(), value);
+  entry.referenced = true;
+  return entry.value.size();
+}
+
+template <typename Key>
+uint64_t RedisNearCache<Key>::update(const uint32_t table_id, const size_t part_index,
+                                     const long long version) {
+  Shard& shard{shards_[part_index]};
+  const std::lock_guard lock(shard.barrier);
+
+  Partition& part{shard.partitions[table_id]};
+  if (part.version != version) {
+    part.version = version;
+    ++part.generation;
+  }
+  part.verified = std::chrono::steady_clock::now();
+  return part.generation;
+}
+
+template <typename Key>
+void RedisNearCache<Key>::insert(const uint32_t table_id, const size_t part_index,
+                                 const uint64_t generation, const Key& key,
+                                 const char* const value, const size_t value_size) {
+  if (value_size > capacity_) {
+    return;
+  }
+
+  Shard& shard{shards_[part_index]};
+  const std::lock_guard lock(shard.barrier);
+
+  const auto& part_it{shard.partitions.find(table_id)};
+  if (part_it == shard.partitions.end() || part_it->second.generation != generation) {
+    return;
+  }
+
+  // Overwrite existing entry.
+  const EntryKey entry_key{table_id, key};
+  const auto& it{shard.index.find(entry_key)};
+  if (it != shard.index.end()) {
+    Entry& entry{shard.entries[it->second]};
+    shard.size -= entry.value.size();
+    entry.generation = generation;
+    entry.value.assign(value, &value[value_size]);
+    shard.size += value_size;
+  } else {
+    while (shard.size + value_size > capacity_) {
+      shard.evict_one();
+    }
+
+    size_t entry_index;
+    if (shard.free_entries.empty()) {
+      entry_index = shard.entries.size();
+      shard.entries.emplace_back();
+    } else {
+      entry_index = shard.free_entries.back();
+      shard.free_entries.pop_back();
+    }
+
+    Entry& entry{shard.entries[entry_index]};
+    entry.key = entry_key;
+    entry.generation = generation;
+    entry.used = true;
+    entry.referenced = false;
+    entry.value.assign(value, &value[value_size]);
+    shard.index.emplace(entry_key, entry_index);
+    shard.size += value_size;
+  }
+}
+
+template <typename Key>
+void RedisNearCache<Key>::invalidate(const uint32_t table_id, const size_t part_index) {
+  Shard& shard{shards_[part_index]};
+  const std::lock_guard lock(shard.barrier);
+
+  Partition& part{shard.partitions[table_id]};
+  part.version = -1;
+  ++part.generation;
+}
+
+template <typename Key>
+size_t RedisNearCache<Key>::size() const {
+  size_t size{0};
+  for (const Shard& shard : shards_) {
+    const std::lock_guard lock(shard.barrier);
+    size += shard.size;
+  }
+  return size;
+}
+
+template <typename Key>
+void RedisNearCache<Key>::Shard::erase(const size_t entry_index) {
+  Entry& entry{entries[entry_index]};
+  index.erase(entry.key);
+  size -= entry.value.size();
+
+  entry.used = false;
+  entry.value.clear();
+  entry.value.shrink_to_fit();
+  free_entries.emplace_back(entry_index);
+}
+
+template <typename Key>
+void RedisNearCache<Key>::Shard::evict_one() {
+  // Terminates within two rounds, because the first round clears all reference bits.
+  for (;;) {
+    if (hand >= entries.size()) {
+      hand = 0;
+    }
+    const size_t entry_index{hand++};
+
+    Entry& entry{entries[entry_index]};
+    if (!entry.used) {
+      continue;
+    }
+
+    // Entries of outdated generations are evicted right away.
+    const auto& part_it{partitions.find(entry.key.first)};
+    const bool outdated{part_it == partitions.end() ||
+                        part_it->second.generation != entry.generation};
+    if (entry.referenced && !outdated) {
+      entry.referenced = false;
+      continue;
+    }
+
+    erase(entry_index);
+    return;
+  }
+}
+
+template class RedisNearCache<unsigned int>;
+template class RedisNearCache<long long>;
+
+}  // namespace HugeCTR
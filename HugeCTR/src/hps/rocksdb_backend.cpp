@@ -14,19 +14,44 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <core23/logger.hpp>
+#include <execution>
 #include <hps/hier_parameter_server_base.hpp>
 #include <hps/rocksdb_backend.hpp>
 #include <hps/rocksdb_backend_detail.hpp>
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/table.h>
+#include <thread_pool.hpp>
+#include <type_traits>
 
 // TODO: Remove me!
 #pragma GCC diagnostic error "-Wconversion"
 
 namespace HugeCTR {
 
+namespace {
+
+/**
+ * RocksDB compares keys bytewise, and keys are stored in host byte order (little-endian). Hence,
+ * their order in the database is the same as the numeric order of the byte-swapped keys.
+ */
+template <typename Key>
+inline std::make_unsigned_t<Key> rocksdb_key_order(const Key key) {
+  static_assert(sizeof(Key) == sizeof(uint32_t) || sizeof(Key) == sizeof(uint64_t));
+  if constexpr (sizeof(Key) == sizeof(uint32_t)) {
+    return __builtin_bswap32(static_cast<uint32_t>(key));
+  } else {
+    return __builtin_bswap64(static_cast<uint64_t>(key));
+  }
+}
+
+}  // namespace
+
 template <typename Key>
 RocksDBBackend<Key>::RocksDBBackend(const RocksDBBackendParams& params)
-    : Base(params), db_{nullptr} {
+    : Base(params), db_{nullptr}, codec_{params.value_codec} {
   HCTR_LOG(INFO, WORLD, "Connecting to RocksDB database...\n");
 
   // Basic behavior.
@@ -37,10 +62,40 @@ RocksDBBackend<Key>::RocksDBBackend(const RocksDBBackendParams& params)
   options.OptimizeLevelStyleCompaction();
   HCTR_CHECK(this->params_.num_threads <= std::numeric_limits<int>::max());
   options.IncreaseParallelism(static_cast<int>(this->params_.num_threads));
+  options.use_direct_reads = this->params_.use_direct_reads;
 
   // Configure various behaviors and options used in later operations.
   column_family_options_.OptimizeForPointLookup(8);
   column_family_options_.OptimizeLevelStyleCompaction();
+  {
+    // Same as `OptimizeForPointLookup`, but all tables share one block cache of configurable size.
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.data_block_index_type =
+        rocksdb::BlockBasedTableOptions::kDataBlockBinaryAndHash;
+    table_options.data_block_hash_table_util_ratio = 0.75;
+    if (this->params_.block_cache_size) {
+      table_options.block_cache = rocksdb::NewLRUCache(this->params_.block_cache_size);
+    } else {
+      table_options.no_block_cache = true;
+    }
+    if (this->params_.bloom_filter_bits_per_key > 0) {
+      table_options.filter_policy.reset(
+          rocksdb::NewBloomFilterPolicy(this->params_.bloom_filter_bits_per_key, false));
+    }
+    if (this->params_.partitioned_filters) {
+      // Only the top-level index and filter blocks are pinned. Partitions are paged in as needed.
+      HCTR_CHECK_HINT(this->params_.block_cache_size > 0,
+                      "Partitioned filters require a block cache!");
+      table_options.index_type = rocksdb::BlockBasedTableOptions::kTwoLevelIndexSearch;
+      table_options.partition_filters = true;
+      table_options.cache_index_and_filter_blocks = true;
+      table_options.cache_index_and_filter_blocks_with_high_priority = true;
+      table_options.pin_top_level_index_and_filter = true;
+      table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+    }
+    column_family_options_.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+    options.table_factory = column_family_options_.table_factory;
+  }
   // Need to tune: read_options_.readahead_size
   // Need to tune: read_options_.verify_checksums
   write_options_.sync = false;
@@ -83,6 +138,11 @@ RocksDBBackend<Key>::RocksDBBackend(const RocksDBBackendParams& params)
   db_.reset(db);
   HCTR_CHECK(column_handles.size() == column_descriptors.size());
 
+  // Left behind by interrupted bulk inserts.
+  if (!this->params_.read_only) {
+    std::filesystem::remove_all(std::filesystem::path{this->params_.path} / ".bulk_insert");
+  }
+
   auto column_handles_it = column_handles.begin();
   for (const auto& column_descriptor : column_descriptors) {
     column_handles_.emplace(column_descriptor.name, *column_handles_it);
@@ -135,54 +195,65 @@ size_t RocksDBBackend<Key>::contains(const std::string& table_name, const size_t
     return Base::contains(table_name, num_keys, keys, time_budget);
   }
 
-  size_t hit_count{0};
-  size_t skip_count{0};
-
-  std::vector<rocksdb::ColumnFamilyHandle*> col_handles;
-  std::vector<std::string> v_views;
-  std::vector<rocksdb::Slice> k_views;
-  k_views.reserve(std::min(num_keys, this->params_.max_batch_size));
-
-  // Step through keys batch-by-batch.
-  std::chrono::nanoseconds elapsed;
-  const Key* const keys_end{&keys[num_keys]};
-  for (const Key* k{keys}; k != keys_end;) {
-    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, nullptr);
-
-    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
-
-    const size_t prev_hit_count{hit_count};
-    if (![&]() {
-          k_views.clear();
-          HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT,
-                             k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key)));
-          col_handles.resize(k_views.size(), ch);
-
-          v_views.clear();
-          v_views.reserve(col_handles.size());
-          const std::vector<rocksdb::Status>& statuses{
-              db_->MultiGet(read_options_, col_handles, k_views, &v_views)};
-
-          for (size_t idx{0}; idx < batch_size; ++idx) {
-            const rocksdb::Status& s{statuses[idx]};
-            if (s.ok()) {
-              ++hit_count;
-            } else if (!s.IsNotFound()) {
-              HCTR_ROCKSDB_CHECK(s);
+  std::atomic<size_t> joint_hit_count{0};
+  std::atomic<size_t> joint_skip_count{0};
+
+  for_each_lookup_range_(num_keys, [&](const size_t first, const size_t last) {
+    size_t hit_count{0};
+    size_t skip_count{0};
+
+    std::vector<rocksdb::ColumnFamilyHandle*> col_handles;
+    std::vector<std::string> v_views;
+    std::vector<rocksdb::Slice> k_views;
+    k_views.reserve(std::min(last - first, this->params_.max_batch_size));
+
+    // Step through keys batch-by-batch.
+    std::chrono::nanoseconds elapsed;
+    const Key* const keys_end{&keys[last]};
+    for (const Key* k{&keys[first]}; k != keys_end;) {
+      HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, nullptr);
+
+      const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+
+      const size_t prev_hit_count{hit_count};
+      if (![&]() {
+            k_views.clear();
+            HCTR_HPS_DB_APPLY_(
+                SEQUENTIAL_DIRECT,
+                k_views.emplace_back(reinterpret_cast<const char*>(k), sizeof(Key)));
+            col_handles.resize(k_views.size(), ch);
+
+            v_views.clear();
+            v_views.reserve(col_handles.size());
+            const std::vector<rocksdb::Status>& statuses{
+                db_->MultiGet(read_options_, col_handles, k_views, &v_views)};
+
+            for (size_t idx{0}; idx < batch_size; ++idx) {
+              const rocksdb::Status& s{statuses[idx]};
+              if (s.ok()) {
+                ++hit_count;
+              } else if (!s.IsNotFound()) {
+                HCTR_ROCKSDB_CHECK(s);
+              }
             }
-          }
 
-          return true;
-        }()) {
-      break;
+            return true;
+          }()) {
+        break;
+      }
+
+      HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+                 (k - keys - 1) / this->params_.max_batch_size, ": ", hit_count - prev_hit_count,
+                 " / ", batch_size, " hits. Time: ", elapsed.count(), " / ", time_budget.count(),
+                 " ns.\n");
     }
 
-    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
-               (k - keys - 1) / this->params_.max_batch_size, ": ", hit_count - prev_hit_count,
-               " / ", batch_size, " hits. Time: ", elapsed.count(), " / ", time_budget.count(),
-               " ns.\n");
-  }
+    joint_hit_count += hit_count;
+    joint_skip_count += skip_count;
+  });
 
+  const size_t hit_count{joint_hit_count};
+  const size_t skip_count{joint_skip_count};
   HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
              num_keys - skip_count, " hits, ", skip_count, " skipped.\n");
   return hit_count;
@@ -200,6 +271,18 @@ size_t RocksDBBackend<Key>::insert(const std::string& table_name, const size_t n
 
   rocksdb::WriteBatch batch;
 
+  // Values are encoded one by one (`Put` copies them).
+  const size_t encoded_size{codec_.encoded_size(value_size)};
+  std::vector<char> encoded(encoded_size);
+  const auto encode{[&](const Key* const k) -> rocksdb::Slice {
+    const char* const value{&values[(k - keys) * value_stride]};
+    if (codec_.type() == DatabaseValueCodec_t::Float32) {
+      return {value, value_size};
+    }
+    codec_.encode(value, value_size, encoded.data());
+    return {encoded.data(), encoded_size};
+  }};
+
   const Key* const keys_end = &keys[num_pairs];
   for (const Key* k{keys}; k != keys_end;) {
     const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
@@ -208,8 +291,8 @@ size_t RocksDBBackend<Key>::insert(const std::string& table_name, const size_t n
           batch.Clear();
           HCTR_HPS_DB_APPLY_(
               SEQUENTIAL_DIRECT,
-              HCTR_ROCKSDB_CHECK(batch.Put(ch, {reinterpret_cast<const char*>(k), sizeof(Key)},
-                                           {&values[(k - keys) * value_stride], value_size})));
+              HCTR_ROCKSDB_CHECK(
+                  batch.Put(ch, {reinterpret_cast<const char*>(k), sizeof(Key)}, encode(k))));
           HCTR_ROCKSDB_CHECK(db_->Write(write_options_, &batch));
           return true;
         }()) {
@@ -231,6 +314,104 @@ size_t RocksDBBackend<Key>::insert(const std::string& table_name, const size_t n
   return num_inserts;
 }
 
+template <typename Key>
+size_t RocksDBBackend<Key>::bulk_insert(const std::string& table_name, const size_t num_pairs,
+                                        const Key* const keys, const char* const values,
+                                        const uint32_t value_size, const size_t value_stride) {
+  // Not worth the effort for small batches.
+  if (num_pairs <= this->params_.max_batch_size) {
+    return insert(table_name, num_pairs, keys, values, value_size, value_stride);
+  }
+  HCTR_CHECK(value_size <= value_stride);
+
+  rocksdb::ColumnFamilyHandle* const ch{get_or_create_column_handle_(table_name)};
+
+  // Sort pairs in the order of the database. For duplicate keys, the last value prevails.
+  using KeyOrder = std::make_unsigned_t<Key>;
+  std::vector<std::pair<KeyOrder, size_t>> order(num_pairs);
+  for (size_t i{0}; i < num_pairs; ++i) {
+    order[i] = {rocksdb_key_order(keys[i]), i};
+  }
+  std::sort(std::execution::par, order.begin(), order.end());
+
+  // Each thread writes a range of the sorted pairs. Hence, the files do not overlap.
+  const size_t encoded_size{codec_.encoded_size(value_size)};
+  ThreadPool& pool{ThreadPool::get()};
+  const size_t num_files{std::min(
+      num_pairs, std::max(pool.size(), num_pairs * (sizeof(Key) + encoded_size) /
+                                           std::max<size_t>(this->params_.bulk_file_size, 1)))};
+
+  // Each call writes its files to a directory of its own. Hence, concurrent bulk inserts (e.g.,
+  // into different tables) do not interfere.
+  const std::filesystem::path dir{std::filesystem::path{this->params_.path} / ".bulk_insert" /
+                                  std::to_string(num_bulk_inserts_++)};
+  std::filesystem::create_directories(dir);
+  std::vector<std::string> paths(num_files);
+  for (size_t i{0}; i < num_files; ++i) {
+    paths[i] = (dir / (std::to_string(i) + ".sst"));
+  }
+
+  const rocksdb::Options options{rocksdb::DBOptions{}, column_family_options_};
+  std::vector<size_t> num_entries(num_files);
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(num_files);
+  for (size_t file_index{0}; file_index < num_files; ++file_index) {
+    tasks.emplace_back(pool.submit([&, file_index]() {
+      const size_t first{file_index * num_pairs / num_files};
+      const size_t last{(file_index + 1) * num_pairs / num_files};
+
+      rocksdb::SstFileWriter file{rocksdb::EnvOptions{}, options, ch};
+      std::vector<char> encoded(encoded_size);
+      size_t n{0};
+      for (size_t i{first}; i != last; ++i) {
+        if (i + 1 != num_pairs && order[i + 1].first == order[i].first) {
+          continue;
+        }
+        if (!n) {
+          HCTR_ROCKSDB_CHECK(file.Open(paths[file_index]));
+        }
+
+        const size_t index{order[i].second};
+        const char* const value{&values[index * value_stride]};
+        rocksdb::Slice v_view;
+        if (codec_.type() == DatabaseValueCodec_t::Float32) {
+          v_view = {value, value_size};
+        } else {
+          codec_.encode(value, value_size, encoded.data());
+          v_view = {encoded.data(), encoded_size};
+        }
+        HCTR_ROCKSDB_CHECK(
+            file.Put({reinterpret_cast<const char*>(&keys[index]), sizeof(Key)}, v_view));
+        ++n;
+      }
+      // Ranges that only contain overridden values yield no file.
+      if (n) {
+        HCTR_ROCKSDB_CHECK(file.Finish());
+      }
+      num_entries[file_index] = n;
+    }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+
+  // Attach the files to the database.
+  std::vector<std::string> files;
+  size_t num_inserts{0};
+  for (size_t i{0}; i < num_files; ++i) {
+    if (num_entries[i]) {
+      files.emplace_back(paths[i]);
+      num_inserts += num_entries[i];
+    }
+  }
+  rocksdb::IngestExternalFileOptions ingest_options{ingest_file_options_};
+  ingest_options.move_files = true;
+  HCTR_ROCKSDB_CHECK(db_->IngestExternalFile(ch, files, ingest_options));
+  std::filesystem::remove_all(dir);
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Bulk inserted ",
+             num_inserts, " / ", num_pairs, " entries (", files.size(), " files).\n");
+  return num_inserts;
+}
+
 template <typename Key>
 size_t RocksDBBackend<Key>::fetch(const std::string& table_name, const size_t num_keys,
                                   const Key* const keys, char* const values,
@@ -243,33 +424,43 @@ size_t RocksDBBackend<Key>::fetch(const std::string& table_name, const size_t nu
     return Base::fetch(table_name, num_keys, keys, values, value_stride, on_miss, time_budget);
   }
 
-  size_t miss_count{0};
-  size_t skip_count{0};
+  std::atomic<size_t> joint_miss_count{0};
+  std::atomic<size_t> joint_skip_count{0};
 
-  std::vector<rocksdb::ColumnFamilyHandle*> col_handles;
-  std::vector<std::string> v_views;
-  std::vector<rocksdb::Slice> k_views;
-  k_views.reserve(std::min(num_keys, this->params_.max_batch_size));
+  for_each_lookup_range_(num_keys, [&](const size_t first, const size_t last) {
+    size_t miss_count{0};
+    size_t skip_count{0};
 
-  // Step through input batch-by-batch.
-  std::chrono::nanoseconds elapsed;
-  const Key* const keys_end{&keys[num_keys]};
-  for (const Key* k{keys}; k != keys_end;) {
-    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
+    std::vector<rocksdb::ColumnFamilyHandle*> col_handles;
+    std::vector<std::string> v_views;
+    std::vector<rocksdb::Slice> k_views;
+    k_views.reserve(std::min(last - first, this->params_.max_batch_size));
 
-    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+    // Step through input batch-by-batch.
+    std::chrono::nanoseconds elapsed;
+    const Key* const keys_end{&keys[last]};
+    for (const Key* k{&keys[first]}; k != keys_end;) {
+      HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
 
-    const size_t prev_miss_count{miss_count};
-    if (!HCTR_HPS_ROCKSDB_FETCH_(SEQUENTIAL_DIRECT)) {
-      break;
+      const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+
+      const size_t prev_miss_count{miss_count};
+      if (!HCTR_HPS_ROCKSDB_FETCH_(SEQUENTIAL_DIRECT)) {
+        break;
+      }
+
+      HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+                 (k - keys - 1) / this->params_.max_batch_size, ": ",
+                 batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                 " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
     }
 
-    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
-               (k - keys - 1) / this->params_.max_batch_size, ": ",
-               batch_size - miss_count + prev_miss_count, " / ", batch_size,
-               " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
-  }
+    joint_miss_count += miss_count;
+    joint_skip_count += skip_count;
+  });
 
+  const size_t miss_count{joint_miss_count};
+  const size_t skip_count{joint_skip_count};
   const size_t hit_count{num_keys - skip_count - miss_count};
   HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
              num_keys - skip_count, " hits; skipped ", skip_count, " keys.\n");
@@ -290,32 +481,42 @@ size_t RocksDBBackend<Key>::fetch(const std::string& table_name, const size_t nu
                        time_budget);
   }
 
-  size_t miss_count{0};
-  size_t skip_count{0};
+  std::atomic<size_t> joint_miss_count{0};
+  std::atomic<size_t> joint_skip_count{0};
 
-  std::vector<rocksdb::ColumnFamilyHandle*> col_handles;
-  std::vector<std::string> v_views;
-  std::vector<rocksdb::Slice> k_views;
-  k_views.reserve(std::min(num_indices, this->params_.max_batch_size));
+  for_each_lookup_range_(num_indices, [&](const size_t first, const size_t last) {
+    size_t miss_count{0};
+    size_t skip_count{0};
 
-  std::chrono::nanoseconds elapsed;
-  const size_t* const indices_end{&indices[num_indices]};
-  for (const size_t* i{indices}; i != indices_end;) {
-    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
+    std::vector<rocksdb::ColumnFamilyHandle*> col_handles;
+    std::vector<std::string> v_views;
+    std::vector<rocksdb::Slice> k_views;
+    k_views.reserve(std::min(last - first, this->params_.max_batch_size));
 
-    const size_t batch_size{std::min<size_t>(indices_end - i, this->params_.max_batch_size)};
+    std::chrono::nanoseconds elapsed;
+    const size_t* const indices_end{&indices[last]};
+    for (const size_t* i{&indices[first]}; i != indices_end;) {
+      HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
 
-    const size_t prev_miss_count{miss_count};
-    if (!HCTR_HPS_ROCKSDB_FETCH_(SEQUENTIAL_INDIRECT)) {
-      break;
+      const size_t batch_size{std::min<size_t>(indices_end - i, this->params_.max_batch_size)};
+
+      const size_t prev_miss_count{miss_count};
+      if (!HCTR_HPS_ROCKSDB_FETCH_(SEQUENTIAL_INDIRECT)) {
+        break;
+      }
+
+      HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, ", batch ",
+                 (i - indices - 1) / this->params_.max_batch_size, ": ",
+                 v_views.size() - miss_count + prev_miss_count, " / ", v_views.size(),
+                 " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
     }
 
-    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Partition ", table_name, ", batch ",
-               (i - indices - 1) / this->params_.max_batch_size, ": ",
-               v_views.size() - miss_count + prev_miss_count, " / ", v_views.size(),
-               " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
-  }
+    joint_miss_count += miss_count;
+    joint_skip_count += skip_count;
+  });
 
+  const size_t miss_count{joint_miss_count};
+  const size_t skip_count{joint_skip_count};
   const size_t hit_count{num_indices - skip_count - miss_count};
   HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
              num_indices - skip_count, " hits; skipped ", skip_count, " keys.\n");
@@ -404,15 +605,19 @@ size_t RocksDBBackend<Key>::dump_bin(const std::string& table_name, std::ofstrea
   std::unique_ptr<rocksdb::Iterator> it{db_->NewIterator(read_options_, ch)};
   it->SeekToFirst();
 
-  // Value size field.
+  // Value size field (values are decoded, so that dumps do not depend on the storage format).
   uint32_t value_size;
+  size_t encoded_size;
   if (it->Valid()) {
-    value_size = static_cast<uint32_t>(it->value().size());
-    HCTR_CHECK(value_size == it->value().size());
+    encoded_size = it->value().size();
+    value_size = static_cast<uint32_t>(codec_.decoded_size(encoded_size));
+    HCTR_CHECK(value_size == codec_.decoded_size(encoded_size));
   } else {
+    encoded_size = 0;
     value_size = 0;
   }
   file.write(reinterpret_cast<const char*>(&value_size), sizeof(uint32_t));
+  std::vector<char> value(value_size);
 
   size_t num_entries{0};
   for (; it->Valid(); it->Next(), ++num_entries) {
@@ -425,8 +630,9 @@ size_t RocksDBBackend<Key>::dump_bin(const std::string& table_name, std::ofstrea
     // Value
     {
       const rocksdb::Slice& v_view{it->value()};
-      HCTR_CHECK(v_view.size() == value_size);
-      file.write(v_view.data(), value_size);
+      HCTR_CHECK(v_view.size() == encoded_size);
+      codec_.decode(v_view.data(), value_size, value.data());
+      file.write(value.data(), value_size);
     }
   }
   return num_entries;
@@ -443,20 +649,56 @@ size_t RocksDBBackend<Key>::dump_sst(const std::string& table_name, rocksdb::Sst
   it->SeekToFirst();
 
   size_t num_entries{0};
+  std::vector<char> value;
   for (; it->Valid(); it->Next(), ++num_entries) {
-    HCTR_ROCKSDB_CHECK(file.Put(it->key(), it->value()));
+    if (codec_.type() == DatabaseValueCodec_t::Float32) {
+      HCTR_ROCKSDB_CHECK(file.Put(it->key(), it->value()));
+    } else {
+      // Dumps contain decoded values.
+      const rocksdb::Slice& v_view{it->value()};
+      value.resize(codec_.decoded_size(v_view.size()));
+      codec_.decode(v_view.data(), value.size(), value.data());
+      HCTR_ROCKSDB_CHECK(file.Put(it->key(), {value.data(), value.size()}));
+    }
   }
   return num_entries;
 }
 
 template <typename Key>
 size_t RocksDBBackend<Key>::load_dump_sst(const std::string& table_name, const std::string& path) {
-  // return Base::load_dump_sst(table_name, path);
+  // Ingesting the file directly is only possible if values are stored as is.
+  if (codec_.type() != DatabaseValueCodec_t::Float32) {
+    return Base::load_dump_sst(table_name, path);
+  }
   rocksdb::ColumnFamilyHandle* const ch{get_or_create_column_handle_(table_name)};
   HCTR_ROCKSDB_CHECK(db_->IngestExternalFile(ch, {path}, ingest_file_options_));
   return 0;
 }
 
+template <typename Key>
+void RocksDBBackend<Key>::for_each_lookup_range_(
+    const size_t num_items, const std::function<void(size_t, size_t)>& fn) const {
+  const size_t max_batch_size{this->params_.max_batch_size};
+  const size_t num_batches{(num_items + max_batch_size - 1) / max_batch_size};
+  const size_t num_tasks{std::min(num_batches, this->params_.num_lookup_tasks)};
+  if (num_tasks <= 1) {
+    fn(0, num_items);
+    return;
+  }
+
+  // Ranges consist of whole batches. Hence, the batching is the same as in sequential mode.
+  ThreadPool& pool{ThreadPool::get()};
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(num_tasks);
+  for (size_t task_index{0}; task_index < num_tasks; ++task_index) {
+    const size_t first{task_index * num_batches / num_tasks * max_batch_size};
+    const size_t last{
+        std::min((task_index + 1) * num_batches / num_tasks * max_batch_size, num_items)};
+    tasks.emplace_back(pool.submit([&fn, first, last]() { fn(first, last); }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+}
+
 template class RocksDBBackend<unsigned int>;
 template class RocksDBBackend<long long>;
 
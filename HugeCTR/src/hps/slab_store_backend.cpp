@@ -0,0 +1,969 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <core23/logger.hpp>
+#include <cstring>
+#include <data_readers/multi_hot/detail/aio_context.hpp>
+#include <filesystem>
+#include <fstream>
+#include <hps/hier_parameter_server_base.hpp>
+#include <hps/slab_store_backend.hpp>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+namespace {
+
+/**
+ * Slab files start with a \p SlabFileHeader , padded to \p slab_block_size bytes, followed by
+ * rows of \p row_size bytes. Each row consists of a \p SlabRowHeader and an encoded value. Rows are
+ * only ever appended, and supersede earlier rows with the same key.
+ */
+constexpr size_t slab_block_size{4096};  // Alignment of O_DIRECT reads.
+constexpr size_t slab_row_alignment{64};
+constexpr char slab_magic[8]{'h', 'p', 's', 's', 'l', 'a', 'b', '\0'};
+constexpr uint64_t slab_version{2};
+constexpr uint32_t slab_row_marker{0x534c4142};  // Distinguishes rows from unwritten space.
+constexpr size_t slab_copy_size{16 * 1024 * 1024};  // Granularity of scans and compactions.
+
+struct SlabFileHeader final {
+  char magic[8];
+  uint64_t version;
+  uint64_t key_size;
+  uint64_t value_size;  // Decoded.
+  uint64_t value_codec;
+  uint64_t row_size;
+};
+static_assert(sizeof(SlabFileHeader) <= slab_block_size);
+
+struct SlabRowHeader final {
+  uint64_t key;
+  uint32_t value_size;  // Encoded (0 = tombstone).
+  uint32_t marker;
+  uint64_t checksum;  // Of the key, the value size, and the rest of the row (see below).
+};
+
+/**
+ * Rows can straddle sectors. Hence, a crash may leave the header of a row on disk, but not (all
+ * of) its value. The checksum detects such torn rows. Rows are padded with zeros to a multiple of
+ * \p slab_row_alignment . Hence, they can be summed in 8 byte words.
+ */
+inline uint64_t slab_row_checksum(const char* const row, const size_t row_size) {
+  SlabRowHeader header;
+  std::memcpy(&header, row, sizeof(SlabRowHeader));
+
+  uint64_t sum{header.key * 0x9e3779b97f4a7c15ULL + header.value_size};
+  for (size_t i{sizeof(SlabRowHeader)}; i < row_size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, &row[i], sizeof(uint64_t));
+    sum = sum * 0x100000001b3ULL + word;
+  }
+  return sum;
+}
+
+// Checks the marker and the checksum of a row.
+inline bool slab_row_valid(const char* const row, const size_t row_size) {
+  SlabRowHeader header;
+  std::memcpy(&header, row, sizeof(SlabRowHeader));
+  return header.marker == slab_row_marker && header.checksum == slab_row_checksum(row, row_size);
+}
+
+inline size_t slab_row_offset(const size_t row_size, const uint64_t row) {
+  return slab_block_size + row * row_size;
+}
+
+void slab_pread(const int fd, char* data, size_t size, size_t offset) {
+  while (size) {
+    const ssize_t n{pread(fd, data, size, static_cast<off_t>(offset))};
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    HCTR_CHECK_HINT(n > 0, "Slab file read failed: ", n < 0 ? std::strerror(errno) : "EOF", '.');
+    data += n;
+    size -= static_cast<size_t>(n);
+    offset += static_cast<size_t>(n);
+  }
+}
+
+void slab_pwrite(const int fd, const char* data, size_t size, size_t offset) {
+  while (size) {
+    const ssize_t n{pwrite(fd, data, size, static_cast<off_t>(offset))};
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    HCTR_CHECK_HINT(n > 0, "Slab file write failed: ", std::strerror(errno), '.');
+    data += n;
+    size -= static_cast<size_t>(n);
+    offset += static_cast<size_t>(n);
+  }
+}
+
+struct AlignedDeleter final {
+  void operator()(uint8_t* const p) const { std::free(p); }
+};
+
+}  // namespace
+
+/**
+ * Reads rows of a slab file asynchronously, and decodes their values. Up to \p io_depth reads are
+ * kept in flight.
+ */
+class SlabReader final {
+ public:
+  HCTR_DISALLOW_COPY_AND_MOVE(SlabReader);
+
+  SlabReader(const size_t io_depth) : aio_{io_depth}, reads_(io_depth) {
+    free_reads_.reserve(io_depth);
+    for (size_t i{io_depth}; i--;) {
+      free_reads_.emplace_back(i);
+    }
+  }
+
+  /**
+   * Selects the file and the format of subsequent reads.
+   */
+  void reset(const int fd, const size_t row_size, const ValueCodec& codec,
+             const uint32_t value_size) {
+    HCTR_CHECK(free_reads_.size() == reads_.size());
+    fd_ = fd;
+    row_size_ = row_size;
+    codec_ = &codec;
+    value_size_ = value_size;
+
+    // Rows can straddle a block boundary. Reading them still takes a single request.
+    const size_t buffer_size{(row_size + 2 * slab_block_size - 1) / slab_block_size *
+                             slab_block_size};
+    if (buffer_size > buffer_size_) {
+      buffer_size_ = buffer_size;
+      buffers_.reset(static_cast<uint8_t*>(
+          std::aligned_alloc(slab_block_size, buffer_size_ * reads_.size())));
+      HCTR_CHECK(buffers_);
+    }
+  }
+
+  /**
+   * Requests the value of \p key stored in \p row to be written to \p value .
+   */
+  void submit(const uint64_t row, const uint64_t key, char* const value) {
+    // `complete_` may time out without collecting anything if the device is busy.
+    while (free_reads_.empty()) {
+      complete_(1);
+    }
+    const size_t read_index{free_reads_.back()};
+    free_reads_.pop_back();
+
+    Read& read{reads_[read_index]};
+    read.key = key;
+    read.value = value;
+
+    const size_t offset{slab_row_offset(row_size_, row)};
+    read.data = &buffers_.get()[read_index * buffer_size_];
+    read.skip = offset % slab_block_size;
+    aio_.submit({fd_, read.data, row_size_, offset, &read});
+  }
+
+  /**
+   * Waits for all pending reads to complete.
+   */
+  void drain() {
+    while (free_reads_.size() < reads_.size()) {
+      complete_(reads_.size() - free_reads_.size());
+    }
+  }
+
+ private:
+  struct Read final {
+    uint64_t key;
+    char* value;
+    uint8_t* data;
+    size_t skip;
+  };
+
+  AIOContext aio_;
+  std::vector<Read> reads_;
+  std::vector<size_t> free_reads_;
+
+  std::unique_ptr<uint8_t, AlignedDeleter> buffers_;
+  size_t buffer_size_{0};
+
+  int fd_{-1};
+  size_t row_size_{0};
+  const ValueCodec* codec_{nullptr};
+  uint32_t value_size_{0};
+
+  void complete_(const size_t min_reqs) {
+    for (const IOEvent& event : aio_.collect(min_reqs, 100'000)) {
+      Read& read{*static_cast<Read*>(event.user_data)};
+      const char* const row{reinterpret_cast<const char*>(&read.data[read.skip])};
+
+      SlabRowHeader header;
+      std::memcpy(&header, row, sizeof(SlabRowHeader));
+      HCTR_CHECK_HINT(slab_row_valid(row, row_size_) && header.key == read.key &&
+                          header.value_size == codec_->encoded_size(value_size_),
+                      "Slab file is corrupted!");
+      codec_->decode(&row[sizeof(SlabRowHeader)], value_size_, read.value);
+
+      free_reads_.emplace_back(static_cast<size_t>(&read - reads_.data()));
+    }
+  }
+};
+
+template <typename Key>
+SlabStoreBackend<Key>::Table::Table(const std::string& path, const uint32_t value_size,
+                                    const DatabaseValueCodec_t value_codec)
+    : path{path},
+      value_size{value_size},
+      codec{value_codec},
+      row_size{(sizeof(SlabRowHeader) + codec.encoded_size(value_size) + slab_row_alignment - 1) /
+               slab_row_alignment * slab_row_alignment} {}
+
+template <typename Key>
+SlabStoreBackend<Key>::SlabStoreBackend(const SlabStoreBackendParams& params) : Base(params) {
+  HCTR_CHECK(params.io_depth > 0);
+  std::filesystem::create_directories(params.path);
+
+  // Open existing tables, and rebuild their indices.
+  std::vector<std::string> paths;
+  for (const auto& entry : std::filesystem::directory_iterator(params.path)) {
+    if (entry.path().extension() == ".slab") {
+      paths.emplace_back(entry.path());
+    } else if (entry.path().extension() == ".compact" && !params.read_only) {
+      // Left behind by an interrupted compaction.
+      std::filesystem::remove(entry.path());
+    }
+  }
+
+  std::vector<std::unique_ptr<Table>> tables(paths.size());
+  std::vector<std::future<void>> tasks;
+  tasks.reserve(paths.size());
+  for (size_t i{0}; i < paths.size(); ++i) {
+    tasks.emplace_back(
+        ThreadPool::get().submit([&, i]() { tables[i] = open_table_(paths[i], 0); }));
+  }
+  ThreadPool::await(tasks.begin(), tasks.end());
+
+  for (size_t i{0}; i < paths.size(); ++i) {
+    const std::string table_name{std::filesystem::path(paths[i]).stem()};
+    HCTR_LOG_C(DEBUG, WORLD, get_name(), " backend; Table ", table_name, ": Opened ",
+               tables[i]->index.size(), " entries.\n");
+    tables_.emplace(table_name, std::move(tables[i]));
+  }
+
+  HCTR_LOG_C(DEBUG, WORLD, "Opened slab store in ", params.path, " (", tables_.size(),
+             " tables).\n");
+}
+
+template <typename Key>
+SlabStoreBackend<Key>::~SlabStoreBackend() {
+  compaction_worker_.await_idle();
+
+  for (const auto& pair : tables_) {
+    const Table& table{*pair.second};
+    if (table.read_fd != table.fd) {
+      close(table.read_fd);
+    }
+    close(table.fd);
+  }
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::size(const std::string& table_name) const {
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::shared_lock table_lock(table->guard);
+  return table->index.size();
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::contains(const std::string& table_name, const size_t num_keys,
+                                       const Key* const keys,
+                                       const std::chrono::nanoseconds& time_budget) const {
+  const auto begin{std::chrono::high_resolution_clock::now()};
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return Base::contains(table_name, num_keys, keys, time_budget);
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  const Key* const keys_end{&keys[num_keys]};
+  size_t hit_count{0};
+  size_t skip_count{0};
+
+  // Step through input batch-by-batch. Lookups do not require any I/O.
+  std::chrono::nanoseconds elapsed;
+  for (const Key* k{keys}; k != keys_end;) {
+    HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, nullptr);
+
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT, hit_count += table->index.contains(*k));
+  }
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
+             num_keys - skip_count, " hits; skipped ", skip_count, " keys.\n");
+  return hit_count;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::insert(const std::string& table_name, const size_t num_pairs,
+                                     const Key* const keys, const char* const values,
+                                     const uint32_t value_size, const size_t value_stride) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(), " backend is read-only!");
+  HCTR_CHECK(value_size <= value_stride);
+
+  // Tables are only removed while holding `tables_guard_` exclusively. Hence, the table must be
+  // looked up again after (re-)acquiring the shared lock, because a concurrent `evict` may have
+  // dropped it while the lock was released to create it.
+  std::shared_lock lock(tables_guard_);
+  Table* table{get_table_(table_name)};
+  while (!table) {
+    lock.unlock();
+    {
+      const std::unique_lock create_lock(tables_guard_);
+      if (!get_table_(table_name)) {
+        HCTR_CHECK(value_size > 0);
+        const std::filesystem::path path{std::filesystem::path(this->params_.path) /
+                                         (table_name + ".slab")};
+        tables_.emplace(table_name, open_table_(path, value_size));
+      }
+    }
+    lock.lock();
+    table = get_table_(table_name);
+  }
+  const std::unique_lock table_lock(table->guard);
+  HCTR_CHECK(table->value_size == value_size);
+
+  const size_t encoded_value_size{table->codec.encoded_size(value_size)};
+  const Key* const keys_end{&keys[num_pairs]};
+  size_t num_inserts{0};
+  std::vector<char> rows;
+
+  // Step through input batch-by-batch.
+  for (const Key* k{keys}; k != keys_end;) {
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+    rows.assign(batch_size * table->row_size, 0);
+
+    // Encode rows, and update the index to point at their future location.
+    char* row{rows.data()};
+    uint64_t row_index{table->num_rows};
+    const size_t prev_num_inserts{num_inserts};
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT, {
+      SlabRowHeader header{static_cast<uint64_t>(*k), static_cast<uint32_t>(encoded_value_size),
+                           slab_row_marker, 0};
+      std::memcpy(row, &header, sizeof(SlabRowHeader));
+      table->codec.encode(&values[(k - keys) * value_stride], value_size,
+                          &row[sizeof(SlabRowHeader)]);
+      header.checksum = slab_row_checksum(row, table->row_size);
+      std::memcpy(row, &header, sizeof(SlabRowHeader));
+      row += table->row_size;
+
+      num_inserts += table->index.insert_or_assign(*k, row_index++).second;
+    });
+    append_rows_(*table, rows.data(), batch_size);
+
+    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+               (k - keys - 1) / this->params_.max_batch_size, ": Inserted ",
+               num_inserts - prev_num_inserts, " + updated ",
+               batch_size - num_inserts + prev_num_inserts, " = ", batch_size, " entries.\n");
+  }
+
+  maybe_schedule_compaction_(table_name, *table);
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Inserted ", num_inserts,
+             " + updated ", num_pairs - num_inserts, " = ", num_pairs, " entries.\n");
+  return num_inserts;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::fetch(const std::string& table_name, const size_t num_keys,
+                                    const Key* const keys, char* const values,
+                                    const size_t value_stride, const DatabaseMissCallback& on_miss,
+                                    const std::chrono::nanoseconds& time_budget) {
+  const auto begin{std::chrono::high_resolution_clock::now()};
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return Base::fetch(table_name, num_keys, keys, values, value_stride, on_miss, time_budget);
+  }
+  const std::shared_lock table_lock(table->guard);
+  HCTR_CHECK(table->value_size <= value_stride);
+
+  std::atomic<size_t> joint_miss_count{0};
+  std::atomic<size_t> joint_skip_count{0};
+
+  for_each_lookup_range_(num_keys, [&](SlabReader& reader, const size_t first, const size_t last) {
+    reader.reset(table->read_fd, table->row_size, table->codec, table->value_size);
+
+    size_t miss_count{0};
+    size_t skip_count{0};
+
+    // Step through input batch-by-batch. The reads of each batch are issued together.
+    std::chrono::nanoseconds elapsed;
+    const Key* const keys_end{&keys[last]};
+    for (const Key* k{&keys[first]}; k != keys_end;) {
+      HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_DIRECT, on_miss);
+
+      const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+      const size_t prev_miss_count{miss_count};
+      HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT, {
+        const auto& it{table->index.find(*k)};
+        if (it != table->index.end()) {
+          reader.submit(it->second, static_cast<uint64_t>(*k), &values[(k - keys) * value_stride]);
+        } else {
+          on_miss(k - keys);
+          ++miss_count;
+        }
+      });
+      reader.drain();
+
+      HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+                 (k - keys - 1) / this->params_.max_batch_size, ": ",
+                 batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                 " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+    }
+
+    joint_miss_count += miss_count;
+    joint_skip_count += skip_count;
+  });
+
+  const size_t miss_count{joint_miss_count};
+  const size_t skip_count{joint_skip_count};
+  const size_t hit_count{num_keys - skip_count - miss_count};
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
+             num_keys - skip_count, " hits; skipped ", skip_count, " keys.\n");
+  return hit_count;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::fetch(const std::string& table_name, const size_t num_indices,
+                                    const size_t* const indices, const Key* const keys,
+                                    char* const values, const size_t value_stride,
+                                    const DatabaseMissCallback& on_miss,
+                                    const std::chrono::nanoseconds& time_budget) {
+  const auto begin{std::chrono::high_resolution_clock::now()};
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return Base::fetch(table_name, num_indices, indices, keys, values, value_stride, on_miss,
+                       time_budget);
+  }
+  const std::shared_lock table_lock(table->guard);
+  HCTR_CHECK(table->value_size <= value_stride);
+
+  std::atomic<size_t> joint_miss_count{0};
+  std::atomic<size_t> joint_skip_count{0};
+
+  for_each_lookup_range_(num_indices, [&](SlabReader& reader, const size_t first,
+                                          const size_t last) {
+    reader.reset(table->read_fd, table->row_size, table->codec, table->value_size);
+
+    size_t miss_count{0};
+    size_t skip_count{0};
+
+    // Step through input batch-by-batch. The reads of each batch are issued together.
+    std::chrono::nanoseconds elapsed;
+    const size_t* const indices_end{&indices[last]};
+    for (const size_t* i{&indices[first]}; i != indices_end;) {
+      HCTR_HPS_DB_CHECK_TIME_BUDGET_(SEQUENTIAL_INDIRECT, on_miss);
+
+      const size_t batch_size{std::min<size_t>(indices_end - i, this->params_.max_batch_size)};
+      const size_t prev_miss_count{miss_count};
+      HCTR_HPS_DB_APPLY_(SEQUENTIAL_INDIRECT, {
+        const auto& it{table->index.find(*k)};
+        if (it != table->index.end()) {
+          reader.submit(it->second, static_cast<uint64_t>(*k), &values[(k - keys) * value_stride]);
+        } else {
+          on_miss(k - keys);
+          ++miss_count;
+        }
+      });
+      reader.drain();
+
+      HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+                 (i - indices - 1) / this->params_.max_batch_size, ": ",
+                 batch_size - miss_count + prev_miss_count, " / ", batch_size,
+                 " hits. Time: ", elapsed.count(), " / ", time_budget.count(), " ns.\n");
+    }
+
+    joint_miss_count += miss_count;
+    joint_skip_count += skip_count;
+  });
+
+  const size_t miss_count{joint_miss_count};
+  const size_t skip_count{joint_skip_count};
+  const size_t hit_count{num_indices - skip_count - miss_count};
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": ", hit_count, " / ",
+             num_indices - skip_count, " hits; skipped ", skip_count, " keys.\n");
+  return hit_count;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::evict(const std::string& table_name) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(), " backend is read-only!");
+  const std::unique_lock lock(tables_guard_);
+
+  const auto& tables_it{tables_.find(table_name)};
+  if (tables_it == tables_.end()) {
+    return 0;
+  }
+  Table& table{*tables_it->second};
+
+  // Compactions hold `tables_guard_`. Hence, none can be in progress.
+  const size_t num_deletions{table.index.size()};
+  if (table.read_fd != table.fd) {
+    close(table.read_fd);
+  }
+  close(table.fd);
+  std::filesystem::remove(table.path);
+  tables_.erase(tables_it);
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Erased ", num_deletions,
+             " entries.\n");
+  return num_deletions;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::evict(const std::string& table_name, const size_t num_keys,
+                                    const Key* const keys) {
+  HCTR_CHECK_HINT(!this->params_.read_only, get_name(), " backend is read-only!");
+  const std::shared_lock lock(tables_guard_);
+
+  Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::unique_lock table_lock(table->guard);
+
+  const Key* const keys_end{&keys[num_keys]};
+  size_t num_deletions{0};
+  std::vector<char> rows;
+
+  // Step through input batch-by-batch. Deletions are recorded as tombstones.
+  for (const Key* k{keys}; k != keys_end;) {
+    const size_t batch_size{std::min<size_t>(keys_end - k, this->params_.max_batch_size)};
+    rows.clear();
+
+    const size_t prev_num_deletions{num_deletions};
+    HCTR_HPS_DB_APPLY_(SEQUENTIAL_DIRECT, {
+      if (table->index.erase(*k)) {
+        SlabRowHeader header{static_cast<uint64_t>(*k), 0, slab_row_marker, 0};
+        rows.resize(rows.size() + table->row_size);
+        char* const row{&rows[rows.size() - table->row_size]};
+        std::memcpy(row, &header, sizeof(SlabRowHeader));
+        header.checksum = slab_row_checksum(row, table->row_size);
+        std::memcpy(row, &header, sizeof(SlabRowHeader));
+        ++num_deletions;
+      }
+    });
+    append_rows_(*table, rows.data(), num_deletions - prev_num_deletions);
+
+    HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ", batch ",
+               (k - keys - 1) / this->params_.max_batch_size, ": Erased ",
+               num_deletions - prev_num_deletions, " / ", batch_size, " entries.\n");
+  }
+
+  maybe_schedule_compaction_(table_name, *table);
+
+  HCTR_LOG_C(TRACE, WORLD, get_name(), " backend; Table ", table_name, ": Erased ", num_deletions,
+             " / ", num_keys, " entries.\n");
+  return num_deletions;
+}
+
+template <typename Key>
+std::vector<std::string> SlabStoreBackend<Key>::find_tables(const std::string& model_name) {
+  const std::string& tag_prefix{HierParameterServerBase::make_tag_name(model_name, "", false)};
+
+  const std::shared_lock lock(tables_guard_);
+
+  std::vector<std::string> matches;
+  for (const auto& pair : tables_) {
+    if (pair.first.find(tag_prefix) == 0) {
+      matches.push_back(pair.first);
+    }
+  }
+  return matches;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::dump_bin(const std::string& table_name, std::ofstream& file) {
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  // Store value size.
+  const uint32_t value_size{table->value_size};
+  file.write(reinterpret_cast<const char*>(&value_size), sizeof(uint32_t));
+
+  // Store values (decoded), in the order of the slab file.
+  std::vector<std::pair<uint64_t, Key>> rows;
+  rows.reserve(table->index.size());
+  for (const auto& [key, row] : table->index) {
+    rows.emplace_back(row, key);
+  }
+  std::sort(rows.begin(), rows.end());
+
+  std::vector<char> value(value_size);
+  for (const auto& [row, key] : rows) {
+    file.write(reinterpret_cast<const char*>(&key), sizeof(Key));
+    read_value_(*table, row, value.data());
+    file.write(value.data(), value_size);
+  }
+
+  return rows.size();
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::dump_sst(const std::string& table_name,
+                                       rocksdb::SstFileWriter& file) {
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::shared_lock table_lock(table->guard);
+
+  // Sort keys by value.
+  std::vector<std::pair<Key, uint64_t>> rows(table->index.begin(), table->index.end());
+  std::sort(rows.begin(), rows.end());
+
+  // Iterate over pairs and insert (values are decoded).
+  std::vector<char> value(table->value_size);
+  rocksdb::Slice k_view{nullptr, sizeof(Key)};
+  rocksdb::Slice v_view{value.data(), value.size()};
+
+  for (const auto& [key, row] : rows) {
+    k_view.data_ = reinterpret_cast<const char*>(&key);
+    read_value_(*table, row, value.data());
+    HCTR_ROCKSDB_CHECK(file.Put(k_view, v_view));
+  }
+
+  return rows.size();
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::compact(const std::string& table_name) {
+  // Prevents the table from being dropped, but does not block lookups or writes.
+  const std::shared_lock lock(tables_guard_);
+
+  Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+
+  // Concurrent compactions would write the same file, and remap rows of a stale snapshot.
+  const std::lock_guard compaction_lock(table->compaction_guard);
+
+  // Take a snapshot of the current rows. Rows are immutable once written.
+  std::vector<std::pair<uint64_t, Key>> live_rows;
+  size_t prev_num_rows;
+  {
+    const std::shared_lock table_lock(table->guard);
+    live_rows.reserve(table->index.size());
+    for (const auto& [key, row] : table->index) {
+      live_rows.emplace_back(row, key);
+    }
+    prev_num_rows = table->num_rows;
+  }
+  std::sort(live_rows.begin(), live_rows.end());
+
+  // Copy them (in file order) into a new slab file.
+  const std::string new_path{table->path + ".compact"};
+  const int new_fd{open(new_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+  HCTR_CHECK_HINT(new_fd >= 0, "Unable to create '", new_path, "': ", std::strerror(errno), '.');
+
+  std::vector<char> buffer(slab_block_size);
+  slab_pread(table->fd, buffer.data(), slab_block_size, 0);
+  slab_pwrite(new_fd, buffer.data(), slab_block_size, 0);
+
+  const size_t row_size{table->row_size};
+  const size_t rows_per_copy{std::max<size_t>(slab_copy_size / row_size, 1)};
+  buffer.resize(rows_per_copy * row_size);
+
+  uint64_t new_num_rows{0};
+  for (auto it{live_rows.begin()}; it != live_rows.end();) {
+    const auto it_end{it + std::min<ptrdiff_t>(live_rows.end() - it, rows_per_copy)};
+    char* row{buffer.data()};
+    for (; it != it_end; ++it, row += row_size) {
+      slab_pread(table->fd, row, row_size, slab_row_offset(row_size, it->first));
+    }
+    const size_t n{static_cast<size_t>(row - buffer.data()) / row_size};
+    slab_pwrite(new_fd, buffer.data(), n * row_size, slab_row_offset(row_size, new_num_rows));
+    new_num_rows += n;
+  }
+
+  // Swap files. Rows that were written in the meantime are appended verbatim.
+  const std::unique_lock table_lock(table->guard);
+
+  for (size_t row{prev_num_rows}; row < table->num_rows;) {
+    const size_t n{std::min(table->num_rows - row, rows_per_copy)};
+    slab_pread(table->fd, buffer.data(), n * row_size, slab_row_offset(row_size, row));
+    slab_pwrite(new_fd, buffer.data(), n * row_size,
+                slab_row_offset(row_size, new_num_rows + row - prev_num_rows));
+    row += n;
+  }
+
+  // Entries that were overwritten or evicted in the meantime keep pointing to later rows.
+  for (size_t i{0}; i < live_rows.size(); ++i) {
+    const auto& it{table->index.find(live_rows[i].second)};
+    if (it != table->index.end() && it->second == live_rows[i].first) {
+      it->second = i;
+    }
+  }
+  for (auto& pair : table->index) {
+    if (pair.second >= prev_num_rows) {
+      pair.second = pair.second - prev_num_rows + new_num_rows;
+    }
+  }
+  new_num_rows += table->num_rows - prev_num_rows;
+
+  HCTR_CHECK_HINT(!fdatasync(new_fd), "Unable to sync '", new_path, "': ", std::strerror(errno));
+  std::filesystem::rename(new_path, table->path);
+
+  if (table->read_fd != table->fd) {
+    close(table->read_fd);
+  }
+  close(table->fd);
+  table->fd = new_fd;
+  open_read_fd_(*table);
+
+  const size_t prev_total_rows{table->num_rows};
+  table->num_rows = new_num_rows;
+  table->compaction_pending = false;
+
+  HCTR_LOG_C(DEBUG, WORLD, get_name(), " backend; Table ", table_name, ": Compacted ",
+             prev_total_rows, " to ", new_num_rows, " rows.\n");
+  return prev_total_rows - new_num_rows;
+}
+
+template <typename Key>
+size_t SlabStoreBackend<Key>::file_size(const std::string& table_name) const {
+  const std::shared_lock lock(tables_guard_);
+
+  const Table* const table{get_table_(table_name)};
+  if (!table) {
+    return 0;
+  }
+  const std::shared_lock table_lock(table->guard);
+  return slab_row_offset(table->row_size, table->num_rows);
+}
+
+template <typename Key>
+std::unique_ptr<typename SlabStoreBackend<Key>::Table> SlabStoreBackend<Key>::open_table_(
+    const std::string& path, const uint32_t value_size) const {
+  const bool read_only{this->params_.read_only};
+  const int fd{open(path.c_str(), read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644)};
+  HCTR_CHECK_HINT(fd >= 0, "Unable to open '", path, "': ", std::strerror(errno), '.');
+
+  SlabFileHeader header{};
+  std::unique_ptr<Table> table;
+
+  const size_t file_size{std::filesystem::file_size(path)};
+  if (file_size == 0) {
+    // Create new table.
+    HCTR_CHECK_HINT(value_size > 0, "Slab file '", path, "' is empty!");
+    table = std::make_unique<Table>(path, value_size, this->params_.value_codec);
+
+    std::copy_n(slab_magic, sizeof(slab_magic), header.magic);
+    header.version = slab_version;
+    header.key_size = sizeof(Key);
+    header.value_size = value_size;
+    header.value_codec = static_cast<uint64_t>(table->codec.type());
+    header.row_size = table->row_size;
+
+    std::vector<char> block(slab_block_size);
+    std::memcpy(block.data(), &header, sizeof(SlabFileHeader));
+    slab_pwrite(fd, block.data(), block.size(), 0);
+  } else {
+    // Validate header.
+    HCTR_CHECK_HINT(file_size >= slab_block_size, "Slab file '", path, "' is truncated!");
+    slab_pread(fd, reinterpret_cast<char*>(&header), sizeof(SlabFileHeader), 0);
+    HCTR_CHECK_HINT(std::equal(header.magic, &header.magic[sizeof(slab_magic)], slab_magic),
+                    "'", path, "' is not a slab file!");
+    HCTR_CHECK_HINT(header.version == slab_version, "Slab file '", path,
+                    "' has an unsupported version!");
+    HCTR_CHECK_HINT(header.key_size == sizeof(Key), "Slab file '", path,
+                    "' has the wrong key size!");
+
+    table = std::make_unique<Table>(path, static_cast<uint32_t>(header.value_size),
+                                    static_cast<DatabaseValueCodec_t>(header.value_codec));
+    HCTR_CHECK_HINT(header.row_size == table->row_size, "Slab file '", path, "' is corrupted!");
+    HCTR_CHECK_HINT(value_size == 0 || value_size == table->value_size, "Slab file '", path,
+                    "' holds values of a different size!");
+
+    // Replay rows. Scanning stops at the first incomplete or torn row (e.g., after a crash).
+    const size_t row_size{table->row_size};
+    const size_t rows_per_copy{std::max<size_t>(slab_copy_size / row_size, 1)};
+    const size_t max_rows{(file_size - slab_block_size) / row_size};
+    std::vector<char> buffer(rows_per_copy * row_size);
+
+    size_t num_rows{0};
+    while (num_rows < max_rows) {
+      const size_t n{std::min(max_rows - num_rows, rows_per_copy)};
+      slab_pread(fd, buffer.data(), n * row_size, slab_row_offset(row_size, num_rows));
+
+      size_t i{0};
+      for (; i < n; ++i) {
+        if (!slab_row_valid(&buffer[i * row_size], row_size)) {
+          break;
+        }
+        SlabRowHeader row;
+        std::memcpy(&row, &buffer[i * row_size], sizeof(SlabRowHeader));
+        const Key key{static_cast<Key>(row.key)};
+        if (row.value_size) {
+          table->index.insert_or_assign(key, num_rows + i);
+        } else {
+          table->index.erase(key);
+        }
+      }
+      num_rows += i;
+      if (i < n) {
+        break;
+      }
+    }
+    table->num_rows = num_rows;
+
+    if (num_rows != max_rows || file_size != slab_row_offset(row_size, num_rows)) {
+      HCTR_LOG_S(WARNING, WORLD) << "Slab file '" << path << "' has an incomplete tail after "
+                                 << num_rows << " rows." << std::endl;
+      if (!read_only) {
+        HCTR_CHECK(!ftruncate(fd, static_cast<off_t>(slab_row_offset(row_size, num_rows))));
+      }
+    }
+  }
+
+  table->fd = fd;
+  open_read_fd_(*table);
+  return table;
+}
+
+template <typename Key>
+void SlabStoreBackend<Key>::open_read_fd_(Table& table) const {
+  table.read_fd = table.fd;
+  if (this->params_.use_direct_reads) {
+    const int fd{open(table.path.c_str(), O_RDONLY | O_DIRECT)};
+    if (fd >= 0) {
+      table.read_fd = fd;
+    } else {
+      HCTR_LOG_S(WARNING, WORLD) << "Unable to open '" << table.path
+                                 << "' with O_DIRECT. Reads will use the page cache." << std::endl;
+    }
+  }
+}
+
+template <typename Key>
+void SlabStoreBackend<Key>::append_rows_(Table& table, const char* const rows,
+                                         const size_t num_rows) const {
+  slab_pwrite(table.fd, rows, num_rows * table.row_size,
+              slab_row_offset(table.row_size, table.num_rows));
+  table.num_rows += num_rows;
+}
+
+template <typename Key>
+void SlabStoreBackend<Key>::read_value_(const Table& table, const uint64_t row,
+                                        char* const value) const {
+  std::vector<char> buffer(table.row_size);
+  slab_pread(table.fd, buffer.data(), buffer.size(), slab_row_offset(table.row_size, row));
+
+  SlabRowHeader header;
+  std::memcpy(&header, buffer.data(), sizeof(SlabRowHeader));
+  HCTR_CHECK_HINT(slab_row_valid(buffer.data(), buffer.size()) && header.value_size > 0,
+                  "Slab file is corrupted!");
+  table.codec.decode(&buffer[sizeof(SlabRowHeader)], table.value_size, value);
+}
+
+template <typename Key>
+void SlabStoreBackend<Key>::maybe_schedule_compaction_(const std::string& table_name,
+                                                       Table& table) {
+  const size_t num_outdated_rows{table.num_rows - table.index.size()};
+  if (table.compaction_pending || num_outdated_rows < this->params_.max_batch_size ||
+      static_cast<double>(num_outdated_rows) <=
+          this->params_.compaction_threshold * static_cast<double>(table.num_rows)) {
+    return;
+  }
+
+  table.compaction_pending = true;
+  compaction_worker_.submit([this, table_name]() { compact(table_name); });
+}
+
+template <typename Key>
+void SlabStoreBackend<Key>::for_each_lookup_range_(
+    const size_t num_items, const std::function<void(SlabReader&, size_t, size_t)>& fn) const {
+  const size_t max_batch_size{this->params_.max_batch_size};
+  const size_t num_batches{(num_items + max_batch_size - 1) / max_batch_size};
+  const size_t num_tasks{std::max<size_t>(std::min(num_batches, this->params_.num_lookup_tasks),
+                                          1)};
+
+  // Borrow readers.
+  std::vector<std::unique_ptr<SlabReader>> readers;
+  {
+    const std::lock_guard lock(readers_guard_);
+    while (readers.size() < num_tasks && !idle_readers_.empty()) {
+      readers.emplace_back(std::move(idle_readers_.back()));
+      idle_readers_.pop_back();
+    }
+  }
+  while (readers.size() < num_tasks) {
+    readers.emplace_back(std::make_unique<SlabReader>(this->params_.io_depth));
+  }
+
+  if (num_tasks == 1) {
+    fn(*readers.front(), 0, num_items);
+  } else {
+    // Ranges consist of whole batches. Hence, the batching is the same as in sequential mode.
+    ThreadPool& pool{ThreadPool::get()};
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(num_tasks);
+    for (size_t task_index{0}; task_index < num_tasks; ++task_index) {
+      const size_t first{task_index * num_batches / num_tasks * max_batch_size};
+      const size_t last{
+          std::min((task_index + 1) * num_batches / num_tasks * max_batch_size, num_items)};
+      SlabReader& reader{*readers[task_index]};
+      tasks.emplace_back(pool.submit([&fn, &reader, first, last]() { fn(reader, first, last); }));
+    }
+    ThreadPool::await(tasks.begin(), tasks.end());
+  }
+
+  // Return readers.
+  const std::lock_guard lock(readers_guard_);
+  for (auto& reader : readers) {
+    idle_readers_.emplace_back(std::move(reader));
+  }
+}
+
+template class SlabStoreBackend<unsigned int>;
+template class SlabStoreBackend<long long>;
+
+}  // namespace HugeCTR
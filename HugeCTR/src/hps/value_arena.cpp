@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <core23/logger.hpp>
+#include <fstream>
+#include <hps/value_arena.hpp>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <vector>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+// Size of the huge pages that are used by `MAP_HUGETLB` by default (x86-64 and aarch64 with 4K
+// base pages).
+static constexpr size_t huge_page_size{2L * 1024 * 1024};
+
+ValueArenaStats& ValueArenaStats::operator+=(const ValueArenaStats& other) {
+  num_pages += other.num_pages;
+  num_resident_pages += other.num_resident_pages;
+  reserved_bytes += other.reserved_bytes;
+  resident_bytes += other.resident_bytes;
+  used_bytes += other.used_bytes;
+  return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const ValueArenaStats& stats) {
+  return os << "pages = " << stats.num_resident_pages << " / " << stats.num_pages
+            << ", reserved = " << stats.reserved_bytes << " bytes, resident = "
+            << stats.resident_bytes << " bytes, used = " << stats.used_bytes
+            << " bytes, fragmentation = " << stats.fragmentation();
+}
+
+ValueArena::ValueArena(const size_t value_size, const size_t value_alignment,
+                       const size_t page_size, const DatabaseHugePages_t huge_pages,
+                       const int numa_node)
+    : value_size_{value_size}, huge_pages_{huge_pages}, numa_node_{numa_node} {
+  HCTR_CHECK(value_size > 0);
+  HCTR_CHECK(value_alignment > 0 && !(value_alignment & (value_alignment - 1)));
+  slot_size_ = (value_size + value_alignment - 1) / value_alignment * value_alignment;
+
+  // Pages must at least hold a single value, and be a multiple of the huge page size.
+  const size_t granularity{huge_pages == DatabaseHugePages_t::Disabled
+                               ? static_cast<size_t>(sysconf(_SC_PAGESIZE))
+                               : huge_page_size};
+  page_size_ = std::max(page_size, slot_size_);
+  page_size_ = (page_size_ + granularity - 1) / granularity * granularity;
+
+  const size_t slots_per_page{page_size_ / slot_size_};
+  HCTR_CHECK(slots_per_page <= std::numeric_limits<uint32_t>::max());
+  slots_per_page_ = static_cast<uint32_t>(slots_per_page);
+}
+
+ValueArena::ValueArena(ValueArena&& other) noexcept
+    : value_size_{other.value_size_},
+      slot_size_{other.slot_size_},
+      page_size_{other.page_size_},
+      slots_per_page_{other.slots_per_page_},
+      huge_pages_{other.huge_pages_},
+      numa_node_{other.numa_node_},
+      pages_{std::move(other.pages_)},
+      page_indices_{std::move(other.page_indices_)},
+      open_pages_{std::move(other.open_pages_)},
+      released_pages_{std::move(other.released_pages_)},
+      num_used_{other.num_used_} {
+  other.pages_.clear();
+  other.page_indices_.clear();
+  other.open_pages_.clear();
+  other.released_pages_.clear();
+  other.num_used_ = 0;
+}
+
+ValueArena& ValueArena::operator=(ValueArena&& other) noexcept {
+  if (this != &other) {
+    unmap_pages_();
+    value_size_ = other.value_size_;
+    slot_size_ = other.slot_size_;
+    page_size_ = other.page_size_;
+    slots_per_page_ = other.slots_per_page_;
+    huge_pages_ = other.huge_pages_;
+    numa_node_ = other.numa_node_;
+    pages_ = std::move(other.pages_);
+    page_indices_ = std::move(other.page_indices_);
+    open_pages_ = std::move(other.open_pages_);
+    released_pages_ = std::move(other.released_pages_);
+    num_used_ = other.num_used_;
+
+    other.pages_.clear();
+    other.page_indices_.clear();
+    other.open_pages_.clear();
+    other.released_pages_.clear();
+    other.num_used_ = 0;
+  }
+  return *this;
+}
+
+ValueArena::~ValueArena() { unmap_pages_(); }
+
+char* ValueArena::allocate() {
+  // Prefer low numbered pages, so that high numbered pages can drain.
+  if (open_pages_.empty()) {
+    if (released_pages_.empty()) {
+      map_page_();
+    } else {
+      const size_t page_index{released_pages_.back()};
+      released_pages_.pop_back();
+      pages_[page_index].resident = true;
+      open_pages_.emplace(page_index);
+    }
+  }
+  const size_t page_index{*open_pages_.begin()};
+  Page& page{pages_[page_index]};
+
+  uint32_t slot;
+  if (!page.free_slots.empty()) {
+    slot = page.free_slots.back();
+    page.free_slots.pop_back();
+  } else {
+    slot = slots_per_page_ - page.num_untouched;
+    --page.num_untouched;
+  }
+  if (++page.num_used == slots_per_page_) {
+    open_pages_.erase(page_index);
+  }
+  ++num_used_;
+
+  return &page.data[static_cast<size_t>(slot) * slot_size_];
+}
+
+void ValueArena::release(char* const value) {
+  const size_t page_index{page_index_(value)};
+  Page& page{pages_[page_index]};
+  HCTR_CHECK(page.num_used > 0);
+
+  const size_t offset{static_cast<size_t>(value - page.data)};
+  page.free_slots.emplace_back(static_cast<uint32_t>(offset / slot_size_));
+  if (page.num_used-- == slots_per_page_ && !page.draining) {
+    open_pages_.emplace(page_index);
+  }
+  --num_used_;
+
+  // Return memory to the OS, unless this is the last page that can take new values.
+  if (page.num_used == 0 && (page.draining || open_pages_.size() > 1)) {
+    release_page_(page_index);
+  }
+}
+
+size_t ValueArena::begin_compaction(const double threshold) {
+  const ValueArenaStats stats{this->stats()};
+  if (stats.fragmentation() <= threshold) {
+    return 0;
+  }
+
+  // Free slots in resident pages (untouched slots are included, since they are not mapped in yet).
+  size_t num_free{0};
+  for (const Page& page : pages_) {
+    if (page.resident) {
+      num_free += slots_per_page_ - page.num_used;
+    }
+  }
+
+  // Drain pages from the back, as long as their values fit into the remaining pages.
+  size_t num_moves{0};
+  for (size_t page_index{pages_.size()}; page_index-- > 0;) {
+    Page& page{pages_[page_index]};
+    if (!page.resident || page.num_used == 0) {
+      continue;
+    }
+
+    const size_t page_free{slots_per_page_ - page.num_used};
+    if (num_free - page_free < num_moves + page.num_used) {
+      break;
+    }
+    num_free -= page_free;
+    num_moves += page.num_used;
+
+    page.draining = true;
+    open_pages_.erase(page_index);
+  }
+  return num_moves;
+}
+
+bool ValueArena::is_draining(const char* const value) const {
+  return pages_[page_index_(value)].draining;
+}
+
+void ValueArena::end_compaction() {
+  for (size_t page_index{0}; page_index < pages_.size(); ++page_index) {
+    Page& page{pages_[page_index]};
+    if (page.draining) {
+      page.draining = false;
+      if (page.resident && page.num_used < slots_per_page_) {
+        open_pages_.emplace(page_index);
+      }
+    }
+  }
+}
+
+ValueArenaStats ValueArena::stats() const {
+  ValueArenaStats stats;
+  stats.num_pages = pages_.size();
+  stats.reserved_bytes = pages_.size() * page_size_;
+  for (const Page& page : pages_) {
+    if (page.resident) {
+      ++stats.num_resident_pages;
+      // Slots that were never touched have not been faulted in yet.
+      stats.resident_bytes += page_size_ - page.num_untouched * slot_size_;
+    }
+  }
+  stats.used_bytes = num_used_ * slot_size_;
+  return stats;
+}
+
+std::vector<char*> ValueArena::map_image(const int fd, size_t offset, size_t num_values) {
+  HCTR_CHECK(offset % static_cast<size_t>(sysconf(_SC_PAGESIZE)) == 0);
+
+  std::vector<char*> image_pages;
+  image_pages.reserve((num_values + slots_per_page_ - 1) / slots_per_page_);
+
+  for (; num_values; offset += page_size_) {
+    void* const data{mmap(nullptr, page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                          static_cast<off_t>(offset))};
+    if (data == MAP_FAILED) {
+      HCTR_OWN_THROW(Error_t::WrongInput, "Unable to map value image.");
+    }
+
+    const uint32_t num_used{static_cast<uint32_t>(std::min<size_t>(num_values, slots_per_page_))};
+    num_values -= num_used;
+
+    const size_t page_index{pages_.size()};
+    pages_.push_back(
+        {static_cast<char*>(data), num_used, slots_per_page_ - num_used, {}, true, false});
+    page_indices_.emplace(static_cast<char*>(data), page_index);
+    if (num_used < slots_per_page_) {
+      open_pages_.emplace(page_index);
+    }
+    num_used_ += num_used;
+
+    image_pages.emplace_back(static_cast<char*>(data));
+  }
+
+  return image_pages;
+}
+
+int ValueArena::numa_node_for_partition(const size_t part_index) {
+  // Parse the list of online nodes (e.g., "0-1,3") once.
+  static const std::vector<int> nodes{[]() {
+    std::vector<int> nodes;
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string range;
+    while (std::getline(file, range, ',')) {
+      int first{-1}, last{-1};
+      char separator;
+      std::istringstream range_stream(range);
+      range_stream >> first;
+      if (!(range_stream >> separator >> last)) {
+        last = first;
+      }
+      for (int node{first}; node >= 0 && node <= last; ++node) {
+        nodes.emplace_back(node);
+      }
+    }
+    return nodes;
+  }()};
+
+  return nodes.size() > 1 ? nodes[part_index % nodes.size()] : -1;
+}
+
+size_t ValueArena::page_index_(const char* const value) const {
+  auto it{page_indices_.upper_bound(value)};
+  HCTR_CHECK(it != page_indices_.begin());
+  --it;
+  HCTR_CHECK(value < it->first + page_size_);
+  return it->second;
+}
+
+void ValueArena::map_page_() {
+  void* data{MAP_FAILED};
+
+  // Huge pages are reserved upon mapping. Hence, this fails if the pool is exhausted, instead of
+  // raising SIGBUS once the memory is touched.
+  if (huge_pages_ == DatabaseHugePages_t::Explicit) {
+    data = mmap(nullptr, page_size_, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data == MAP_FAILED) {
+      static std::atomic<bool> warned{false};
+      if (!warned.exchange(true)) {
+        HCTR_LOG_S(WARNING, WORLD) << "Unable to allocate explicit huge pages (check "
+                                      "/proc/sys/vm/nr_hugepages). Falling back to transparent "
+                                      "huge pages."
+                                   << std::endl;
+      }
+    }
+  }
+  if (data == MAP_FAILED) {
+    data = mmap(nullptr, page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    if (huge_pages_ != DatabaseHugePages_t::Disabled) {
+      madvise(data, page_size_, MADV_HUGEPAGE);
+    }
+  }
+
+  // Memory is only placed once faulted in. Hence, the policy must be set beforehand.
+  if (numa_node_ >= 0) {
+    // Node ids can exceed the width of a single mask word. The kernel ignores the last bit.
+    constexpr size_t bits_per_word{sizeof(unsigned long) * 8};
+    const size_t node{static_cast<size_t>(numa_node_)};
+    std::vector<unsigned long> node_mask(node / bits_per_word + 1);
+    node_mask[node / bits_per_word] = 1UL << (node % bits_per_word);
+    if (syscall(SYS_mbind, data, page_size_, MPOL_PREFERRED, node_mask.data(),
+                node_mask.size() * bits_per_word + 1, 0)) {
+      HCTR_LOG_S(DEBUG, WORLD) << "Unable to prefer NUMA node " << numa_node_ << " for "
+                               << page_size_ << " bytes." << std::endl;
+    }
+  }
+
+  const size_t page_index{pages_.size()};
+  pages_.push_back({static_cast<char*>(data), 0, slots_per_page_, {}, true, false});
+  page_indices_.emplace(static_cast<char*>(data), page_index);
+  open_pages_.emplace(page_index);
+}
+
+void ValueArena::release_page_(const size_t page_index) {
+  Page& page{pages_[page_index]};
+  HCTR_CHECK(page.num_used == 0);
+
+  // The address range remains mapped. Subsequent reads yield zeroes (or the original contents of
+  // pages adopted by `map_image`).
+  madvise(page.data, page_size_, MADV_DONTNEED);
+
+  page.num_untouched = slots_per_page_;
+  page.free_slots.clear();
+  page.free_slots.shrink_to_fit();
+  page.resident = false;
+  page.draining = false;
+  open_pages_.erase(page_index);
+  released_pages_.emplace_back(page_index);
+}
+
+void ValueArena::unmap_pages_() {
+  for (const Page& page : pages_) {
+    munmap(page.data, page_size_);
+  }
+  pages_.clear();
+  page_indices_.clear();
+  open_pages_.clear();
+  released_pages_.clear();
+  num_used_ = 0;
+}
+
+}  // namespace HugeCTR
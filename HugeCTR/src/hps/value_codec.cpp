@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <core23/logger.hpp>
+#include <cstring>
+#include <hps/value_codec.hpp>
+
+// TODO: Remove me!
+#pragma GCC diagnostic error "-Wconversion"
+
+namespace HugeCTR {
+
+namespace {
+
+// Encoded values are not aligned. Hence, all accesses go through `memcpy`, which the compiler
+// lowers to plain (unaligned) loads and stores.
+template <typename T>
+inline T load(const char* const src) {
+  T value;
+  std::memcpy(&value, src, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline void store(char* const dst, const T value) {
+  std::memcpy(dst, &value, sizeof(T));
+}
+
+// IEEE 754 binary32 <-> binary16 conversion with round-to-nearest-even. Subnormals, infinities and
+// NaNs are retained.
+inline uint16_t float_to_half(const float f) {
+  uint32_t x{load<uint32_t>(reinterpret_cast<const char*>(&f))};
+  const uint32_t sign{(x >> 16) & 0x8000};
+  x &= 0x7fffffff;
+
+  uint32_t h;
+  if (x >= 0x47800000) {
+    // Overflow, infinity or NaN.
+    h = x > 0x7f800000 ? 0x7e00 : 0x7c00;
+  } else if (x < 0x38800000) {
+    // Subnormal or zero. Let the FPU round by aligning the mantissa through an addition.
+    constexpr uint32_t magic_bits{126U << 23};
+    const float magic{load<float>(reinterpret_cast<const char*>(&magic_bits))};
+    const float tmp{load<float>(reinterpret_cast<const char*>(&x)) + magic};
+    h = load<uint32_t>(reinterpret_cast<const char*>(&tmp)) - magic_bits;
+  } else {
+    // Normal number. Rebias exponent and round mantissa.
+    const uint32_t mantissa_odd{(x >> 13) & 1};
+    x += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + mantissa_odd;
+    h = x >> 13;
+  }
+  return static_cast<uint16_t>(h | sign);
+}
+
+// Decoding is on the lookup path. Hence, all cases are computed and selected without branches,
+// which allows the compiler to vectorize the calling loop.
+inline float half_to_float(const uint16_t h) {
+  const uint32_t bits{h & 0x7fffU};
+  const uint32_t exponent{bits & 0x7c00U};
+
+  // Normal numbers: Rebias exponent. Infinity and NaN: Saturate exponent.
+  const uint32_t inf_nan_mask{0U - static_cast<uint32_t>(exponent == 0x7c00U)};
+  const uint32_t normal{((bits << 13) + ((127U - 15U) << 23)) | (inf_nan_mask & 0x7f800000U)};
+
+  // Subnormal numbers and zero: Scale mantissa (exact).
+  const float subnormal_value{static_cast<float>(static_cast<int32_t>(bits)) * 0x1p-24f};
+  const uint32_t subnormal{load<uint32_t>(reinterpret_cast<const char*>(&subnormal_value))};
+
+  const uint32_t subnormal_mask{0U - static_cast<uint32_t>(exponent == 0)};
+  const uint32_t sign{static_cast<uint32_t>(h & 0x8000U) << 16};
+  const uint32_t x{(subnormal & subnormal_mask) | (normal & ~subnormal_mask) | sign};
+  return load<float>(reinterpret_cast<const char*>(&x));
+}
+
+// IEEE 754 binary32 <-> bfloat16 conversion with round-to-nearest-even.
+inline uint16_t float_to_bfloat(const float f) {
+  const uint32_t x{load<uint32_t>(reinterpret_cast<const char*>(&f))};
+  if ((x & 0x7fffffff) > 0x7f800000) {
+    // Keep NaNs quiet (rounding could turn them into infinities).
+    return static_cast<uint16_t>((x >> 16) | 0x40);
+  }
+  return static_cast<uint16_t>((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+}
+
+inline float bfloat_to_float(const uint16_t b) {
+  const uint32_t x{static_cast<uint32_t>(b) << 16};
+  return load<float>(reinterpret_cast<const char*>(&x));
+}
+
+// Size of the `[scale, bias]` header of int8 encoded values.
+constexpr size_t int8_header_size{2 * sizeof(float)};
+
+}  // namespace
+
+size_t ValueCodec::encoded_size(const size_t value_size) const {
+  if (type_ == DatabaseValueCodec_t::Float32) {
+    return value_size;
+  }
+
+  HCTR_CHECK_HINT(value_size % sizeof(float) == 0, "Value codec ", type_,
+                  " requires values to consist of `float`s, but value size is ", value_size,
+                  " bytes.");
+  const size_t num_elements{value_size / sizeof(float)};
+  switch (type_) {
+    case DatabaseValueCodec_t::Float16:
+    case DatabaseValueCodec_t::BFloat16:
+      return num_elements * sizeof(uint16_t);
+    case DatabaseValueCodec_t::Int8:
+      return int8_header_size + num_elements * sizeof(uint8_t);
+    default:
+      HCTR_DIE("Unsupported value codec!");
+  }
+  return 0;
+}
+
+size_t ValueCodec::decoded_size(const size_t encoded_size) const {
+  switch (type_) {
+    case DatabaseValueCodec_t::Float32:
+      return encoded_size;
+    case DatabaseValueCodec_t::Float16:
+    case DatabaseValueCodec_t::BFloat16:
+      HCTR_CHECK(encoded_size % sizeof(uint16_t) == 0);
+      return encoded_size / sizeof(uint16_t) * sizeof(float);
+    case DatabaseValueCodec_t::Int8:
+      HCTR_CHECK(encoded_size >= int8_header_size);
+      return (encoded_size - int8_header_size) * sizeof(float);
+    default:
+      HCTR_DIE("Unsupported value codec!");
+  }
+  return 0;
+}
+
+void ValueCodec::encode_(const char* const value, const size_t value_size,
+                         char* const encoded) const {
+  const size_t num_elements{value_size / sizeof(float)};
+
+  switch (type_) {
+    case DatabaseValueCodec_t::Float16:
+      for (size_t i{0}; i < num_elements; ++i) {
+        store(&encoded[i * sizeof(uint16_t)],
+              float_to_half(load<float>(&value[i * sizeof(float)])));
+      }
+      break;
+    case DatabaseValueCodec_t::BFloat16:
+      for (size_t i{0}; i < num_elements; ++i) {
+        store(&encoded[i * sizeof(uint16_t)],
+              float_to_bfloat(load<float>(&value[i * sizeof(float)])));
+      }
+      break;
+    case DatabaseValueCodec_t::Int8: {
+      // Row-wise affine quantization onto [0, 255].
+      float min_value{0}, max_value{0};
+      if (num_elements) {
+        min_value = max_value = load<float>(value);
+        for (size_t i{1}; i < num_elements; ++i) {
+          const float x{load<float>(&value[i * sizeof(float)])};
+          min_value = std::min(min_value, x);
+          max_value = std::max(max_value, x);
+        }
+      }
+      const float scale{(max_value - min_value) / 255.f};
+      const float inv_scale{scale > 0.f ? 1.f / scale : 0.f};
+      store(encoded, scale);
+      store(&encoded[sizeof(float)], min_value);
+
+      uint8_t* const q{reinterpret_cast<uint8_t*>(&encoded[int8_header_size])};
+      for (size_t i{0}; i < num_elements; ++i) {
+        const float x{(load<float>(&value[i * sizeof(float)]) - min_value) * inv_scale + 0.5f};
+        q[i] = static_cast<uint8_t>(std::min(std::max(x, 0.f), 255.f));
+      }
+    } break;
+    default:
+      HCTR_DIE("Unsupported value codec!");
+  }
+}
+
+void ValueCodec::decode_(const char* const encoded, const size_t value_size,
+                         char* const value) const {
+  const size_t num_elements{value_size / sizeof(float)};
+
+  switch (type_) {
+    case DatabaseValueCodec_t::Float16:
+      for (size_t i{0}; i < num_elements; ++i) {
+        store(&value[i * sizeof(float)],
+              half_to_float(load<uint16_t>(&encoded[i * sizeof(uint16_t)])));
+      }
+      break;
+    case DatabaseValueCodec_t::BFloat16:
+      for (size_t i{0}; i < num_elements; ++i) {
+        store(&value[i * sizeof(float)],
+              bfloat_to_float(load<uint16_t>(&encoded[i * sizeof(uint16_t)])));
+      }
+      break;
+    case DatabaseValueCodec_t::Int8: {
+      const float scale{load<float>(encoded)};
+      const float bias{load<float>(&encoded[sizeof(float)])};
+
+      const uint8_t* const q{reinterpret_cast<const uint8_t*>(&encoded[int8_header_size])};
+      for (size_t i{0}; i < num_elements; ++i) {
+        store(&value[i * sizeof(float)], bias + scale * static_cast<float>(q[i]));
+      }
+    } break;
+    default:
+      HCTR_DIE("Unsupported value codec!");
+  }
+}
+
+}  // namespace HugeCTR
@@ -468,6 +468,11 @@ Model::Model(const Solver& solver, const DataReaderParams& reader_params,
     KafkaMessageSinkParams params;
     params.brokers = solver_.kafka_brokers;
     message_sink_ = std::make_shared<KafkaMessageSink<long long>>(params);
+  } else if (etc_params_->use_embedding_training_cache &&
+             solver_.local_message_queue_path.length()) {
+    LocalMessageSinkParams params;
+    params.path = solver_.local_message_queue_path;
+    message_sink_ = std::make_shared<LocalMessageSink<long long>>(params);
   }
   if (etc_params_->use_embedding_training_cache && solver_.repeat_dataset) {
     HCTR_OWN_THROW(Error_t::WrongInput,
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cpu/embedding_feature_combiner_cpu.hpp>
+#include <cpu/gemm_cpu.hpp>
+#include <general_buffer2.hpp>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures the throughput of \p EmbeddingFeatureCombinerCPU on multi-hot inputs. The number of
+ * features per slot follows a geometric distribution with the given mean (i.e., most slots are
+ * short, but there is a long tail). The old per-dimension loop serves as baseline.
+ *
+ * Usage: embedding_feature_combiner_cpu_bench [batch_size] [slot_num] [num_threads] [duration_s]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+struct Config {
+  int batch_size{1024};
+  int slot_num{26};
+  size_t num_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+  double duration_s{1};
+};
+
+void naive_combine(const float* input, float* output, const int* row_ptrs, int batch_size,
+                   int slot_num, int embedding_vec_size) {
+  for (int i = 0; i < batch_size; i++) {
+    for (int j = 0; j < slot_num; j++) {
+      int feature_row_index = i * slot_num + j;
+      int row_offset = row_ptrs[feature_row_index];
+      int feature_num = row_ptrs[feature_row_index + 1] - row_offset;
+      for (int k = 0; k < embedding_vec_size; k++) {
+        float tmp = 0.0f;
+        for (int l = 0; l < feature_num; l++) {
+          tmp += input[(row_offset + l) * embedding_vec_size + k];
+        }
+        output[feature_row_index * embedding_vec_size + k] = tmp;
+      }
+    }
+  }
+}
+
+// Returns the number of input bytes combined per second.
+template <typename Func>
+double measure(const size_t num_bytes, const double duration_s, const Func& func) {
+  func();  // Warm up.
+
+  size_t num_runs{0};
+  const auto t0{std::chrono::steady_clock::now()};
+  std::chrono::duration<double> elapsed;
+  do {
+    func();
+    ++num_runs;
+    elapsed = std::chrono::steady_clock::now() - t0;
+  } while (elapsed.count() < duration_s);
+
+  return static_cast<double>(num_bytes * num_runs) / elapsed.count();
+}
+
+template <typename TypeEmbedding>
+void run(const Config& cfg, const int embedding_vec_size, const double mean_hotness) {
+  std::mt19937 gen{42};
+  std::geometric_distribution<int> nnz_dist{1.0 / mean_hotness};
+  std::vector<int> row_ptrs(cfg.batch_size * cfg.slot_num + 1, 0);
+  for (size_t i = 1; i < row_ptrs.size(); i++) {
+    row_ptrs[i] = row_ptrs[i - 1] + 1 + nnz_dist(gen);
+  }
+  const size_t feature_num{static_cast<size_t>(row_ptrs.back())};
+
+  auto blobs_buff{GeneralBuffer2<HostAllocator>::create()};
+  auto in_tensor{std::make_shared<Tensor2<float>>()};
+  auto row_ptrs_tensor{std::make_shared<Tensor2<int>>()};
+  blobs_buff->reserve({feature_num, static_cast<size_t>(embedding_vec_size)}, in_tensor.get());
+  blobs_buff->reserve({row_ptrs.size()}, row_ptrs_tensor.get());
+  Tensor2<TypeEmbedding> out_tensor;
+  EmbeddingFeatureCombinerCPU<TypeEmbedding> combiner(in_tensor, row_ptrs_tensor, out_tensor,
+                                                      cfg.batch_size, cfg.slot_num,
+                                                      EmbeddingFeatureCombiner_t::Sum, blobs_buff);
+  blobs_buff->allocate();
+
+  std::uniform_real_distribution<float> value_dist{-1, 1};
+  std::generate_n(in_tensor->get_ptr(), in_tensor->get_num_elements(),
+                  [&]() { return value_dist(gen); });
+  std::copy(row_ptrs.begin(), row_ptrs.end(), row_ptrs_tensor->get_ptr());
+  const size_t num_bytes{in_tensor->get_size_in_bytes()};
+
+  std::vector<float> naive_output(out_tensor.get_num_elements());
+  const double naive_rate{measure(num_bytes, cfg.duration_s, [&]() {
+    naive_combine(in_tensor->get_ptr(), naive_output.data(), row_ptrs.data(), cfg.batch_size,
+                  cfg.slot_num, embedding_vec_size);
+  })};
+  set_gemm_cpu_num_threads(1);
+  const double rate_1{measure(num_bytes, cfg.duration_s, [&]() { combiner.fprop(false); })};
+  set_gemm_cpu_num_threads(cfg.num_threads);
+  const double rate_n{measure(num_bytes, cfg.duration_s, [&]() { combiner.fprop(false); })};
+
+  HCTR_LOG_S(INFO, ROOT) << (std::is_same_v<TypeEmbedding, float> ? "fp32" : "fp16")
+                         << " output, embedding_vec_size = " << embedding_vec_size
+                         << ", mean hotness = " << mean_hotness
+                         << ", features = " << feature_num
+                         << ", naive = " << naive_rate / 1e9
+                         << " GB/s, 1 thread = " << rate_1 / 1e9 << " GB/s, " << cfg.num_threads
+                         << " threads = " << rate_n / 1e9 << " GB/s" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.batch_size;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.slot_num;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.num_threads;
+  if (argc >= 5) std::istringstream(argv[4]) >> cfg.duration_s;
+
+  for (const int embedding_vec_size : {16, 64, 128}) {
+    for (const double mean_hotness : {1.0, 4.0, 20.0}) {
+      run<float>(cfg, embedding_vec_size, mean_hotness);
+      run<__half>(cfg, embedding_vec_size, mean_hotness);
+    }
+  }
+  return 0;
+}
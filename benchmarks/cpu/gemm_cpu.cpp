@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cpu/gemm_cpu.hpp>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures the throughput of \p gemm_cpu for the fully connected layer shapes of the DLRM and DCN
+ * sample models, at various batch sizes. The naive triple loop that the CPU layers used before
+ * serves as baseline. If the peak performance of a single core is given (i.e., `clock rate * FMA
+ * units * vector lanes * 2`), the gap to peak FLOPs is reported as well.
+ *
+ * Usage: gemm_cpu_bench [peak_gflops_per_core] [num_threads] [duration_s]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+struct Config {
+  double peak_gflops_per_core{0};
+  size_t num_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+  double duration_s{1};
+};
+
+struct Shape {
+  const char* layer;
+  size_t k;
+  size_t n;
+};
+
+// Bottom and top MLP of DLRM (Criteo), and the deep part of DCN.
+const Shape shapes[]{
+    {"dlrm_bottom_0", 13, 512},  {"dlrm_bottom_1", 512, 256}, {"dlrm_bottom_2", 256, 128},
+    {"dlrm_top_0", 479, 1024},   {"dlrm_top_1", 1024, 1024},  {"dlrm_top_2", 1024, 512},
+    {"dlrm_top_3", 512, 256},    {"dcn_deep_0", 429, 1024},   {"dcn_deep_1", 1024, 1024},
+};
+
+void naive_mm(const float* a, const float* b, float* c, size_t m, size_t k, size_t n) {
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      c[i * n + j] = 0.0f;
+      for (size_t kk = 0; kk < k; ++kk) c[i * n + j] += a[i * k + kk] * b[kk * n + j];
+    }
+  }
+}
+
+// Returns the achieved GFLOP/s.
+template <typename Func>
+double measure(const size_t m, const size_t n, const size_t k, const double duration_s,
+               const Func& func) {
+  func();  // Warm up.
+
+  size_t num_runs{0};
+  const auto t0{std::chrono::steady_clock::now()};
+  std::chrono::duration<double> elapsed;
+  do {
+    func();
+    ++num_runs;
+    elapsed = std::chrono::steady_clock::now() - t0;
+  } while (elapsed.count() < duration_s);
+
+  return static_cast<double>(2 * m * n * k * num_runs) / elapsed.count() / 1e9;
+}
+
+void run(const Config& cfg, const Shape& shape, const size_t batch_size) {
+  const size_t m{batch_size};
+  const size_t n{shape.n};
+  const size_t k{shape.k};
+
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<float> dist{-1, 1};
+  std::vector<float> a(m * k);
+  std::vector<float> b(k * n);
+  std::vector<float> c(m * n);
+  std::generate(a.begin(), a.end(), [&]() { return dist(gen); });
+  std::generate(b.begin(), b.end(), [&]() { return dist(gen); });
+  std::vector<__half> a_half(a.begin(), a.end());
+  std::vector<__half> b_half(b.begin(), b.end());
+
+  // The naive loop is only measured for small problems. Otherwise it takes too long.
+  double naive_gflops{0};
+  if (m * n * k <= size_t{1} << 27) {
+    naive_gflops = measure(m, n, k, cfg.duration_s,
+                           [&]() { naive_mm(a.data(), b.data(), c.data(), m, k, n); });
+  }
+
+  set_gemm_cpu_num_threads(1);
+  const double gflops_1{
+      measure(m, n, k, cfg.duration_s,
+              [&]() { gemm_cpu(m, n, k, a.data(), b.data(), c.data()); })};
+  set_gemm_cpu_num_threads(cfg.num_threads);
+  const double gflops_n{
+      measure(m, n, k, cfg.duration_s,
+              [&]() { gemm_cpu(m, n, k, a.data(), b.data(), c.data()); })};
+  const double gflops_half{
+      measure(m, n, k, cfg.duration_s,
+              [&]() { gemm_cpu(m, n, k, a_half.data(), b_half.data(), c.data()); })};
+
+  std::ostringstream log;
+  log << shape.layer << ", m = " << m << ", n = " << n << ", k = " << k;
+  if (naive_gflops > 0) {
+    log << ", naive = " << naive_gflops << " GFLOP/s";
+  }
+  log << ", 1 thread = " << gflops_1 << " GFLOP/s";
+  if (cfg.peak_gflops_per_core > 0) {
+    log << " (" << 100 * gflops_1 / cfg.peak_gflops_per_core << "% of peak)";
+  }
+  log << ", " << cfg.num_threads << " threads = " << gflops_n << " GFLOP/s";
+  if (cfg.peak_gflops_per_core > 0) {
+    log << " (" << 100 * gflops_n / (cfg.peak_gflops_per_core * cfg.num_threads) << "% of peak)";
+  }
+  log << ", fp16 inputs = " << gflops_half << " GFLOP/s";
+  HCTR_LOG_S(INFO, ROOT) << log.str() << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.peak_gflops_per_core;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.num_threads;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.duration_s;
+
+  HCTR_LOG_S(INFO, ROOT) << "Micro-kernel: " << gemm_cpu_isa() << std::endl;
+  for (const size_t batch_size : {1, 64, 1024}) {
+    for (const Shape& shape : shapes) {
+      run(cfg, shape, batch_size);
+    }
+  }
+  return 0;
+}
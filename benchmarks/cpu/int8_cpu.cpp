@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <core23/logger.hpp>
+#include <cpu/gemm_cpu.hpp>
+#include <cpu/layers/fully_connected_layer_cpu.hpp>
+#include <general_buffer2.hpp>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Reports the accuracy and throughput of int8 inference (see \p NetworkCPU::quantize ) for the
+ * MLPs of the DLRM and DCN sample models. Each MLP is evaluated in fp32, and in int8 with inputs
+ * quantized with calibrated scales (static) or per row (dynamic). The calibration batch and the
+ * evaluation batch are drawn independently. Accuracy is the deviation of the predicted
+ * probabilities (i.e., the sigmoid of the logits) from fp32.
+ *
+ * Usage: int8_cpu_bench [batch_size] [num_threads] [duration_s]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+struct Config {
+  size_t batch_size{1024};
+  size_t num_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+  double duration_s{1};
+};
+
+struct Model {
+  const char* name;
+  std::vector<size_t> dims;  // Input width, followed by the outputs of each layer. The last layer
+                             // computes the logits, all others are followed by ReLU.
+};
+
+// Top MLP of DLRM (Criteo), and the deep part of DCN (followed by the logit layer).
+const Model models[]{
+    {"dlrm_top", {479, 1024, 1024, 512, 256, 1}},
+    {"dcn_deep", {429, 1024, 1024, 1}},
+};
+
+// A stack of fully connected layers with Xavier-initialized weights.
+class Mlp {
+ public:
+  Mlp(const Model& model, const size_t batch_size)
+      : blobs_buff_{GeneralBuffer2<HostAllocator>::create()},
+        params_buff_{GeneralBuffer2<HostAllocator>::create()} {
+    std::vector<std::shared_ptr<BufferBlock2<float>>> weight_buffs;
+    blobs_buff_->reserve({batch_size, model.dims.front()}, &input_);
+    Tensor2<float> bottom{input_};
+    for (size_t i = 1; i < model.dims.size(); i++) {
+      Tensor2<float> top;
+      blobs_buff_->reserve({batch_size, model.dims[i]}, &top);
+      weight_buffs.emplace_back(params_buff_->create_block<float>());
+      layers_.emplace_back(std::make_unique<FullyConnectedLayerCPU<float>>(
+          weight_buffs.back(), blobs_buff_->create_block<float>(), Tensors2<float>{bottom}, top,
+          false, i + 1 < model.dims.size()));
+      bottom = top;
+    }
+    output_ = bottom;
+    blobs_buff_->allocate();
+    params_buff_->allocate();
+
+    std::mt19937 gen{42};
+    for (size_t i = 1; i < model.dims.size(); i++) {
+      const float limit{std::sqrt(6.f / (model.dims[i - 1] + model.dims[i]))};
+      std::uniform_real_distribution<float> dist{-limit, limit};
+      Tensor2<float> weights{weight_buffs[i - 1]->as_tensor()};
+      std::generate_n(weights.get_ptr(), weights.get_num_elements(), [&]() { return dist(gen); });
+    }
+  }
+
+  // Returns the predicted probabilities for the given inputs.
+  std::vector<float> predict(const std::vector<float>& input) {
+    std::copy(input.begin(), input.end(), input_.get_ptr());
+    fprop();
+    std::vector<float> output(output_.get_ptr(), output_.get_ptr() + output_.get_num_elements());
+    for (float& x : output) {
+      x = 1.f / (1.f + std::exp(-x));
+    }
+    return output;
+  }
+
+  void fprop() {
+    for (auto& layer : layers_) {
+      layer->fprop(false);
+    }
+  }
+
+  void calibrate(const std::vector<float>& input) {
+    for (auto& layer : layers_) {
+      layer->set_calibration(true);
+    }
+    predict(input);
+    for (auto& layer : layers_) {
+      layer->set_calibration(false);
+    }
+  }
+
+  void quantize() {
+    for (auto& layer : layers_) {
+      layer->quantize(nullptr);
+    }
+  }
+
+ private:
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> blobs_buff_;
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> params_buff_;
+  std::vector<std::unique_ptr<FullyConnectedLayerCPU<float>>> layers_;
+  Tensor2<float> input_;
+  Tensor2<float> output_;
+};
+
+// Returns the number of samples processed per second.
+template <typename Func>
+double measure(const size_t batch_size, const double duration_s, const Func& func) {
+  func();  // Warm up.
+
+  size_t num_runs{0};
+  const auto t0{std::chrono::steady_clock::now()};
+  std::chrono::duration<double> elapsed;
+  do {
+    func();
+    ++num_runs;
+    elapsed = std::chrono::steady_clock::now() - t0;
+  } while (elapsed.count() < duration_s);
+
+  return static_cast<double>(batch_size * num_runs) / elapsed.count();
+}
+
+std::vector<float> random_batch(const size_t num_elements, std::mt19937& gen) {
+  std::normal_distribution<float> dist{0, 1};
+  std::vector<float> batch(num_elements);
+  std::generate(batch.begin(), batch.end(), [&]() { return dist(gen); });
+  return batch;
+}
+
+void run(const Config& cfg, const Model& model) {
+  std::mt19937 gen{7};
+  const size_t input_size{cfg.batch_size * model.dims.front()};
+  const std::vector<float> calibration_batch{random_batch(input_size, gen)};
+  const std::vector<float> batch{random_batch(input_size, gen)};
+
+  Mlp fp32{model, cfg.batch_size};
+  const std::vector<float> ref{fp32.predict(batch)};
+  const double fp32_rate{measure(cfg.batch_size, cfg.duration_s, [&]() { fp32.fprop(); })};
+
+  std::ostringstream log;
+  log << model.name << ", batch size = " << cfg.batch_size << ", " << cfg.num_threads
+      << " threads, fp32 = " << fp32_rate << " samples/s";
+  for (const bool calibrated : {true, false}) {
+    Mlp int8{model, cfg.batch_size};
+    if (calibrated) {
+      int8.calibrate(calibration_batch);
+    }
+    int8.quantize();
+    const std::vector<float> output{int8.predict(batch)};
+    const double int8_rate{measure(cfg.batch_size, cfg.duration_s, [&]() { int8.fprop(); })};
+
+    double max_error{0};
+    double sum_error{0};
+    for (size_t i = 0; i < output.size(); i++) {
+      const double error{std::abs(output[i] - ref[i])};
+      max_error = std::max(max_error, error);
+      sum_error += error;
+    }
+    log << ", int8 " << (calibrated ? "static" : "dynamic") << " = " << int8_rate
+        << " samples/s (" << int8_rate / fp32_rate << "x, max error = " << max_error
+        << ", mean error = " << sum_error / output.size() << ")";
+  }
+  HCTR_LOG_S(INFO, ROOT) << log.str() << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.batch_size;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.num_threads;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.duration_s;
+
+  set_gemm_cpu_num_threads(cfg.num_threads);
+  HCTR_LOG_S(INFO, ROOT) << "fp32 kernel: " << gemm_cpu_isa()
+                         << ", int8 kernel: " << gemm_int8_cpu_isa() << std::endl;
+  for (const Model& model : models) {
+    run(cfg, model);
+  }
+  return 0;
+}
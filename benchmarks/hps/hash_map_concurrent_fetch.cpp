@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cstdint>
+#include <hps/hash_map_backend.hpp>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures how the fetch throughput of a \p HashMapBackend scales with the number of concurrently
+ * querying threads. Each thread looks up batches of uniformly distributed random keys.
+ *
+ * Usage: hash_map_concurrent_fetch_bench [max_num_threads] [num_keys] [batch_size] [duration_s]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+using Key = long long;
+
+constexpr size_t value_size{32 * sizeof(float)};
+const std::string table_name{"concurrent_fetch_bench"};
+
+struct Config {
+  size_t max_num_threads{64};
+  size_t num_keys{8L * 1024 * 1024};
+  size_t batch_size{1024};
+  double duration_s{5};
+};
+
+double run(HashMapBackend<Key>& db, const Config& cfg, const size_t num_threads) {
+  std::atomic<bool> start{false};
+  std::atomic<bool> stop{false};
+  std::vector<size_t> num_fetched(num_threads);
+
+  std::vector<std::thread> threads;
+  for (size_t t{0}; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937_64 gen{t};
+      std::uniform_int_distribution<Key> dist{0, static_cast<Key>(cfg.num_keys) - 1};
+      std::vector<Key> keys(cfg.batch_size);
+      std::vector<char> values(cfg.batch_size * value_size);
+
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+
+      size_t n{0};
+      while (!stop.load(std::memory_order_relaxed)) {
+        std::generate(keys.begin(), keys.end(), [&]() { return dist(gen); });
+        n += db.fetch(table_name, keys.size(), keys.data(), values.data(), value_size,
+                      [](size_t) {}, std::chrono::nanoseconds::max());
+      }
+      num_fetched[t] = n;
+    });
+  }
+
+  const auto t0{std::chrono::steady_clock::now()};
+  start.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(std::chrono::duration<double>(cfg.duration_s));
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - t0};
+
+  return static_cast<double>(std::accumulate(num_fetched.begin(), num_fetched.end(), size_t{0})) /
+         elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.max_num_threads;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.num_keys;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.batch_size;
+  if (argc >= 5) std::istringstream(argv[4]) >> cfg.duration_s;
+
+  for (const DatabaseOverflowPolicy_t policy :
+       {DatabaseOverflowPolicy_t::EvictRandom, DatabaseOverflowPolicy_t::EvictLeastUsed,
+        DatabaseOverflowPolicy_t::EvictOldest}) {
+    // A single partition, so that lookups are not dispatched to the thread pool.
+    HashMapBackendParams params;
+    params.num_partitions = 1;
+    params.overflow_policy = policy;
+    HashMapBackend<Key> db{params};
+
+    std::vector<Key> keys(64 * 1024);
+    std::vector<char> values(keys.size() * value_size);
+    for (size_t i{0}; i < cfg.num_keys; i += keys.size()) {
+      const size_t n{std::min(keys.size(), cfg.num_keys - i)};
+      std::iota(keys.begin(), keys.begin() + n, static_cast<Key>(i));
+      db.insert(table_name, n, keys.data(), values.data(), value_size, value_size);
+    }
+
+    double base_rate{0};
+    for (size_t num_threads{1}; num_threads <= cfg.max_num_threads; num_threads *= 2) {
+      const double rate{run(db, cfg, num_threads)};
+      if (num_threads == 1) {
+        base_rate = rate;
+      }
+
+      HCTR_LOG_S(INFO, ROOT) << "policy = " << policy << ", threads = " << num_threads
+                             << ", throughput = " << rate / 1e6 << " M keys/s"
+                             << ", speedup = " << rate / base_rate << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cstdint>
+#include <hps/hash_map_backend.hpp>
+#include <inference_key_generator.hpp>
+#include <list>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Measures how well a \p HashMapBackend with \p DatabaseOverflowPolicy_t::EvictOldest retains the
+ * working set of a power-law distributed key stream. The backend is used as a cache: Each batch is
+ * fetched, and the missing keys are inserted afterwards. The hit rate is compared against an exact
+ * LRU cache with the same overflow behavior, which serves as an oracle.
+ *
+ * Usage: hash_map_eviction_quality_bench [num_keys] [alpha] [overflow_margin] [batch_size]
+ *                                        [num_batches]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+using Key = long long;
+
+constexpr size_t value_size{8 * sizeof(float)};
+const std::string table_name{"eviction_quality_bench"};
+
+struct Config {
+  size_t num_keys{10L * 1024 * 1024};
+  float alpha{1.2f};
+  size_t overflow_margin{64L * 1024};
+  size_t batch_size{1024};
+  size_t num_batches{4 * 1024};
+  double overflow_resolution_target{0.8};
+};
+
+/**
+ * Exact LRU cache. Mimics the way the backends resolve overflows.
+ */
+class LRUOracle final {
+ public:
+  LRUOracle(const Config& cfg)
+      : overflow_margin_{cfg.overflow_margin},
+        overflow_resolution_margin_{static_cast<size_t>(
+            static_cast<double>(cfg.overflow_margin) * cfg.overflow_resolution_target + 0.5)} {}
+
+  size_t fetch(const std::vector<Key>& keys, std::vector<Key>& missed_keys) {
+    size_t hit_count{0};
+    for (const Key& k : keys) {
+      const auto& it{entries_.find(k)};
+      if (it != entries_.end()) {
+        lru_.splice(lru_.end(), lru_, it->second);
+        ++hit_count;
+      } else {
+        missed_keys.emplace_back(k);
+      }
+    }
+    return hit_count;
+  }
+
+  void insert(const std::vector<Key>& keys) {
+    if (entries_.size() >= overflow_margin_) {
+      while (entries_.size() > overflow_resolution_margin_) {
+        entries_.erase(lru_.front());
+        lru_.pop_front();
+      }
+    }
+
+    for (const Key& k : keys) {
+      const auto& it{entries_.find(k)};
+      if (it != entries_.end()) {
+        lru_.splice(lru_.end(), lru_, it->second);
+      } else {
+        entries_.emplace(k, lru_.emplace(lru_.end(), k));
+      }
+    }
+  }
+
+ private:
+  const size_t overflow_margin_;
+  const size_t overflow_resolution_margin_;
+  std::list<Key> lru_;
+  std::unordered_map<Key, std::list<Key>::iterator> entries_;
+};
+
+double run_oracle(const Config& cfg, const std::vector<std::vector<Key>>& trace) {
+  LRUOracle oracle{cfg};
+
+  size_t hit_count{0};
+  size_t num_keys{0};
+  std::vector<Key> missed_keys;
+  for (const std::vector<Key>& keys : trace) {
+    missed_keys.clear();
+    hit_count += oracle.fetch(keys, missed_keys);
+    oracle.insert(missed_keys);
+    num_keys += keys.size();
+  }
+  return static_cast<double>(hit_count) / static_cast<double>(num_keys);
+}
+
+void run(const Config& cfg, const std::vector<std::vector<Key>>& trace, const double oracle_rate,
+         const DatabaseRecencySource_t recency_source, const size_t sample_size) {
+  HashMapBackendParams params;
+  params.max_batch_size = cfg.batch_size;
+  params.num_partitions = 1;
+  params.overflow_margin = cfg.overflow_margin;
+  params.overflow_policy = DatabaseOverflowPolicy_t::EvictOldest;
+  params.overflow_resolution_target = cfg.overflow_resolution_target;
+  params.overflow_sample_size = sample_size;
+  params.recency_source = recency_source;
+  HashMapBackend<Key> db{params};
+
+  size_t hit_count{0};
+  size_t num_keys{0};
+  std::vector<char> values(cfg.batch_size * value_size);
+  std::vector<Key> missed_keys;
+
+  const auto t0{std::chrono::steady_clock::now()};
+  for (const std::vector<Key>& keys : trace) {
+    missed_keys.clear();
+    hit_count += db.fetch(
+        table_name, keys.size(), keys.data(), values.data(), value_size,
+        [&](const size_t i) { missed_keys.emplace_back(keys[i]); },
+        std::chrono::nanoseconds::max());
+    db.insert(table_name, missed_keys.size(), missed_keys.data(), values.data(), value_size,
+              value_size);
+    num_keys += keys.size();
+  }
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - t0};
+
+  const double rate{static_cast<double>(hit_count) / static_cast<double>(num_keys)};
+  HCTR_LOG_S(INFO, ROOT) << "recency_source = " << recency_source
+                         << ", sample_size = " << sample_size << ", hit rate = " << rate
+                         << ", exact LRU hit rate = " << oracle_rate
+                         << ", ratio = " << rate / oracle_rate << ", time = " << elapsed.count()
+                         << " s" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.num_keys;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.alpha;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.overflow_margin;
+  if (argc >= 5) std::istringstream(argv[4]) >> cfg.batch_size;
+  if (argc >= 6) std::istringstream(argv[5]) >> cfg.num_batches;
+
+  // Generate the trace upfront, so that every configuration replays the same key stream.
+  std::vector<std::vector<Key>> trace(cfg.num_batches, std::vector<Key>(cfg.batch_size));
+  for (std::vector<Key>& keys : trace) {
+    batch_key_generator_by_powerlaw(keys.data(), keys.size(), cfg.num_keys, cfg.alpha);
+  }
+
+  const double oracle_rate{run_oracle(cfg, trace)};
+  for (const DatabaseRecencySource_t recency_source :
+       {DatabaseRecencySource_t::CoarseClock, DatabaseRecencySource_t::LogicalEpoch}) {
+    run(cfg, trace, oracle_rate, recency_source, 0);
+    run(cfg, trace, oracle_rate, recency_source, 16);
+  }
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cstdint>
+#include <hps/hash_map_backend.hpp>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+/**
+ * Measures the single-threaded fetch throughput of a \p HashMapBackend. Batches of uniformly
+ * distributed random keys are looked up in a table that is considerably larger than the CPU caches.
+ * A fraction of the keys is absent from the table. Each value codec is measured with
+ * \p DatabaseOverflowPolicy_t::EvictRandom .
+ *
+ * Usage: hash_map_fetch_bench [num_keys] [dim] [batch_size] [num_partitions] [duration_s]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+using Key = long long;
+
+const std::string table_name{"fetch_bench"};
+
+struct Config {
+  size_t num_keys{4L * 1024 * 1024};
+  size_t dim{128};
+  size_t batch_size{16 * 1024};
+  size_t num_partitions{1};
+  double duration_s{5};
+  double hit_rate{0.9};
+};
+
+void run(const Config& cfg, const DatabaseOverflowPolicy_t policy,
+         const DatabaseValueCodec_t value_codec) {
+  const size_t value_size{cfg.dim * sizeof(float)};
+
+  HashMapBackendParams params;
+  params.num_partitions = cfg.num_partitions;
+  params.overflow_policy = policy;
+  params.value_codec = value_codec;
+  HashMapBackend<Key> db{params};
+
+  {
+    std::vector<Key> keys(64 * 1024);
+    std::vector<float> values(keys.size() * cfg.dim);
+    std::mt19937 gen{7};
+    std::uniform_real_distribution<float> dist{-1, 1};
+    std::generate(values.begin(), values.end(), [&]() { return dist(gen); });
+    for (size_t i{0}; i < cfg.num_keys; i += keys.size()) {
+      const size_t n{std::min(keys.size(), cfg.num_keys - i)};
+      std::iota(keys.begin(), keys.begin() + n, static_cast<Key>(i));
+      db.insert(table_name, n, keys.data(), reinterpret_cast<const char*>(values.data()),
+                value_size, value_size);
+    }
+  }
+
+  // Pregenerate the queries, so that key generation is not measured.
+  const Key max_key{static_cast<Key>(static_cast<double>(cfg.num_keys) / cfg.hit_rate)};
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<Key> dist{0, max_key - 1};
+  std::vector<std::vector<Key>> queries(16, std::vector<Key>(cfg.batch_size));
+  for (std::vector<Key>& keys : queries) {
+    std::generate(keys.begin(), keys.end(), [&]() { return dist(gen); });
+  }
+  std::vector<float> values(cfg.batch_size * cfg.dim);
+
+  size_t num_queried{0};
+  size_t num_fetched{0};
+  const auto t0{std::chrono::steady_clock::now()};
+  std::chrono::duration<double> elapsed;
+  for (size_t n{0};; ++n) {
+    const std::vector<Key>& keys{queries[n % queries.size()]};
+    num_fetched += db.fetch(
+        table_name, keys.size(), keys.data(), reinterpret_cast<char*>(values.data()), value_size,
+        [](size_t) {}, std::chrono::nanoseconds::max());
+    num_queried += keys.size();
+
+    elapsed = std::chrono::steady_clock::now() - t0;
+    if (elapsed.count() >= cfg.duration_s) {
+      break;
+    }
+  }
+
+  const double rate{static_cast<double>(num_queried) / elapsed.count()};
+  const double bandwidth{static_cast<double>(num_fetched * value_size) / elapsed.count()};
+  HCTR_LOG_S(INFO, ROOT) << "policy = " << policy << ", codec = " << value_codec
+                         << ", partitions = " << cfg.num_partitions << ", dim = " << cfg.dim
+                         << ", throughput = " << rate / 1e6
+                         << " M keys/s, bandwidth = " << bandwidth / 1e9
+                         << " GB/s, resident = " << db.memory_stats(table_name).resident_bytes
+                         << " bytes" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.num_keys;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.dim;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.batch_size;
+  if (argc >= 5) std::istringstream(argv[4]) >> cfg.num_partitions;
+  if (argc >= 6) std::istringstream(argv[5]) >> cfg.duration_s;
+
+  for (const DatabaseOverflowPolicy_t policy :
+       {DatabaseOverflowPolicy_t::EvictRandom, DatabaseOverflowPolicy_t::EvictLeastUsed,
+        DatabaseOverflowPolicy_t::EvictOldest}) {
+    run(cfg, policy, DatabaseValueCodec_t::Float32);
+  }
+  for (const DatabaseValueCodec_t value_codec :
+       {DatabaseValueCodec_t::Float16, DatabaseValueCodec_t::BFloat16,
+        DatabaseValueCodec_t::Int8}) {
+    run(cfg, DatabaseOverflowPolicy_t::EvictRandom, value_codec);
+  }
+  return 0;
+}
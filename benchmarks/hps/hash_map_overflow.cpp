@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <core23/logger.hpp>
+#include <cstdint>
+#include <hps/hash_map_backend.hpp>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures the fetch latency of a \p HashMapBackend while a concurrent writer keeps pushing new
+ * keys into it, so that overflow resolution is triggered over and over again. Compares exhaustive
+ * overflow resolution (overflow_sample_size = 0) with sampled overflow resolution.
+ *
+ * Usage: hash_map_overflow_bench [overflow_margin] [sample_size] [num_readers] [duration_s]
+ *                               [fetch_interval_us]
+ */
+
+namespace {
+
+using namespace HugeCTR;
+
+using Key = long long;
+
+constexpr size_t value_size{32 * sizeof(float)};
+constexpr size_t fetch_batch_size{256};
+constexpr size_t insert_batch_size{4 * 1024};
+const std::string table_name{"overflow_bench"};
+
+struct Config {
+  size_t overflow_margin{4L * 1024 * 1024};
+  size_t sample_size{16};
+  size_t num_readers{4};
+  double duration_s{10};
+  size_t fetch_interval_us{100};  // Readers are paced, so that they cannot starve the writer.
+};
+
+double percentile(const std::vector<int64_t>& sorted_ns, const double p) {
+  if (sorted_ns.empty()) {
+    return 0;
+  }
+  const size_t i{static_cast<size_t>(p * static_cast<double>(sorted_ns.size() - 1))};
+  return static_cast<double>(sorted_ns[i]) / 1000.0;
+}
+
+void run(const Config& cfg, const DatabaseOverflowPolicy_t policy, const size_t sample_size) {
+  HashMapBackendParams params;
+  params.num_partitions = 1;  // Worst case: Every overflow blocks all readers.
+  params.overflow_margin = cfg.overflow_margin;
+  params.overflow_policy = policy;
+  params.overflow_sample_size = sample_size;
+  HashMapBackend<Key> db{params};
+
+  // Prefill up to the overflow margin.
+  std::vector<Key> keys(insert_batch_size);
+  std::vector<char> values(insert_batch_size * value_size);
+  Key next_key{0};
+  while (static_cast<size_t>(next_key) < cfg.overflow_margin) {
+    const size_t n{
+        std::min(insert_batch_size, cfg.overflow_margin - static_cast<size_t>(next_key))};
+    std::iota(keys.begin(), keys.begin() + n, next_key);
+    next_key += static_cast<Key>(n);
+    db.insert(table_name, n, keys.data(), values.data(), value_size, value_size);
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<Key> key_hi{next_key};
+
+  // Readers: Fetch random batches out of the most recent window of keys.
+  std::vector<std::vector<int64_t>> latencies(cfg.num_readers);
+  std::vector<std::thread> readers;
+  for (size_t r{0}; r < cfg.num_readers; ++r) {
+    readers.emplace_back([&, r]() {
+      std::mt19937_64 gen{r};
+      std::vector<Key> fetch_keys(fetch_batch_size);
+      std::vector<char> fetch_values(fetch_batch_size * value_size);
+      std::vector<int64_t>& lat{latencies[r]};
+
+      while (!stop.load(std::memory_order_relaxed)) {
+        const Key hi{key_hi.load(std::memory_order_relaxed)};
+        const Key lo{std::max<Key>(0, hi - static_cast<Key>(cfg.overflow_margin))};
+        std::uniform_int_distribution<Key> dist{lo, hi - 1};
+        std::generate(fetch_keys.begin(), fetch_keys.end(), [&]() { return dist(gen); });
+
+        const auto t0{std::chrono::steady_clock::now()};
+        db.fetch(table_name, fetch_keys.size(), fetch_keys.data(), fetch_values.data(), value_size,
+                 [](size_t) {}, std::chrono::nanoseconds::max());
+        const auto t1{std::chrono::steady_clock::now()};
+        lat.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+
+        std::this_thread::sleep_for(std::chrono::microseconds(cfg.fetch_interval_us));
+      }
+    });
+  }
+
+  // Writer: Keep inserting new keys, which repeatedly overflows the partition.
+  size_t num_inserts{0};
+  const auto t_end{std::chrono::steady_clock::now() +
+                   std::chrono::duration<double>(cfg.duration_s)};
+  while (std::chrono::steady_clock::now() < t_end) {
+    std::iota(keys.begin(), keys.end(), next_key);
+    next_key += static_cast<Key>(keys.size());
+    db.insert(table_name, keys.size(), keys.data(), values.data(), value_size, value_size);
+    key_hi.store(next_key, std::memory_order_relaxed);
+    num_inserts += keys.size();
+  }
+  stop = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  std::vector<int64_t> all;
+  for (const auto& lat : latencies) {
+    all.insert(all.end(), lat.begin(), lat.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  HCTR_LOG_S(INFO, ROOT) << "policy = " << policy << ", sample_size = " << sample_size
+                         << ", inserts = " << num_inserts << ", fetches = " << all.size()
+                         << ", fetch latency [us]: p50 = " << percentile(all, 0.5)
+                         << ", p99 = " << percentile(all, 0.99)
+                         << ", p99.9 = " << percentile(all, 0.999)
+                         << ", max = " << percentile(all, 1.0) << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Config cfg;
+  if (argc >= 2) std::istringstream(argv[1]) >> cfg.overflow_margin;
+  if (argc >= 3) std::istringstream(argv[2]) >> cfg.sample_size;
+  if (argc >= 4) std::istringstream(argv[3]) >> cfg.num_readers;
+  if (argc >= 5) std::istringstream(argv[4]) >> cfg.duration_s;
+  if (argc >= 6) std::istringstream(argv[5]) >> cfg.fetch_interval_us;
+
+  for (const DatabaseOverflowPolicy_t policy :
+       {DatabaseOverflowPolicy_t::EvictRandom, DatabaseOverflowPolicy_t::EvictLeastUsed,
+        DatabaseOverflowPolicy_t::EvictOldest}) {
+    run(cfg, policy, 0);
+    run(cfg, policy, cfg.sample_size);
+  }
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <general_buffer2.hpp>
+#include <random>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+struct Lifetime {
+  size_t first_use;
+  size_t last_use;
+};
+
+bool intersect(const Lifetime& a, const Lifetime& b) {
+  return a.first_use <= b.last_use && b.first_use <= a.last_use;
+}
+
+bool overlap(const Tensor2<float>& a, const Tensor2<float>& b) {
+  const auto a_begin = reinterpret_cast<uintptr_t>(a.get_ptr());
+  const auto b_begin = reinterpret_cast<uintptr_t>(b.get_ptr());
+  return a_begin < b_begin + b.get_size_in_bytes() && b_begin < a_begin + a.get_size_in_bytes();
+}
+
+void general_buffer2_lifetime_test(const std::vector<size_t>& sizes,
+                                   const std::vector<Lifetime>& lifetimes) {
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> buff = GeneralBuffer2<HostAllocator>::create();
+  std::vector<Tensor2<float>> tensors(sizes.size());
+  for (size_t i = 0; i < sizes.size(); i++) {
+    buff->reserve({1, sizes[i]}, &tensors[i]);
+    buff->set_lifetime(tensors[i].get_buffer(), lifetimes[i].first_use, lifetimes[i].last_use);
+  }
+  // A buffer without a lifetime never shares memory.
+  Tensor2<float> unplanned;
+  buff->reserve({1, 100}, &unplanned);
+  buff->allocate();
+
+  size_t sum_of_sizes = unplanned.get_size_in_bytes();
+  for (size_t i = 0; i < tensors.size(); i++) {
+    sum_of_sizes += tensors[i].get_size_in_bytes();
+    EXPECT_FALSE(overlap(tensors[i], unplanned));
+    for (size_t j = 0; j < i; j++) {
+      if (intersect(lifetimes[i], lifetimes[j])) {
+        EXPECT_FALSE(overlap(tensors[i], tensors[j])) << "buffers " << j << " and " << i;
+      }
+    }
+  }
+  EXPECT_LE(buff->get_size_in_bytes(), sum_of_sizes + 32 * (tensors.size() + 1));
+}
+
+}  // namespace
+
+TEST(general_buffer2, lifetime_chain) {
+  // Layer i produces buffer i and the next layer consumes it. Hence, buffers 0, 2 and 4 may share
+  // memory, and so may buffers 1 and 3.
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> buff = GeneralBuffer2<HostAllocator>::create();
+  std::vector<Tensor2<float>> tensors(5);
+  for (size_t i = 0; i < tensors.size(); i++) {
+    buff->reserve({64, 256}, &tensors[i]);
+    buff->set_lifetime(tensors[i].get_buffer(), i, i + 1);
+  }
+  buff->allocate();
+
+  for (size_t i = 1; i < tensors.size(); i++) {
+    EXPECT_FALSE(overlap(tensors[i - 1], tensors[i]));
+  }
+  EXPECT_EQ(tensors[0].get_ptr(), tensors[2].get_ptr());
+  EXPECT_EQ(tensors[0].get_ptr(), tensors[4].get_ptr());
+  EXPECT_EQ(tensors[1].get_ptr(), tensors[3].get_ptr());
+  EXPECT_EQ(buff->get_size_in_bytes(), 2 * tensors[0].get_size_in_bytes());
+}
+
+TEST(general_buffer2, lifetime_disjoint) {
+  // Buffers that are never alive at the same time share one region as large as the largest.
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> buff = GeneralBuffer2<HostAllocator>::create();
+  const std::vector<size_t> sizes{300, 1000, 20, 700};
+  std::vector<Tensor2<float>> tensors(sizes.size());
+  for (size_t i = 0; i < sizes.size(); i++) {
+    buff->reserve({1, sizes[i]}, &tensors[i]);
+    buff->set_lifetime(tensors[i].get_buffer(), i, i);
+  }
+  buff->allocate();
+
+  for (const Tensor2<float>& tensor : tensors) {
+    EXPECT_EQ(tensor.get_ptr(), tensors[0].get_ptr());
+  }
+  EXPECT_EQ(buff->get_size_in_bytes(), 1000 * sizeof(float));
+}
+
+TEST(general_buffer2, lifetime_overlapping) {
+  // Buffers that are alive at the same time never overlap.
+  general_buffer2_lifetime_test({10, 20, 30}, {{0, 5}, {1, 2}, {2, 7}});
+  general_buffer2_lifetime_test({100, 7, 100, 33, 64}, {{0, 0}, {0, 3}, {1, 4}, {4, 4}, {2, 9}});
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> size_dist(1, 4096);
+  std::uniform_int_distribution<size_t> use_dist(0, 31);
+  for (int round = 0; round < 20; round++) {
+    std::vector<size_t> sizes(64);
+    std::vector<Lifetime> lifetimes(sizes.size());
+    for (size_t i = 0; i < sizes.size(); i++) {
+      sizes[i] = size_dist(gen);
+      const size_t first_use = use_dist(gen);
+      lifetimes[i] = {first_use, first_use + use_dist(gen) % 4};
+    }
+    general_buffer2_lifetime_test(sizes, lifetimes);
+  }
+}
+
+TEST(general_buffer2, lifetime_of_foreign_buffer) {
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> buff = GeneralBuffer2<HostAllocator>::create();
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> other = GeneralBuffer2<HostAllocator>::create();
+  Tensor2<float> tensor;
+  other->reserve({1, 16}, &tensor);
+  EXPECT_THROW(buff->set_lifetime(tensor.get_buffer(), 0, 1), std::runtime_error);
+}
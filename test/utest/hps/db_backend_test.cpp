@@ -17,6 +17,7 @@
 #include <cuda_profiler_api.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <cassert>
 #include <core23/logger.hpp>
 #include <filesystem>
@@ -24,10 +25,17 @@
 #include <hps/database_backend.hpp>
 #include <hps/hash_map_backend.hpp>
 #include <hps/hier_parameter_server_base.hpp>
+#include <hps/local_message.hpp>
+#include <hps/message_codec.hpp>
 #include <hps/mp_hash_map_backend.hpp>
+#include <hps/promotion_queue.hpp>
 #include <hps/redis_backend.hpp>
 #include <hps/rocksdb_backend.hpp>
+#include <hps/slab_store_backend.hpp>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
 #include <vector>
 
 using namespace HugeCTR;
@@ -43,6 +51,15 @@ std::unique_ptr<DatabaseBackendBase<T>> make_db(const DatabaseType_t database_ty
       return std::make_unique<HashMapBackend<T>>(params);
     } break;
 
+    case DatabaseType_t::MultiProcessHashMap: {
+      MultiProcessHashMapBackendParams params;
+      params.num_partitions = 16;
+      params.shared_memory_size = 1024L * 1024 * 1024;
+      params.shared_memory_name = "hctr_db_backend_test";
+      params.open_addressing = true;
+      return std::make_unique<MultiProcessHashMapBackend<T>>(params);
+    } break;
+
     case DatabaseType_t::RedisCluster: {
       RedisClusterBackendParams params;
       params.address = "127.0.0.1:7000,127.0.0.1:7001,127.0.0.1:7002";
@@ -55,6 +72,12 @@ std::unique_ptr<DatabaseBackendBase<T>> make_db(const DatabaseType_t database_ty
       return std::make_unique<RocksDBBackend<T>>(params);
     } break;
 
+    case DatabaseType_t::SlabStore: {
+      SlabStoreBackendParams params;
+      params.path = "/hugectr/Test_Data/slab_store";
+      return std::make_unique<SlabStoreBackend<T>>(params);
+    } break;
+
     default:
       HCTR_DIE("Unsupported database type!");
       return nullptr;
@@ -115,6 +138,58 @@ void db_backend_insert_fetch_test(const DatabaseType_t database_type) {
   }
 }
 
+template <typename Key>
+void db_backend_indirect_fetch_test(const DatabaseType_t database_type) {
+  std::unique_ptr<DatabaseBackendBase<Key>> db{make_db<Key>(database_type)};
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("indirect_fetch", "test")};
+
+  // Insert even keys only.
+  {
+    std::vector<Key> keys(500);
+    std::vector<double> values(keys.size());
+    for (size_t i{0}; i < keys.size(); ++i) {
+      keys[i] = static_cast<Key>(i * 2);
+      values[i] = static_cast<double>(keys[i]) * 0.5;
+    }
+    db->insert(tag, keys.size(), keys.data(), reinterpret_cast<char*>(values.data()),
+               sizeof(double), sizeof(double));
+  }
+
+  // Fetch every third key. Odd keys must be reported as misses.
+  std::vector<Key> keys(1000);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<size_t> indices;
+  for (size_t i{0}; i < keys.size(); i += 3) {
+    indices.emplace_back(i);
+  }
+
+  std::vector<double> values(keys.size(), -1);
+  std::vector<size_t> missed;
+  const size_t hit_count{db->fetch(tag, indices.size(), indices.data(), keys.data(),
+                                   reinterpret_cast<char*>(values.data()), sizeof(double),
+                                   [&](const size_t index) { missed.emplace_back(index); })};
+  EXPECT_EQ(hit_count + missed.size(), indices.size());
+  for (const size_t index : missed) {
+    EXPECT_EQ(index % 3, size_t{0});
+    EXPECT_EQ(keys[index] % 2, Key{1});
+  }
+  for (size_t i{0}; i < keys.size(); ++i) {
+    if (i % 3 == 0 && keys[i] % 2 == 0) {
+      EXPECT_DOUBLE_EQ(values[i], static_cast<double>(keys[i]) * 0.5);
+    } else if (i % 3 != 0) {
+      EXPECT_DOUBLE_EQ(values[i], -1);
+    }
+  }
+
+  // Single key.
+  const size_t index{42};
+  EXPECT_EQ(db->fetch(tag, 1, &index, keys.data(), reinterpret_cast<char*>(values.data()),
+                      sizeof(double), [&](size_t) { FAIL(); }),
+            size_t{1});
+  EXPECT_DOUBLE_EQ(values[index], 21);
+}
+
 template <typename Key>
 void db_backend_multi_evict_test(const DatabaseType_t database_type) {
   std::unique_ptr<DatabaseBackendBase<Key>> db{make_db<Key>(database_type)};
@@ -245,30 +320,1040 @@ void db_backend_dump_test(DatabaseType_t database_type) {
   }
 }
 
+template <typename Key>
+void db_backend_sampled_overflow_test(const DatabaseOverflowPolicy_t overflow_policy) {
+  HashMapBackendParams params;
+  params.num_partitions = 1;
+  params.overflow_margin = 1000;
+  params.overflow_policy = overflow_policy;
+  params.overflow_sample_size = 16;
+  std::unique_ptr<DatabaseBackendBase<Key>> db{std::make_unique<HashMapBackend<Key>>(params)};
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("sampled_overflow", "test")};
+  constexpr Key num_hot_keys{100};
+
+  std::vector<Key> keys(num_hot_keys);
+  std::vector<double> values(keys.size());
+  const auto insert_range = [&](const Key first) {
+    std::iota(keys.begin(), keys.end(), first);
+    db->insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+               sizeof(double), sizeof(double));
+  };
+  const auto fetch_hot_keys = [&]() {
+    std::iota(keys.begin(), keys.end(), 0);
+    return db->fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(values.data()),
+                     sizeof(double), [](size_t) {});
+  };
+
+  // Make the first keys popular, then flood the table with other keys.
+  insert_range(0);
+  for (size_t i{0}; i < 10; ++i) {
+    fetch_hot_keys();
+  }
+  for (Key k{num_hot_keys}; k < 50 * num_hot_keys; k += num_hot_keys) {
+    insert_range(k);
+    EXPECT_LE(db->size(tag), params.overflow_margin + keys.size());
+  }
+
+  const size_t num_hot_hits{fetch_hot_keys()};
+  std::cout << "Hot keys retained: " << num_hot_hits << " / " << num_hot_keys << std::endl;
+  if (overflow_policy == DatabaseOverflowPolicy_t::EvictLeastUsed) {
+    EXPECT_GE(num_hot_hits, static_cast<size_t>(num_hot_keys * 9 / 10));
+  }
+}
+
+template <typename Key>
+void db_backend_concurrent_fetch_test(const size_t num_partitions) {
+  HashMapBackendParams params;
+  params.num_partitions = num_partitions;
+  params.max_batch_size = 1000;
+  params.allocation_rate = 64L * 1024;  // Many small pages, so that compaction moves values.
+  params.overflow_margin = 20000;
+  params.overflow_policy = DatabaseOverflowPolicy_t::EvictRandom;
+  params.overflow_resolution_target = 0.5;
+  params.overflow_sample_size = 16;
+  params.compaction_threshold = 0.25;
+  HashMapBackend<Key> db{params};
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("concurrent_fetch", "test")};
+  constexpr size_t num_keys{200000};
+  constexpr size_t batch_size{1000};
+  constexpr size_t value_dim{4};  // Torn reads show up as values that disagree with each other.
+  const auto value_of = [](const Key k, const size_t j) {
+    return static_cast<double>(k) + 0.25 * static_cast<double>(j);
+  };
+
+  // The table must exist before readers can look it up.
+  {
+    const Key k{0};
+    const std::vector<double> value{value_of(k, 0), value_of(k, 1), value_of(k, 2), value_of(k, 3)};
+    db.insert(tag, 1, &k, reinterpret_cast<const char*>(value.data()), sizeof(double) * value_dim,
+              sizeof(double) * value_dim);
+  }
+
+  std::atomic<size_t> num_inserted{1};
+  std::atomic<bool> done{false};
+  std::atomic<size_t> num_hits{0};
+  std::atomic<size_t> num_mismatches{0};
+
+  std::vector<std::thread> readers;
+  for (size_t t{0}; t < 4; ++t) {
+    readers.emplace_back([&, t]() {
+      std::mt19937_64 gen(t);
+      std::vector<Key> keys(256);
+      std::vector<double> values(keys.size() * value_dim);
+      std::vector<bool> missed(keys.size());
+      while (!done.load()) {
+        const size_t range{num_inserted.load()};
+        for (Key& k : keys) {
+          k = static_cast<Key>(gen() % range);
+        }
+        std::fill(values.begin(), values.end(), -1);
+        std::fill(missed.begin(), missed.end(), false);
+        num_hits += db.fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(values.data()),
+                             sizeof(double) * value_dim, [&](const size_t i) { missed[i] = true; },
+                             std::chrono::nanoseconds::max());
+        for (size_t i{0}; i < keys.size(); ++i) {
+          for (size_t j{0}; j < value_dim && !missed[i]; ++j) {
+            num_mismatches += values[i * value_dim + j] != value_of(keys[i], j);
+          }
+        }
+        num_mismatches += db.contains(tag, keys.size(), keys.data(),
+                                      std::chrono::nanoseconds::max()) > keys.size();
+      }
+    });
+  }
+
+  // Insert fresh keys to force rehashes and overflow resolution, and evict every other key of
+  // each batch to leave holes for compaction.
+  std::vector<Key> keys(batch_size);
+  std::vector<double> values(keys.size() * value_dim);
+  std::vector<Key> evicted_keys;
+  for (size_t first{1}; first < num_keys; first += batch_size) {
+    std::iota(keys.begin(), keys.end(), static_cast<Key>(first));
+    for (size_t i{0}; i < keys.size(); ++i) {
+      for (size_t j{0}; j < value_dim; ++j) {
+        values[i * value_dim + j] = value_of(keys[i], j);
+      }
+    }
+    db.insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+              sizeof(double) * value_dim, sizeof(double) * value_dim);
+    num_inserted = first + batch_size;
+
+    evicted_keys.clear();
+    std::copy_if(keys.begin(), keys.end(), std::back_inserter(evicted_keys),
+                 [](const Key k) { return k % 2 != 0; });
+    db.evict(tag, evicted_keys.size(), evicted_keys.data());
+  }
+  done = true;
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+
+  std::cout << "Concurrent hits: " << num_hits << std::endl;
+  EXPECT_GT(num_hits.load(), size_t{0});
+  EXPECT_EQ(num_mismatches.load(), size_t{0});
+  EXPECT_LE(db.size(tag), params.overflow_margin * num_partitions + batch_size);
+}
+
+template <typename Key>
+void db_backend_recency_test(const DatabaseType_t database_type,
+                             const DatabaseRecencySource_t recency_source) {
+  std::unique_ptr<DatabaseBackendBase<Key>> db;
+  switch (database_type) {
+    case DatabaseType_t::HashMap: {
+      HashMapBackendParams params;
+      params.max_batch_size = 100;  // Overflow resolution evicts batch-wise.
+      params.num_partitions = 1;
+      params.overflow_margin = 1000;
+      params.overflow_policy = DatabaseOverflowPolicy_t::EvictOldest;
+      params.recency_source = recency_source;
+      db = std::make_unique<HashMapBackend<Key>>(params);
+    } break;
+
+    case DatabaseType_t::MultiProcessHashMap: {
+      MultiProcessHashMapBackendParams params;
+      params.max_batch_size = 100;  // Overflow resolution evicts batch-wise.
+      params.num_partitions = 1;
+      params.overflow_margin = 1000;
+      params.overflow_policy = DatabaseOverflowPolicy_t::EvictOldest;
+      params.shared_memory_size = 1024L * 1024 * 1024;
+      params.shared_memory_name = "hctr_db_backend_recency_test";
+      params.open_addressing = true;
+      params.recency_source = recency_source;
+      db = std::make_unique<MultiProcessHashMapBackend<Key>>(params);
+    } break;
+
+    default:
+      HCTR_DIE("Unsupported database type!");
+  }
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("recency", "test")};
+  constexpr Key num_hot_keys{100};
+
+  std::vector<Key> keys(num_hot_keys);
+  std::vector<double> values(keys.size());
+  const auto insert_range = [&](const Key first) {
+    std::iota(keys.begin(), keys.end(), first);
+    db->insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+               sizeof(double), sizeof(double));
+  };
+  const auto fetch_hot_keys = [&]() {
+    std::iota(keys.begin(), keys.end(), 0);
+    return db->fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(values.data()),
+                     sizeof(double), [](size_t) {});
+  };
+
+  // Keep touching the first keys, while flooding the table with other keys. Everything happens
+  // within a few milliseconds, which is below the resolution of a timestamp.
+  insert_range(0);
+  for (Key k{num_hot_keys}; k < 50 * num_hot_keys; k += num_hot_keys) {
+    fetch_hot_keys();
+    insert_range(k);
+  }
+
+  const size_t num_hot_hits{fetch_hot_keys()};
+  std::cout << "Hot keys retained: " << num_hot_hits << " / " << num_hot_keys << std::endl;
+  if (recency_source == DatabaseRecencySource_t::LogicalEpoch) {
+    EXPECT_EQ(num_hot_hits, static_cast<size_t>(num_hot_keys));
+  }
+
+  db->evict(tag);
+}
+
+template <typename Key>
+void db_backend_compaction_test(const DatabaseHugePages_t huge_pages) {
+  HashMapBackendParams params;
+  params.num_partitions = 1;
+  params.allocation_rate = 64L * 1024;  // Many small pages.
+  params.huge_pages = huge_pages;
+  params.numa_aware = true;
+  params.compaction_threshold = 0.5;
+  HashMapBackend<Key> db{params};
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("compaction", "test")};
+  constexpr size_t num_keys{64 * 1024};
+
+  std::vector<Key> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<double> values(keys.begin(), keys.end());
+  db.insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+            sizeof(double), sizeof(double));
+
+  const ValueArenaStats full_stats{db.memory_stats(tag)};
+  std::cout << "Full: " << full_stats << std::endl;
+  EXPECT_EQ(full_stats.num_resident_pages, full_stats.num_pages);
+  EXPECT_LT(full_stats.fragmentation(), 0.1);
+
+  // Evict 3 out of 4 keys. No page becomes empty. Compaction should release 3/4 of the pages.
+  std::vector<Key> evicted_keys;
+  std::copy_if(keys.begin(), keys.end(), std::back_inserter(evicted_keys),
+               [](const Key k) { return k % 4 != 0; });
+  EXPECT_EQ(db.evict(tag, evicted_keys.size(), evicted_keys.data()), evicted_keys.size());
+
+  const ValueArenaStats sparse_stats{db.memory_stats(tag)};
+  std::cout << "Compacted: " << sparse_stats << std::endl;
+  EXPECT_EQ(sparse_stats.num_pages, full_stats.num_pages);
+  EXPECT_LE(sparse_stats.num_resident_pages, full_stats.num_pages / 4 + 1);
+  EXPECT_LE(sparse_stats.fragmentation(), params.compaction_threshold);
+  EXPECT_EQ(sparse_stats.used_bytes * 4, full_stats.used_bytes);
+
+  // Relocated values must be intact.
+  std::fill(values.begin(), values.end(), -1);
+  EXPECT_EQ(db.fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(values.data()),
+                     sizeof(double), [](size_t) {}, std::chrono::nanoseconds::max()),
+            num_keys / 4);
+  for (size_t i{0}; i < keys.size(); i += 4) {
+    EXPECT_DOUBLE_EQ(values[i], static_cast<double>(keys[i]));
+  }
+
+  // Released pages are reused before new pages are mapped.
+  db.insert(tag, evicted_keys.size(), evicted_keys.data(),
+            reinterpret_cast<const char*>(values.data()), sizeof(double), sizeof(double));
+  const ValueArenaStats refilled_stats{db.memory_stats(tag)};
+  EXPECT_EQ(refilled_stats.num_pages, full_stats.num_pages);
+  EXPECT_EQ(refilled_stats.used_bytes, full_stats.used_bytes);
+}
+
+template <typename Key>
+void db_backend_snapshot_test(const size_t load_allocation_rate) {
+  HashMapBackendParams params;
+  params.num_partitions = 4;
+  params.allocation_rate = 64L * 1024;
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("snapshot", "test")};
+  const std::string path{"tbl_snapshot.snap"};
+  constexpr size_t num_keys{10000};
+
+  std::vector<Key> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<double> values(keys.begin(), keys.end());
+  {
+    HashMapBackend<Key> db{params};
+    db.insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+              sizeof(double), sizeof(double));
+    EXPECT_EQ(db.dump(tag, path), num_keys);
+  }
+  const size_t file_size{std::filesystem::file_size(path)};
+
+  // If the value storage layout matches, values are mapped. Otherwise, they are copied.
+  params.allocation_rate = load_allocation_rate;
+  HashMapBackend<Key> db{params};
+
+  // Restoring replaces existing contents.
+  const Key stray_key{static_cast<Key>(num_keys)};
+  db.insert(tag, 1, &stray_key, reinterpret_cast<const char*>(values.data()), sizeof(double),
+            sizeof(double));
+  EXPECT_EQ(db.load_dump(tag, path), num_keys);
+  EXPECT_EQ(db.size(tag), num_keys);
+  EXPECT_EQ(db.contains(tag, 1, &stray_key, std::chrono::nanoseconds::max()), 0);
+
+  std::vector<double> fetched_values(num_keys);
+  EXPECT_EQ(db.fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                     sizeof(double), [](size_t) { FAIL(); }, std::chrono::nanoseconds::max()),
+            num_keys);
+  EXPECT_EQ(fetched_values, values);
+
+  // Modifications must not leak into the snapshot file.
+  const std::vector<double> new_values(num_keys / 2, -1);
+  db.insert(tag, new_values.size(), keys.data(), reinterpret_cast<const char*>(new_values.data()),
+            sizeof(double), sizeof(double));
+  EXPECT_EQ(db.evict(tag, num_keys / 4, &keys[num_keys / 2]), num_keys / 4);
+  EXPECT_EQ(db.fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                     sizeof(double), [](size_t) {}, std::chrono::nanoseconds::max()),
+            num_keys - num_keys / 4);
+  EXPECT_DOUBLE_EQ(fetched_values.front(), -1);
+  EXPECT_DOUBLE_EQ(fetched_values.back(), values.back());
+  {
+    HashMapBackend<Key> db2{params};
+    EXPECT_EQ(db2.load_dump(tag, path), num_keys);
+    EXPECT_EQ(db2.fetch(tag, keys.size(), keys.data(),
+                        reinterpret_cast<char*>(fetched_values.data()), sizeof(double),
+                        [](size_t) { FAIL(); }, std::chrono::nanoseconds::max()),
+              num_keys);
+    EXPECT_EQ(fetched_values, values);
+  }
+  EXPECT_EQ(std::filesystem::file_size(path), file_size);
+
+  std::filesystem::remove(path);
+}
+
+template <typename Key>
+void db_backend_value_codec_test(const DatabaseType_t database_type,
+                                 const DatabaseValueCodec_t value_codec) {
+  std::unique_ptr<DatabaseBackendBase<Key>> db;
+  switch (database_type) {
+    case DatabaseType_t::HashMap: {
+      HashMapBackendParams params;
+      params.num_partitions = 4;
+      params.value_codec = value_codec;
+      db = std::make_unique<HashMapBackend<Key>>(params);
+    } break;
+
+    case DatabaseType_t::MultiProcessHashMap: {
+      MultiProcessHashMapBackendParams params;
+      params.num_partitions = 4;
+      params.allocation_rate = 1024L * 1024;
+      params.shared_memory_size = 256L * 1024 * 1024;
+      params.shared_memory_name = "hctr_db_backend_value_codec_test";
+      params.open_addressing = true;
+      params.value_codec = value_codec;
+      db = std::make_unique<MultiProcessHashMapBackend<Key>>(params);
+    } break;
+
+    default:
+      HCTR_DIE("Unsupported database type!");
+  }
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("value_codec", "test")};
+  constexpr size_t num_keys{1000};
+  constexpr size_t embedding_size{16};
+  constexpr size_t value_size{embedding_size * sizeof(float)};
+
+  std::vector<Key> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::vector<float> values(num_keys * embedding_size);
+  for (size_t i{0}; i < values.size(); ++i) {
+    values[i] = static_cast<float>(std::sin(static_cast<double>(i))) *
+                static_cast<float>(1 + i % 7);  // Different ranges per element.
+  }
+  db->insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+             value_size, value_size);
+
+  std::vector<float> fetched_values(values.size());
+  EXPECT_EQ(db->fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                      value_size, [](size_t) { FAIL(); }),
+            num_keys);
+
+  for (size_t i{0}; i < num_keys; ++i) {
+    const float* const x{&values[i * embedding_size]};
+    const float* const y{&fetched_values[i * embedding_size]};
+    const auto [min_x, max_x] = std::minmax_element(x, &x[embedding_size]);
+
+    for (size_t j{0}; j < embedding_size; ++j) {
+      switch (value_codec) {
+        case DatabaseValueCodec_t::Float32:
+          EXPECT_EQ(y[j], x[j]);
+          break;
+        case DatabaseValueCodec_t::Float16:
+          EXPECT_NEAR(y[j], x[j], std::abs(x[j]) / 2048 + 1e-7);
+          break;
+        case DatabaseValueCodec_t::BFloat16:
+          EXPECT_NEAR(y[j], x[j], std::abs(x[j]) / 256);
+          break;
+        case DatabaseValueCodec_t::Int8:
+          EXPECT_NEAR(y[j], x[j], (*max_x - *min_x) / 255 * 0.51);
+          break;
+      }
+    }
+  }
+
+  db->evict(tag);
+}
+
+template <typename Key>
+void db_backend_promotion_queue_test() {
+  std::unique_ptr<DatabaseBackendBase<Key>> db{
+      std::make_unique<HashMapBackend<Key>>(HashMapBackendParams{})};
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("promotion", "test")};
+  constexpr size_t num_keys{1000};
+  constexpr size_t value_size{sizeof(float)};
+
+  std::vector<Key> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0U);
+  std::vector<float> values(keys.begin(), keys.end());
+  std::vector<size_t> indices(num_keys);
+  std::iota(indices.begin(), indices.end(), 0U);
+
+  // The batch size is never reached. Hence, keys are only inserted after the delay expired.
+  PromotionQueue<Key> queue(db.get(), 2 * num_keys, 2 * num_keys, std::chrono::seconds{3600});
+
+  // Duplicates are skipped.
+  const char* const v{reinterpret_cast<const char*>(values.data())};
+  EXPECT_EQ(queue.submit(tag, num_keys, indices.data(), keys.data(), v, value_size), num_keys);
+  EXPECT_EQ(queue.submit(tag, num_keys, indices.data(), keys.data(), v, value_size), 0U);
+  EXPECT_EQ(queue.stats().queue_depth, num_keys);
+  EXPECT_EQ(queue.stats().num_duplicates, num_keys);
+  EXPECT_EQ(db->size(tag), 0U);
+
+  queue.flush();
+  EXPECT_EQ(queue.stats().queue_depth, 0U);
+  EXPECT_EQ(queue.stats().num_promoted, num_keys);
+  EXPECT_EQ(db->size(tag), num_keys);
+
+  std::vector<float> fetched_values(num_keys);
+  EXPECT_EQ(db->fetch(tag, keys.size(), keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                      value_size, [](size_t) { FAIL(); }),
+            num_keys);
+  EXPECT_EQ(fetched_values, values);
+
+  // Keys beyond the capacity of the queue are dropped.
+  std::vector<Key> more_keys(3 * num_keys);
+  std::iota(more_keys.begin(), more_keys.end(), num_keys);
+  std::vector<float> more_values(more_keys.size());
+  std::vector<size_t> more_indices(more_keys.size());
+  std::iota(more_indices.begin(), more_indices.end(), 0U);
+  EXPECT_EQ(queue.submit(tag, more_keys.size(), more_indices.data(), more_keys.data(),
+                         reinterpret_cast<const char*>(more_values.data()), value_size),
+            2 * num_keys);
+  EXPECT_EQ(queue.stats().num_dropped, num_keys);
+
+  queue.flush();
+  EXPECT_EQ(db->size(tag), 3 * num_keys);
+}
+
+template <typename Key>
+void db_backend_bulk_insert_test(DatabaseType_t database_type) {
+  std::unique_ptr<DatabaseBackendBase<Key>> db{make_db<Key>(database_type)};
+  const std::string& tag{HierParameterServerBase::make_tag_name("bulk", "test")};
+  db->evict(tag);
+
+  // Every key appears twice (negative keys, if signed). The last value must prevail.
+  constexpr size_t num_keys{100'000};
+  std::vector<Key> keys(2 * num_keys);
+  std::vector<float> values(keys.size());
+  for (size_t i{0}; i < keys.size(); ++i) {
+    keys[i] = static_cast<Key>(i % num_keys) - static_cast<Key>(num_keys / 2);
+    values[i] = static_cast<float>(i);
+  }
+  db->bulk_insert(tag, keys.size(), keys.data(), reinterpret_cast<const char*>(values.data()),
+                  sizeof(float), sizeof(float));
+
+  std::vector<float> fetched_values(num_keys);
+  EXPECT_EQ(db->fetch(tag, num_keys, keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                      sizeof(float), [](size_t) { FAIL(); }),
+            num_keys);
+  EXPECT_TRUE(std::equal(fetched_values.begin(), fetched_values.end(), &values[num_keys]));
+
+  // Bulk insertions override existing values.
+  std::fill(values.begin(), values.end(), -1.f);
+  db->bulk_insert(tag, num_keys, keys.data(), reinterpret_cast<const char*>(values.data()),
+                  sizeof(float), sizeof(float));
+  EXPECT_EQ(db->fetch(tag, num_keys, keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                      sizeof(float), [](size_t) { FAIL(); }),
+            num_keys);
+  EXPECT_TRUE(std::equal(fetched_values.begin(), fetched_values.end(), values.begin()));
+
+  db->evict(tag);
+}
+
+template <typename Key>
+void db_backend_rocksdb_lookup_test(const size_t num_lookup_tasks, const bool partitioned_filters) {
+  RocksDBBackendParams params;
+  params.path = "/hugectr/Test_Data/rockdb";
+  params.max_batch_size = 1'000;
+  params.block_cache_size = 64L * 1024 * 1024;
+  params.partitioned_filters = partitioned_filters;
+  params.num_lookup_tasks = num_lookup_tasks;
+  std::unique_ptr<DatabaseBackendBase<Key>> db{std::make_unique<RocksDBBackend<Key>>(params)};
+  const std::string& tag{HierParameterServerBase::make_tag_name("lookup", "test")};
+  db->evict(tag);
+
+  // Only even keys are stored.
+  constexpr size_t num_keys{20'000};
+  std::vector<Key> keys(num_keys);
+  std::vector<float> values(num_keys);
+  for (size_t i{0}; i < num_keys; ++i) {
+    keys[i] = static_cast<Key>(i);
+    values[i] = static_cast<float>(i);
+  }
+  std::vector<Key> even_keys;
+  std::vector<float> even_values;
+  for (size_t i{0}; i < num_keys; i += 2) {
+    even_keys.push_back(keys[i]);
+    even_values.push_back(values[i]);
+  }
+  db->bulk_insert(tag, even_keys.size(), even_keys.data(),
+                 reinterpret_cast<const char*>(even_values.data()), sizeof(float), sizeof(float));
+
+  EXPECT_EQ(db->contains(tag, num_keys, keys.data(), std::chrono::nanoseconds::zero()),
+            num_keys / 2);
+
+  // Misses may be reported concurrently, but each index only once.
+  std::vector<float> fetched_values(num_keys, -1.f);
+  std::vector<char> missed(num_keys, 0);
+  EXPECT_EQ(db->fetch(tag, num_keys, keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                     sizeof(float), [&](const size_t index) { ++missed[index]; }),
+            num_keys / 2);
+  for (size_t i{0}; i < num_keys; ++i) {
+    EXPECT_EQ(missed[i], static_cast<char>(i % 2));
+    if (i % 2 == 0) {
+      EXPECT_EQ(fetched_values[i], values[i]);
+    }
+  }
+
+  // Indirect lookup of every third key.
+  std::vector<size_t> indices;
+  for (size_t i{0}; i < num_keys; i += 3) {
+    indices.push_back(i);
+  }
+  std::fill(fetched_values.begin(), fetched_values.end(), -1.f);
+  std::fill(missed.begin(), missed.end(), 0);
+  const size_t hit_count{db->fetch(tag, indices.size(), indices.data(), keys.data(),
+                                  reinterpret_cast<char*>(fetched_values.data()), sizeof(float),
+                                  [&](const size_t index) { ++missed[index]; })};
+  EXPECT_EQ(hit_count, (indices.size() + 1) / 2);
+  for (const size_t i : indices) {
+    EXPECT_EQ(missed[i], static_cast<char>(i % 2));
+    if (i % 2 == 0) {
+      EXPECT_EQ(fetched_values[i], values[i]);
+    }
+  }
+
+  db->evict(tag);
+}
+
+template <typename Key>
+void db_backend_slab_store_test(const size_t num_lookup_tasks) {
+  SlabStoreBackendParams params;
+  params.path = "/hugectr/Test_Data/slab_store";
+  params.max_batch_size = 1'000;
+  params.num_lookup_tasks = num_lookup_tasks;
+  params.io_depth = 16;
+  params.compaction_threshold = 1;  // Compact explicitly.
+  const std::string& tag{HierParameterServerBase::make_tag_name("slab_store", "test")};
+  {
+    SlabStoreBackend<Key> db{params};
+    db.evict(tag);
+  }
+
+  constexpr size_t num_keys{20'000};
+  constexpr size_t value_size{24};
+  std::vector<Key> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0);
+  const auto make_values = [&](const float offset) {
+    std::vector<float> values(num_keys * value_size);
+    for (size_t i{0}; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i) + offset;
+    }
+    return values;
+  };
+  const std::vector<float> old_values{make_values(0)};
+  const std::vector<float> new_values{make_values(0.5f)};
+
+  // Overwrite the first half, and remove every fourth key. Only these rows are current.
+  const auto check = [&](SlabStoreBackend<Key>& db) {
+    std::vector<float> values(num_keys * value_size, -1.f);
+    std::vector<char> missed(num_keys, 0);
+    EXPECT_EQ(db.size(tag), num_keys - num_keys / 4);
+    EXPECT_EQ(db.fetch(tag, num_keys, keys.data(), reinterpret_cast<char*>(values.data()),
+                       value_size * sizeof(float), [&](const size_t index) { ++missed[index]; },
+                       std::chrono::nanoseconds::max()),
+              num_keys - num_keys / 4);
+
+    for (size_t i{0}; i < num_keys; ++i) {
+      EXPECT_EQ(missed[i], static_cast<char>(i % 4 == 0));
+      if (i % 4 != 0) {
+        const std::vector<float>& expected{i < num_keys / 2 ? new_values : old_values};
+        EXPECT_TRUE(std::equal(&values[i * value_size], &values[(i + 1) * value_size],
+                               &expected[i * value_size]));
+      }
+    }
+  };
+
+  std::vector<Key> evicted_keys;
+  for (size_t i{0}; i < num_keys; i += 4) {
+    evicted_keys.push_back(keys[i]);
+  }
+
+  size_t full_size;
+  {
+    SlabStoreBackend<Key> db{params};
+    EXPECT_EQ(db.insert(tag, num_keys, keys.data(),
+                        reinterpret_cast<const char*>(old_values.data()),
+                        value_size * sizeof(float), value_size * sizeof(float)),
+              num_keys);
+    EXPECT_EQ(db.insert(tag, num_keys / 2, keys.data(),
+                        reinterpret_cast<const char*>(new_values.data()),
+                        value_size * sizeof(float), value_size * sizeof(float)),
+              0);
+    EXPECT_EQ(db.evict(tag, evicted_keys.size(), evicted_keys.data()), evicted_keys.size());
+    check(db);
+    full_size = db.file_size(tag);
+  }
+
+  // Reopen, and rebuild the index from the slab file.
+  {
+    SlabStoreBackend<Key> db{params};
+    check(db);
+
+    EXPECT_EQ(db.compact(tag), num_keys / 2 + 2 * (num_keys / 4));
+    EXPECT_LT(db.file_size(tag), full_size);
+    check(db);
+  }
+
+  // The compacted file yields the same state.
+  size_t compacted_size;
+  {
+    SlabStoreBackend<Key> db{params};
+    check(db);
+    compacted_size = db.file_size(tag);
+
+    // Overwrite a key, whose row is then torn below.
+    EXPECT_EQ(db.insert(tag, 1, &keys[1], reinterpret_cast<const char*>(old_values.data()),
+                        value_size * sizeof(float), value_size * sizeof(float)),
+              0);
+    EXPECT_GT(db.file_size(tag), compacted_size);
+  }
+
+  // Only the header of the last row reached the disk (e.g., after a crash). Reopening discards
+  // the torn row, and restores the previous value.
+  {
+    const std::string path{params.path + "/" + tag + ".slab"};
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-static_cast<std::streamoff>(sizeof(uint64_t)), std::ios::end);
+    const uint64_t garbage{0xdeadbeefdeadbeef};
+    file.write(reinterpret_cast<const char*>(&garbage), sizeof(uint64_t));
+  }
+  {
+    SlabStoreBackend<Key> db{params};
+    check(db);
+    EXPECT_EQ(db.file_size(tag), compacted_size);
+    EXPECT_EQ(db.evict(tag), num_keys - num_keys / 4);
+  }
+}
+
+template <typename Key>
+void db_backend_redis_near_cache_test(const size_t max_staleness_ms) {
+  // Simulate a client with near cache, and another client that modifies the database.
+  RedisClusterBackendParams params;
+  params.address = "127.0.0.1:7000,127.0.0.1:7001,127.0.0.1:7002";
+  params.max_batch_size = 100;
+  std::unique_ptr<DatabaseBackendBase<Key>> writer{
+      std::make_unique<RedisClusterBackend<Key>>(params)};
+  params.near_cache_size = 1024L * 1024;
+  params.near_cache_max_staleness_ms = max_staleness_ms;
+  std::unique_ptr<DatabaseBackendBase<Key>> db{std::make_unique<RedisClusterBackend<Key>>(params)};
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("near_cache", "test")};
+  db->evict(tag);
+
+  constexpr size_t num_keys{1'000};
+  std::vector<Key> keys(num_keys);
+  std::vector<double> values(num_keys);
+  for (size_t i{0}; i < num_keys; ++i) {
+    keys[i] = static_cast<Key>(i);
+    values[i] = static_cast<double>(i * i);
+  }
+  writer->insert(tag, num_keys, keys.data(), reinterpret_cast<const char*>(values.data()),
+                 sizeof(double), sizeof(double));
+
+  // Expects the first \p num_misses keys to be missing.
+  const auto check_fetch = [&](const size_t num_misses) {
+    std::vector<double> fetched_values(num_keys);
+    std::vector<char> missed(num_keys, 0);
+    EXPECT_EQ(db->fetch(tag, num_keys, keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                        sizeof(double), [&](const size_t index) { ++missed[index]; },
+                        std::chrono::nanoseconds::zero()),
+              num_keys - num_misses);
+    for (size_t i{0}; i < num_keys; ++i) {
+      EXPECT_EQ(missed[i], static_cast<char>(i < num_misses));
+      if (i >= num_misses) {
+        EXPECT_DOUBLE_EQ(fetched_values[i], values[i]);
+      }
+    }
+  };
+
+  // Second lookup is served from the near cache.
+  check_fetch(0);
+  check_fetch(0);
+
+  // Modifications by other clients must become visible.
+  for (size_t i{0}; i < num_keys; i += 3) {
+    values[i] += 0.5;
+    writer->insert(tag, 1, &keys[i], reinterpret_cast<const char*>(&values[i]), sizeof(double),
+                   sizeof(double));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(max_staleness_ms * 2));
+  check_fetch(0);
+
+  // Own modifications must become visible immediately.
+  db->evict(tag, 100, keys.data());
+  check_fetch(100);
+
+  writer->evict(tag);
+  std::this_thread::sleep_for(std::chrono::milliseconds(max_staleness_ms * 2));
+  check_fetch(num_keys);
+}
+
+template <typename Key>
+void db_backend_message_codec_test(const MessageCodecParams& params) {
+  constexpr size_t num_keys{100'000};
+  constexpr size_t num_floats{16};
+  constexpr uint32_t value_size{num_floats * sizeof(float)};
+
+  // Unique keys (negative, if signed) in random order.
+  std::vector<Key> keys(num_keys);
+  for (size_t i{0}; i < num_keys; ++i) {
+    keys[i] = static_cast<Key>(i * 7919) - static_cast<Key>(num_keys / 2);
+  }
+  std::sort(keys.begin(), keys.end());
+  std::vector<float> values(num_keys * num_floats);
+  for (size_t i{0}; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i % 97) / 97.f - 0.5f;
+  }
+  std::vector<size_t> order(num_keys);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937{42});
+  std::vector<Key> shuffled_keys(num_keys);
+  std::vector<float> shuffled_values(values.size());
+  for (size_t i{0}; i < num_keys; ++i) {
+    shuffled_keys[i] = keys[order[i]];
+    std::copy_n(&values[order[i] * num_floats], num_floats, &shuffled_values[i * num_floats]);
+  }
+
+  const MessageCodec<Key> codec{params};
+  std::vector<char> payload(codec.max_encoded_size(num_keys, value_size));
+  const size_t payload_size{codec.encode(num_keys, shuffled_keys.data(),
+                                         reinterpret_cast<const char*>(shuffled_values.data()),
+                                         value_size, payload.data())};
+  EXPECT_LE(payload_size, payload.size());
+  EXPECT_LE(codec.max_num_pairs(payload.size(), value_size), num_keys);
+  HCTR_LOG_S(INFO, WORLD) << "Message codec: " << num_keys * (sizeof(Key) + value_size) << " -> "
+                          << payload_size << " bytes." << std::endl;
+
+  std::vector<Key> decoded_keys;
+  std::vector<char> decoded_values;
+  uint32_t decoded_value_size;
+  EXPECT_EQ(MessageCodec<Key>::decode(payload.data(), payload_size, decoded_keys, decoded_values,
+                                      decoded_value_size),
+            num_keys);
+  EXPECT_EQ(decoded_value_size, value_size);
+  ASSERT_EQ(decoded_keys.size(), num_keys);
+  ASSERT_EQ(decoded_values.size(), num_keys * value_size);
+
+  const float tolerance{params.value_codec == DatabaseValueCodec_t::Float32 ? 0.f : 1.f / 64.f};
+  std::vector<size_t> decoded_order(num_keys);
+  std::iota(decoded_order.begin(), decoded_order.end(), 0);
+  std::sort(decoded_order.begin(), decoded_order.end(),
+            [&](const size_t a, const size_t b) { return decoded_keys[a] < decoded_keys[b]; });
+  for (size_t i{0}; i < num_keys; ++i) {
+    const size_t j{decoded_order[i]};
+    ASSERT_EQ(decoded_keys[j], keys[i]);
+    const float* const v{reinterpret_cast<const float*>(&decoded_values[j * value_size])};
+    for (size_t k{0}; k < num_floats; ++k) {
+      ASSERT_NEAR(v[k], values[i * num_floats + k], tolerance);
+    }
+  }
+
+  // Corrupted payloads are rejected.
+  EXPECT_ANY_THROW(MessageCodec<Key>::decode(payload.data(), payload_size / 2, decoded_keys,
+                                             decoded_values, decoded_value_size));
+}
+
+template <typename Key>
+void db_backend_local_message_queue_test(const MessageCodecParams& codec = {}) {
+  const std::string path{"/tmp/hps_db_backend_local_mq_test"};
+  std::filesystem::remove_all(path);
+
+  const std::string& tag{HierParameterServerBase::make_tag_name("local_mq", "test")};
+  constexpr size_t num_keys{100'000};
+  constexpr size_t num_floats{8};
+  constexpr uint32_t value_size{num_floats * sizeof(float)};
+
+  std::vector<Key> keys(3 * num_keys);
+  std::iota(keys.begin(), keys.end(), 0U);
+  std::vector<float> values(keys.size() * num_floats);
+  for (size_t i{0}; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i / num_floats);
+  }
+  auto post = [&](MessageSinkBase<Key>& sink, const size_t first, const size_t last) {
+    sink.post(tag, last - first, &keys[first],
+              reinterpret_cast<const char*>(&values[first * num_floats]), value_size);
+    sink.flush();
+  };
+
+  // Consumes all messages that are available for the group, and returns what was received.
+  auto consume = [&](const std::string& group, const size_t num_expected) {
+    std::unique_ptr<DatabaseBackendBase<Key>> db{
+        std::make_unique<HashMapBackend<Key>>(HashMapBackendParams{})};
+
+    LocalMessageSource<Key> source(path, group, {"^hps_.+$"}, 10, 4096);
+    source.engage([&](const std::string& tag_name, const size_t num_pairs, const Key* const k,
+                      const char* const v, const size_t v_size) {
+      return db->insert(tag_name, num_pairs, k, v, static_cast<uint32_t>(v_size), v_size);
+    });
+    for (size_t i{0}; i < 1000 && source.num_keys_committed() < num_expected; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(source.num_keys_committed(), num_expected);
+    return db;
+  };
+
+  // Small segments to enforce rotation.
+  LocalMessageSinkParams sink_params;
+  sink_params.path = path;
+  sink_params.segment_size = 1024 * 1024;
+  sink_params.num_retained_segments = 0;
+  sink_params.codec = codec;
+  {
+    LocalMessageSink<Key> sink(sink_params);
+    post(sink, 0, num_keys / 2);
+    post(sink, num_keys / 2, num_keys);
+
+    // Only one sink can write to the same tag.
+    LocalMessageSink<Key> other_sink(sink_params);
+    EXPECT_ANY_THROW(post(other_sink, 0, 1));
+  }
+
+  // Consumer groups are independent.
+  for (const char* const group : {"a", "b"}) {
+    const auto& db{consume(group, num_keys)};
+    EXPECT_EQ(db->size(tag), num_keys);
+
+    std::vector<float> fetched_values(num_keys * num_floats);
+    EXPECT_EQ(db->fetch(tag, num_keys, keys.data(), reinterpret_cast<char*>(fetched_values.data()),
+                        value_size, [](size_t) { FAIL(); }),
+              num_keys);
+    EXPECT_TRUE(std::equal(fetched_values.begin(), fetched_values.end(), values.begin()));
+  }
+
+  // A new sink continues the log, and consumers resume at their last commit.
+  {
+    LocalMessageSink<Key> sink(sink_params);
+    post(sink, num_keys, 2 * num_keys);
+  }
+  EXPECT_EQ(consume("a", num_keys)->size(tag), num_keys);
+  {
+    LocalMessageSink<Key> sink(sink_params);
+    post(sink, 2 * num_keys, 3 * num_keys);
+  }
+  EXPECT_EQ(consume("a", num_keys)->size(tag), num_keys);
+  EXPECT_EQ(consume("b", 2 * num_keys)->size(tag), 2 * num_keys);
+  EXPECT_EQ(consume("c", 3 * num_keys)->size(tag), 3 * num_keys);
+
+  std::filesystem::remove_all(path);
+}
+
 }  // namespace
 
 TEST(db_backend_insert_fetch_test, HashMap) {
   db_backend_insert_fetch_test<long long>(DatabaseType_t::HashMap);
 }
+TEST(db_backend_insert_fetch_test, MultiProcessHashMap) {
+  db_backend_insert_fetch_test<long long>(DatabaseType_t::MultiProcessHashMap);
+}
 TEST(db_backend_insert_fetch_test, Redis) {
   db_backend_insert_fetch_test<long long>(DatabaseType_t::RedisCluster);
 }
 TEST(db_backend_insert_fetch_test, Rocksdb) {
   db_backend_insert_fetch_test<long long>(DatabaseType_t::RocksDB);
 }
+TEST(db_backend_insert_fetch_test, SlabStore) {
+  db_backend_insert_fetch_test<long long>(DatabaseType_t::SlabStore);
+}
+
+TEST(db_backend_indirect_fetch_test, HashMap) {
+  db_backend_indirect_fetch_test<long long>(DatabaseType_t::HashMap);
+}
+TEST(db_backend_indirect_fetch_test, MultiProcessHashMap) {
+  db_backend_indirect_fetch_test<long long>(DatabaseType_t::MultiProcessHashMap);
+}
 
 TEST(db_backend_multi_evict, HashMap) {
   db_backend_multi_evict_test<long long>(DatabaseType_t::HashMap);
 }
+TEST(db_backend_multi_evict, MultiProcessHashMap) {
+  db_backend_multi_evict_test<long long>(DatabaseType_t::MultiProcessHashMap);
+}
 TEST(db_backend_multi_evict, Redis) {
   db_backend_multi_evict_test<long long>(DatabaseType_t::RedisCluster);
 }
 TEST(db_backend_multi_evict, Rocksdb) {
   db_backend_multi_evict_test<long long>(DatabaseType_t::RocksDB);
 }
+TEST(db_backend_multi_evict, SlabStore) {
+  db_backend_multi_evict_test<long long>(DatabaseType_t::SlabStore);
+}
 
 TEST(db_backend_dump_load, HashMap) { db_backend_dump_test<long long>(DatabaseType_t::HashMap); }
+TEST(db_backend_dump_load, MultiProcessHashMap) {
+  db_backend_dump_test<long long>(DatabaseType_t::MultiProcessHashMap);
+}
 TEST(db_backend_dump_load, RedisCluster) {
   db_backend_dump_test<long long>(DatabaseType_t::RedisCluster);
 }
 TEST(db_backend_dump_load, RocksDB) { db_backend_dump_test<long long>(DatabaseType_t::RocksDB); }
+TEST(db_backend_dump_load, SlabStore) {
+  db_backend_dump_test<long long>(DatabaseType_t::SlabStore);
+}
+
+TEST(db_backend_bulk_insert, HashMap) {
+  db_backend_bulk_insert_test<long long>(DatabaseType_t::HashMap);
+}
+TEST(db_backend_bulk_insert, RocksDB) {
+  db_backend_bulk_insert_test<long long>(DatabaseType_t::RocksDB);
+}
+TEST(db_backend_bulk_insert, RocksDBUInt32) {
+  db_backend_bulk_insert_test<unsigned int>(DatabaseType_t::RocksDB);
+}
+
+TEST(db_backend_rocksdb_lookup, Sequential) { db_backend_rocksdb_lookup_test<long long>(1, false); }
+TEST(db_backend_rocksdb_lookup, Parallel) { db_backend_rocksdb_lookup_test<long long>(4, false); }
+TEST(db_backend_rocksdb_lookup, ParallelPartitionedFilters) {
+  db_backend_rocksdb_lookup_test<long long>(4, true);
+}
+
+TEST(db_backend_slab_store, Sequential) { db_backend_slab_store_test<long long>(1); }
+TEST(db_backend_slab_store, Parallel) { db_backend_slab_store_test<long long>(4); }
+
+TEST(db_backend_redis_near_cache, Strict) { db_backend_redis_near_cache_test<long long>(0); }
+TEST(db_backend_redis_near_cache, BoundedStaleness) {
+  db_backend_redis_near_cache_test<long long>(50);
+}
+
+TEST(db_backend_sampled_overflow, EvictRandom) {
+  db_backend_sampled_overflow_test<long long>(DatabaseOverflowPolicy_t::EvictRandom);
+}
+TEST(db_backend_sampled_overflow, EvictLeastUsed) {
+  db_backend_sampled_overflow_test<long long>(DatabaseOverflowPolicy_t::EvictLeastUsed);
+}
+TEST(db_backend_sampled_overflow, EvictOldest) {
+  db_backend_sampled_overflow_test<long long>(DatabaseOverflowPolicy_t::EvictOldest);
+}
+
+TEST(db_backend_concurrent_fetch, HashMapSinglePartition) {
+  db_backend_concurrent_fetch_test<long long>(1);
+}
+TEST(db_backend_concurrent_fetch, HashMap) { db_backend_concurrent_fetch_test<unsigned int>(4); }
+
+TEST(db_backend_recency, HashMapCoarseClock) {
+  db_backend_recency_test<long long>(DatabaseType_t::HashMap, DatabaseRecencySource_t::CoarseClock);
+}
+TEST(db_backend_recency, HashMapLogicalEpoch) {
+  db_backend_recency_test<long long>(DatabaseType_t::HashMap,
+                                     DatabaseRecencySource_t::LogicalEpoch);
+}
+TEST(db_backend_recency, MultiProcessHashMapLogicalEpoch) {
+  db_backend_recency_test<long long>(DatabaseType_t::MultiProcessHashMap,
+                                     DatabaseRecencySource_t::LogicalEpoch);
+}
+
+TEST(db_backend_compaction, HashMap) {
+  db_backend_compaction_test<long long>(DatabaseHugePages_t::Disabled);
+}
+TEST(db_backend_compaction, HashMapTransparentHugePages) {
+  db_backend_compaction_test<long long>(DatabaseHugePages_t::Transparent);
+}
+
+TEST(db_backend_snapshot, HashMapMapped) { db_backend_snapshot_test<long long>(64L * 1024); }
+TEST(db_backend_snapshot, HashMapCopied) { db_backend_snapshot_test<unsigned int>(256L * 1024); }
+
+TEST(db_backend_value_codec, HashMapFloat16) {
+  db_backend_value_codec_test<long long>(DatabaseType_t::HashMap, DatabaseValueCodec_t::Float16);
+}
+TEST(db_backend_value_codec, HashMapBFloat16) {
+  db_backend_value_codec_test<long long>(DatabaseType_t::HashMap, DatabaseValueCodec_t::BFloat16);
+}
+TEST(db_backend_value_codec, HashMapInt8) {
+  db_backend_value_codec_test<long long>(DatabaseType_t::HashMap, DatabaseValueCodec_t::Int8);
+}
+TEST(db_backend_value_codec, MultiProcessHashMapInt8) {
+  db_backend_value_codec_test<long long>(DatabaseType_t::MultiProcessHashMap,
+                                         DatabaseValueCodec_t::Int8);
+}
+
+TEST(db_backend_promotion_queue, HashMap) { db_backend_promotion_queue_test<long long>(); }
+
+TEST(db_backend_local_message_queue, HashMap) {
+  db_backend_local_message_queue_test<long long>();
+}
+TEST(db_backend_local_message_queue, HashMapDeltaKeys) {
+  MessageCodecParams codec;
+  codec.delta_keys = true;
+  codec.block_size = 1000;
+  db_backend_local_message_queue_test<long long>(codec);
+}
+
+TEST(db_backend_message_codec, DeltaKeys) {
+  MessageCodecParams params;
+  params.delta_keys = true;
+  db_backend_message_codec_test<long long>(params);
+}
+TEST(db_backend_message_codec, DeltaKeysUInt32) {
+  MessageCodecParams params;
+  params.delta_keys = true;
+  params.block_size = 1000;
+  db_backend_message_codec_test<unsigned int>(params);
+}
+TEST(db_backend_message_codec, Float16) {
+  MessageCodecParams params;
+  params.value_codec = DatabaseValueCodec_t::Float16;
+  db_backend_message_codec_test<long long>(params);
+}
+#ifdef ENABLE_MESSAGE_COMPRESSION
+TEST(db_backend_message_codec, LZ4) {
+  MessageCodecParams params;
+  params.delta_keys = true;
+  params.compression = MessageCompression_t::LZ4;
+  db_backend_message_codec_test<long long>(params);
+}
+TEST(db_backend_message_codec, ZstdInt8) {
+  MessageCodecParams params;
+  params.delta_keys = true;
+  params.value_codec = DatabaseValueCodec_t::Int8;
+  params.compression = MessageCompression_t::Zstd;
+  db_backend_message_codec_test<long long>(params);
+}
+#endif
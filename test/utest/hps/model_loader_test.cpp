@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <hps/modelloader.hpp>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+const size_t emb_size = 16;
+
+// Writes a sparse model in the raw format, i.e., a key file and an embedding vector file.
+void write_sparse_model(const std::string& path, const size_t num_keys, const size_t seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+  std::vector<long long> keys(num_keys);
+  for (long long& key : keys) {
+    key = static_cast<long long>(gen() >> 33);
+  }
+  std::vector<float> vectors(num_keys * emb_size);
+  for (float& value : vectors) {
+    value = dist(gen);
+  }
+
+  std::filesystem::create_directories(path);
+  std::ofstream key_stream(path + "/key", std::ofstream::binary);
+  key_stream.write(reinterpret_cast<const char*>(keys.data()), keys.size() * sizeof(long long));
+  std::ofstream vec_stream(path + "/emb_vector", std::ofstream::binary);
+  vec_stream.write(reinterpret_cast<const char*>(vectors.data()), vectors.size() * sizeof(float));
+}
+
+// Reads the first `count` elements of a file with plain stream I/O.
+template <typename T>
+std::vector<T> read_file(const std::string& file, const size_t count) {
+  std::vector<T> values(count);
+  std::ifstream stream(file, std::ifstream::binary);
+  stream.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+  EXPECT_TRUE(stream.good()) << file;
+  return values;
+}
+
+template <typename TKey>
+void raw_model_loader_iteration_test(const size_t num_keys, const size_t key_num_per_iteration,
+                                     const bool prefault) {
+  const std::string path = "raw_model_loader_test_sparse";
+  write_sparse_model(path, num_keys, num_keys);
+
+  auto loader = std::make_unique<RawModelLoader<TKey, float>>(prefault);
+  loader->load("table", path, key_num_per_iteration, -1);
+  EXPECT_EQ(loader->getkeycount(), num_keys);
+
+  // The final iteration is shorter than the others.
+  const size_t key_iteration = key_num_per_iteration ? key_num_per_iteration : num_keys / 10;
+  ASSERT_NE(num_keys % key_iteration, size_t{0});
+  const size_t num_iterations = loader->get_num_iterations();
+  ASSERT_EQ(num_iterations, num_keys / key_iteration + 1);
+
+  const std::vector<long long> ref_keys = read_file<long long>(path + "/key", num_keys);
+  const std::vector<float> ref_vectors =
+      read_file<float>(path + "/emb_vector", num_keys * emb_size);
+  for (size_t iteration = 0; iteration < num_iterations; ++iteration) {
+    const size_t first_key = iteration * key_iteration;
+    const size_t num_iteration_keys = std::min(key_iteration, num_keys - first_key);
+
+    const auto [keys, key_count] = loader->getkeys(iteration);
+    ASSERT_EQ(key_count, num_iteration_keys) << "iteration " << iteration;
+    // Callers may read a full iteration. Keys past the end of the file are zero.
+    const TKey* const key_ptr = static_cast<const TKey*>(keys);
+    for (size_t i = 0; i < key_iteration; ++i) {
+      const TKey ref = i < num_iteration_keys ? static_cast<TKey>(ref_keys[first_key + i]) : 0;
+      ASSERT_EQ(key_ptr[i], ref) << "iteration " << iteration << ", key " << i;
+    }
+
+    const auto [vectors, vec_count] = loader->getvectors(iteration, emb_size);
+    ASSERT_EQ(vec_count, num_iteration_keys * emb_size) << "iteration " << iteration;
+    const float* const vec_ptr = static_cast<const float*>(vectors);
+    for (size_t i = 0; i < key_iteration * emb_size; ++i) {
+      const float ref = i < vec_count ? ref_vectors[first_key * emb_size + i] : 0.0f;
+      ASSERT_EQ(vec_ptr[i], ref) << "iteration " << iteration << ", value " << i;
+    }
+  }
+
+  loader.reset();
+  std::filesystem::remove_all(path);
+}
+
+}  // namespace
+
+TEST(raw_model_loader, iterations_long_long) {
+  raw_model_loader_iteration_test<long long>(1000, 128, false);
+  raw_model_loader_iteration_test<long long>(1000, 128, true);
+  raw_model_loader_iteration_test<long long>(1003, 0, false);
+}
+
+TEST(raw_model_loader, iterations_unsigned) {
+  raw_model_loader_iteration_test<unsigned int>(1000, 128, false);
+  raw_model_loader_iteration_test<unsigned int>(1003, 0, true);
+}
+
+TEST(raw_model_loader, fused_tables) {
+  const std::vector<std::string> paths{"raw_model_loader_test_fused_0",
+                                       "raw_model_loader_test_fused_1"};
+  const std::vector<size_t> num_keys{300, 77};
+  for (size_t i = 0; i < paths.size(); ++i) {
+    write_sparse_model(paths[i], num_keys[i], i);
+  }
+
+  auto loader = std::make_unique<RawModelLoader<long long, float>>();
+  loader->load_fused_emb("table", paths);
+
+  // The tables are concatenated.
+  const long long* keys = static_cast<const long long*>(loader->getkeys());
+  const float* vectors = static_cast<const float*>(loader->getvectors());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const std::vector<long long> ref_keys = read_file<long long>(paths[i] + "/key", num_keys[i]);
+    const std::vector<float> ref_vectors =
+        read_file<float>(paths[i] + "/emb_vector", num_keys[i] * emb_size);
+    for (size_t j = 0; j < num_keys[i]; ++j) {
+      ASSERT_EQ(keys[j], ref_keys[j]) << "table " << i << ", key " << j;
+    }
+    for (size_t j = 0; j < ref_vectors.size(); ++j) {
+      ASSERT_EQ(vectors[j], ref_vectors[j]) << "table " << i << ", value " << j;
+    }
+    keys += num_keys[i];
+    vectors += ref_vectors.size();
+  }
+
+  loader.reset();
+  for (const std::string& path : paths) {
+    std::filesystem::remove_all(path);
+  }
+}
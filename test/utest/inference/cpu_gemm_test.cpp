@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpu/gemm_cpu.hpp>
+#include <cpu/packed_fully_connected_cpu.hpp>
+#include <cpu/quantized_fully_connected_cpu.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+float to_float(float x) { return x; }
+float to_float(__half x) { return __half2float(x); }
+
+// Odd lengths are not supported by test::GaussianDataSimulator.
+void fill(std::vector<float>& v) {
+  static std::mt19937 gen(42);
+  std::normal_distribution<float> dist(0.0f, 1.0f);
+  for (float& x : v) {
+    x = dist(gen);
+  }
+}
+
+template <typename TIn>
+void gemm_ref(size_t m, size_t n, size_t k, const TIn* a, const TIn* b, float* c, bool accumulate,
+              const GemmEpilogueCPU& epilogue = {}) {
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      double sum = accumulate ? c[i * n + j] : 0.0;
+      for (size_t p = 0; p < k; ++p) {
+        sum += static_cast<double>(to_float(a[i * k + p])) * to_float(b[p * n + j]);
+      }
+      if (epilogue.bias) {
+        sum += epilogue.bias[j];
+      }
+      if (epilogue.relu && sum < 0.0) {
+        sum = 0.0;
+      }
+      c[i * n + j] = static_cast<float>(sum);
+    }
+  }
+}
+
+template <typename TIn, typename TOut>
+void gemm_test(size_t m, size_t n, size_t k, bool accumulate, size_t num_threads,
+               bool bias = false, bool relu = false, bool packed = false) {
+  std::vector<float> h_a(m * k), h_b(k * n), h_c(m * n), h_bias(n);
+  fill(h_a);
+  fill(h_b);
+  fill(h_c);
+  fill(h_bias);
+  const GemmEpilogueCPU epilogue{bias ? h_bias.data() : nullptr, relu};
+
+  std::vector<TIn> a(h_a.begin(), h_a.end()), b(h_b.begin(), h_b.end());
+  std::vector<TOut> c(h_c.begin(), h_c.end());
+  std::vector<float> ref(c.begin(), c.end());
+  gemm_ref(m, n, k, a.data(), b.data(), ref.data(), accumulate, epilogue);
+
+  set_gemm_cpu_num_threads(num_threads);
+  if (packed) {
+    gemm_cpu(m, a.data(), PackedMatrixCPU(k, n, b.data()), c.data(), accumulate, epilogue);
+  } else {
+    gemm_cpu(m, n, k, a.data(), b.data(), c.data(), accumulate, epilogue);
+  }
+  set_gemm_cpu_num_threads(std::thread::hardware_concurrency());
+
+  const float eps = std::is_same_v<TOut, float> ? 1e-3f : 5e-2f;
+  for (size_t i = 0; i < m * n; ++i) {
+    ASSERT_NEAR(to_float(c[i]), ref[i], eps * std::max(1.0f, std::abs(ref[i])))
+        << "m = " << m << ", n = " << n << ", k = " << k << ", i = " << i;
+  }
+}
+
+// Rounds to the nearest multiple of scale in [-127 * scale, 127 * scale], like gemm_int8_cpu.
+float quantize_ref(float x, float scale) {
+  if (scale == 0) {
+    return 0;
+  }
+  return std::round(std::min(std::max(x * (1 / scale), -127.f), 127.f)) * scale;
+}
+
+template <typename T, typename TOut = T>
+void gemm_int8_test(size_t m, size_t n, size_t k, bool static_scale, bool accumulate,
+                    size_t num_threads, bool bias = false, bool relu = false) {
+  std::vector<float> h_a(m * k), h_b(k * n), h_c(m * n), h_bias(n);
+  fill(h_a);
+  fill(h_b);
+  fill(h_c);
+  fill(h_bias);
+  const GemmEpilogueCPU epilogue{bias ? h_bias.data() : nullptr, relu};
+  std::vector<T> a(h_a.begin(), h_a.end());
+  std::vector<TOut> c(h_c.begin(), h_c.end());
+
+  // Static scales clip the largest inputs.
+  const float a_scale = static_scale ? 0.8f * abs_max_cpu(a.size(), a.data()) / 127 : 0;
+  std::vector<float> a_ref(m * k), b_ref(k * n), ref(c.begin(), c.end());
+  for (size_t i = 0; i < m; ++i) {
+    const float scale = static_scale ? a_scale : abs_max_cpu(k, &a[i * k]) / 127;
+    for (size_t p = 0; p < k; ++p) {
+      a_ref[i * k + p] = quantize_ref(to_float(a[i * k + p]), scale);
+    }
+  }
+  // The range of B depends on the micro-kernel.
+  const Int8MatrixCPU b(k, n, h_b.data());
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t p = 0; p < k; ++p) {
+      b_ref[p * n + j] = quantize_ref(h_b[p * n + j], b.get_scales()[j]);
+    }
+  }
+  gemm_ref(m, n, k, a_ref.data(), b_ref.data(), ref.data(), accumulate, epilogue);
+
+  set_gemm_cpu_num_threads(num_threads);
+  gemm_int8_cpu(m, a.data(), a_scale, b, c.data(), accumulate, epilogue);
+  set_gemm_cpu_num_threads(std::thread::hardware_concurrency());
+
+  const float eps = std::is_same_v<TOut, float> ? 1e-4f : 5e-2f;
+  for (size_t i = 0; i < m * n; ++i) {
+    ASSERT_NEAR(to_float(c[i]), ref[i], eps * std::max(1.0f, std::abs(ref[i])))
+        << "m = " << m << ", n = " << n << ", k = " << k << ", i = " << i;
+  }
+}
+
+// Fused product of a fully connected layer with several fp16 inputs. The partial sums must be
+// kept in fp32. That is, the output is only rounded to fp16 once.
+void fully_connected_fp16_test(size_t m, size_t n, const std::vector<size_t>& input_widths,
+                               bool quantized) {
+  size_t k = 0;
+  for (size_t width : input_widths) {
+    k += width;
+  }
+  std::vector<float> h_a(m * k), h_b(k * n), h_bias(n);
+  fill(h_a);
+  fill(h_b);
+  fill(h_bias);
+  const GemmEpilogueCPU epilogue{h_bias.data(), false};
+
+  // Each input is a column range of A.
+  std::vector<std::vector<__half>> inputs;
+  std::vector<const __half*> input_ptrs;
+  size_t k_offset = 0;
+  for (size_t width : input_widths) {
+    inputs.emplace_back(m * width);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t p = 0; p < width; ++p) {
+        inputs.back()[i * width + p] = h_a[i * k + k_offset + p];
+      }
+    }
+    input_ptrs.push_back(inputs.back().data());
+    k_offset += width;
+  }
+  std::vector<__half> c(m * n);
+
+  // The reference multiplies what the fused product sees, i.e., the rounded inputs and weights.
+  std::vector<float> a_ref(m * k), b_ref(k * n), ref(m * n);
+  if (quantized) {
+    QuantizedFullyConnectedCPU fc(input_widths);
+    fc.set_calibration(true);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      fc.calibrate(i, m, input_ptrs[i]);
+    }
+    fc.set_calibration(false);
+    fc.quantize(h_b.data(), n, nullptr);
+    fc.fprop(m, input_ptrs, c.data(), epilogue);
+
+    k_offset = 0;
+    for (size_t w = 0; w < inputs.size(); ++w) {
+      const size_t width = input_widths[w];
+      const float scale = abs_max_cpu(m * width, input_ptrs[w]) / 127;
+      const Int8MatrixCPU b(width, n, &h_b[k_offset * n]);
+      for (size_t i = 0; i < m; ++i) {
+        for (size_t p = 0; p < width; ++p) {
+          a_ref[i * k + k_offset + p] = quantize_ref(to_float(inputs[w][i * width + p]), scale);
+        }
+      }
+      for (size_t p = 0; p < width; ++p) {
+        for (size_t j = 0; j < n; ++j) {
+          b_ref[(k_offset + p) * n + j] =
+              quantize_ref(h_b[(k_offset + p) * n + j], b.get_scales()[j]);
+        }
+      }
+      k_offset += width;
+    }
+  } else {
+    const std::vector<__half> b(h_b.begin(), h_b.end());
+    PackedFullyConnectedCPU fc(input_widths);
+    fc.pack(b.data(), n, nullptr);
+    fc.fprop(m, input_ptrs, c.data(), epilogue);
+
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t p = 0; p < k; ++p) {
+        a_ref[i * k + p] = to_float(__float2half(h_a[i * k + p]));
+      }
+    }
+    for (size_t i = 0; i < k * n; ++i) {
+      b_ref[i] = to_float(b[i]);
+    }
+  }
+  gemm_ref(m, n, k, a_ref.data(), b_ref.data(), ref.data(), false, epilogue);
+
+  // Half an fp16 ulp, plus the error of fp32 sums.
+  for (size_t i = 0; i < m * n; ++i) {
+    ASSERT_NEAR(to_float(c[i]), ref[i], std::abs(ref[i]) / 2048 + 1e-4f)
+        << "m = " << m << ", n = " << n << ", k = " << k << ", i = " << i;
+  }
+}
+
+void gemv_test(size_t m, size_t k, size_t num_threads) {
+  std::vector<float> a(m * k), x(k), y(m), ref(m);
+  fill(a);
+  fill(x);
+  gemm_ref(m, 1, k, a.data(), x.data(), ref.data(), false);
+
+  set_gemm_cpu_num_threads(num_threads);
+  gemv_cpu(m, k, a.data(), x.data(), y.data());
+  set_gemm_cpu_num_threads(std::thread::hardware_concurrency());
+
+  for (size_t i = 0; i < m; ++i) {
+    ASSERT_NEAR(y[i], ref[i], 1e-3f * std::max(1.0f, std::abs(ref[i])));
+  }
+}
+
+}  // namespace
+
+TEST(gemm_cpu, fp32_edges) {
+  for (size_t m : {1, 4, 5, 7, 97}) {
+    for (size_t n : {1, 17, 33, 520}) {
+      for (size_t k : {1, 13, 257}) {
+        gemm_test<float, float>(m, n, k, false, 1);
+      }
+    }
+  }
+}
+
+TEST(gemm_cpu, fp32_accumulate) { gemm_test<float, float>(64, 1024, 479, true, 1); }
+
+TEST(gemm_cpu, fp32_multithreaded) {
+  gemm_test<float, float>(1024, 1024, 512, false, 8);
+  gemm_test<float, float>(16, 1024, 1024, true, 8);
+}
+
+TEST(gemm_cpu, fp16_fp32_out) {
+  gemm_test<__half, float>(3, 130, 300, false, 4);
+  gemm_test<__half, float>(100, 130, 300, false, 4);
+}
+
+TEST(gemm_cpu, fp16_fp16_out) {
+  gemm_test<__half, __half>(3, 256, 600, true, 4);
+  gemm_test<__half, __half>(64, 256, 600, true, 4);
+}
+
+TEST(gemm_cpu, epilogue) {
+  for (size_t m : {1, 7, 300}) {
+    gemm_test<float, float>(m, 130, 257, false, 1, true, false);
+    gemm_test<float, float>(m, 130, 257, false, 4, true, true);
+    gemm_test<float, float>(m, 130, 257, true, 4, false, true);
+  }
+  gemm_test<float, float>(5, 33, 0, false, 1, true, true);
+  gemm_test<__half, __half>(64, 256, 600, false, 4, true, true);
+}
+
+TEST(gemm_cpu, packed) {
+  for (size_t m : {1, 4, 5, 97}) {
+    for (size_t n : {1, 33, 520}) {
+      for (size_t k : {1, 257, 600}) {
+        gemm_test<float, float>(m, n, k, false, 1, false, false, true);
+      }
+    }
+  }
+  gemm_test<float, float>(300, 1024, 512, true, 8, true, true, true);
+  gemm_test<__half, float>(3, 130, 300, false, 4, true, false, true);
+  gemm_test<__half, __half>(64, 256, 600, true, 4, true, true, true);
+  gemm_test<float, float>(5, 33, 0, true, 1, true, true, true);
+}
+
+TEST(gemm_cpu, int8_edges) {
+  for (size_t m : {1, 7, 97}) {
+    for (size_t n : {1, 17, 33, 520}) {
+      for (size_t k : {1, 6, 257}) {
+        gemm_int8_test<float>(m, n, k, false, false, 1);
+      }
+    }
+  }
+}
+
+TEST(gemm_cpu, int8_static_scale) {
+  gemm_int8_test<float>(64, 130, 300, true, false, 1);
+  gemm_int8_test<float>(300, 1024, 512, true, true, 8);
+}
+
+TEST(gemm_cpu, int8_epilogue) {
+  gemm_int8_test<float>(100, 130, 257, false, false, 4, true, true);
+  gemm_int8_test<float>(100, 130, 257, true, true, 4, true, false);
+  gemm_int8_test<__half>(64, 256, 600, false, true, 4, true, true);
+  gemm_int8_test<__half>(3, 256, 600, true, false, 4);
+  gemm_int8_test<__half, float>(64, 130, 257, false, true, 4, true, true);
+}
+
+TEST(gemm_cpu, int8_zero_weights) {
+  const size_t m = 5, n = 40, k = 9;
+  std::vector<float> a(m * k, 1.0f), b(k * n, 0.0f), bias(n, -1.0f), c(m * n);
+  gemm_int8_cpu(m, a.data(), 0, Int8MatrixCPU(k, n, b.data()), c.data(), false,
+                {bias.data(), false});
+  for (float x : c) {
+    ASSERT_EQ(x, -1.0f);
+  }
+}
+
+TEST(gemm_cpu, fully_connected_fp16) {
+  fully_connected_fp16_test(33, 130, {64, 64, 64, 64}, false);
+  fully_connected_fp16_test(5, 40, {13, 300}, false);
+  fully_connected_fp16_test(33, 130, {64, 64, 64, 64}, true);
+  fully_connected_fp16_test(5, 40, {13, 300}, true);
+}
+
+TEST(gemm_cpu, gemv) {
+  gemv_test(1, 4, 1);
+  gemv_test(33, 1023, 1);
+  gemv_test(4096, 1024, 8);
+}
@@ -24,6 +24,10 @@
 #include <general_buffer2.hpp>
 #include <hps/hier_parameter_server.hpp>
 #include <hps/inference_utils.hpp>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <unordered_set>
 #include <utest/test_utils.hpp>
 #include <utils.hpp>
 #include <vector>
@@ -333,6 +337,202 @@ void session_inference_generated_test(const std::string& config_file, const std:
   host_allocator.deallocate(h_embeddingcolumns);
 }
 
+// Inputs, parameter server and reference predictions shared by the session tests below.
+template <typename TypeHashKey>
+struct SessionTestData {
+  std::vector<int> h_row_ptrs;
+  std::vector<float> h_dense;
+  std::vector<TypeHashKey> h_keys;
+  std::vector<InferenceParams> inference_params;
+  std::vector<std::string> model_config_path;
+  std::shared_ptr<HierParameterServerBase> parameter_server;
+  // Predictions of a session without cache and with a single worker context.
+  std::vector<float> h_out_ref;
+
+  SessionTestData(const std::string& config_file, const std::string& model, int batchsize) {
+    InferenceInfo inference_info(read_json_file(config_file));
+    const int batch_size = batchsize;
+    const int dense_dim = inference_info.dense_dim;
+    const int slot_num = inference_info.slot_num[0];
+    const int max_feature_num_per_sample = inference_info.max_feature_num_per_sample[0];
+
+    // One key per slot.
+    h_row_ptrs.resize(batch_size * slot_num + 1);
+    std::iota(h_row_ptrs.begin(), h_row_ptrs.end(), 0);
+
+    h_dense.resize(batch_size * dense_dim);
+    FloatUniformDataSimulator<float> fdata_sim(0, 1);
+    for (float& value : h_dense) {
+      value = fdata_sim.get_num();
+    }
+
+    h_keys.resize(batch_size * max_feature_num_per_sample);
+    for (int i = 0; i < batch_size; i++) {
+      for (int j = 0; j < slot_num; j++) {
+        IntUniformDataSimulator<int> ldata_sim(RANGE[j], RANGE[j + 1] - 1);
+        h_keys[i * slot_num + j] = static_cast<TypeHashKey>(ldata_sim.get_num());
+      }
+    }
+
+    std::string dense_model{"/hugectr/test/utest/_dense_10000.model"};
+    std::vector<std::string> sparse_models{"/hugectr/test/utest/0_sparse_10000.model"};
+    InferenceParams infer_param(model, batchsize, 0.5, dense_model, sparse_models, 0, true, 0.8,
+                                false);
+    inference_params.push_back(infer_param);
+    model_config_path.push_back(config_file);
+    parameter_server_config ps_config{model_config_path, inference_params};
+    parameter_server = HierParameterServerBase::create(ps_config);
+
+    h_out_ref.resize(batch_size);
+    InferenceSessionCPU<TypeHashKey> sess(model_config_path[0], inference_params[0],
+                                          parameter_server);
+    sess.predict(h_dense.data(), h_keys.data(), h_row_ptrs.data(), h_out_ref.data(), batch_size);
+  }
+};
+
+template <typename TypeHashKey>
+void session_inference_embedding_cache_test(const std::string& config_file,
+                                            const std::string& model, int batchsize) {
+  const int batch_size = batchsize;
+  SessionTestData<TypeHashKey> data(config_file, model, batchsize);
+
+  // The first batch populates the cache, and the second batch is served from the cache.
+  EmbeddingCacheCPUParams cache_params;
+  cache_params.capacity = 64 * 1024;
+  cache_params.num_shards = 4;
+  InferenceSessionCPU<TypeHashKey> sess(data.model_config_path[0], data.inference_params[0],
+                                        data.parameter_server, cache_params);
+  for (int iteration = 0; iteration < 2; iteration++) {
+    std::vector<float> h_out(batch_size);
+    sess.predict(data.h_dense.data(), data.h_keys.data(), data.h_row_ptrs.data(), h_out.data(),
+                 batch_size);
+    for (int i = 0; i < batch_size; i++) {
+      EXPECT_FLOAT_EQ(h_out[i], data.h_out_ref[i]);
+    }
+  }
+
+  // Keys are deduplicated per table before the cache lookup. All slots belong to table 0.
+  const std::unordered_set<TypeHashKey> distinct_keys(
+      data.h_keys.begin(), data.h_keys.begin() + data.h_row_ptrs.back());
+  const EmbeddingCacheCPUStats stats{sess.get_embedding_cache()->stats(0)};
+  HCTR_LOG_S(INFO, ROOT) << "CPU embedding cache: " << stats << std::endl;
+  EXPECT_EQ(stats.num_hits + stats.num_misses, 2 * distinct_keys.size());
+  EXPECT_GE(stats.num_hits, distinct_keys.size());
+  EXPECT_GE(stats.hit_rate(), 0.5);
+}
+
+template <typename TypeHashKey>
+void session_inference_concurrency_test(const std::string& config_file, const std::string& model,
+                                        int batchsize, int num_workers) {
+  const int batch_size = batchsize;
+  SessionTestData<TypeHashKey> data(config_file, model, batchsize);
+
+  // Concurrent predictions, whose batches are split across the worker contexts.
+  InferenceSessionCPUParams session_params;
+  session_params.num_workers = num_workers;
+  session_params.worker_batchsize = (batch_size + num_workers - 1) / num_workers;
+  InferenceSessionCPU<TypeHashKey> sess(data.model_config_path[0], data.inference_params[0],
+                                        data.parameter_server, {}, session_params);
+  EXPECT_EQ(sess.get_num_workers(), num_workers);
+
+  std::vector<std::vector<float>> h_outs(num_workers, std::vector<float>(batch_size));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_workers; t++) {
+    threads.emplace_back([&, t]() {
+      for (int iteration = 0; iteration < 4; iteration++) {
+        sess.predict(data.h_dense.data(), data.h_keys.data(), data.h_row_ptrs.data(),
+                     h_outs[t].data(), batch_size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const std::vector<float>& h_out : h_outs) {
+    for (int i = 0; i < batch_size; i++) {
+      EXPECT_FLOAT_EQ(h_out[i], data.h_out_ref[i]);
+    }
+  }
+
+  // Partial batch.
+  const int num_samples = batch_size / 2 + 1;
+  std::vector<float> h_out(batch_size);
+  sess.predict(data.h_dense.data(), data.h_keys.data(), data.h_row_ptrs.data(), h_out.data(),
+               num_samples);
+  for (int i = 0; i < num_samples; i++) {
+    EXPECT_FLOAT_EQ(h_out[i], data.h_out_ref[i]);
+  }
+}
+
+template <typename TypeEmbedding>
+void embedding_feature_combine_cpu_test(int batch_size, int slot_num, int embedding_vec_size,
+                                        int max_nnz, EmbeddingFeatureCombiner_t combiner_type,
+                                        int num_unique_rows = 0) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> nnz_dist(0, max_nnz);
+  std::vector<int> h_row_ptrs(batch_size * slot_num + 1, 0);
+  for (size_t i = 1; i < h_row_ptrs.size(); i++) {
+    h_row_ptrs[i] = h_row_ptrs[i - 1] + nnz_dist(gen);
+  }
+  const int feature_num = h_row_ptrs.back();
+
+  // If num_unique_rows is set, features refer to random rows of a deduplicated input.
+  std::vector<int> h_row_indices(feature_num);
+  std::iota(h_row_indices.begin(), h_row_indices.end(), 0);
+  if (num_unique_rows > 0) {
+    std::uniform_int_distribution<int> row_dist(0, num_unique_rows - 1);
+    std::generate(h_row_indices.begin(), h_row_indices.end(), [&]() { return row_dist(gen); });
+  }
+  const int num_in_rows = num_unique_rows > 0 ? num_unique_rows : feature_num;
+
+  auto blobs_buff = GeneralBuffer2<HostAllocator>::create();
+  auto in_tensor = std::make_shared<Tensor2<float>>();
+  auto row_ptrs_tensor = std::make_shared<Tensor2<int>>();
+  std::shared_ptr<Tensor2<int>> row_indices_tensor;
+  blobs_buff->reserve({static_cast<size_t>(std::max(num_in_rows, 1)),
+                       static_cast<size_t>(embedding_vec_size)},
+                      in_tensor.get());
+  blobs_buff->reserve({h_row_ptrs.size()}, row_ptrs_tensor.get());
+  if (num_unique_rows > 0) {
+    row_indices_tensor = std::make_shared<Tensor2<int>>();
+    blobs_buff->reserve({static_cast<size_t>(std::max(feature_num, 1))}, row_indices_tensor.get());
+  }
+  Tensor2<TypeEmbedding> out_tensor;
+  EmbeddingFeatureCombinerCPU<TypeEmbedding> combiner(in_tensor, row_ptrs_tensor, out_tensor,
+                                                      batch_size, slot_num, combiner_type,
+                                                      blobs_buff, row_indices_tensor);
+  blobs_buff->allocate();
+
+  std::normal_distribution<float> value_dist(0.0f, 1.0f);
+  float* h_in = in_tensor->get_ptr();
+  for (size_t i = 0; i < in_tensor->get_num_elements(); i++) {
+    h_in[i] = value_dist(gen);
+  }
+  std::copy(h_row_ptrs.begin(), h_row_ptrs.end(), row_ptrs_tensor->get_ptr());
+  if (row_indices_tensor) {
+    std::copy(h_row_indices.begin(), h_row_indices.end(), row_indices_tensor->get_ptr());
+  }
+  combiner.fprop(false);
+
+  // Empty slots yield zeros, like the GPU combiner.
+  const TypeEmbedding* h_out = out_tensor.get_ptr();
+  for (int i = 0; i < batch_size * slot_num; i++) {
+    const int num = h_row_ptrs[i + 1] - h_row_ptrs[i];
+    for (int k = 0; k < embedding_vec_size; k++) {
+      double ref = 0;
+      for (int l = h_row_ptrs[i]; l < h_row_ptrs[i + 1]; l++) {
+        ref += h_in[h_row_indices[l] * embedding_vec_size + k];
+      }
+      if (combiner_type == EmbeddingFeatureCombiner_t::Mean && num > 1) {
+        ref /= num;
+      }
+      const float eps = std::is_same_v<TypeEmbedding, float> ? 1e-4f : 1e-2f;
+      ASSERT_NEAR(static_cast<float>(h_out[i * embedding_vec_size + k]), ref,
+                  eps * std::max(1.0, std::abs(ref)));
+    }
+  }
+}
+
 }  // namespace
 
 TEST(session_inference_cpu, criteo_dcn) {
@@ -342,4 +542,31 @@ TEST(session_inference_cpu, criteo_dcn) {
 TEST(session_inference_cpu, generated_dcn_32) {
   session_inference_generated_test<unsigned int>("/workdir/test/utest/simple_inference_config.json",
                                                  "DCN", 32, 32);
-}
\ No newline at end of file
+}
+TEST(session_inference_cpu, embedding_cache_dcn_32) {
+  session_inference_embedding_cache_test<unsigned int>(
+      "/workdir/test/utest/simple_inference_config.json", "DCN", 32);
+}
+TEST(session_inference_cpu, concurrency_dcn_32) {
+  session_inference_concurrency_test<unsigned int>(
+      "/workdir/test/utest/simple_inference_config.json", "DCN", 32, 4);
+}
+TEST(embedding_feature_combiner_cpu, fp32_1024x26x64_30_Sum) {
+  embedding_feature_combine_cpu_test<float>(1024, 26, 64, 30, EmbeddingFeatureCombiner_t::Sum);
+}
+TEST(embedding_feature_combiner_cpu, fp32_1000x3x37_10_Mean) {
+  embedding_feature_combine_cpu_test<float>(1000, 3, 37, 10, EmbeddingFeatureCombiner_t::Mean);
+}
+TEST(embedding_feature_combiner_cpu, fp16_1024x26x64_30_Mean) {
+  embedding_feature_combine_cpu_test<__half>(1024, 26, 64, 30, EmbeddingFeatureCombiner_t::Mean);
+}
+TEST(embedding_feature_combiner_cpu, fp16_10x10x7_3_Sum) {
+  embedding_feature_combine_cpu_test<__half>(10, 10, 7, 3, EmbeddingFeatureCombiner_t::Sum);
+}
+TEST(embedding_feature_combiner_cpu, fp32_1024x26x64_30_Mean_row_indices) {
+  embedding_feature_combine_cpu_test<float>(1024, 26, 64, 30, EmbeddingFeatureCombiner_t::Mean,
+                                            1000);
+}
+TEST(embedding_feature_combiner_cpu, fp16_100x10x37_10_Sum_row_indices) {
+  embedding_feature_combine_cpu_test<__half>(100, 10, 37, 10, EmbeddingFeatureCombiner_t::Sum, 50);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cpu/layers/interaction_layer_cpu.hpp>
+#include <memory>
+#include <utest/test_utils.hpp>
+#include <utils.hpp>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+template <typename T>
+class InteractionLayerCPUTest {
+ private:
+  const size_t batchsize_;
+  const size_t w_;
+  const size_t n_emb_;
+  const size_t n_ins_;
+  const size_t out_w_;
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> blob_buf_;
+
+  Tensor2<T> in_mlp_;
+  Tensor2<T> in_emb_;
+  Tensor2<T> output_;
+
+  std::vector<float> h_in_mlp_;
+  std::vector<float> h_in_emb_;
+  std::vector<float> h_output_;
+
+  std::shared_ptr<InteractionLayerCPU<T>> layer_;
+  test::GaussianDataSimulator data_sim_;
+
+  void reset_forward_() {
+    data_sim_.fill(h_in_mlp_.data(), h_in_mlp_.size());
+    data_sim_.fill(h_in_emb_.data(), h_in_emb_.size());
+    // The inputs are rounded to T, so that the reference sees the same values as the layer.
+    for (size_t i = 0; i < h_in_mlp_.size(); i++) {
+      in_mlp_.get_ptr()[i] = TypeConvert<T, float>::convert(h_in_mlp_[i]);
+      h_in_mlp_[i] = TypeConvert<float, T>::convert(in_mlp_.get_ptr()[i]);
+    }
+    for (size_t i = 0; i < h_in_emb_.size(); i++) {
+      in_emb_.get_ptr()[i] = TypeConvert<T, float>::convert(h_in_emb_[i]);
+      h_in_emb_[i] = TypeConvert<float, T>::convert(in_emb_.get_ptr()[i]);
+    }
+    // The padding must be written by the layer, even if the buffer is reused.
+    for (size_t i = 0; i < batchsize_ * out_w_; i++) {
+      output_.get_ptr()[i] = TypeConvert<T, float>::convert(1.f);
+    }
+  }
+
+  void cpu_fprop_() {
+    for (size_t p = 0; p < batchsize_; p++) {
+      std::vector<float> concat(h_in_mlp_.begin() + p * w_, h_in_mlp_.begin() + (p + 1) * w_);
+      concat.insert(concat.end(), h_in_emb_.begin() + p * n_emb_ * w_,
+                    h_in_emb_.begin() + (p + 1) * n_emb_ * w_);
+
+      float* out = h_output_.data() + p * out_w_;
+      for (size_t i = 0; i < w_; i++) {
+        *out++ = concat[i];
+      }
+      for (size_t n = 0; n < n_ins_; n++) {
+        for (size_t m = 0; m < n; m++) {
+          float accum = 0.0f;
+          for (size_t k = 0; k < w_; k++) {
+            accum += concat[m * w_ + k] * concat[n * w_ + k];
+          }
+          *out++ = accum;
+        }
+      }
+      *out = 0.0f;
+    }
+  }
+
+  void compare_forward_(float eps) {
+    for (size_t i = 0; i < h_output_.size(); i++) {
+      const float result = TypeConvert<float, T>::convert(output_.get_ptr()[i]);
+      ASSERT_NEAR(result, h_output_[i], eps * std::max(1.0f, std::abs(h_output_[i]))) << i;
+    }
+  }
+
+ public:
+  InteractionLayerCPUTest(size_t batchsize, size_t w, size_t n_emb)
+      : batchsize_(batchsize),
+        w_(w),
+        n_emb_(n_emb),
+        n_ins_(1 + n_emb),
+        out_w_(w + n_emb * (n_emb + 1) / 2 + 1),
+        blob_buf_(GeneralBuffer2<HostAllocator>::create()),
+        data_sim_(0.0f, 1.0f) {
+    blob_buf_->reserve({batchsize, w}, &in_mlp_);
+    blob_buf_->reserve({batchsize, n_emb, w}, &in_emb_);
+
+    h_in_mlp_.resize(batchsize * w);
+    h_in_emb_.resize(batchsize * n_emb * w);
+    h_output_.resize(batchsize * out_w_);
+
+    layer_.reset(new InteractionLayerCPU<T>(in_mlp_, in_emb_, output_, blob_buf_,
+                                            std::is_same<T, __half>::value));
+
+    blob_buf_->allocate();
+  }
+
+  void test(float eps) {
+    ASSERT_EQ(output_.get_dimensions()[1], out_w_);
+    reset_forward_();
+    cpu_fprop_();
+    layer_->fprop(false);
+    compare_forward_(eps);
+  }
+};
+
+}  // namespace
+
+TEST(interaction_layer_cpu, fp32_1x16x1) { InteractionLayerCPUTest<float>(1, 16, 1).test(1e-5f); }
+
+TEST(interaction_layer_cpu, fp32_64x128x26) {
+  InteractionLayerCPUTest<float>(64, 128, 26).test(1e-4f);
+}
+
+TEST(interaction_layer_cpu, fp32_1000x37x9) {
+  InteractionLayerCPUTest<float>(1000, 37, 9).test(1e-4f);
+}
+
+TEST(interaction_layer_cpu, fp32_8x300x40) {
+  InteractionLayerCPUTest<float>(8, 300, 40).test(1e-4f);
+}
+
+TEST(interaction_layer_cpu, fp16_64x128x26) {
+  InteractionLayerCPUTest<__half>(64, 128, 26).test(1e-2f);
+}
+
+TEST(interaction_layer_cpu, fp16_100x33x5) {
+  InteractionLayerCPUTest<__half>(100, 33, 5).test(1e-2f);
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cpu/network_cpu.hpp>
+#include <cpu_resource.hpp>
+#include <cstdio>
+#include <fstream>
+#include <general_buffer2.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+const float eps = 1e-4f;
+
+const size_t batch_size = 64;
+const size_t a_dim = 24;
+const size_t b_dim = 40;
+const size_t fc1_dim = 48;
+const size_t fc2_dim = 16;
+
+// Every fusion of NetworkCPU applies: Concat -> InnerProduct, InnerProduct -> ReLU and
+// Add -> ReLU. Besides, the intermediate activations share memory.
+const char* network_config = R"([
+  {"name": "data", "type": "Data"},
+  {"name": "concat1", "type": "Concat", "bottom": ["a", "b"], "top": "concat1"},
+  {"name": "fc1", "type": "InnerProduct", "bottom": "concat1", "top": "fc1",
+   "fc_param": {"num_output": 48}},
+  {"name": "relu1", "type": "ReLU", "bottom": "fc1", "top": "relu1"},
+  {"name": "add1", "type": "Add", "bottom": ["relu1", "c"], "top": "add1"},
+  {"name": "relu2", "type": "ReLU", "bottom": "add1", "top": "relu2"},
+  {"name": "fc2", "type": "InnerProduct", "bottom": "relu2", "top": "fc2",
+   "fc_param": {"num_output": 16}},
+  {"name": "relu3", "type": "ReLU", "bottom": "fc2", "top": "relu3"},
+  {"name": "fc3", "type": "InnerProduct", "bottom": "relu3", "top": "fc3",
+   "fc_param": {"num_output": 1}}
+])";
+
+// out = in * weights + bias, followed by ReLU if relu is set.
+std::vector<float> fully_connected_ref(const std::vector<float>& in, size_t k, size_t n,
+                                       const float* weights, const float* bias, bool relu) {
+  const size_t m = in.size() / k;
+  std::vector<float> out(m * n);
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      float sum = bias[j];
+      for (size_t l = 0; l < k; l++) {
+        sum += in[i * k + l] * weights[l * n + j];
+      }
+      out[i * n + j] = relu ? std::max(sum, 0.0f) : sum;
+    }
+  }
+  return out;
+}
+
+// The unfused network, one layer after the other.
+std::vector<float> network_ref(const std::vector<float>& a, const std::vector<float>& b,
+                               const std::vector<float>& c, const std::vector<float>& params) {
+  std::vector<float> concat1(batch_size * (a_dim + b_dim));
+  for (size_t i = 0; i < batch_size; i++) {
+    std::copy_n(&a[i * a_dim], a_dim, &concat1[i * (a_dim + b_dim)]);
+    std::copy_n(&b[i * b_dim], b_dim, &concat1[i * (a_dim + b_dim) + a_dim]);
+  }
+
+  // The weights of each InnerProduct, followed by its bias.
+  const float* fc1_weights = params.data();
+  const float* fc1_bias = fc1_weights + (a_dim + b_dim) * fc1_dim;
+  const float* fc2_weights = fc1_bias + fc1_dim;
+  const float* fc2_bias = fc2_weights + fc1_dim * fc2_dim;
+  const float* fc3_weights = fc2_bias + fc2_dim;
+  const float* fc3_bias = fc3_weights + fc2_dim;
+
+  std::vector<float> relu1 =
+      fully_connected_ref(concat1, a_dim + b_dim, fc1_dim, fc1_weights, fc1_bias, true);
+  std::vector<float> relu2(relu1.size());
+  for (size_t i = 0; i < relu1.size(); i++) {
+    relu2[i] = std::max(relu1[i] + c[i], 0.0f);
+  }
+  std::vector<float> relu3 = fully_connected_ref(relu2, fc1_dim, fc2_dim, fc2_weights, fc2_bias,
+                                                 true);
+  return fully_connected_ref(relu3, fc2_dim, 1, fc3_weights, fc3_bias, false);
+}
+
+void compare(const std::vector<float>& expected, Tensor2<float> pred) {
+  ASSERT_EQ(pred.get_num_elements(), expected.size());
+  const float* actual = pred.get_ptr();
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_NEAR(actual[i], expected[i], eps * std::max(1.0f, std::abs(expected[i]))) << i;
+  }
+}
+
+}  // namespace
+
+TEST(network_cpu, fused_layers) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+  // Inputs of the network.
+  std::shared_ptr<GeneralBuffer2<HostAllocator>> input_buff =
+      GeneralBuffer2<HostAllocator>::create();
+  Tensor2<float> a_tensor, b_tensor, c_tensor;
+  input_buff->reserve({batch_size, a_dim}, &a_tensor);
+  input_buff->reserve({batch_size, b_dim}, &b_tensor);
+  input_buff->reserve({batch_size, fc1_dim}, &c_tensor);
+  input_buff->allocate();
+  std::vector<float> a(a_tensor.get_num_elements());
+  std::vector<float> b(b_tensor.get_num_elements());
+  std::vector<float> c(c_tensor.get_num_elements());
+  for (auto* input : {&a, &b, &c}) {
+    for (float& value : *input) {
+      value = dist(gen);
+    }
+  }
+  std::copy(a.begin(), a.end(), a_tensor.get_ptr());
+  std::copy(b.begin(), b.end(), b_tensor.get_ptr());
+  std::copy(c.begin(), c.end(), c_tensor.get_ptr());
+  const std::vector<TensorEntry> input_entries{
+      {"a", a_tensor.shrink()}, {"b", b_tensor.shrink()}, {"c", c_tensor.shrink()}};
+
+  const nlohmann::json j_array = nlohmann::json::parse(network_config);
+  std::shared_ptr<CPUResource> cpu_resource(new CPUResource(0, {}));
+  std::vector<TensorEntry> tensor_entries{input_entries};
+  std::unique_ptr<NetworkCPU> network(
+      NetworkCPU::create_network(j_array, tensor_entries, cpu_resource, false));
+
+  // Load random weights through a model file, as InferenceSessionCPU does.
+  std::vector<float> params(network->get_params_num());
+  for (float& value : params) {
+    value = dist(gen);
+  }
+  const std::string model_file = "cpu_network_test_model.bin";
+  {
+    std::ofstream model_stream(model_file, std::ofstream::binary);
+    model_stream.write(reinterpret_cast<const char*>(params.data()),
+                       params.size() * sizeof(float));
+  }
+  network->load_params_from_model(model_file);
+  std::remove(model_file.c_str());
+
+  const std::vector<float> expected = network_ref(a, b, c, params);
+  network->predict();
+  compare(expected, network->get_pred_tensor());
+
+  // Predicting again must not depend on stale activations in shared memory.
+  network->predict();
+  compare(expected, network->get_pred_tensor());
+
+  // Same with packed weights, and for a replica that shares them.
+  network->pack_weights();
+  network->predict();
+  compare(expected, network->get_pred_tensor());
+
+  std::vector<TensorEntry> replica_tensor_entries{input_entries};
+  std::unique_ptr<NetworkCPU> replica(NetworkCPU::create_network(
+      j_array, replica_tensor_entries, cpu_resource, false, network.get()));
+  replica->pack_weights(network.get());
+  replica->predict();
+  compare(expected, replica->get_pred_tensor());
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cpu/unique_op_cpu.hpp>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace HugeCTR;
+
+namespace {
+
+template <typename TypeHashKey>
+void unique_op_test(size_t len, size_t key_range, size_t num_runs) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<long long> key_dist(0, key_range - 1);
+  UniqueOpCPU unique_op(len);
+
+  // The workspace is reused across runs of different lengths.
+  for (size_t run = 0; run < num_runs; run++) {
+    const size_t num_keys = len >> run;
+    std::vector<TypeHashKey> keys(num_keys);
+    for (auto& key : keys) {
+      key = static_cast<TypeHashKey>(key_dist(gen));
+    }
+
+    std::vector<int> output_index(num_keys, -1);
+    std::vector<TypeHashKey> unique_keys(num_keys);
+    const size_t num_unique =
+        unique_op.unique(keys.data(), num_keys, output_index.data(), unique_keys.data());
+
+    const std::unordered_set<TypeHashKey> ref(keys.begin(), keys.end());
+    ASSERT_EQ(num_unique, ref.size());
+    const std::unordered_set<TypeHashKey> result(unique_keys.begin(),
+                                                 unique_keys.begin() + num_unique);
+    ASSERT_EQ(result.size(), num_unique);
+    for (size_t i = 0; i < num_keys; i++) {
+      ASSERT_GE(output_index[i], 0);
+      ASSERT_LT(static_cast<size_t>(output_index[i]), num_unique);
+      ASSERT_EQ(unique_keys[output_index[i]], keys[i]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(unique_op_cpu, empty) { unique_op_test<unsigned int>(0, 1, 1); }
+
+TEST(unique_op_cpu, u32_small) {
+  unique_op_test<unsigned int>(1, 1, 1);
+  unique_op_test<unsigned int>(1000, 100, 3);
+}
+
+TEST(unique_op_cpu, i64_small) { unique_op_test<long long>(4096, 1ll << 40, 2); }
+
+TEST(unique_op_cpu, u32_partitioned) { unique_op_test<unsigned int>(1 << 20, 50000, 4); }
+
+TEST(unique_op_cpu, i64_partitioned) { unique_op_test<long long>(1 << 20, 1ll << 40, 2); }
+
+TEST(unique_op_cpu, capacity) {
+  UniqueOpCPU unique_op(8);
+  std::vector<long long> keys(9, 0);
+  std::vector<int> output_index(9);
+  std::vector<long long> unique_keys(9);
+  EXPECT_THROW(unique_op.unique(keys.data(), keys.size(), output_index.data(), unique_keys.data()),
+               std::runtime_error);
+}
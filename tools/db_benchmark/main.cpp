@@ -22,6 +22,7 @@
 #include <hps/mp_hash_map_backend.hpp>
 #include <hps/redis_backend.hpp>
 #include <hps/rocksdb_backend.hpp>
+#include <hps/slab_store_backend.hpp>
 #include <iostream>
 #include <random>
 #include <sstream>
@@ -87,6 +88,11 @@ int main(int argc, char** argv) {
       .default_value<size_t>(8L * 1024 * 1024)
       .scan<'u', size_t>();
 
+  args.add_argument("--hm_open_addressing")
+      .help("Use open-addressing storage with lock-free lookups (mp_hashmap only).")
+      .default_value(false)
+      .implicit_value(true);
+
   // Redis parameters.
   args.add_argument("--re_address")
       .help("Redis server address.")
@@ -122,6 +128,31 @@ int main(int argc, char** argv) {
       .default_value<size_t>(1024 * 1024)
       .scan<'u', size_t>();
 
+  // SlabStore parameters.
+  args.add_argument("--ss_path")
+      .help("Slab store path.")
+      .default_value<std::string>("/tmp/slab_store");
+
+  args.add_argument("--ss_tasks")
+      .help("Number of concurrent lookup tasks for SlabStore.")
+      .default_value<size_t>(4)
+      .scan<'u', size_t>();
+
+  args.add_argument("--ss_io_depth")
+      .help("Number of reads in flight per SlabStore lookup task.")
+      .default_value<size_t>(64)
+      .scan<'u', size_t>();
+
+  args.add_argument("--ss_no_direct")
+      .help("Read SlabStore files through the OS page cache.")
+      .default_value(false)
+      .implicit_value(true);
+
+  args.add_argument("--ss_batch_size")
+      .help("Batch size for SlabStore.")
+      .default_value<size_t>(64 * 1024)
+      .scan<'u', size_t>();
+
   // Other parmeters.
   args.add_argument("--emb_size")
       .help("Size of one embedding.")
@@ -170,6 +201,7 @@ int main(int argc, char** argv) {
   const auto hm_alloc_rate = args.get<size_t>("--hm_alloc_rate");
   const auto hm_sm_size = args.get<size_t>("--hm_sm_size");
   const auto hm_batch_size = args.get<size_t>("--hm_batch_size");
+  const auto hm_open_addressing = args.get<bool>("--hm_open_addressing");
   // Redis parameters.
   const auto re_address = args.get<std::string>("--re_address");
   const auto re_parts = args.get<size_t>("--re_parts");
@@ -179,6 +211,12 @@ int main(int argc, char** argv) {
   const auto ro_path = args.get<std::string>("--ro_path");
   const auto ro_threads = args.get<size_t>("--ro_threads");
   const auto ro_batch_size = args.get<size_t>("--ro_batch_size");
+  // SlabStore parameters.
+  const auto ss_path = args.get<std::string>("--ss_path");
+  const auto ss_tasks = args.get<size_t>("--ss_tasks");
+  const auto ss_io_depth = args.get<size_t>("--ss_io_depth");
+  const auto ss_no_direct = args.get<bool>("--ss_no_direct");
+  const auto ss_batch_size = args.get<size_t>("--ss_batch_size");
   // Other parameters.
   const auto emb_size = args.get<size_t>("--emb_size");
   const auto fill_amount = args.get<size_t>("--fill_amount");
@@ -203,6 +241,7 @@ int main(int argc, char** argv) {
             << "  hm_alloc_rate  = " << hm_alloc_rate << std::endl
             << "  hm_sm_size     = " << hm_sm_size << std::endl
             << "  hm_batch_size  = " << hm_batch_size << std::endl
+            << "  hm_open_addr   = " << hm_open_addressing << std::endl
             << std::endl
             << "  re_address     = " << re_address << std::endl
             << "  re_parts       = " << re_parts << std::endl
@@ -212,6 +251,12 @@ int main(int argc, char** argv) {
             << "  ro_path        = " << ro_path << std::endl
             << "  ro_threads     = " << ro_threads << std::endl
             << "  ro_batch_size  = " << ro_batch_size << std::endl
+            << std::endl
+            << "  ss_path        = " << ss_path << std::endl
+            << "  ss_tasks       = " << ss_tasks << std::endl
+            << "  ss_io_depth    = " << ss_io_depth << std::endl
+            << "  ss_no_direct   = " << ss_no_direct << std::endl
+            << "  ss_batch_size  = " << ss_batch_size << std::endl
             << "  -----------------------------" << std::endl
             << "  emb_size     = " << emb_size << " x " << sizeof(float) << std::endl
             << "  fill_amount  = " << fill_amount << std::endl
@@ -235,6 +280,7 @@ int main(int argc, char** argv) {
     params.num_partitions = hm_parts;
     params.allocation_rate = hm_alloc_rate;
     params.shared_memory_size = hm_sm_size;
+    params.open_addressing = hm_open_addressing;
     db = std::make_unique<MultiProcessHashMapBackend<Key>>(params);
   } else if (db_type == "redis") {
     RedisClusterBackendParams params;
@@ -249,6 +295,14 @@ int main(int argc, char** argv) {
     params.path = ro_path;
     params.num_threads = ro_threads;
     db = std::make_unique<RocksDBBackend<Key>>(params);
+  } else if (db_type == "slab_store") {
+    SlabStoreBackendParams params;
+    params.max_batch_size = ss_batch_size;
+    params.path = ss_path;
+    params.use_direct_reads = !ss_no_direct;
+    params.num_lookup_tasks = ss_tasks;
+    params.io_depth = ss_io_depth;
+    db = std::make_unique<SlabStoreBackend<Key>>(params);
   } else {
     HCTR_DIE("Invalid db_type!");
   }
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2023, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <argparse/argparse.hpp>
+#include <chrono>
+#include <cmath>
+#include <core23/logger.hpp>
+#include <hps/message_codec.hpp>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace HugeCTR;
+
+typedef long long Key;
+
+int main(int argc, char** argv) {
+  argparse::ArgumentParser args;
+
+  // Codec parameters.
+  args.add_argument("--delta_keys")
+      .help("Sort keys, and store them as variable length deltas.")
+      .default_value(false)
+      .implicit_value(true);
+
+  args.add_argument("--value_codec")
+      .help("Value quantization (float32, float16, bfloat16, int8).")
+      .default_value<std::string>("float32");
+
+  args.add_argument("--compression")
+      .help("Block compression (none, lz4, zstd).")
+      .default_value<std::string>("none");
+
+  args.add_argument("--compression_level")
+      .help("Compression level (0 = library default).")
+      .default_value<int>(0)
+      .scan<'i', int>();
+
+  args.add_argument("--block_size")
+      .help("Number of pairs per block.")
+      .default_value<size_t>(16 * 1024)
+      .scan<'u', size_t>();
+
+  // Data parameters.
+  args.add_argument("--emb_size")
+      .help("Size of one embedding.")
+      .default_value<size_t>(128)
+      .scan<'u', size_t>();
+
+  args.add_argument("--num_keys")
+      .help("Number of keys per message.")
+      .default_value<size_t>(1024 * 1024)
+      .scan<'u', size_t>();
+
+  args.add_argument("--key_range")
+      .help("Keys are drawn from [0, key_range).")
+      .default_value<size_t>(500L * 1000 * 1000)
+      .scan<'u', size_t>();
+
+  args.add_argument("--value_stddev")
+      .help("Standard deviation of the embedding values.")
+      .default_value<float>(0.05f)
+      .scan<'g', float>();
+
+  args.add_argument("--repeat")
+      .help("Amount of encode / decode repeats.")
+      .default_value<size_t>(10)
+      .scan<'u', size_t>();
+
+  args.add_argument("--seed")
+      .help("Seed for the random number generator.")
+      .default_value<uint64_t>(4711)
+      .scan<'u', uint64_t>();
+
+  try {
+    args.parse_args(argc, argv);
+  } catch (const std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    std::cout << args;
+    return 1;
+  }
+
+  const auto delta_keys = args.get<bool>("--delta_keys");
+  const auto value_codec = args.get<std::string>("--value_codec");
+  const auto compression = args.get<std::string>("--compression");
+  const auto compression_level = args.get<int>("--compression_level");
+  const auto block_size = args.get<size_t>("--block_size");
+  const auto emb_size = args.get<size_t>("--emb_size");
+  const auto num_keys = args.get<size_t>("--num_keys");
+  const auto key_range = args.get<size_t>("--key_range");
+  const auto value_stddev = args.get<float>("--value_stddev");
+  const auto repeat = args.get<size_t>("--repeat");
+  const auto seed = args.get<uint64_t>("--seed");
+
+  std::cout << "Options: " << std::endl
+            << "  -----------------------------" << std::endl
+            << "  delta_keys        = " << delta_keys << std::endl
+            << "  value_codec       = " << value_codec << std::endl
+            << "  compression       = " << compression << std::endl
+            << "  compression_level = " << compression_level << std::endl
+            << "  block_size        = " << block_size << std::endl
+            << "  -----------------------------" << std::endl
+            << "  emb_size     = " << emb_size << " x " << sizeof(float) << std::endl
+            << "  num_keys     = " << num_keys << std::endl
+            << "  key_range    = " << key_range << std::endl
+            << "  value_stddev = " << value_stddev << std::endl
+            << "  repeat       = " << repeat << std::endl
+            << "  seed         = " << seed << std::endl
+            << "  -----------------------------" << std::endl;
+
+  MessageCodecParams params;
+  params.delta_keys = delta_keys;
+  for (const DatabaseValueCodec_t c :
+       {DatabaseValueCodec_t::Float32, DatabaseValueCodec_t::Float16,
+        DatabaseValueCodec_t::BFloat16, DatabaseValueCodec_t::Int8}) {
+    if (value_codec == hctr_enum_to_c_str(c)) {
+      params.value_codec = c;
+      break;
+    }
+    HCTR_CHECK_HINT(c != DatabaseValueCodec_t::Int8, "Invalid value_codec!");
+  }
+  for (const MessageCompression_t c :
+       {MessageCompression_t::None, MessageCompression_t::LZ4, MessageCompression_t::Zstd}) {
+    if (compression == hctr_enum_to_c_str(c)) {
+      params.compression = c;
+      break;
+    }
+    HCTR_CHECK_HINT(c != MessageCompression_t::Zstd, "Invalid compression!");
+  }
+  params.compression_level = compression_level;
+  params.block_size = block_size;
+
+  const uint32_t value_size = static_cast<uint32_t>(emb_size * sizeof(float));
+
+  try {
+    // Updates touch a random subset of a large key space, and trained embeddings are small.
+    HCTR_LOG_S(INFO, WORLD) << "Create embedding-like keys and values..." << std::endl;
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<Key> key_dist(0, static_cast<Key>(key_range) - 1);
+    std::normal_distribution<float> val_dist(0.0f, value_stddev);
+
+    std::vector<Key> keys(num_keys);
+    std::generate(keys.begin(), keys.end(), [&]() { return key_dist(gen); });
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    std::shuffle(keys.begin(), keys.end(), gen);
+    const size_t num_pairs = keys.size();
+    const size_t raw_size = num_pairs * (sizeof(Key) + value_size);
+    std::vector<float> values(num_pairs * emb_size);
+    std::generate(values.begin(), values.end(), [&]() { return val_dist(gen); });
+
+    const MessageCodec<Key> codec(params);
+    std::vector<char> payload(codec.max_encoded_size(num_pairs, value_size));
+    size_t payload_size = 0;
+
+    std::vector<Key> out_keys;
+    std::vector<char> out_values;
+    uint32_t out_value_size;
+
+    for (size_t k = 0; k < repeat; ++k) {
+      {
+        const auto t0 = std::chrono::high_resolution_clock::now();
+
+        payload_size = codec.encode(num_pairs, keys.data(),
+                                    reinterpret_cast<const char*>(values.data()), value_size,
+                                    payload.data());
+
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        const auto dur = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+        HCTR_LOG_S(INFO, WORLD) << "k = " << k << ", encode time = " << dur.count() << " us, "
+                                << std::fixed << std::setprecision(3)
+                                << (raw_size / 1000.0 / dur.count()) << " GB/s, ratio = "
+                                << (static_cast<double>(raw_size) / payload_size) << std::endl;
+      }
+      {
+        out_keys.clear();
+        out_values.clear();
+
+        const auto t0 = std::chrono::high_resolution_clock::now();
+
+        MessageCodec<Key>::decode(payload.data(), payload_size, out_keys, out_values,
+                                  out_value_size);
+
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        const auto dur = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+        HCTR_LOG_S(INFO, WORLD) << "k = " << k << ", decode time = " << dur.count() << " us, "
+                                << std::fixed << std::setprecision(3)
+                                << (raw_size / 1000.0 / dur.count()) << " GB/s" << std::endl;
+      }
+    }
+
+    // Quantization error. Keys are unique. Hence, sorting by key aligns input and output.
+    auto sorted_order = [&](const std::vector<Key>& k) {
+      std::vector<size_t> order(num_pairs);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+                [&](const size_t a, const size_t b) { return k[a] < k[b]; });
+      return order;
+    };
+    const std::vector<size_t>& in_order = sorted_order(keys);
+    const std::vector<size_t>& out_order = sorted_order(out_keys);
+    double max_error = 0;
+    for (size_t i = 0; i < num_pairs; ++i) {
+      const float* const in_v = &values[in_order[i] * emb_size];
+      const float* const out_v =
+          reinterpret_cast<const float*>(&out_values[out_order[i] * value_size]);
+      for (size_t j = 0; j < emb_size; ++j) {
+        max_error = std::max(max_error, std::abs(static_cast<double>(out_v[j] - in_v[j])));
+      }
+    }
+
+    HCTR_LOG_S(INFO, WORLD) << "Raw size = " << raw_size << " bytes, encoded size = "
+                            << payload_size << " bytes, ratio = " << std::fixed
+                            << std::setprecision(3)
+                            << (static_cast<double>(raw_size) / payload_size)
+                            << ", max. value error = " << std::scientific << max_error
+                            << std::endl;
+  } catch (const std::exception& error) {
+    HCTR_LOG_S(ERROR, WORLD) << "Error: " << error.what() << std::endl;
+    return 1;
+  }
+}